@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+UI効果音の波形（src/audio/SfxClips.cpp）を生成する
+
+短いクリップを8bit・16kHzで作り、const配列としてフラッシュに置く。
+音を変えるときはこのスクリプトを直して再実行する。
+"""
+
+import math
+from pathlib import Path
+
+SAMPLE_RATE = 16000
+OUTPUT = Path(__file__).resolve().parent.parent / "src" / "audio" / "SfxClips.cpp"
+
+
+def tone(freq, ms, amplitude, decay):
+    """減衰する正弦波（decayは1msあたりの減衰率）"""
+    count = int(SAMPLE_RATE * ms / 1000)
+    samples = []
+    for i in range(count):
+        t = i / SAMPLE_RATE
+        envelope = amplitude * math.exp(-decay * t * 1000)
+        # 立ち上がり1msでプチ音を避ける
+        envelope *= min(1.0, i / (SAMPLE_RATE / 1000))
+        samples.append(envelope * math.sin(2 * math.pi * freq * t))
+    return samples
+
+
+def square(freq_start, freq_end, ms, amplitude):
+    """周波数を下げていく矩形波（末尾はフェードアウト）"""
+    count = int(SAMPLE_RATE * ms / 1000)
+    samples = []
+    phase = 0.0
+    for i in range(count):
+        freq = freq_start + (freq_end - freq_start) * i / count
+        phase += freq / SAMPLE_RATE
+        fade = min(1.0, (count - i) / (SAMPLE_RATE * 0.02))
+        samples.append(amplitude * fade * (1.0 if (phase % 1.0) < 0.5 else -1.0))
+    return samples
+
+
+def clips():
+    click = tone(2400, 6, 0.9, 0.6)
+    confirm = tone(880, 40, 0.7, 0.04) + tone(1320, 60, 0.7, 0.04)
+    error = square(330, 180, 120, 0.5)
+    return [("CLICK", click), ("CONFIRM", confirm), ("ERROR", error)]
+
+
+def to_int8(samples):
+    return [max(-127, min(127, int(round(s * 127)))) for s in samples]
+
+
+def main():
+    lines = [
+        "// scripts/generate_sfx_clips.py で生成（直接編集しない）",
+        '#include "SfxMixer.h"',
+        "",
+        "// constの配列はフラッシュ上に置かれ、キャッシュ経由でそのまま読む（RAMにコピーしない）",
+        "namespace {",
+    ]
+    entries = []
+    for name, samples in clips():
+        data = to_int8(samples)
+        lines.append("const int8_t SFX_%s_SAMPLES[%d] = {" % (name, len(data)))
+        for start in range(0, len(data), 16):
+            chunk = ", ".join("%d" % v for v in data[start:start + 16])
+            lines.append("    %s," % chunk)
+        lines.append("};")
+        lines.append("")
+        entries.append("    {SFX_%s_SAMPLES, sizeof(SFX_%s_SAMPLES), %d}," % (name, name, SAMPLE_RATE))
+    lines.append("} // namespace")
+    lines.append("")
+    lines.append("const SfxClip SFX_CLIPS[SFX_COUNT] = {")
+    lines.extend(entries)
+    lines.append("};")
+    OUTPUT.write_text("\n".join(lines) + "\n", encoding="utf-8")
+    print("wrote %s" % OUTPUT)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,52 @@
+#ifndef AUDIO_DECODER_H
+#define AUDIO_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// 1回の復号で出力する最大サンプル数（インターリーブ、MP3の1フレーム×2ch）
+#define AUDIO_MAX_FRAME_SAMPLES (1152 * 2)
+
+struct AudioFormat {
+    uint32_t sampleRate;
+    uint8_t channels;       // 1または2
+
+    bool operator==(const AudioFormat& other) const {
+        return sampleRate == other.sampleRate && channels == other.channels;
+    }
+    bool operator!=(const AudioFormat& other) const { return !(*this == other); }
+};
+
+enum DecodeStatus : uint8_t {
+    DECODE_OK = 0,          // samplesにPCMを出力した
+    DECODE_SKIPPED,         // ヘッダーやタグを読み飛ばした（出力なし）
+    DECODE_NEED_MORE,       // 1単位分の入力がそろっていない
+    DECODE_END,             // ストリームの終わり
+    DECODE_ERROR            // 復号できない（consumedが0なら続行不能）
+};
+
+// 音声デコーダーの共通インターフェース
+// 呼び出し側は連続した入力の窓を渡し、デコーダーは先頭から1単位（MP3なら1フレーム）を
+// 復号して使ったバイト数を返す。出力は16bit符号付きPCMで、チャンネルはインターリーブ。
+class AudioDecoder {
+protected:
+    AudioFormat format;
+    uint32_t errorCount;
+
+public:
+    AudioDecoder() : format{0, 0}, errorCount(0) {}
+    virtual ~AudioDecoder() {}
+
+    virtual const char* getName() const = 0;
+    // 新しいストリームの先頭から復号できる状態に戻す
+    virtual void reset() = 0;
+    // inの先頭から復号する。pcmはAUDIO_MAX_FRAME_SAMPLES以上
+    // endOfStreamならinが残りのすべて
+    virtual DecodeStatus decode(const uint8_t* in, size_t length, bool endOfStream,
+                                size_t& consumed, int16_t* pcm, size_t& samples) = 0;
+
+    const AudioFormat& getFormat() const { return format; }
+    uint32_t getErrorCount() const { return errorCount; }
+};
+
+#endif // AUDIO_DECODER_H
@@ -0,0 +1,131 @@
+#include "AudioPipeline.h"
+#include <cstring>
+
+AudioPipeline::AudioPipeline(SpscRing<uint8_t>& inputRing, SpscRing<int16_t>& outputRing, ClockFn clockFn)
+    : input(inputRing), output(outputRing), clock(clockFn), decoder(nullptr), windowFill(0),
+      active(false), decodeDone(false), failed(false), primed(false), inputStarved(false),
+      currentFormat{0, 0},
+      decodedFrames(0), decodedSamples(0), decodeUs(0), maxDecodeUs(0), inputUnderruns(0),
+      outputUnderruns(0), renderedSamples(0), formatChanges(0) {
+}
+
+void AudioPipeline::start(AudioDecoder* streamDecoder) {
+    decoder = streamDecoder;
+    if (decoder) {
+        decoder->reset();
+    }
+    windowFill = 0;
+    primed = false;
+    inputStarved = false;
+    currentFormat = AudioFormat{0, 0};
+    decodeDone.store(false);
+    failed.store(false);
+    active.store(decoder != nullptr);
+}
+
+void AudioPipeline::stop() {
+    active.store(false);
+}
+
+AudioPipeline::StepResult AudioPipeline::decodeStep() {
+    if (!active.load() || !decoder) {
+        return STEP_IDLE;
+    }
+    if (decodeDone.load()) {
+        return STEP_FINISHED;
+    }
+    if (output.space() < AUDIO_MAX_FRAME_SAMPLES) {
+        return STEP_OUTPUT_FULL;
+    }
+
+    // 窓の後ろに入力を継ぎ足す（closeを先に見て、読み残しがないことを確かめる）
+    bool closed = input.isClosed();
+    windowFill += input.read(window + windowFill, sizeof(window) - windowFill);
+    bool endOfStream = closed && input.available() == 0;
+
+    size_t consumed = 0;
+    size_t samples = 0;
+    uint32_t startUs = clock();
+    DecodeStatus status = decoder->decode(window, windowFill, endOfStream, consumed, frame, samples);
+    uint32_t elapsedUs = clock() - startUs;
+
+    if (consumed > windowFill) {
+        consumed = windowFill;
+    }
+    if (consumed > 0) {
+        memmove(window, window + consumed, windowFill - consumed);
+        windowFill -= consumed;
+    }
+
+    switch (status) {
+        case DECODE_OK: {
+            const AudioFormat& format = decoder->getFormat();
+            if (format != currentFormat) {
+                formatChanges += currentFormat.sampleRate != 0 ? 1 : 0;
+                currentFormat = format;
+            }
+            if (format.channels == 1) {
+                // 後ろから広げて左右に複製
+                for (size_t i = samples; i-- > 0;) {
+                    frame[i * 2] = frame[i];
+                    frame[i * 2 + 1] = frame[i];
+                }
+                samples *= 2;
+            }
+            output.write(frame, samples);
+            inputStarved = false;
+            decodedFrames++;
+            decodedSamples += static_cast<uint32_t>(samples);
+            decodeUs += elapsedUs;
+            if (elapsedUs > maxDecodeUs) {
+                maxDecodeUs = elapsedUs;
+            }
+            return STEP_PROGRESS;
+        }
+        case DECODE_SKIPPED:
+            return STEP_PROGRESS;
+        case DECODE_NEED_MORE:
+            if (!endOfStream) {
+                // 復号を始めたあとで入力が尽きた＝先読みが追いついていない（続いている間は1回）
+                if (!inputStarved && decodedFrames > 0) {
+                    inputUnderruns++;
+                    inputStarved = true;
+                }
+                return STEP_NEED_INPUT;
+            }
+            break;
+        case DECODE_ERROR:
+            if (consumed > 0) {
+                return STEP_PROGRESS;
+            }
+            failed.store(true);
+            break;
+        case DECODE_END:
+        default:
+            break;
+    }
+    decodeDone.store(true);
+    output.close();
+    return STEP_FINISHED;
+}
+
+size_t AudioPipeline::render(int16_t* out, size_t count) {
+    size_t copied = 0;
+    if (active.load()) {
+        // 出だしはある程度ためてから流す（途中の途切れを減らす）
+        if (!primed && (output.available() >= AUDIO_PREBUFFER_SAMPLES || output.isClosed())) {
+            primed = true;
+        }
+        if (primed) {
+            copied = output.read(out, count);
+            if (copied < count && !output.isClosed()) {
+                outputUnderruns++;
+            }
+        }
+    }
+    if (copied < count) {
+        memset(out + copied, 0, (count - copied) * sizeof(int16_t));
+    }
+    renderedSamples += static_cast<uint32_t>(copied);
+    return copied;
+}
@@ -0,0 +1,94 @@
+#ifndef AUDIO_PIPELINE_H
+#define AUDIO_PIPELINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "AudioDecoder.h"
+#include "../shared/SpscRing.h"
+
+// デコーダーに渡す入力の窓（MP3の最大フレーム1441バイト＋同期探索の余裕）
+#ifndef AUDIO_INPUT_WINDOW_BYTES
+#define AUDIO_INPUT_WINDOW_BYTES 2048
+#endif
+
+// 再生開始前にためておくPCM（ステレオのサンプル数、MP3の2フレーム分）
+#ifndef AUDIO_PREBUFFER_SAMPLES
+#define AUDIO_PREBUFFER_SAMPLES (AUDIO_MAX_FRAME_SAMPLES * 2)
+#endif
+
+// 再生パイプライン
+// 入力リング（SDから先読みした符号化データ）→ デコーダー → PCMリング → 出力の順に流す。
+// decodeStep()は復号タスク、render()は出力タスクから呼び、リングを介してだけやり取りする。
+// PCMリングには常にステレオのインターリーブで積む（モノラルは左右に複製）。
+// SD・I2Sに依存しないので、ホストでもファイルを流して検証できる。
+class AudioPipeline {
+public:
+    typedef uint32_t (*ClockFn)();
+
+    enum StepResult : uint8_t {
+        STEP_PROGRESS = 0,      // 復号した、またはヘッダーを読み進めた
+        STEP_OUTPUT_FULL,       // PCMリングに空きがない
+        STEP_NEED_INPUT,        // 入力待ち
+        STEP_FINISHED,          // 終端まで復号した（またはエラーで打ち切った）
+        STEP_IDLE               // 再生していない
+    };
+
+private:
+    SpscRing<uint8_t>& input;
+    SpscRing<int16_t>& output;
+    ClockFn clock;
+    AudioDecoder* decoder;
+
+    uint8_t window[AUDIO_INPUT_WINDOW_BYTES];
+    size_t windowFill;
+    int16_t frame[AUDIO_MAX_FRAME_SAMPLES * 2];  // モノラルの複製用に2倍
+
+    std::atomic<bool> active;
+    std::atomic<bool> decodeDone;
+    std::atomic<bool> failed;
+    bool primed;                    // 出力を始めた
+    bool inputStarved;              // 入力待ちが続いている
+    AudioFormat currentFormat;
+
+    // 統計
+    uint32_t decodedFrames;
+    uint32_t decodedSamples;
+    uint32_t decodeUs;
+    uint32_t maxDecodeUs;
+    uint32_t inputUnderruns;        // 再生中に先読みが尽きた回数
+    uint32_t outputUnderruns;       // 出力時にPCMが足りず無音を挟んだ回数
+    uint32_t renderedSamples;
+    uint32_t formatChanges;
+
+public:
+    AudioPipeline(SpscRing<uint8_t>& inputRing, SpscRing<int16_t>& outputRing, ClockFn clockFn);
+
+    // 両方のリングが止まっている状態で呼ぶ（リングの初期化は呼び出し側）
+    void start(AudioDecoder* streamDecoder);
+    void stop();
+
+    // 復号タスク: 1単位進める
+    StepResult decodeStep();
+    // 出力タスク: countサンプルを書く（足りない分は無音）。実データの数を返す
+    size_t render(int16_t* out, size_t count);
+
+    bool isActive() const { return active.load(); }
+    bool hasFailed() const { return failed.load(); }
+    // 最後まで出力し終えた
+    bool isFinished() const { return decodeDone.load() && output.available() == 0; }
+    const AudioFormat& getFormat() const { return currentFormat; }
+    const char* getDecoderName() const { return decoder ? decoder->getName() : "-"; }
+
+    uint32_t getDecodedFrames() const { return decodedFrames; }
+    uint32_t getDecodedSamples() const { return decodedSamples; }
+    uint32_t getDecodeUs() const { return decodeUs; }
+    uint32_t getMaxDecodeUs() const { return maxDecodeUs; }
+    uint32_t getInputUnderruns() const { return inputUnderruns; }
+    uint32_t getOutputUnderruns() const { return outputUnderruns; }
+    uint32_t getRenderedSamples() const { return renderedSamples; }
+    uint32_t getFormatChanges() const { return formatChanges; }
+    uint32_t getDecodeErrors() const { return decoder ? decoder->getErrorCount() : 0; }
+};
+
+#endif // AUDIO_PIPELINE_H
@@ -0,0 +1,244 @@
+#include "AudioPlayer.h"
+#include <cstring>
+#include <driver/i2s.h>
+#include "SfxMixer.h"
+#include "../storage/SdService.h"
+
+// 復号タスクが入力・出力の空きを待つ間隔
+#ifndef AUDIO_DECODE_POLL_MS
+#define AUDIO_DECODE_POLL_MS 5
+#endif
+
+// 停止中の復号タスクが停止の確認のために起きる間隔
+#ifndef AUDIO_DECODE_IDLE_MS
+#define AUDIO_DECODE_IDLE_MS 20
+#endif
+
+AudioPlayer* g_audioPlayer = nullptr;
+
+namespace {
+uint32_t clockUs() {
+    return static_cast<uint32_t>(micros());
+}
+} // namespace
+
+AudioPlayer::AudioPlayer()
+    : inputRing(AUDIO_INPUT_RING_BYTES), pcmRing(AUDIO_PCM_RING_SAMPLES),
+      pipeline(inputRing, pcmRing, clockUs), decodeTaskHandle(nullptr), outputTaskHandle(nullptr),
+      outputReady(false), running(false), decodeParked(true), outputParked(true),
+      decoderSelected(false), state(STATE_IDLE), sampleRate(0), outputRate(AUDIO_DEFAULT_SAMPLE_RATE),
+      playCount(0) {
+}
+
+bool AudioPlayer::begin() {
+    if (decodeTaskHandle) {
+        return true;
+    }
+    // 内蔵DAC（8bit）へDMAで出す。途切れたときに0（DACでは最小値）を出さないよう自動クリアは切る
+    i2s_config_t config = {};
+    config.mode = static_cast<i2s_mode_t>(I2S_MODE_MASTER | I2S_MODE_TX | I2S_MODE_DAC_BUILT_IN);
+    config.sample_rate = AUDIO_DEFAULT_SAMPLE_RATE;
+    config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+    config.channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT;
+    config.communication_format = I2S_COMM_FORMAT_STAND_MSB;
+    config.intr_alloc_flags = 0;
+    config.dma_buf_count = AUDIO_DMA_BUFFER_COUNT;
+    config.dma_buf_len = AUDIO_DMA_BUFFER_FRAMES;
+    config.use_apll = false;
+    config.tx_desc_auto_clear = false;
+    outputReady = i2s_driver_install(I2S_NUM_0, &config, 0, nullptr) == ESP_OK;
+    if (outputReady) {
+        // i2s_set_pin(NULL)は両方のDACを有効にするので使わない（GPIO25はタッチのCLK）
+        i2s_set_dac_mode(I2S_DAC_CHANNEL_LEFT_EN);
+    } else {
+        Serial.println("I2S driver install failed");
+    }
+
+    xTaskCreatePinnedToCore(
+        decodeTask,               // タスク関数
+        "AudioDecode",            // タスク名
+        AUDIO_DECODE_STACK_SIZE,  // スタックサイズ
+        this,                     // パラメータ（thisポインタ）
+        AUDIO_DECODE_PRIORITY,    // 優先度（タッチ・SDより高い）
+        &decodeTaskHandle,        // タスクハンドル
+        AUDIO_TASK_CORE           // 表示コアとは別のコア
+    );
+    if (outputReady) {
+        xTaskCreatePinnedToCore(
+            outputTask,
+            "AudioOutput",
+            AUDIO_OUTPUT_STACK_SIZE,
+            this,
+            AUDIO_OUTPUT_PRIORITY,    // DMAの補充を最優先
+            &outputTaskHandle,
+            AUDIO_TASK_CORE
+        );
+    }
+    Serial.println("Audio tasks started");
+    return decodeTaskHandle != nullptr && outputTaskHandle != nullptr;
+}
+
+bool AudioPlayer::play(const char* path) {
+    if (!decodeTaskHandle || !outputTaskHandle || !g_sdService) {
+        state.store(STATE_FAILED);
+        return false;
+    }
+    stop();
+    // ここでは両タスクもSDサービスもリングに触れていない
+    inputRing.reset();
+    pcmRing.reset();
+    decoderSelected.store(false);
+    sampleRate.store(0);
+    if (g_sdService->requestStream(path, &inputRing) == 0) {
+        state.store(STATE_FAILED);
+        return false;
+    }
+    playCount++;
+    state.store(STATE_PLAYING);
+    running.store(true);
+    xTaskNotifyGive(decodeTaskHandle);
+    return true;
+}
+
+void AudioPlayer::stop() {
+    halt();
+    // 先読みも止める（戻った時点でSDサービスはリングに書かない）
+    if (g_sdService) {
+        g_sdService->detachStream();
+    }
+    if (state.load() == STATE_PLAYING) {
+        state.store(STATE_IDLE);
+    }
+}
+
+void AudioPlayer::halt() {
+    running.store(false);
+    pipeline.stop();
+    // 各タスクが停止を見たあとに立て直すまで待つ（出力タスクはDMA1バッファ分で戻る）
+    decodeParked.store(decodeTaskHandle == nullptr);
+    outputParked.store(outputTaskHandle == nullptr);
+    if (decodeTaskHandle) {
+        xTaskNotifyGive(decodeTaskHandle);
+    }
+    while (!decodeParked.load() || !outputParked.load()) {
+        vTaskDelay(1);
+    }
+}
+
+void AudioPlayer::setDspSettings(const DspSettings& settings) {
+    dsp.requestSettings(settings);
+    if (decodeTaskHandle) {
+        xTaskNotifyGive(decodeTaskHandle);
+    }
+}
+
+void AudioPlayer::decodeTask(void* parameter) {
+    AudioPlayer* player = static_cast<AudioPlayer*>(parameter);
+    player->runDecodeTask();
+}
+
+void AudioPlayer::outputTask(void* parameter) {
+    AudioPlayer* player = static_cast<AudioPlayer*>(parameter);
+    player->runOutputTask();
+}
+
+bool AudioPlayer::selectDecoder() {
+    // closeを先に見て、読み残しがないことを確かめる
+    bool closed = inputRing.isClosed();
+    uint8_t head[4];
+    size_t length = inputRing.peek(head, sizeof(head));
+    if (length < sizeof(head) && !closed) {
+        return false;
+    }
+    if (length == 0) {
+        // 開けなかった（SDサービスが空のまま閉じた）
+        state.store(STATE_FAILED);
+        running.store(false);
+        return false;
+    }
+    bool isWav = length == sizeof(head) && memcmp(head, "RIFF", 4) == 0;
+    pipeline.start(isWav ? static_cast<AudioDecoder*>(&wavDecoder) : &mp3Decoder);
+    decoderSelected.store(true);
+    return true;
+}
+
+void AudioPlayer::runDecodeTask() {
+    while (true) {
+        // 出力段の係数は設定かレートが変わったときだけここで作る（出力タスクでは計算しない）
+        uint32_t currentRate = sampleRate.load();
+        dsp.update(currentRate != 0 ? currentRate : AUDIO_DEFAULT_SAMPLE_RATE);
+
+        if (!running.load()) {
+            decodeParked.store(true);
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(AUDIO_DECODE_IDLE_MS));
+            continue;
+        }
+        decodeParked.store(false);
+        if (!decoderSelected.load() && !selectDecoder()) {
+            vTaskDelay(pdMS_TO_TICKS(AUDIO_DECODE_POLL_MS));
+            continue;
+        }
+
+        AudioPipeline::StepResult result = pipeline.decodeStep();
+        uint32_t rate = pipeline.getFormat().sampleRate;
+        if (rate != 0) {
+            sampleRate.store(rate);
+        }
+        switch (result) {
+            case AudioPipeline::STEP_PROGRESS:
+                break;
+            case AudioPipeline::STEP_FINISHED:
+                // 出力タスクが読み切ったら終わり
+                if (pipeline.isFinished()) {
+                    state.store(pipeline.hasFailed() ? STATE_FAILED : STATE_FINISHED);
+                    running.store(false);
+                    break;
+                }
+                vTaskDelay(pdMS_TO_TICKS(AUDIO_DECODE_POLL_MS));
+                break;
+            case AudioPipeline::STEP_OUTPUT_FULL:
+            case AudioPipeline::STEP_NEED_INPUT:
+            case AudioPipeline::STEP_IDLE:
+            default:
+                vTaskDelay(pdMS_TO_TICKS(AUDIO_DECODE_POLL_MS));
+                break;
+        }
+    }
+}
+
+void AudioPlayer::runOutputTask() {
+    while (true) {
+        if (running.load()) {
+            outputParked.store(false);
+            pipeline.render(block, AUDIO_DMA_BUFFER_FRAMES * 2);
+            dsp.process(block, AUDIO_DMA_BUFFER_FRAMES);
+            uint32_t rate = sampleRate.load();
+            if (rate != 0 && rate != outputRate) {
+                i2s_set_sample_rates(I2S_NUM_0, rate);
+                outputRate = rate;
+            }
+        } else {
+            // 停止中も無音（DACの中点）を流し続け、再開時のポップ音を避ける
+            outputParked.store(true);
+            memset(block, 0, sizeof(block));
+        }
+        // 先にDMAにたまっている分だけ遅れて聞こえる
+        uint32_t queuedUs = static_cast<uint32_t>(
+            static_cast<uint64_t>(AUDIO_DMA_BUFFER_COUNT * AUDIO_DMA_BUFFER_FRAMES) * 1000000 / outputRate);
+        g_sfxMixer.mix(block, AUDIO_DMA_BUFFER_FRAMES, outputRate, queuedUs);
+        writeBlock();
+    }
+}
+
+void AudioPlayer::writeBlock() {
+    // 内蔵DACは各16bitの上位8bitを符号なしで出す。左右を混ぜて両方に同じ値を置く
+    for (size_t i = 0; i < AUDIO_DMA_BUFFER_FRAMES; i++) {
+        int32_t mono = (static_cast<int32_t>(block[i * 2]) + block[i * 2 + 1]) >> 1;
+        int16_t value = static_cast<int16_t>(static_cast<uint16_t>(mono + 0x8000));
+        block[i * 2] = value;
+        block[i * 2 + 1] = value;
+    }
+    // DMAバッファに空きができるまで待つ（これが出力タスクの周期になる）
+    size_t written = 0;
+    i2s_write(I2S_NUM_0, block, sizeof(block), &written, portMAX_DELAY);
+}
@@ -0,0 +1,139 @@
+#ifndef AUDIO_PLAYER_H
+#define AUDIO_PLAYER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <Arduino.h>
+#include "AudioPipeline.h"
+#include "DspChain.h"
+#include "Mp3Decoder.h"
+#include "WavDecoder.h"
+#include "../shared/SpscRing.h"
+
+// SDから先読みする符号化データ（320kbpsで約400ms）
+#ifndef AUDIO_INPUT_RING_BYTES
+#define AUDIO_INPUT_RING_BYTES 16384
+#endif
+
+// 復号済みPCM（ステレオのサンプル数、44.1kHzで約90ms）
+#ifndef AUDIO_PCM_RING_SAMPLES
+#define AUDIO_PCM_RING_SAMPLES 8192
+#endif
+
+// I2SのDMAバッファ（個数とフレーム数）。出力タスクは1バッファ分ずつ書く
+// たまっている分がそのまま効果音の遅れになるので浅くする（44.1kHzで約5.8ms）
+#ifndef AUDIO_DMA_BUFFER_COUNT
+#define AUDIO_DMA_BUFFER_COUNT 4
+#endif
+
+#ifndef AUDIO_DMA_BUFFER_FRAMES
+#define AUDIO_DMA_BUFFER_FRAMES 64
+#endif
+
+// 停止中に出力するサンプルレート
+#ifndef AUDIO_DEFAULT_SAMPLE_RATE
+#define AUDIO_DEFAULT_SAMPLE_RATE 44100
+#endif
+
+// 復号タスク・出力タスク（タッチ・SDと同じCore 1、出力を最優先）
+#ifndef AUDIO_DECODE_STACK_SIZE
+#define AUDIO_DECODE_STACK_SIZE 4096
+#endif
+
+#ifndef AUDIO_DECODE_PRIORITY
+#define AUDIO_DECODE_PRIORITY 3
+#endif
+
+#ifndef AUDIO_OUTPUT_STACK_SIZE
+#define AUDIO_OUTPUT_STACK_SIZE 3072
+#endif
+
+#ifndef AUDIO_OUTPUT_PRIORITY
+#define AUDIO_OUTPUT_PRIORITY 4
+#endif
+
+#ifndef AUDIO_TASK_CORE
+#define AUDIO_TASK_CORE 1
+#endif
+
+// 再生エンジン
+// SDサービスが入力リングを先読みで埋め、復号タスクがPCMリングへ、
+// 出力タスクがPCMリングからI2SのDMAへ流す（内蔵DACでGPIO26のスピーカー端子に出す）。
+// 曲には出力タスクでDspChain（音量・EQ・リミッター）をかけ、その係数は復号タスクで作る。
+// UI効果音（g_sfxMixer）はDMAに渡す直前に重ねるので、曲を止めていても鳴る。
+// 形式はファイルの先頭で判断する（"RIFF"ならWAV、それ以外はMP3）。
+// play()/stop()は画面などから呼び、両タスクが止まったのを確かめてからリングを入れ替える。
+class AudioPlayer {
+public:
+    enum State : uint8_t {
+        STATE_IDLE = 0,
+        STATE_PLAYING,
+        STATE_FINISHED,     // 最後まで再生した
+        STATE_FAILED        // 開けない・形式が違う
+    };
+
+private:
+    SpscRing<uint8_t> inputRing;
+    SpscRing<int16_t> pcmRing;
+    AudioPipeline pipeline;
+    Mp3Decoder mp3Decoder;
+    WavDecoder wavDecoder;
+    DspChain dsp;
+
+    TaskHandle_t decodeTaskHandle;
+    TaskHandle_t outputTaskHandle;
+    bool outputReady;
+
+    std::atomic<bool> running;          // 両タスクが再生を進めてよい
+    std::atomic<bool> decodeParked;     // 復号タスクが止まったことを確認した
+    std::atomic<bool> outputParked;     // 出力タスクが止まったことを確認した
+    std::atomic<bool> decoderSelected;
+    std::atomic<uint8_t> state;
+    std::atomic<uint32_t> sampleRate;   // 出力タスクに伝える現在のレート
+    uint32_t outputRate;                // I2Sに設定済みのレート（出力タスクだけが触る）
+
+    int16_t block[AUDIO_DMA_BUFFER_FRAMES * 2];
+
+    uint32_t playCount;
+
+    static void decodeTask(void* parameter);
+    static void outputTask(void* parameter);
+    void runDecodeTask();
+    void runOutputTask();
+    bool selectDecoder();
+    void writeBlock();
+    void halt();
+
+public:
+    AudioPlayer();
+
+    // I2Sの設定と両タスクの作成
+    bool begin();
+
+    // pathのファイル（ディレクトリなら目録の先頭）を再生する。再生中なら止めてから
+    bool play(const char* path);
+    void stop();
+
+    State getState() const { return static_cast<State>(state.load()); }
+    bool isPlaying() const { return getState() == STATE_PLAYING; }
+    const AudioPipeline& getPipeline() const { return pipeline; }
+    uint32_t getSampleRate() const { return sampleRate.load(); }
+
+    // 出力設定（復号タスクを起こして係数を作らせる）
+    void setDspSettings(const DspSettings& settings);
+    DspSettings getDspSettings() const { return dsp.getRequestedSettings(); }
+    const DspChain& getDsp() const { return dsp; }
+
+    // 統計
+    uint32_t getPlayCount() const { return playCount; }
+    uint32_t getInputUnderruns() const { return pipeline.getInputUnderruns(); }
+    uint32_t getOutputUnderruns() const { return pipeline.getOutputUnderruns(); }
+    size_t getInputFill() const { return inputRing.available(); }
+    size_t getPcmFill() const { return pcmRing.available(); }
+};
+
+// グローバル再生エンジン
+extern AudioPlayer* g_audioPlayer;
+
+#endif // AUDIO_PLAYER_H
@@ -0,0 +1,334 @@
+#include "DspChain.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+// int16をQ31の語に載せるときのシフト（上に24dBの余裕）
+const int SAMPLE_SHIFT = 12;
+const int32_t Q31_ONE = 0x7FFFFFFF;
+// フィルターの出力の上限（フルスケールの+18dB。5項の積和が64bitに収まる範囲）
+const int32_t STAGE_LIMIT = 1 << 30;
+
+// 帯域ごとの特性（低音はシェルフ、中音はピーキング、高音はシェルフ）
+struct BandDef {
+    DspChain::BandType type;
+    double frequency;
+    double q;
+};
+
+const BandDef BAND_DEFS[DSP_EQ_BANDS] = {
+    {DspChain::BAND_LOW_SHELF, 120.0, 0.707},
+    {DspChain::BAND_PEAKING, 1000.0, 0.9},
+    {DspChain::BAND_HIGH_SHELF, 6000.0, 0.707},
+};
+
+int32_t clampStage(int64_t value) {
+    return static_cast<int32_t>(value >= STAGE_LIMIT ? STAGE_LIMIT - 1 : (value < -STAGE_LIMIT ? -STAGE_LIMIT : value));
+}
+
+int16_t toSample(int32_t value) {
+    int32_t shifted = value >> SAMPLE_SHIFT;
+    return static_cast<int16_t>(shifted > 32767 ? 32767 : (shifted < -32768 ? -32768 : shifted));
+}
+
+int32_t toQ31(double value) {
+    double scaled = std::round(value * 2147483648.0);
+    return static_cast<int32_t>(scaled >= 2147483647.0 ? 2147483647.0 : (scaled <= -2147483648.0 ? -2147483648.0 : scaled));
+}
+} // namespace
+
+bool DspSettings::operator==(const DspSettings& other) const {
+    return volumeDb == other.volumeDb && memcmp(eqDb, other.eqDb, sizeof(eqDb)) == 0 && limiter == other.limiter;
+}
+
+DspChain::DspChain()
+    : writeIndex(0), middle(1), readIndex(2), requested(pack(defaultSettings())),
+      appliedSettings(0), appliedRate(0), configured(false), limiterGainQ31(Q31_ONE),
+      recomputeCount(0), swapCount(0), limitedBlocks(0) {
+    // 最初の設定が届くまでは既定値（44.1kHz）で通す
+    for (Bank& bank : banks) {
+        buildBank(bank, defaultSettings(), 44100);
+    }
+    memset(states, 0, sizeof(states));
+    for (size_t band = 0; band < DSP_EQ_BANDS; band++) {
+        readActive[band] = banks[readIndex].bandActive[band];
+    }
+}
+
+DspSettings DspChain::defaultSettings() {
+    DspSettings settings;
+    settings.volumeDb = 0;
+    for (size_t band = 0; band < DSP_EQ_BANDS; band++) {
+        settings.eqDb[band] = 0;
+    }
+    settings.limiter = true;
+    return settings;
+}
+
+uint32_t DspChain::bandFrequency(size_t band) {
+    return band < DSP_EQ_BANDS ? static_cast<uint32_t>(BAND_DEFS[band].frequency) : 0;
+}
+
+// 音量8bit、帯域ごとに7bit（符号付き）、リミッター1bitを下位から詰める
+uint32_t DspChain::pack(const DspSettings& settings) {
+    static_assert(8 + 7 * DSP_EQ_BANDS + 1 <= 32, "DspSettings must fit in 32 bits");
+    static_assert(DSP_VOLUME_MIN_DB >= -128 && DSP_EQ_RANGE_DB <= 63, "DspSettings range does not fit the packed fields");
+    uint32_t packed = static_cast<uint8_t>(settings.volumeDb);
+    for (size_t band = 0; band < DSP_EQ_BANDS; band++) {
+        packed |= static_cast<uint32_t>(static_cast<uint8_t>(settings.eqDb[band]) & 0x7F) << (8 + 7 * band);
+    }
+    packed |= static_cast<uint32_t>(settings.limiter ? 1 : 0) << (8 + 7 * DSP_EQ_BANDS);
+    return packed;
+}
+
+DspSettings DspChain::unpack(uint32_t packed) {
+    DspSettings settings;
+    settings.volumeDb = static_cast<int8_t>(packed & 0xFF);
+    for (size_t band = 0; band < DSP_EQ_BANDS; band++) {
+        // 7bitの符号を広げる
+        int field = static_cast<int>((packed >> (8 + 7 * band)) & 0x7F);
+        settings.eqDb[band] = static_cast<int8_t>(field >= 0x40 ? field - 0x80 : field);
+    }
+    settings.limiter = ((packed >> (8 + 7 * DSP_EQ_BANDS)) & 1) != 0;
+    return settings;
+}
+
+int32_t DspChain::dbToQ31(double db) {
+    double gain = std::pow(10.0, db / 20.0);
+    return gain >= 1.0 ? Q31_ONE : toQ31(gain);
+}
+
+DspChain::Biquad DspChain::design(BandType type, double sampleRate, double frequency, double q, double gainDb) {
+    // Robert Bristow-Johnsonの式（Audio EQ Cookbook）
+    double a = std::pow(10.0, gainDb / 40.0);
+    double w0 = 2.0 * M_PI * frequency / sampleRate;
+    double cosW = std::cos(w0);
+    double alpha = std::sin(w0) / (2.0 * q);
+    double twoSqrtAAlpha = 2.0 * std::sqrt(a) * alpha;
+    double b0, b1, b2, a0, a1, a2;
+    switch (type) {
+        case BAND_LOW_SHELF:
+            b0 = a * ((a + 1) - (a - 1) * cosW + twoSqrtAAlpha);
+            b1 = 2 * a * ((a - 1) - (a + 1) * cosW);
+            b2 = a * ((a + 1) - (a - 1) * cosW - twoSqrtAAlpha);
+            a0 = (a + 1) + (a - 1) * cosW + twoSqrtAAlpha;
+            a1 = -2 * ((a - 1) + (a + 1) * cosW);
+            a2 = (a + 1) + (a - 1) * cosW - twoSqrtAAlpha;
+            break;
+        case BAND_HIGH_SHELF:
+            b0 = a * ((a + 1) + (a - 1) * cosW + twoSqrtAAlpha);
+            b1 = -2 * a * ((a - 1) + (a + 1) * cosW);
+            b2 = a * ((a + 1) + (a - 1) * cosW - twoSqrtAAlpha);
+            a0 = (a + 1) - (a - 1) * cosW + twoSqrtAAlpha;
+            a1 = 2 * ((a - 1) - (a + 1) * cosW);
+            a2 = (a + 1) - (a - 1) * cosW - twoSqrtAAlpha;
+            break;
+        case BAND_PEAKING:
+        default:
+            b0 = 1 + alpha * a;
+            b1 = -2 * cosW;
+            b2 = 1 - alpha * a;
+            a0 = 1 + alpha / a;
+            a1 = -2 * cosW;
+            a2 = 1 - alpha / a;
+            break;
+    }
+    double coefficients[5] = {b0 / a0, b1 / a0, b2 / a0, -a1 / a0, -a2 / a0};
+
+    // いちばん大きい係数が1未満になるまで縮める
+    double largest = 0;
+    for (double c : coefficients) {
+        largest = std::fabs(c) > largest ? std::fabs(c) : largest;
+    }
+    uint8_t shift = 0;
+    while (largest >= 1.0 && shift < 4) {
+        largest /= 2;
+        shift++;
+    }
+    double scale = 1.0 / static_cast<double>(1 << shift);
+    Biquad result;
+    result.b0 = toQ31(coefficients[0] * scale);
+    result.b1 = toQ31(coefficients[1] * scale);
+    result.b2 = toQ31(coefficients[2] * scale);
+    result.a1 = toQ31(coefficients[3] * scale);
+    result.a2 = toQ31(coefficients[4] * scale);
+    result.postShift = shift;
+    return result;
+}
+
+void DspChain::buildBank(Bank& bank, const DspSettings& settings, uint32_t sampleRate) const {
+    for (size_t band = 0; band < DSP_EQ_BANDS; band++) {
+        const BandDef& def = BAND_DEFS[band];
+        int gainDb = settings.eqDb[band];
+        gainDb = gainDb > DSP_EQ_RANGE_DB ? DSP_EQ_RANGE_DB : (gainDb < -DSP_EQ_RANGE_DB ? -DSP_EQ_RANGE_DB : gainDb);
+        // ナイキスト周波数に近い帯域（低いレートの高音）は通さない
+        bank.bandActive[band] = gainDb != 0 && def.frequency < sampleRate * 0.45;
+        if (bank.bandActive[band]) {
+            bank.bands[band] = design(def.type, sampleRate, def.frequency, def.q, gainDb);
+        }
+    }
+    int volumeDb = settings.volumeDb > 0 ? 0 : settings.volumeDb;
+    bank.volumeQ31 = volumeDb <= DSP_VOLUME_MIN_DB ? 0 : dbToQ31(volumeDb);
+    bank.limiter = settings.limiter;
+    bank.thresholdQ31 = static_cast<int32_t>((static_cast<int64_t>(32768) << SAMPLE_SHIFT) *
+                                             std::pow(10.0, DSP_LIMITER_THRESHOLD_DB / 20.0));
+    bank.releasePerFrameQ31 = toQ31(1.0 - std::exp(-1000.0 / (DSP_LIMITER_RELEASE_MS * static_cast<double>(sampleRate))));
+}
+
+void DspChain::requestSettings(const DspSettings& settings) {
+    requested.store(pack(settings));
+}
+
+bool DspChain::update(uint32_t sampleRate) {
+    uint32_t packed = requested.load();
+    if (sampleRate == 0 || (configured && packed == appliedSettings && sampleRate == appliedRate)) {
+        return false;
+    }
+    buildBank(banks[writeIndex], unpack(packed), sampleRate);
+    // 書き上げた面を受け渡し位置に置き、空いた面を次の書き込み先にする
+    writeIndex = middle.exchange(static_cast<uint8_t>(writeIndex | BANK_DIRTY), std::memory_order_acq_rel) & BANK_INDEX;
+    appliedSettings = packed;
+    appliedRate = sampleRate;
+    configured = true;
+    recomputeCount++;
+    return true;
+}
+
+void DspChain::acquireBank() {
+    if ((middle.load(std::memory_order_acquire) & BANK_DIRTY) == 0) {
+        return;
+    }
+    readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & BANK_INDEX;
+    swapCount++;
+    // 止めていた帯域を再び通すときは古い履歴を捨てる
+    const Bank& bank = banks[readIndex];
+    for (size_t band = 0; band < DSP_EQ_BANDS; band++) {
+        if (bank.bandActive[band] && !readActive[band]) {
+            memset(&states[0][band], 0, sizeof(BiquadState));
+            memset(&states[1][band], 0, sizeof(BiquadState));
+        }
+        readActive[band] = bank.bandActive[band];
+    }
+}
+
+void DspChain::runBiquad(const Biquad& c, BiquadState& s, int32_t* samples, size_t count) {
+    const int outputShift = 31 - c.postShift;
+    int32_t x1 = s.x1, x2 = s.x2, y1 = s.y1, y2 = s.y2;
+    for (size_t i = 0; i < count; i++) {
+        int32_t x0 = samples[i];
+        int64_t acc = static_cast<int64_t>(c.b0) * x0 + static_cast<int64_t>(c.b1) * x1 +
+                      static_cast<int64_t>(c.b2) * x2 + static_cast<int64_t>(c.a1) * y1 +
+                      static_cast<int64_t>(c.a2) * y2;
+        int32_t y0 = clampStage(acc >> outputShift);
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+        samples[i] = y0;
+    }
+    s.x1 = x1;
+    s.x2 = x2;
+    s.y1 = y1;
+    s.y2 = y2;
+}
+
+void DspChain::process(int16_t* stereo, size_t frames) {
+    while (frames > 0) {
+        size_t block = frames < DSP_MAX_BLOCK_FRAMES ? frames : DSP_MAX_BLOCK_FRAMES;
+        processBlock(stereo, block);
+        stereo += block * 2;
+        frames -= block;
+    }
+}
+
+void DspChain::processBlock(int16_t* stereo, size_t frames) {
+    acquireBank();
+    const Bank& bank = banks[readIndex];
+
+    // 左右に分けて余裕を持たせた語にする（音量もここで掛ける）
+    bool unity = bank.volumeQ31 == Q31_ONE;
+    for (size_t i = 0; i < frames; i++) {
+        for (int ch = 0; ch < 2; ch++) {
+            int32_t x = static_cast<int32_t>(stereo[i * 2 + ch]) << SAMPLE_SHIFT;
+            work[ch][i] = unity ? x : static_cast<int32_t>((static_cast<int64_t>(x) * bank.volumeQ31) >> 31);
+        }
+    }
+
+    // 帯域ごとにブロック全体を通す（係数をレジスタに置いたまま回す）
+    for (size_t band = 0; band < DSP_EQ_BANDS; band++) {
+        if (!bank.bandActive[band]) {
+            continue;
+        }
+        runBiquad(bank.bands[band], states[0][band], work[0], frames);
+        runBiquad(bank.bands[band], states[1][band], work[1], frames);
+    }
+
+    if (bank.limiter) {
+        // ブロックの最大値から利得を決める（左右共通）
+        // 下げるときはしきい値を超えるフレームまでに、戻すときは時定数で少しずつ（利得はブロック内で直線補間）
+        int32_t peak = 0;
+        for (size_t i = 0; i < frames; i++) {
+            int32_t l = work[0][i] < 0 ? -work[0][i] : work[0][i];
+            int32_t r = work[1][i] < 0 ? -work[1][i] : work[1][i];
+            peak = l > peak ? l : peak;
+            peak = r > peak ? r : peak;
+        }
+        int32_t target = Q31_ONE;
+        if (peak > bank.thresholdQ31) {
+            target = static_cast<int32_t>((static_cast<int64_t>(bank.thresholdQ31) << 31) / peak);
+            limitedBlocks++;
+        }
+        int32_t startGain = limiterGainQ31;
+        int32_t endGain;
+        size_t rampFrames;
+        if (target <= startGain) {
+            // 下げるときは、今の利得のままではしきい値を超える最初のフレームで目標に届くよう
+            // そこまで直線で下げる（それより前のフレームは今の利得でも超えない）
+            endGain = target;
+            rampFrames = 0;
+            while (rampFrames < frames) {
+                int32_t l = work[0][rampFrames] < 0 ? -work[0][rampFrames] : work[0][rampFrames];
+                int32_t r = work[1][rampFrames] < 0 ? -work[1][rampFrames] : work[1][rampFrames];
+                int32_t louder = l > r ? l : r;
+                if (((static_cast<int64_t>(louder) * startGain) >> 31) > bank.thresholdQ31) {
+                    break;
+                }
+                rampFrames++;
+            }
+        } else {
+            int64_t release = static_cast<int64_t>(bank.releasePerFrameQ31) * static_cast<int64_t>(frames);
+            release = release > Q31_ONE ? Q31_ONE : release;
+            endGain = startGain + static_cast<int32_t>((static_cast<int64_t>(target - startGain) * release) >> 31);
+            rampFrames = frames;
+        }
+        limiterGainQ31 = endGain;
+        if (startGain != Q31_ONE || endGain != Q31_ONE) {
+            // rampFramesまで直線補間し、以降は目標の利得で保つ
+            int64_t gain = static_cast<int64_t>(rampFrames > 0 ? startGain : endGain) << 16;
+            int64_t step = rampFrames > 0
+                ? ((static_cast<int64_t>(endGain) - startGain) << 16) / static_cast<int64_t>(rampFrames)
+                : 0;
+            for (size_t i = 0; i < frames; i++) {
+                int32_t g = static_cast<int32_t>(gain >> 16);
+                work[0][i] = static_cast<int32_t>((static_cast<int64_t>(work[0][i]) * g) >> 31);
+                work[1][i] = static_cast<int32_t>((static_cast<int64_t>(work[1][i]) * g) >> 31);
+                gain = i + 1 < rampFrames ? gain + step : static_cast<int64_t>(endGain) << 16;
+            }
+        }
+    } else {
+        limiterGainQ31 = Q31_ONE;
+    }
+
+    for (size_t i = 0; i < frames; i++) {
+        stereo[i * 2] = toSample(work[0][i]);
+        stereo[i * 2 + 1] = toSample(work[1][i]);
+    }
+}
+
+int32_t DspChain::getLimiterGainDeciDb() const {
+    int32_t gain = limiterGainQ31;
+    if (gain >= Q31_ONE || gain <= 0) {
+        return 0;
+    }
+    return static_cast<int32_t>(std::lround(200.0 * std::log10(gain / 2147483648.0)));
+}
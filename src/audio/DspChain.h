@@ -0,0 +1,142 @@
+#ifndef DSP_CHAIN_H
+#define DSP_CHAIN_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 1回に処理するフレーム数の上限（これより長いブロックは分けて処理する）
+#ifndef DSP_MAX_BLOCK_FRAMES
+#define DSP_MAX_BLOCK_FRAMES 128
+#endif
+
+// イコライザーの帯域数（低音・中音・高音）
+#define DSP_EQ_BANDS 3
+
+// 設定の範囲（dB）
+#ifndef DSP_VOLUME_MIN_DB
+#define DSP_VOLUME_MIN_DB -40
+#endif
+
+#ifndef DSP_EQ_RANGE_DB
+#define DSP_EQ_RANGE_DB 12
+#endif
+
+// リミッターのしきい値（dBFS）と戻りの時定数
+#ifndef DSP_LIMITER_THRESHOLD_DB
+#define DSP_LIMITER_THRESHOLD_DB -1
+#endif
+
+#ifndef DSP_LIMITER_RELEASE_MS
+#define DSP_LIMITER_RELEASE_MS 80
+#endif
+
+// 出力設定（画面で変える値、32bitに詰めて受け渡す）
+struct DspSettings {
+    int8_t volumeDb;                // DSP_VOLUME_MIN_DB〜0
+    int8_t eqDb[DSP_EQ_BANDS];      // ±DSP_EQ_RANGE_DB
+    bool limiter;
+
+    bool operator==(const DspSettings& other) const;
+    bool operator!=(const DspSettings& other) const { return !(*this == other); }
+};
+
+// 出力段の固定小数点DSP（音量 → 3バンドEQ → ソフトリミッター）
+// 信号はQ31の語に24dBの余裕を持たせて載せ（int16を12bit左へ）、最後にint16へ戻す。
+// 双2次フィルターはDirect Form IのQ31で、1を超える係数はフィルターごとの
+// postShift（CMSISのarm_biquad_cascade_df1_q31と同じ考え方）で縮めて持つ。
+// 係数の計算（浮動小数点）は制御側のタスクがupdate()で行い、3面のバンクを
+// ロックなしで入れ替えて渡すので、出力タスクのprocess()は計算も待ちもしない。
+//   requestSettings(): 画面から（どのタスクからでもよい）
+//   update():          制御タスクから（復号タスク。設定とレートの変化を見て係数を作る）
+//   process():         出力タスクから
+class DspChain {
+public:
+    // Q31の係数を2^postShiftで割って持つ（a1, a2は符号を反転して持ち、すべて足し込む）
+    struct Biquad {
+        int32_t b0, b1, b2, a1, a2;
+        uint8_t postShift;
+    };
+
+    // 帯域ごとの特性
+    enum BandType : uint8_t {
+        BAND_LOW_SHELF = 0,
+        BAND_PEAKING,
+        BAND_HIGH_SHELF
+    };
+
+    // 係数の設計（ホストの周波数特性テストからも使う）
+    static Biquad design(BandType type, double sampleRate, double frequency, double q, double gainDb);
+    static int32_t dbToQ31(double db);
+
+private:
+    struct Bank {
+        Biquad bands[DSP_EQ_BANDS];
+        bool bandActive[DSP_EQ_BANDS];  // 0dBの帯域は通さない
+        int32_t volumeQ31;
+        bool limiter;
+        int32_t thresholdQ31;           // リミッターのしきい値（余裕込みの語の値）
+        int32_t releasePerFrameQ31;     // 1フレームあたりの戻りの割合
+    };
+
+    struct BiquadState {
+        int32_t x1, x2, y1, y2;
+    };
+
+    static const uint8_t BANK_DIRTY = 0x80;
+    static const uint8_t BANK_INDEX = 0x03;
+
+    // 3面のバンク（書き手・受け渡し・読み手）
+    Bank banks[3];
+    uint8_t writeIndex;                 // 制御タスクだけが触る
+    std::atomic<uint8_t> middle;        // 受け渡し中の面（新しければBANK_DIRTY）
+    uint8_t readIndex;                  // 出力タスクだけが触る
+
+    std::atomic<uint32_t> requested;    // 詰めたDspSettings（Xtensaでもロックなしで読み書きできる1語）
+    uint32_t appliedSettings;
+    uint32_t appliedRate;
+    bool configured;
+
+    // 出力タスクの状態
+    BiquadState states[2][DSP_EQ_BANDS];
+    int32_t work[2][DSP_MAX_BLOCK_FRAMES];
+    int32_t limiterGainQ31;
+    bool readActive[DSP_EQ_BANDS];
+
+    // 統計
+    uint32_t recomputeCount;
+    uint32_t swapCount;
+    uint32_t limitedBlocks;
+
+    static uint32_t pack(const DspSettings& settings);
+    static DspSettings unpack(uint32_t packed);
+    static void runBiquad(const Biquad& c, BiquadState& s, int32_t* samples, size_t count);
+    void buildBank(Bank& bank, const DspSettings& settings, uint32_t sampleRate) const;
+    void acquireBank();
+    void processBlock(int16_t* stereo, size_t frames);
+
+public:
+    DspChain();
+
+    static DspSettings defaultSettings();
+    // 画面: 新しい設定を置く（係数は次のupdate()で作られる）
+    void requestSettings(const DspSettings& settings);
+    DspSettings getRequestedSettings() const { return unpack(requested.load()); }
+
+    // 制御タスク: 設定かレートが変わっていれば係数を作り直して渡す。作り直したらtrue
+    bool update(uint32_t sampleRate);
+
+    // 出力タスク: ステレオのブロックをその場で処理する
+    void process(int16_t* stereo, size_t frames);
+
+    // 帯域の中心周波数（画面の表示用）
+    static uint32_t bandFrequency(size_t band);
+
+    uint32_t getRecomputeCount() const { return recomputeCount; }
+    uint32_t getSwapCount() const { return swapCount; }
+    uint32_t getLimitedBlocks() const { return limitedBlocks; }
+    // 現在のリミッターの利得（dB×10、0なら制限なし）
+    int32_t getLimiterGainDeciDb() const;
+};
+
+#endif // DSP_CHAIN_H
@@ -0,0 +1,208 @@
+#include "Mp3Decoder.h"
+
+#if MP3_DECODER_HELIX
+#include <cstring>
+// 状態の初期化に内部の構造体を使う（版はplatformio.iniで固定）
+extern "C" {
+#if defined(MP3_DECODER_HELIX_FLAT)
+#include <mp3dec.h>
+#include <coder.h>
+#else
+#include "libhelix-mp3/mp3dec.h"
+#include "libhelix-mp3/coder.h"
+#endif
+}
+#endif
+
+namespace {
+// ビットレート表（kbps、Layer III）
+const uint16_t BITRATES_MPEG1[16] = {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0};
+const uint16_t BITRATES_MPEG2[16] = {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0};
+const uint32_t SAMPLE_RATES_MPEG1[3] = {44100, 48000, 32000};
+
+#if MP3_DECODER_HELIX
+// MP3InitDecoder()直後と同じ状態に戻す（ビットリザーバー・IMDCTの重ね合わせ・合成フィルターを捨てる）
+void clearHelixState(HMP3Decoder handle) {
+    MP3DecInfo* info = static_cast<MP3DecInfo*>(handle);
+    FrameHeader* frameHeader = static_cast<FrameHeader*>(info->FrameHeaderPS);
+    SideInfo* sideInfo = static_cast<SideInfo*>(info->SideInfoPS);
+    ScaleFactorInfo* scaleFactorInfo = static_cast<ScaleFactorInfo*>(info->ScaleFactorInfoPS);
+    HuffmanInfo* huffmanInfo = static_cast<HuffmanInfo*>(info->HuffmanInfoPS);
+    DequantInfo* dequantInfo = static_cast<DequantInfo*>(info->DequantInfoPS);
+    IMDCTInfo* imdctInfo = static_cast<IMDCTInfo*>(info->IMDCTInfoPS);
+    SubbandInfo* subbandInfo = static_cast<SubbandInfo*>(info->SubbandInfoPS);
+
+    memset(info, 0, sizeof(MP3DecInfo));
+    info->FrameHeaderPS = frameHeader;
+    info->SideInfoPS = sideInfo;
+    info->ScaleFactorInfoPS = scaleFactorInfo;
+    info->HuffmanInfoPS = huffmanInfo;
+    info->DequantInfoPS = dequantInfo;
+    info->IMDCTInfoPS = imdctInfo;
+    info->SubbandInfoPS = subbandInfo;
+    memset(frameHeader, 0, sizeof(FrameHeader));
+    memset(sideInfo, 0, sizeof(SideInfo));
+    memset(scaleFactorInfo, 0, sizeof(ScaleFactorInfo));
+    memset(huffmanInfo, 0, sizeof(HuffmanInfo));
+    memset(dequantInfo, 0, sizeof(DequantInfo));
+    memset(imdctInfo, 0, sizeof(IMDCTInfo));
+    memset(subbandInfo, 0, sizeof(SubbandInfo));
+}
+#endif
+} // namespace
+
+Mp3Decoder::Mp3Decoder() : helix(nullptr) {
+    reset();
+}
+
+Mp3Decoder::~Mp3Decoder() {
+#if MP3_DECODER_HELIX
+    if (helix) {
+        MP3FreeDecoder(static_cast<HMP3Decoder>(helix));
+    }
+#endif
+}
+
+void Mp3Decoder::reset() {
+#if MP3_DECODER_HELIX
+    // 確保済みなら使い回して状態だけ消す（約25KBの確保は最初の復号まで遅らせる）
+    if (helix) {
+        clearHelixState(static_cast<HMP3Decoder>(helix));
+    }
+#endif
+    atStart = true;
+    tagRemaining = 0;
+    frameCount = 0;
+    resyncBytes = 0;
+    format = AudioFormat{0, 0};
+}
+
+bool Mp3Decoder::parseFrameHeader(const uint8_t* p, Mp3FrameHeader& out) {
+    // 同期ワード11bit
+    if (p[0] != 0xFF || (p[1] & 0xE0) != 0xE0) {
+        return false;
+    }
+    uint8_t versionBits = (p[1] >> 3) & 0x03;     // 0=2.5, 2=2, 3=1
+    uint8_t layerBits = (p[1] >> 1) & 0x03;       // 1=Layer III
+    uint8_t bitrateIndex = (p[2] >> 4) & 0x0F;
+    uint8_t rateIndex = (p[2] >> 2) & 0x03;
+    uint8_t padding = (p[2] >> 1) & 0x01;
+    uint8_t mode = (p[3] >> 6) & 0x03;
+    if (versionBits == 1 || layerBits != 1 || bitrateIndex == 0 || bitrateIndex == 15 || rateIndex == 3) {
+        return false;
+    }
+
+    bool mpeg1 = versionBits == 3;
+    out.version = mpeg1 ? 10 : (versionBits == 2 ? 20 : 25);
+    out.bitrateKbps = mpeg1 ? BITRATES_MPEG1[bitrateIndex] : BITRATES_MPEG2[bitrateIndex];
+    out.sampleRate = SAMPLE_RATES_MPEG1[rateIndex] >> (mpeg1 ? 0 : (versionBits == 2 ? 1 : 2));
+    out.samplesPerFrame = mpeg1 ? 1152 : 576;
+    out.channels = mode == 3 ? 1 : 2;
+    uint32_t coefficient = mpeg1 ? 144000u : 72000u;
+    out.frameLength = static_cast<uint16_t>(coefficient * out.bitrateKbps / out.sampleRate + padding);
+    return true;
+}
+
+uint32_t Mp3Decoder::id3v2TagSize(const uint8_t* p, size_t length) {
+    if (length < 10 || p[0] != 'I' || p[1] != 'D' || p[2] != '3' || p[3] == 0xFF || p[4] == 0xFF ||
+        ((p[6] | p[7] | p[8] | p[9]) & 0x80) != 0) {
+        return 0;
+    }
+    // サイズは7bitずつのsyncsafe整数。フッターがあれば10バイト足す
+    uint32_t size = (static_cast<uint32_t>(p[6]) << 21) | (static_cast<uint32_t>(p[7]) << 14) |
+                    (static_cast<uint32_t>(p[8]) << 7) | p[9];
+    return size + 10 + ((p[5] & 0x10) ? 10 : 0);
+}
+
+DecodeStatus Mp3Decoder::decode(const uint8_t* in, size_t length, bool endOfStream,
+                                size_t& consumed, int16_t* pcm, size_t& samples) {
+    consumed = 0;
+    samples = 0;
+
+    if (tagRemaining > 0) {
+        if (length == 0) {
+            return endOfStream ? DECODE_END : DECODE_NEED_MORE;
+        }
+        consumed = length < tagRemaining ? length : tagRemaining;
+        tagRemaining -= static_cast<uint32_t>(consumed);
+        return DECODE_SKIPPED;
+    }
+    if (atStart) {
+        if (length < 10 && !endOfStream) {
+            return DECODE_NEED_MORE;
+        }
+        atStart = false;
+        tagRemaining = id3v2TagSize(in, length);
+        return DECODE_SKIPPED;
+    }
+
+    // 同期ワードを探す（見つからなければ末尾3バイトだけ残して捨てる）
+    Mp3FrameHeader header;
+    size_t offset = 0;
+    while (offset + 4 <= length && !parseFrameHeader(in + offset, header)) {
+        offset++;
+    }
+    if (offset + 4 > length) {
+        if (endOfStream) {
+            consumed = length;
+            return DECODE_END;
+        }
+        consumed = length > 3 ? length - 3 : 0;
+        resyncBytes += static_cast<uint32_t>(consumed);
+        return consumed > 0 ? DECODE_SKIPPED : DECODE_NEED_MORE;
+    }
+    if (offset > 0) {
+        consumed = offset;
+        resyncBytes += static_cast<uint32_t>(offset);
+        return DECODE_SKIPPED;
+    }
+    if (length < header.frameLength) {
+        if (endOfStream) {
+            consumed = length;
+            return DECODE_END;
+        }
+        return DECODE_NEED_MORE;
+    }
+
+#if MP3_DECODER_HELIX
+    if (!helix) {
+        helix = MP3InitDecoder();
+        if (!helix) {
+            // ヒープ不足（consumedが0なので続行しない）
+            errorCount++;
+            return DECODE_ERROR;
+        }
+    }
+    unsigned char* cursor = const_cast<unsigned char*>(in);
+    int bytesLeft = static_cast<int>(length);
+    int result = MP3Decode(static_cast<HMP3Decoder>(helix), &cursor, &bytesLeft, pcm, 0);
+    consumed = length - static_cast<size_t>(bytesLeft);
+    switch (result) {
+        case ERR_MP3_NONE: {
+            MP3FrameInfo info;
+            MP3GetLastFrameInfo(static_cast<HMP3Decoder>(helix), &info);
+            format = AudioFormat{static_cast<uint32_t>(info.samprate), static_cast<uint8_t>(info.nChans)};
+            samples = static_cast<size_t>(info.outputSamps);
+            frameCount++;
+            return DECODE_OK;
+        }
+        case ERR_MP3_INDATA_UNDERFLOW:
+            consumed = 0;
+            return endOfStream ? DECODE_END : DECODE_NEED_MORE;
+        case ERR_MP3_MAINDATA_UNDERFLOW:
+            // 先頭付近でビットリザーバーがまだたまっていない（出力なしで次へ）
+            consumed = consumed > 0 ? consumed : header.frameLength;
+            return DECODE_SKIPPED;
+        default:
+            // 壊れたフレームは1バイトずらして同期を取り直す
+            errorCount++;
+            consumed = 1;
+            resyncBytes++;
+            return DECODE_SKIPPED;
+    }
+#else
+    (void)pcm;
+    errorCount++;
+    return DECODE_ERROR;
+#endif
+}
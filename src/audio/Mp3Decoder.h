@@ -0,0 +1,63 @@
+#ifndef MP3_DECODER_H
+#define MP3_DECODER_H
+
+#include "AudioDecoder.h"
+
+// 固定小数点のHelix MP3デコーダー（platformio.iniのarduino-libhelix）があれば使う
+#if defined(__has_include)
+#if __has_include("libhelix-mp3/mp3dec.h")
+#define MP3_DECODER_HELIX 1
+#elif __has_include(<mp3dec.h>)
+#define MP3_DECODER_HELIX 1
+#define MP3_DECODER_HELIX_FLAT 1
+#endif
+#endif
+
+#ifndef MP3_DECODER_HELIX
+#define MP3_DECODER_HELIX 0
+#endif
+
+// MPEG Audio Layer IIIのフレームヘッダー
+struct Mp3FrameHeader {
+    uint32_t sampleRate;
+    uint16_t bitrateKbps;
+    uint16_t frameLength;       // ヘッダーを含むバイト数
+    uint16_t samplesPerFrame;   // 1チャンネルあたり
+    uint8_t channels;
+    uint8_t version;            // 10=MPEG1, 20=MPEG2, 25=MPEG2.5
+};
+
+// MP3デコーダー
+// ID3v2タグを読み飛ばし、同期ワードを探してフレーム単位で復号する。
+// フレームの切り出しは自前で行い、復号そのものはHelixに任せる。
+// Helixがないビルド（ホストのテストなど）ではフレームの解析だけを行い、復号はエラーを返す。
+class Mp3Decoder : public AudioDecoder {
+private:
+    void* helix;                // HMP3Decoder（最初の復号で確保し、以後は使い回す）
+    bool atStart;
+    uint32_t tagRemaining;
+    uint32_t frameCount;
+    uint32_t resyncBytes;
+
+public:
+    Mp3Decoder();
+    ~Mp3Decoder() override;
+    Mp3Decoder(const Mp3Decoder&) = delete;
+    Mp3Decoder& operator=(const Mp3Decoder&) = delete;
+
+    const char* getName() const override { return "mp3"; }
+    void reset() override;
+    DecodeStatus decode(const uint8_t* in, size_t length, bool endOfStream,
+                        size_t& consumed, int16_t* pcm, size_t& samples) override;
+
+    // 4バイトのヘッダーを解析（Layer III以外・フリーフォーマットはfalse）
+    static bool parseFrameHeader(const uint8_t* p, Mp3FrameHeader& out);
+    // 先頭のID3v2タグの大きさ（タグでなければ0）。10バイト以上必要
+    static uint32_t id3v2TagSize(const uint8_t* p, size_t length);
+
+    uint32_t getFrameCount() const { return frameCount; }
+    uint32_t getResyncBytes() const { return resyncBytes; }
+    static bool hasDecoder() { return MP3_DECODER_HELIX != 0; }
+};
+
+#endif // MP3_DECODER_H
@@ -0,0 +1,247 @@
+// scripts/generate_sfx_clips.py で生成（直接編集しない）
+#include "SfxMixer.h"
+
+// constの配列はフラッシュ上に置かれ、キャッシュ経由でそのまま読む（RAMにコピーしない）
+namespace {
+const int8_t SFX_CLICK_SAMPLES[96] = {
+    0, 6, 13, 6, -14, -30, -20, 12, 40, 37, 0, -42, -52, -18, 35, 61,
+    37, -19, -55, -45, 0, 42, 48, 15, -27, -45, -25, 13, 38, 31, 0, -29,
+    -33, -10, 19, 31, 17, -9, -26, -21, 0, 20, 23, 7, -13, -21, -12, 6,
+    18, 15, 0, -14, -15, -5, 9, 15, 8, -4, -12, -10, 0, 9, 11, 3,
+    -6, -10, -6, 3, 8, 7, 0, -6, -7, -2, 4, 7, 4, -2, -6, -5,
+    0, 4, 5, 2, -3, -5, -3, 1, 4, 3, 0, -3, -3, -1, 2, 3,
+};
+
+const int8_t SFX_CONFIRM_SAMPLES[1600] = {
+    0, 2, 7, 14, 22, 27, 29, 25, 16, 2, -17, -36, -55, -68, -75, -72,
+    -58, -34, -5, 24, 50, 70, 81, 84, 76, 59, 35, 8, -21, -46, -67, -79,
+    -82, -75, -60, -37, -10, 18, 43, 64, 77, 80, 74, 60, 38, 12, -15, -40,
+    -61, -74, -78, -74, -60, -40, -15, 12, 37, 58, 72, 77, 73, 60, 41, 17,
+    -9, -34, -55, -69, -75, -72, -60, -42, -18, 7, 31, 52, 67, 73, 71, 60,
+    43, 20, -5, -29, -49, -64, -71, -70, -60, -44, -22, 2, 26, 47, 62, 69,
+    69, 60, 44, 24, 0, -23, -44, -59, -67, -68, -60, -45, -25, -2, 21, 41,
+    57, 65, 66, 59, 46, 26, 4, -18, -39, -54, -63, -65, -59, -46, -28, -6,
+    16, 36, 52, 62, 64, 59, 46, 29, 8, -14, -34, -50, -60, -62, -58, -47,
+    -30, -10, 12, 31, 47, 58, 61, 57, 47, 31, 11, -9, -29, -45, -56, -60,
+    -57, -47, -32, -13, 7, 27, 43, 54, 58, 56, 47, 33, 14, -5, -25, -41,
+    -52, -57, -55, -47, -33, -16, 4, 22, 38, 50, 55, 54, 47, 34, 17, -2,
+    -20, -36, -48, -54, -53, -47, -35, -18, 0, 18, 34, 46, 52, 53, 47, 35,
+    19, 2, -16, -32, -44, -51, -52, -46, -35, -21, -3, 14, 30, 42, 49, 51,
+    46, 36, 22, 5, -13, -28, -40, -48, -50, -46, -36, -22, -6, 11, 26, 39,
+    46, 49, 45, 36, 23, 8, -9, -24, -37, -45, -48, -45, -36, -24, -9, 7,
+    23, 35, 43, 47, 44, 37, 25, 10, -6, -21, -33, -42, -45, -44, -37, -25,
+    -11, 4, 19, 32, 40, 44, 43, 37, 26, 12, -3, -17, -30, -39, -43, -42,
+    -37, -26, -13, 1, 16, 28, 37, 42, 42, 36, 27, 14, 0, -14, -27, -36,
+    -41, -41, -36, -27, -15, -1, 13, 25, 34, 40, 40, 36, 28, 16, 3, -11,
+    -23, -33, -38, -39, -36, -28, -17, -4, 10, 22, 32, 37, 39, 35, 28, 17,
+    5, -8, -20, -30, -36, -38, -35, -28, -18, -6, 7, 19, 29, 35, 37, 35,
+    28, 19, 7, -6, -18, -27, -34, -36, -34, -28, -19, -8, 4, 16, 26, 33,
+    35, 34, 29, 20, 9, -3, -15, -25, -31, -34, -33, -29, -20, -10, 2, 14,
+    23, 30, 34, 33, 28, 21, 10, -1, -12, -22, -29, -33, -32, -28, -21, -11,
+    0, 11, 21, 28, 32, 32, 28, 21, 12, 1, -10, -20, -27, -31, -31, -28,
+    -22, -12, -2, 9, 18, 26, 30, 31, 28, 22, 13, 3, -8, -17, -25, -29,
+    -30, -28, -22, -14, -4, 7, 16, 23, 28, 30, 27, 22, 14, 5, -5, -15,
+    -22, -27, -29, -27, -22, -15, -5, 4, 14, 21, 26, 28, 27, 22, 15, 6,
+    -3, -13, -20, -25, -28, -26, -22, -15, -7, 3, 12, 19, 24, 27, 26, 22,
+    16, 7, -2, -11, -18, -24, -26, -26, -22, -16, -8, 1, 10, 17, 23, 25,
+    25, 22, 16, 9, 0, -9, -16, -22, -25, -25, -22, -17, -9, -1, 8, 15,
+    21, 24, 24, 22, 17, 10, 2, -7, -14, -20, -23, -24, -22, -17, -10, -2,
+    6, 13, 19, 23, 23, 22, 17, 11, 3, -5, -12, -18, -22, -23, -21, -17,
+    -11, -4, 4, 12, 17, 21, 22, 21, 17, 11, 4, -3, -11, -17, -20, -22,
+    -21, -17, -12, -5, 3, 10, 16, 20, 21, 21, 17, 12, 5, -2, -9, -15,
+    -19, -21, -20, -17, -12, -6, 1, 8, 14, 18, 20, 20, 17, 12, 6, -1,
+    -7, -13, -18, -20, -20, -17, -13, -7, 0, 7, 13, 17, 19, 19, 17, 13,
+    7, 1, -6, -12, -16, -19, -19, -17, -13, -8, -1, 5, 11, 16, 18, 19,
+    17, 13, 8, 2, -5, -10, -15, -18, -18, -17, -13, -8, -2, 4, 10, 14,
+    0, 3, 10, 17, 19, 14, 1, -18, -37, -49, -48, -33, -4, 31, 62, 80,
+    77, 49, 8, -35, -68, -84, -77, -50, -10, 32, 66, 82, 77, 52, 13, -29,
+    -63, -81, -77, -53, -15, 26, 61, 79, 77, 54, 17, -23, -58, -77, -76, -55,
+    -20, 21, 55, 75, 76, 56, 22, -18, -53, -74, -75, -57, -24, 15, 50, 72,
+    74, 57, 26, -13, -48, -70, -74, -58, -27, 10, 45, 68, 73, 59, 29, -8,
+    -43, -66, -72, -59, -31, 6, 40, 64, 71, 59, 32, -3, -38, -62, -70, -60,
+    -34, 1, 35, 60, 69, 60, 35, 1, -33, -58, -68, -60, -36, -3, 31, 56,
+    67, 60, 38, 5, -28, -54, -66, -60, -39, -7, 26, 52, 65, 60, 40, 9,
+    -24, -50, -63, -60, -41, -11, 22, 48, 62, 60, 42, 13, -19, -46, -61, -59,
+    -42, -14, 17, 44, 59, 59, 43, 16, -15, -42, -58, -59, -44, -18, 13, 40,
+    57, 58, 44, 19, -11, -38, -55, -58, -45, -21, 9, 36, 54, 57, 45, 22,
+    -7, -34, -52, -56, -46, -23, 5, 32, 51, 56, 46, 25, -3, -30, -49, -55,
+    -46, -26, 2, 29, 48, 54, 47, 27, 0, -27, -46, -54, -47, -28, -2, 25,
+    45, 53, 47, 29, 3, -23, -43, -52, -47, -30, -5, 21, 41, 51, 47, 31,
+    6, -19, -40, -50, -47, -31, -8, 18, 38, 49, 47, 32, 9, -16, -37, -48,
+    -46, -33, -11, 14, 35, 47, 46, 33, 12, -13, -34, -46, -46, -34, -13, 11,
+    32, 45, 46, 34, 14, -9, -31, -44, -45, -35, -15, 8, 29, 42, 45, 35,
+    17, -6, -27, -41, -44, -36, -18, 5, 26, 40, 44, 36, 19, -3, -24, -39,
+    -43, -36, -20, 2, 23, 38, 43, 36, 20, -1, -21, -37, -42, -36, -21, -1,
+    20, 35, 41, 36, 22, 2, -19, -34, -41, -37, -23, -3, 17, 33, 40, 36,
+    23, 4, -16, -32, -39, -36, -24, -6, 14, 30, 38, 36, 25, 7, -13, -29,
+    -38, -36, -25, -8, 12, 28, 37, 36, 26, 9, -10, -27, -36, -36, -26, -10,
+    9, 26, 35, 36, 27, 11, -8, -24, -34, -35, -27, -12, 7, 23, 34, 35,
+    27, 12, -6, -22, -33, -35, -28, -13, 4, 21, 32, 34, 28, 14, -3, -20,
+    -31, -34, -28, -15, 2, 18, 30, 33, 28, 16, -1, -17, -29, -33, -28, -16,
+    0, 16, 28, 32, 28, 17, 1, -15, -27, -32, -28, -17, -2, 14, 26, 31,
+    28, 18, 3, -13, -25, -31, -28, -19, -4, 12, 24, 30, 28, 19, 5, -11,
+    -23, -30, -28, -19, -6, 10, 22, 29, 28, 20, 6, -9, -21, -28, -28, -20,
+    -7, 8, 20, 28, 28, 21, 8, -7, -19, -27, -28, -21, -9, 6, 19, 26,
+    27, 21, 9, -5, -18, -26, -27, -21, -10, 4, 17, 25, 27, 22, 11, -3,
+    -16, -24, -27, -22, -11, 2, 15, 24, 26, 22, 12, -1, -14, -23, -26, -22,
+    -12, 0, 13, 22, 25, 22, 13, 0, -12, -21, -25, -22, -13, -1, 11, 21,
+    25, 22, 14, 2, -10, -20, -24, -22, -14, -3, 10, 19, 24, 22, 15, 3,
+    -9, -18, -23, -22, -15, -4, 8, 18, 23, 22, 15, 5, -7, -17, -22, -22,
+    -16, -5, 6, 16, 22, 22, 16, 6, -6, -16, -21, -22, -16, -6, 5, 15,
+    21, 21, 16, 7, -4, -14, -20, -21, -17, -8, 3, 13, 20, 21, 17, 8,
+    -3, -13, -19, -21, -17, -9, 2, 12, 19, 21, 17, 9, -1, -11, -18, -20,
+    -17, -9, 1, 10, 18, 20, 17, 10, 0, -10, -17, -20, -17, -10, -1, 9,
+    16, 19, 17, 11, 1, -8, -16, -19, -17, -11, -2, 8, 15, 19, 17, 11,
+    2, -7, -15, -18, -17, -12, -3, 6, 14, 18, 17, 12, 3, -6, -14, -18,
+    -17, -12, -4, 5, 13, 17, 17, 12, 4, -5, -12, -17, -17, -12, -5, 4,
+    12, 16, 17, 13, 5, -3, -11, -16, -17, -13, -6, 3, 11, 16, 16, 13,
+    6, -2, -10, -15, -16, -13, -6, 2, 10, 15, 16, 13, 7, -1, -9, -14,
+    -16, -13, -7, 1, 8, 14, 16, 13, 8, 0, -8, -13, -15, -13, -8, 0,
+    7, 13, 15, 13, 8, 1, -7, -13, -15, -13, -8, -1, 6, 12, 15, 13,
+    9, 2, -6, -12, -14, -13, -9, -2, 5, 11, 14, 13, 9, 2, -5, -11,
+    -14, -13, -9, -3, 4, 10, 14, 13, 9, 3, -4, -10, -13, -13, -10, -4,
+    3, 9, 13, 13, 10, 4, -3, -9, -13, -13, -10, -4, 2, 9, 12, 13,
+    10, 5, -2, -8, -12, -13, -10, -5, 2, 8, 12, 13, 10, 5, -1, -7,
+    -11, -12, -10, -5, 1, 7, 11, 12, 10, 6, 0, -6, -11, -12, -10, -6,
+    0, 6, 10, 12, 10, 6, 0, -6, -10, -12, -10, -6, -1, 5, 10, 12,
+    10, 7, 1, -5, -9, -11, -10, -7, -1, 4, 9, 11, 10, 7, 2, -4,
+    -9, -11, -10, -7, -2, 4, 8, 11, 10, 7, 2, -3, -8, -10, -10, -7,
+    -3, 3, 8, 10, 10, 8, 3, -2, -7, -10, -10, -8, -3, 2, 7, 10,
+    10, 8, 3, -2, -6, -9, -10, -8, -4, 1, 6, 9, 10, 8, 4, -1,
+    -6, -9, -10, -8, -4, 1, 5, 9, 10, 8, 4, 0, -5, -8, -10, -8,
+    -5, 0, 5, 8, 9, 8, 5, 0, -4, -8, -9, -8, -5, 0, 4, 8,
+    9, 8, 5, 1, -4, -7, -9, -8, -5, -1, 4, 7, 9, 8, 5, 1,
+    -3, -7, -9, -8, -6, -1, 3, 7, 8, 8, 6, 2, -3, -6, -8, -8,
+    -6, -2, 2, 6, 8, 8, 6, 2, -2, -6, -8, -8, -6, -2, 2, 5,
+};
+
+const int8_t SFX_ERROR_SAMPLES[1920] = {
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, -64, -64, -64, -64,
+    -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64,
+    -64, -63, -63, -63, -63, -63, -62, -62, -62, -62, -62, -61, -61, -61, -61, -61,
+    -60, -60, -60, 60, 60, 59, 59, 59, 59, 59, 58, 58, 58, 58, 58, 57,
+    57, 57, 57, 57, 56, 56, 56, 56, 56, 55, 55, 55, 55, 55, 54, 54,
+    54, 54, 54, 53, 53, 53, 53, 53, 52, 52, -52, -52, -52, -51, -51, -51,
+    -51, -51, -50, -50, -50, -50, -50, -49, -49, -49, -49, -49, -48, -48, -48, -48,
+    -48, -47, -47, -47, -47, -47, -46, -46, -46, -46, -46, -45, -45, -45, -45, -45,
+    -44, -44, -44, 44, 44, 43, 43, 43, 43, 43, 42, 42, 42, 42, 42, 41,
+    41, 41, 41, 41, 40, 40, 40, 40, 40, 39, 39, 39, 39, 39, 38, 38,
+    38, 38, 38, 38, 37, 37, 37, 37, 37, 36, 36, -36, -36, -36, -35, -35,
+    -35, -35, -35, -34, -34, -34, -34, -34, -33, -33, -33, -33, -33, -32, -32, -32,
+    -32, -32, -31, -31, -31, -31, -31, -30, -30, -30, -30, -30, -29, -29, -29, -29,
+    -29, -28, -28, -28, -28, 28, 27, 27, 27, 27, 27, 26, 26, 26, 26, 26,
+    25, 25, 25, 25, 25, 24, 24, 24, 24, 24, 23, 23, 23, 23, 23, 22,
+    22, 22, 22, 22, 21, 21, 21, 21, 21, 20, 20, 20, 20, 20, 19, -19,
+    -19, -19, -19, -18, -18, -18, -18, -18, -17, -17, -17, -17, -17, -16, -16, -16,
+    -16, -16, -15, -15, -15, -15, -15, -14, -14, -14, -14, -14, -13, -13, -13, -13,
+    -13, -13, -12, -12, -12, -12, -12, -11, -11, -11, 11, 11, 10, 10, 10, 10,
+    10, 9, 9, 9, 9, 9, 8, 8, 8, 8, 8, 7, 7, 7, 7, 7,
+    6, 6, 6, 6, 6, 5, 5, 5, 5, 5, 4, 4, 4, 4, 4, 3,
+    3, 3, 3, 3, 2, 2, -2, -2, -2, -1, -1, -1, -1, -1, 0, 0,
+};
+
+} // namespace
+
+const SfxClip SFX_CLIPS[SFX_COUNT] = {
+    {SFX_CLICK_SAMPLES, sizeof(SFX_CLICK_SAMPLES), 16000},
+    {SFX_CONFIRM_SAMPLES, sizeof(SFX_CONFIRM_SAMPLES), 16000},
+    {SFX_ERROR_SAMPLES, sizeof(SFX_ERROR_SAMPLES), 16000},
+};
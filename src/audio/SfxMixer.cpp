@@ -0,0 +1,10 @@
+#include "SfxMixer.h"
+#include <Arduino.h>
+
+namespace {
+uint32_t sfxClockUs() {
+    return static_cast<uint32_t>(micros());
+}
+} // namespace
+
+SfxMixer g_sfxMixer(&sfxClockUs);
@@ -0,0 +1,193 @@
+#ifndef SFX_MIXER_H
+#define SFX_MIXER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../shared/LatencyTracer.h"
+#include "../shared/SpscRing.h"
+
+// 同時に鳴らせる効果音の数（足りなければいちばん古いものを止める）
+#ifndef AUDIO_SFX_VOICES
+#define AUDIO_SFX_VOICES 4
+#endif
+
+// 1周期の間に受け付けておける要求の数
+#ifndef AUDIO_SFX_COMMANDS
+#define AUDIO_SFX_COMMANDS 8
+#endif
+
+// タッチから音が出るまでの目標
+#ifndef AUDIO_SFX_LATENCY_BUDGET_US
+#define AUDIO_SFX_LATENCY_BUDGET_US 10000
+#endif
+
+// これより前のタッチは効果音と関係ないものとして遅延に数えない
+#ifndef AUDIO_SFX_INPUT_WINDOW_US
+#define AUDIO_SFX_INPUT_WINDOW_US 100000
+#endif
+
+// 効果音の種類（SFX_CLIPSの添字）
+enum SfxId : uint8_t {
+    SFX_CLICK = 0,      // ボタンの押下
+    SFX_CONFIRM,        // 操作の完了
+    SFX_ERROR,          // 操作の失敗
+    SFX_COUNT
+};
+
+// 効果音の波形（8bit符号付きモノラル、フラッシュ上の定数を指す）
+struct SfxClip {
+    const int8_t* samples;
+    uint32_t length;
+    uint32_t sampleRate;
+};
+
+// SfxClips.cpp（scripts/generate_sfx_clips.pyで生成）
+extern const SfxClip SFX_CLIPS[SFX_COUNT];
+
+// UI効果音のミキサー
+// trigger()はUI側（表示タスク）だけが呼び、要求はロックなしのリングで出力タスクに渡す。
+// 出力タスクはDMAに渡す直前のブロックにmix()で重ねる（再生中の曲にも無音にも重なる）。
+// 波形はフラッシュから直接読み、出力のレートに合わせて最近傍で間引き・水増しする。
+// 各効果音が最初に鳴ったブロックで、直前のタッチからの遅延をトレーサーに記録する。
+class SfxMixer {
+public:
+    typedef uint32_t (*ClockFn)();
+
+private:
+    struct Command {
+        uint8_t clip;
+        uint8_t gain;
+        uint32_t inputUs;       // タッチの時刻（なければ0）
+        uint32_t triggerUs;     // trigger()を呼んだ時刻
+    };
+
+    struct Voice {
+        const SfxClip* clip;
+        uint32_t positionQ16;   // 波形上の位置（16.16の固定小数点）
+        uint16_t gain;          // 0〜255
+        bool active;
+        bool traced;
+        uint32_t inputUs;
+        uint32_t triggerUs;
+        uint32_t serial;        // 古いものを止めるための通し番号
+    };
+
+    ClockFn clock;
+    SpscRing<Command> commands;
+    Voice voices[AUDIO_SFX_VOICES];
+    uint32_t nextSerial;
+    LatencyTracer tracer;
+    std::atomic<uint32_t> pendingInputUs;
+    std::atomic<bool> enabled;
+
+    uint32_t triggeredCount;
+    uint32_t droppedCount;      // 要求のリングが満杯
+    uint32_t stolenCount;       // 空きがなく古い音を止めた
+
+    static int16_t saturate(int32_t value) {
+        return static_cast<int16_t>(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+    }
+
+    void startVoice(const Command& command) {
+        Voice* target = nullptr;
+        for (Voice& voice : voices) {
+            if (!voice.active) {
+                target = &voice;
+                break;
+            }
+            if (!target || voice.serial - target->serial > 0x80000000u) {
+                target = &voice;   // 通し番号がいちばん古いもの
+            }
+        }
+        if (target->active) {
+            stolenCount++;
+        }
+        target->clip = &SFX_CLIPS[command.clip];
+        target->positionQ16 = 0;
+        target->gain = command.gain;
+        target->active = true;
+        target->traced = false;
+        target->inputUs = command.inputUs;
+        target->triggerUs = command.triggerUs;
+        target->serial = nextSerial++;
+    }
+
+public:
+    explicit SfxMixer(ClockFn clockFn)
+        : clock(clockFn), commands(AUDIO_SFX_COMMANDS), nextSerial(0),
+          tracer(AUDIO_SFX_LATENCY_BUDGET_US), pendingInputUs(0), enabled(true),
+          triggeredCount(0), droppedCount(0), stolenCount(0) {
+        for (Voice& voice : voices) {
+            voice = Voice();
+        }
+    }
+
+    // タッチ開始の時刻を覚えておく（次のtrigger()がこの時刻からの遅延として記録する）
+    void markInput(uint32_t inputUs) { pendingInputUs.store(inputUs); }
+
+    // 効果音を鳴らす（UI側のタスクからだけ呼ぶ）
+    bool trigger(SfxId id, uint8_t gain = 255) {
+        if (id >= SFX_COUNT || !enabled.load()) {
+            return false;
+        }
+        Command command = { static_cast<uint8_t>(id), gain, pendingInputUs.exchange(0), clock() };
+        if (command.triggerUs - command.inputUs > AUDIO_SFX_INPUT_WINDOW_US) {
+            command.inputUs = 0;
+        }
+        if (commands.write(&command, 1) == 0) {
+            droppedCount++;
+            return false;
+        }
+        triggeredCount++;
+        return true;
+    }
+
+    // 出力タスク: ステレオのブロックに重ねる
+    // queuedUsはこのブロックより先にDMAにたまっている時間（音が出るまでの遅れの見積もり）
+    void mix(int16_t* stereo, size_t frames, uint32_t outputRate, uint32_t queuedUs) {
+        if (outputRate == 0) {
+            return;
+        }
+        uint32_t nowUs = clock();
+        Command command;
+        while (commands.read(&command, 1) == 1) {
+            startVoice(command);
+        }
+        for (Voice& voice : voices) {
+            if (!voice.active) {
+                continue;
+            }
+            const SfxClip& clip = *voice.clip;
+            uint32_t step = static_cast<uint32_t>((static_cast<uint64_t>(clip.sampleRate) << 16) / outputRate);
+            for (size_t i = 0; i < frames; i++) {
+                uint32_t index = voice.positionQ16 >> 16;
+                if (index >= clip.length) {
+                    voice.active = false;
+                    break;
+                }
+                int32_t sample = clip.samples[index] * static_cast<int32_t>(voice.gain);
+                stereo[i * 2] = saturate(stereo[i * 2] + sample);
+                stereo[i * 2 + 1] = saturate(stereo[i * 2 + 1] + sample);
+                voice.positionQ16 += step;
+            }
+            if (!voice.traced) {
+                voice.traced = true;
+                tracer.record(voice.inputUs, voice.triggerUs, nowUs, nowUs + queuedUs);
+            }
+        }
+    }
+
+    void setEnabled(bool enable) { enabled.store(enable); }
+    bool isEnabled() const { return enabled.load(); }
+
+    const LatencyTracer& getTracer() const { return tracer; }
+    uint32_t getTriggeredCount() const { return triggeredCount; }
+    uint32_t getDroppedCount() const { return droppedCount; }
+    uint32_t getStolenCount() const { return stolenCount; }
+};
+
+// グローバル効果音ミキサー
+extern SfxMixer g_sfxMixer;
+
+#endif // SFX_MIXER_H
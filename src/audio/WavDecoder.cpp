@@ -0,0 +1,150 @@
+#include "WavDecoder.h"
+#include <cstring>
+
+namespace {
+uint16_t readLe16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readLe32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+const uint16_t WAVE_FORMAT_PCM = 1;
+const size_t FMT_MIN_SIZE = 16;
+} // namespace
+
+WavDecoder::WavDecoder() {
+    reset();
+}
+
+void WavDecoder::reset() {
+    stage = STAGE_RIFF;
+    bitsPerSample = 0;
+    blockAlign = 0;
+    hasFormat = false;
+    skipRemaining = 0;
+    dataRemaining = 0;
+    format = AudioFormat{0, 0};
+}
+
+DecodeStatus WavDecoder::fail(size_t& consumed) {
+    errorCount++;
+    stage = STAGE_DONE;
+    consumed = 0;
+    return DECODE_ERROR;
+}
+
+DecodeStatus WavDecoder::decode(const uint8_t* in, size_t length, bool endOfStream,
+                                size_t& consumed, int16_t* pcm, size_t& samples) {
+    consumed = 0;
+    samples = 0;
+    switch (stage) {
+        case STAGE_RIFF:
+            if (length < 12) {
+                return endOfStream ? fail(consumed) : DECODE_NEED_MORE;
+            }
+            if (memcmp(in, "RIFF", 4) != 0 || memcmp(in + 8, "WAVE", 4) != 0) {
+                return fail(consumed);
+            }
+            consumed = 12;
+            stage = STAGE_CHUNK;
+            return DECODE_SKIPPED;
+
+        case STAGE_CHUNK: {
+            if (length < 8) {
+                return endOfStream ? fail(consumed) : DECODE_NEED_MORE;
+            }
+            uint32_t size = readLe32(in + 4);
+            if (memcmp(in, "fmt ", 4) == 0) {
+                if (size < FMT_MIN_SIZE) {
+                    return fail(consumed);
+                }
+                if (length < 8 + FMT_MIN_SIZE) {
+                    return endOfStream ? fail(consumed) : DECODE_NEED_MORE;
+                }
+                uint16_t tag = readLe16(in + 8);
+                uint16_t channels = readLe16(in + 10);
+                uint32_t rate = readLe32(in + 12);
+                blockAlign = readLe16(in + 20);
+                bitsPerSample = static_cast<uint8_t>(readLe16(in + 22));
+                if (tag != WAVE_FORMAT_PCM || channels < 1 || channels > 2 || rate == 0 ||
+                    (bitsPerSample != 8 && bitsPerSample != 16) ||
+                    blockAlign != channels * (bitsPerSample / 8)) {
+                    return fail(consumed);
+                }
+                format = AudioFormat{rate, static_cast<uint8_t>(channels)};
+                hasFormat = true;
+                // fmtの拡張部分（とRIFFの2バイト境界の詰め物）は読み飛ばす
+                consumed = 8 + FMT_MIN_SIZE;
+                skipRemaining = size - FMT_MIN_SIZE + (size & 1);
+                stage = skipRemaining > 0 ? STAGE_SKIP : STAGE_CHUNK;
+                return DECODE_SKIPPED;
+            }
+            if (memcmp(in, "data", 4) == 0) {
+                if (!hasFormat) {
+                    return fail(consumed);
+                }
+                consumed = 8;
+                dataRemaining = size;
+                stage = STAGE_DATA;
+                return DECODE_SKIPPED;
+            }
+            // LIST等は中身を読まない
+            consumed = 8;
+            skipRemaining = size + (size & 1);
+            stage = skipRemaining > 0 ? STAGE_SKIP : STAGE_CHUNK;
+            return DECODE_SKIPPED;
+        }
+
+        case STAGE_SKIP:
+            if (length == 0) {
+                return endOfStream ? fail(consumed) : DECODE_NEED_MORE;
+            }
+            consumed = length < skipRemaining ? length : skipRemaining;
+            skipRemaining -= static_cast<uint32_t>(consumed);
+            if (skipRemaining == 0) {
+                stage = STAGE_CHUNK;
+            }
+            return DECODE_SKIPPED;
+
+        case STAGE_DATA: {
+            if (dataRemaining < blockAlign) {
+                stage = STAGE_DONE;
+                return DECODE_END;
+            }
+            size_t usable = length < dataRemaining ? length : dataRemaining;
+            size_t frames = usable / blockAlign;
+            size_t maxFrames = AUDIO_MAX_FRAME_SAMPLES / format.channels;
+            if (frames > maxFrames) {
+                frames = maxFrames;
+            }
+            if (frames == 0) {
+                // ファイルが途中で切れていれば終わりとして扱う
+                if (endOfStream) {
+                    stage = STAGE_DONE;
+                    return DECODE_END;
+                }
+                return DECODE_NEED_MORE;
+            }
+            samples = frames * format.channels;
+            if (bitsPerSample == 16) {
+                for (size_t i = 0; i < samples; i++) {
+                    pcm[i] = static_cast<int16_t>(readLe16(in + i * 2));
+                }
+            } else {
+                for (size_t i = 0; i < samples; i++) {
+                    pcm[i] = static_cast<int16_t>((in[i] - 128) * 256);
+                }
+            }
+            consumed = frames * blockAlign;
+            dataRemaining -= static_cast<uint32_t>(consumed);
+            return DECODE_OK;
+        }
+
+        case STAGE_DONE:
+        default:
+            return DECODE_END;
+    }
+}
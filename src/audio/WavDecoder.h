@@ -0,0 +1,36 @@
+#ifndef WAV_DECODER_H
+#define WAV_DECODER_H
+
+#include "AudioDecoder.h"
+
+// WAV（リニアPCM 8/16bit、モノラル/ステレオ）のデコーダー
+// RIFFのチャンクを順に読み、fmtで形式を決めてdataの中身をそのまま渡す。
+class WavDecoder : public AudioDecoder {
+private:
+    enum Stage : uint8_t {
+        STAGE_RIFF = 0,
+        STAGE_CHUNK,            // 次のチャンクの見出し
+        STAGE_SKIP,             // 不要なチャンクの中身を読み飛ばし中
+        STAGE_DATA,
+        STAGE_DONE
+    };
+
+    Stage stage;
+    uint8_t bitsPerSample;
+    uint16_t blockAlign;
+    bool hasFormat;
+    uint32_t skipRemaining;
+    uint32_t dataRemaining;
+
+    DecodeStatus fail(size_t& consumed);
+
+public:
+    WavDecoder();
+
+    const char* getName() const override { return "wav"; }
+    void reset() override;
+    DecodeStatus decode(const uint8_t* in, size_t length, bool endOfStream,
+                        size_t& consumed, int16_t* pcm, size_t& samples) override;
+};
+
+#endif // WAV_DECODER_H
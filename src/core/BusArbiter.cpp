@@ -0,0 +1,133 @@
+#include "BusArbiter.h"
+
+BusArbiter g_busArbiter;
+
+namespace {
+const int CLIENT_HOSTS[BUS_CLIENT_COUNT] = {
+    BUS_TOUCH_HOST,
+    BUS_DISPLAY_HOST,
+    BUS_SD_HOST
+};
+
+const char* const CLIENT_NAMES[BUS_CLIENT_COUNT] = {
+    "touch",
+    "display",
+    "sd"
+};
+} // namespace
+
+BusArbiter::BusArbiter() : busCount(0), windowStartUs(0) {
+    // 同じホストのクライアントを1本のバスにまとめる
+    for (size_t i = 0; i < BUS_CLIENT_COUNT; i++) {
+        size_t bus = 0;
+        while (bus < busCount && buses[bus].host != CLIENT_HOSTS[i]) {
+            bus++;
+        }
+        if (bus == busCount) {
+            buses[bus].mutex = nullptr;
+            buses[bus].host = CLIENT_HOSTS[i];
+            buses[bus].clientMask = 0;
+            buses[bus].waitingMask.store(0);
+            buses[bus].owner.store(BUS_CLIENT_COUNT);
+            buses[bus].busyUs = 0;
+            busCount++;
+        }
+        buses[bus].clientMask |= static_cast<uint8_t>(1u << i);
+        busOf[i] = static_cast<uint8_t>(bus);
+        stats[i] = ClientStats();
+        acquiredUs[i] = 0;
+    }
+}
+
+void BusArbiter::init() {
+    for (size_t bus = 0; bus < busCount; bus++) {
+        if (!buses[bus].mutex) {
+            buses[bus].mutex = xSemaphoreCreateMutex();
+        }
+    }
+    windowStartUs = micros();
+}
+
+bool BusArbiter::acquire(BusClient client, TickType_t timeout) {
+    Bus& bus = buses[busOf[client]];
+    ClientStats& stat = stats[client];
+    if (!bus.mutex) {
+        return false;
+    }
+    uint8_t bit = static_cast<uint8_t>(1u << client);
+    uint32_t startUs = micros();
+    bool contended = bus.owner.load() != BUS_CLIENT_COUNT;
+
+    bus.waitingMask.fetch_or(bit);
+    bool taken = xSemaphoreTake(bus.mutex, timeout) == pdTRUE;
+    bus.waitingMask.fetch_and(static_cast<uint8_t>(~bit));
+    if (!taken) {
+        stat.timeoutCount++;
+        return false;
+    }
+
+    uint32_t nowUs = micros();
+    uint32_t waitUs = nowUs - startUs;
+    bus.owner.store(client);
+    acquiredUs[client] = nowUs;
+    stat.acquireCount++;
+    stat.contendedCount += contended ? 1 : 0;
+    stat.totalWaitUs += waitUs;
+    if (waitUs > stat.maxWaitUs) {
+        stat.maxWaitUs = waitUs;
+    }
+    return true;
+}
+
+void BusArbiter::release(BusClient client) {
+    Bus& bus = buses[busOf[client]];
+    if (bus.owner.load() != client) {
+        return;
+    }
+    ClientStats& stat = stats[client];
+    uint32_t holdUs = micros() - acquiredUs[client];
+    stat.totalHoldUs += holdUs;
+    if (holdUs > stat.maxHoldUs) {
+        stat.maxHoldUs = holdUs;
+    }
+    bus.busyUs += holdUs;
+    bus.owner.store(BUS_CLIENT_COUNT);
+    xSemaphoreGive(bus.mutex);
+}
+
+bool BusArbiter::hasHigherWaiter(BusClient client) const {
+    // 自分より小さい番号のクライアントのビット
+    uint8_t higher = static_cast<uint8_t>((1u << client) - 1u);
+    return (buses[busOf[client]].waitingMask.load() & higher) != 0;
+}
+
+void BusArbiter::yield(BusClient client) {
+    if (!hasHigherWaiter(client)) {
+        return;
+    }
+    stats[client].yieldCount++;
+    release(client);
+    // 待っている側は別のコアにいることがあるので、1tick空けて先に取らせる
+    vTaskDelay(1);
+    acquire(client);
+}
+
+uint8_t BusArbiter::getUtilizationPercent(size_t bus) const {
+    uint32_t windowUs = micros() - windowStartUs;
+    if (bus >= busCount || windowUs == 0) {
+        return 0;
+    }
+    uint64_t percent = static_cast<uint64_t>(buses[bus].busyUs) * 100u / windowUs;
+    return static_cast<uint8_t>(percent > 100 ? 100 : percent);
+}
+
+void BusArbiter::resetWindow() {
+    for (size_t bus = 0; bus < busCount; bus++) {
+        buses[bus].busyUs = 0;
+    }
+    windowStartUs = micros();
+}
+
+const char* BusArbiter::clientName(BusClient client) {
+    return client < BUS_CLIENT_COUNT ? CLIENT_NAMES[client] : "?";
+}
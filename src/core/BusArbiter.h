@@ -0,0 +1,116 @@
+#ifndef BUS_ARBITER_H
+#define BUS_ARBITER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <Arduino.h>
+#include <SPI.h>
+
+// 各クライアントが使うSPIホスト（同じ値なら1本のバスを共有して順番に使う）
+// LCDはmain.cppのSPI2_HOST（HSPI）、SDはVSPI、タッチは専用ピンのソフトウェアSPI
+#ifndef BUS_DISPLAY_HOST
+#define BUS_DISPLAY_HOST HSPI
+#endif
+
+#ifndef BUS_SD_HOST
+#define BUS_SD_HOST VSPI
+#endif
+
+// -1はどのホストとも共有しない（タッチはバスを取らずに読む）
+#ifndef BUS_TOUCH_HOST
+#define BUS_TOUCH_HOST -1
+#endif
+
+// バスの利用者（値が小さいほど優先度が高い）
+enum BusClient : uint8_t {
+    BUS_CLIENT_TOUCH = 0,       // 10ms周期の短い読み取り
+    BUS_CLIENT_DISPLAY,         // 1フレーム分の転送をまとめて行う
+    BUS_CLIENT_SD,              // 長い処理は区切りごとに譲る
+    BUS_CLIENT_COUNT
+};
+
+// SPIバスの調停
+// ホストごとにミューテックスを1つ持ち、同じホストを使うクライアントの転送を直列化する。
+// 待っているクライアントより優先度の低い保持者はyield()で一度バスを手放す。
+// クライアントごとの待ち時間・保持時間と、バスごとの使用率を記録する。
+// 1つのクライアントは1つのタスクからだけ使う前提（統計は保持者のみが書く）。
+class BusArbiter {
+public:
+    struct ClientStats {
+        uint32_t acquireCount;
+        uint32_t contendedCount;    // 他のクライアントが保持していて待った回数
+        uint32_t yieldCount;
+        uint32_t timeoutCount;
+        uint32_t totalWaitUs;
+        uint32_t maxWaitUs;
+        uint32_t totalHoldUs;
+        uint32_t maxHoldUs;
+    };
+
+private:
+    struct Bus {
+        SemaphoreHandle_t mutex;
+        int host;
+        uint8_t clientMask;                 // このバスを使うクライアント
+        std::atomic<uint8_t> waitingMask;   // 取得を待っているクライアント
+        std::atomic<uint8_t> owner;         // BUS_CLIENT_COUNTなら空き
+        uint32_t busyUs;                    // 計測窓内の保持時間の合計
+    };
+
+    Bus buses[BUS_CLIENT_COUNT];
+    uint8_t busOf[BUS_CLIENT_COUNT];
+    size_t busCount;
+    ClientStats stats[BUS_CLIENT_COUNT];
+    uint32_t acquiredUs[BUS_CLIENT_COUNT];
+    uint32_t windowStartUs;
+
+public:
+    BusArbiter();
+
+    // ミューテックスを作成（タスク開始前に一度呼ぶ）
+    void init();
+
+    // バスを取得（timeoutまで待てなければfalse）
+    bool acquire(BusClient client, TickType_t timeout = portMAX_DELAY);
+    void release(BusClient client);
+    // 優先度の高いクライアントが待っていればバスを一度譲る（長い処理の区切りで呼ぶ）
+    void yield(BusClient client);
+    bool hasHigherWaiter(BusClient client) const;
+
+    bool isShared(BusClient a, BusClient b) const { return busOf[a] == busOf[b]; }
+    size_t getBusCount() const { return busCount; }
+    int getBusHost(size_t bus) const { return buses[bus].host; }
+    uint8_t getBusClients(size_t bus) const { return buses[bus].clientMask; }
+
+    // 統計
+    const ClientStats& getStats(BusClient client) const { return stats[client]; }
+    // 前回のresetWindow()からのバス使用率（%）
+    uint8_t getUtilizationPercent(size_t bus) const;
+    void resetWindow();
+    static const char* clientName(BusClient client);
+};
+
+// バスを保持する範囲
+class BusLock {
+private:
+    BusArbiter& arbiter;
+    BusClient client;
+    bool held;
+
+public:
+    BusLock(BusArbiter& busArbiter, BusClient busClient)
+        : arbiter(busArbiter), client(busClient), held(busArbiter.acquire(busClient)) {}
+    ~BusLock() {
+        if (held) {
+            arbiter.release(client);
+        }
+    }
+    BusLock(const BusLock&) = delete;
+    BusLock& operator=(const BusLock&) = delete;
+};
+
+// グローバルバス調停
+extern BusArbiter g_busArbiter;
+
+#endif // BUS_ARBITER_H
@@ -1,7 +1,13 @@
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
 #include "Core0Manager.h"
+#include "FrameScheduler.h"
+#include "BusArbiter.h"
 #include <Arduino.h>
 
-Core0Manager::Core0Manager(LGFX* display) : tft(display), displayManager(nullptr) {
+TaskHandle_t Core0Manager::wakeTarget = nullptr;
+
+Core0Manager::Core0Manager(LGFX* display) : tft(display), displayManager(nullptr), displayTaskHandle(nullptr) {
 }
 
 Core0Manager::~Core0Manager() {
@@ -30,9 +36,16 @@ void Core0Manager::startTasks() {
         0                         // Core 0に固定
     );
     
+    wakeTarget = displayTaskHandle;
     Serial.println("Core 0: Display task started");
 }
 
+void Core0Manager::requestFrame() {
+    if (wakeTarget) {
+        xTaskNotifyGive(wakeTarget);
+    }
+}
+
 void Core0Manager::displayTask(void* parameter) {
     Core0Manager* manager = static_cast<Core0Manager*>(parameter);
     manager->runDisplayTask();
@@ -40,15 +53,30 @@ void Core0Manager::displayTask(void* parameter) {
 
 void Core0Manager::runDisplayTask() {
     TickType_t lastWakeTime = xTaskGetTickCount();
-    const TickType_t frameDelay = pdMS_TO_TICKS(16); // 約60FPS
+    const TickType_t frameDelay = pdMS_TO_TICKS(FRAME_PERIOD_US / 1000); // 約60FPS
     
     while (true) {
-        // ディスプレイの更新
+        // 描画を先に行い、フレーム予算の残りで後回しの処理を進める
+        // 1フレーム分の転送はバスを保持したまま1つのトランザクションにまとめ、
+        // バスを共有する構成ではSDの読み書きはフレームの合間に行われる
+        g_frameScheduler.beginFrame();
+        g_busArbiter.acquire(BUS_CLIENT_DISPLAY);
+        tft->startWrite();
         if (displayManager) {
             displayManager->update();
         }
+        g_frameScheduler.runDeferred();
+        tft->endWrite();
+        g_busArbiter.release(BUS_CLIENT_DISPLAY);
+        g_frameScheduler.endFrame();
         
-        // 60FPSを維持
-        vTaskDelayUntil(&lastWakeTime, frameDelay);
+        // 60FPSを維持（タッチ開始の通知があれば前倒しし、押下の反応を1フレーム待たせない）
+        TickType_t elapsed = xTaskGetTickCount() - lastWakeTime;
+        if (elapsed < frameDelay) {
+            ulTaskNotifyTake(pdTRUE, frameDelay - elapsed);
+        } else {
+            ulTaskNotifyTake(pdTRUE, 0);
+        }
+        lastWakeTime = xTaskGetTickCount();
     }
 }
\ No newline at end of file
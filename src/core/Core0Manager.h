@@ -16,6 +16,7 @@ private:
     LGFX* tft;
     DisplayManager* displayManager;
     TaskHandle_t displayTaskHandle;
+    static TaskHandle_t wakeTarget;   // requestFrame()で起こす表示タスク
     
 public:
     Core0Manager(LGFX* display);
@@ -30,6 +31,9 @@ public:
     // 表示更新タスク（static関数）
     static void displayTask(void* parameter);
     
+    // 次のフレームを待たずに表示タスクを起こす（タッチ開始など反応を急ぐ入力で呼ぶ）
+    static void requestFrame();
+    
 private:
     // タスクの実際の処理
     void runDisplayTask();
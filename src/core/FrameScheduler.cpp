@@ -0,0 +1,10 @@
+#include "FrameScheduler.h"
+#include <Arduino.h>
+
+namespace {
+uint32_t frameClockUs() {
+    return static_cast<uint32_t>(micros());
+}
+} // namespace
+
+FrameScheduler g_frameScheduler(&frameClockUs);
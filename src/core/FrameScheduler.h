@@ -0,0 +1,274 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../shared/Delegate.h"
+
+// 1フレームの周期（マイクロ秒、表示タスクの16msに合わせる）
+#ifndef FRAME_PERIOD_US
+#define FRAME_PERIOD_US 16000
+#endif
+
+// 1フレームのうち描画と後回しの処理に使ってよい時間（残りは他タスクに譲る）
+#ifndef FRAME_BUDGET_US
+#define FRAME_BUDGET_US 12000
+#endif
+
+// 同時に登録できる後回しの処理の数
+#ifndef FRAME_SCHEDULER_MAX_JOBS
+#define FRAME_SCHEDULER_MAX_JOBS 8
+#endif
+
+// 後回しの処理の優先度（小さいほど先に実行）
+enum JobPriority : uint8_t {
+    JOB_PRIORITY_HIGH = 0,      // 画面の表示内容に必要なもの
+    JOB_PRIORITY_NORMAL,
+    JOB_PRIORITY_LOW,           // 統計・先読みなど
+    JOB_PRIORITY_COUNT
+};
+
+// 1回分の処理を実行し、完了したらtrueを返す（未完了なら次の空き時間に続きを呼ぶ）
+typedef Delegate<bool()> JobStep;
+
+// 表示コア用の協調スケジューラ
+// 各フレームで描画を先に行い、フレーム予算の残り時間に後回しの処理を
+// 1ステップずつ割り当てる。優先度の高いもの、同じ優先度なら期限の近いものから実行し、
+// 前回のステップ時間が残り時間に収まらなければ次のフレームに回す。
+// 期限を過ぎた処理は予算が残っていなくても1フレームに1ステップは進める。
+// 表示タスクからのみ呼ぶ前提（ロックなし）。
+class FrameScheduler {
+public:
+    typedef uint32_t (*ClockFn)();
+
+private:
+    struct Job {
+        const void* owner;
+        const char* name;
+        JobStep step;
+        JobPriority priority;
+        bool active;
+        bool overdue;           // 期限超過を記録済み
+        uint32_t postedUs;
+        uint32_t deadlineUs;    // 0なら期限なし
+        uint32_t lastStepUs;    // 1ステップの所要時間の見積もり
+        uint32_t lastRunFrame;
+    };
+
+    Job jobs[FRAME_SCHEDULER_MAX_JOBS];
+    ClockFn clock;
+    uint32_t budgetUs;
+
+    uint32_t frameStartUs;
+    uint32_t renderUs;          // 今のフレームの描画時間
+    uint32_t jobUs;             // 今のフレームの後回し処理の時間
+    bool rendered;
+
+    uint32_t frameCount;
+    uint32_t overBudgetFrames;
+    uint32_t missedDeadlines;
+    uint32_t completedJobs;
+    uint32_t rejectedJobs;
+    uint32_t stepCount;
+    uint8_t lastUtilization;    // 直近フレームの予算使用率（%）
+    uint8_t peakUtilization;
+    uint64_t utilizationSum;
+
+    static bool before(uint32_t a, uint32_t b) {
+        return static_cast<int32_t>(a - b) < 0;
+    }
+
+    // 次に実行する処理（なければnullptr）
+    Job* pickJob(uint32_t nowUs, uint32_t remainingUs, bool allowOverdueOnly) {
+        Job* best = nullptr;
+        for (size_t i = 0; i < FRAME_SCHEDULER_MAX_JOBS; i++) {
+            Job& job = jobs[i];
+            if (!job.active) {
+                continue;
+            }
+            bool late = job.deadlineUs != 0 && !before(nowUs, job.deadlineUs);
+            if (allowOverdueOnly ? !late : job.lastStepUs > remainingUs) {
+                continue;
+            }
+            if (!best || job.priority < best->priority ||
+                (job.priority == best->priority && earlierDeadline(job, *best))) {
+                best = &job;
+            }
+        }
+        return best;
+    }
+
+    static bool earlierDeadline(const Job& a, const Job& b) {
+        if (a.deadlineUs == 0 || b.deadlineUs == 0) {
+            return a.deadlineUs != 0 || (b.deadlineUs == 0 && before(a.postedUs, b.postedUs));
+        }
+        return before(a.deadlineUs, b.deadlineUs);
+    }
+
+    void runStep(Job& job) {
+        uint32_t startUs = clock();
+        bool done = job.step();
+        uint32_t endUs = clock();
+        job.lastStepUs = endUs - startUs;
+        job.lastRunFrame = frameCount;
+        jobUs += job.lastStepUs;
+        stepCount++;
+
+        bool late = job.deadlineUs != 0 && !before(endUs, job.deadlineUs);
+        if (late && !job.overdue) {
+            job.overdue = true;
+            missedDeadlines++;
+        }
+        if (done) {
+            job.active = false;
+            job.step = JobStep();
+            completedJobs++;
+        }
+    }
+
+public:
+    explicit FrameScheduler(ClockFn clockFn, uint32_t frameBudgetUs = FRAME_BUDGET_US)
+        : clock(clockFn), budgetUs(frameBudgetUs), frameStartUs(0), renderUs(0), jobUs(0),
+          rendered(false), frameCount(0), overBudgetFrames(0), missedDeadlines(0),
+          completedJobs(0), rejectedJobs(0), stepCount(0), lastUtilization(0),
+          peakUtilization(0), utilizationSum(0) {
+        for (size_t i = 0; i < FRAME_SCHEDULER_MAX_JOBS; i++) {
+            jobs[i].active = false;
+        }
+    }
+
+    // 処理を登録（deadlineMsは今からの期限、0で期限なし）。表が満杯ならfalse
+    bool post(const void* owner, const char* name, JobPriority priority, uint32_t deadlineMs,
+              const JobStep& step) {
+        if (!step) {
+            return false;
+        }
+        for (size_t i = 0; i < FRAME_SCHEDULER_MAX_JOBS; i++) {
+            Job& job = jobs[i];
+            if (job.active) {
+                continue;
+            }
+            uint32_t nowUs = clock();
+            job.owner = owner;
+            job.name = name;
+            job.step = step;
+            job.priority = priority < JOB_PRIORITY_COUNT ? priority : JOB_PRIORITY_LOW;
+            job.active = true;
+            job.overdue = false;
+            job.postedUs = nowUs;
+            job.deadlineUs = deadlineMs > 0 ? (nowUs + deadlineMs * 1000u) | 1u : 0;
+            job.lastStepUs = 0;
+            job.lastRunFrame = frameCount;
+            return true;
+        }
+        rejectedJobs++;
+        return false;
+    }
+
+    // ownerの処理をすべて取り消す（画面を離れるときなど）
+    void cancel(const void* owner) {
+        for (size_t i = 0; i < FRAME_SCHEDULER_MAX_JOBS; i++) {
+            if (jobs[i].active && jobs[i].owner == owner) {
+                jobs[i].active = false;
+                jobs[i].step = JobStep();
+            }
+        }
+    }
+
+    bool hasPending(const void* owner) const {
+        for (size_t i = 0; i < FRAME_SCHEDULER_MAX_JOBS; i++) {
+            if (jobs[i].active && jobs[i].owner == owner) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // フレームの開始（描画の前に呼ぶ）
+    void beginFrame() {
+        frameStartUs = clock();
+        renderUs = 0;
+        jobUs = 0;
+        rendered = false;
+    }
+
+    // 描画の後に呼び、フレーム予算の残りで後回しの処理を進める
+    void runDeferred() {
+        uint32_t nowUs = clock();
+        renderUs = nowUs - frameStartUs;
+        rendered = true;
+
+        // 期限を過ぎた処理は予算に関係なく1ステップ進める
+        Job* late = pickJob(nowUs, 0, true);
+        if (late) {
+            runStep(*late);
+        }
+
+        while (true) {
+            nowUs = clock();
+            uint32_t elapsed = nowUs - frameStartUs;
+            if (elapsed >= budgetUs) {
+                break;
+            }
+            Job* job = pickJob(nowUs, budgetUs - elapsed, false);
+            if (!job) {
+                break;
+            }
+            runStep(*job);
+        }
+
+        // 収まらずに見送った処理は見積もりを少しずつ下げ、いずれ実行されるようにする
+        for (size_t i = 0; i < FRAME_SCHEDULER_MAX_JOBS; i++) {
+            Job& job = jobs[i];
+            if (job.active && job.lastRunFrame != frameCount) {
+                job.lastStepUs -= job.lastStepUs / 4;
+            }
+        }
+    }
+
+    // フレームの終了（統計を更新）
+    void endFrame() {
+        uint32_t total = clock() - frameStartUs;
+        if (!rendered) {
+            renderUs = total;
+        }
+        uint32_t utilization = total * 100u / (budgetUs > 0 ? budgetUs : 1u);
+        lastUtilization = static_cast<uint8_t>(utilization > 255 ? 255 : utilization);
+        if (lastUtilization > peakUtilization) {
+            peakUtilization = lastUtilization;
+        }
+        if (total > budgetUs) {
+            overBudgetFrames++;
+        }
+        utilizationSum += lastUtilization;
+        frameCount++;
+    }
+
+    // 統計
+    size_t getPendingCount() const {
+        size_t count = 0;
+        for (size_t i = 0; i < FRAME_SCHEDULER_MAX_JOBS; i++) {
+            count += jobs[i].active ? 1 : 0;
+        }
+        return count;
+    }
+    uint32_t getBudgetUs() const { return budgetUs; }
+    uint32_t getLastRenderUs() const { return renderUs; }
+    uint32_t getLastJobUs() const { return jobUs; }
+    uint8_t getLastUtilization() const { return lastUtilization; }
+    uint8_t getPeakUtilization() const { return peakUtilization; }
+    uint8_t getAverageUtilization() const {
+        return frameCount > 0 ? static_cast<uint8_t>(utilizationSum / frameCount) : 0;
+    }
+    uint32_t getFrameCount() const { return frameCount; }
+    uint32_t getOverBudgetFrames() const { return overBudgetFrames; }
+    uint32_t getMissedDeadlines() const { return missedDeadlines; }
+    uint32_t getCompletedJobs() const { return completedJobs; }
+    uint32_t getRejectedJobs() const { return rejectedJobs; }
+    uint32_t getStepCount() const { return stepCount; }
+};
+
+// 表示コアのスケジューラ
+extern FrameScheduler g_frameScheduler;
+
+#endif // FRAME_SCHEDULER_H
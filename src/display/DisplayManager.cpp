@@ -7,10 +7,13 @@
 
 DisplayManager::DisplayManager(LGFX* display) 
     : tft(display), dirty(false), needsRedraw(true) {
-    lastTouch = {EVENT_NONE, 0, 0, 0, 0, 0, 0};
+    lastTouch = TouchEvent();
 }
 
 DisplayManager::~DisplayManager() {
+    if (g_eventBus) {
+        g_eventBus->unsubscribe(this);
+    }
     // unique_ptrが自動的にScreenManagerを削除
 }
 
@@ -19,14 +22,20 @@ void DisplayManager::init() {
     screenManager.reset(new ScreenManager(tft));
     screenManager->init();
     
+    // スワイプによる画面遷移（ScreenManagerの購読より後に呼ばれる）
+    if (g_eventBus) {
+        g_eventBus->subscribe(TOPIC_GESTURE, this, [this](const Event& event) {
+            onSwipeDetected(event.gestureDirection());
+        });
+    }
+    
     Serial.println("DisplayManager initialized with ScreenManager");
 }
 
 void DisplayManager::update() {
-    // イベントキューからタッチイベントを処理
-    Event event;
-    while (g_touchEventQueue && g_touchEventQueue->receive(event)) {
-        handleEvent(event);
+    // 溜まっているイベントを購読者へ配信
+    if (g_eventBus) {
+        g_eventBus->dispatchPending();
     }
     
     // 画面の更新
@@ -35,18 +44,6 @@ void DisplayManager::update() {
     }
 }
 
-void DisplayManager::handleEvent(const Event& event) {
-    // 画面管理にイベントを渡す
-    if (screenManager) {
-        screenManager->handleEvent(event);
-        
-        // スワイプジェスチャーの特別処理
-        if (event.type == EVENT_GESTURE_SWIPE) {
-            onSwipeDetected(event.data.gesture.direction);
-        }
-    }
-}
-
 void DisplayManager::redraw() {
     // 現在の画面を再描画
     if (screenManager && screenManager->getCurrentScreen()) {
@@ -76,10 +73,10 @@ void DisplayManager::onSwipeDetected(int direction) {
     
     // ホーム画面で上スワイプ → メニュー画面
     if (currentScreen == SCREEN_HOME && direction == GestureEvent::GESTURE_UP) {
-        screenManager->transitionTo(SCREEN_MENU, TRANSITION_SLIDE_UP);
+        screenManager->requestTransition(SCREEN_MENU, TRANSITION_SLIDE_UP);
     }
     // メニュー画面で任意方向のスワイプ → ホーム画面
     else if (currentScreen == SCREEN_MENU) {
-        screenManager->transitionTo(SCREEN_HOME, TRANSITION_SLIDE_DOWN);
+        screenManager->requestTransition(SCREEN_HOME, TRANSITION_SLIDE_DOWN);
     }
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 #define DISPLAY_MANAGER_H
 
 #include "../shared/Events.h"
-#include "../shared/EventQueue.h"
+#include "../shared/EventBus.h"
 #include <memory>
 
 // 前方宣言
@@ -37,9 +37,6 @@ public:
     // 画面更新（Core0のメインループから呼ばれる）
     void update();
     
-    // イベント処理
-    void handleEvent(const Event& event);
-    
     // 画面の再描画
     void redraw();
     
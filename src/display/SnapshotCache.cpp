@@ -0,0 +1,178 @@
+#include "SnapshotCache.h"
+#include <new>
+
+SnapshotCache::SnapshotCache(size_t budgetBytes)
+    : budget(budgetBytes), useCounter(0), capturing(false), captureKey(0),
+      captureWidth(0), captureHeight(0), capturedRows(0),
+      hitCount(0), missCount(0), captureCount(0), overflowCount(0) {
+    for (size_t i = 0; i < SNAPSHOT_CACHE_SLOTS; i++) {
+        entries[i].key = 0;
+        entries[i].width = 0;
+        entries[i].height = 0;
+        entries[i].size = 0;
+        entries[i].lastUsed = 0;
+    }
+}
+
+SnapshotCache::Entry* SnapshotCache::find(uint8_t key) {
+    for (size_t i = 0; i < SNAPSHOT_CACHE_SLOTS; i++) {
+        if (entries[i].data && entries[i].key == key) {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+const SnapshotCache::Entry* SnapshotCache::find(uint8_t key) const {
+    for (size_t i = 0; i < SNAPSHOT_CACHE_SLOTS; i++) {
+        if (entries[i].data && entries[i].key == key) {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+size_t SnapshotCache::getUsedBytes() const {
+    size_t total = 0;
+    for (size_t i = 0; i < SNAPSHOT_CACHE_SLOTS; i++) {
+        if (entries[i].data) {
+            total += entries[i].size;
+        }
+    }
+    return total;
+}
+
+void SnapshotCache::setBudget(size_t bytes) {
+    budget = bytes;
+    if (capturing && staging.size() > budget) {
+        abortCapture();
+    }
+    evictForSize(0);
+}
+
+void SnapshotCache::evictForSize(size_t size) {
+    // 空きスロットができ、予算に収まるまで最も使われていないものを破棄
+    while (true) {
+        Entry* oldest = nullptr;
+        bool hasFreeSlot = false;
+        for (size_t i = 0; i < SNAPSHOT_CACHE_SLOTS; i++) {
+            if (!entries[i].data) {
+                hasFreeSlot = true;
+            } else if (!oldest || entries[i].lastUsed < oldest->lastUsed) {
+                oldest = &entries[i];
+            }
+        }
+        bool fits = getUsedBytes() + size <= budget;
+        if ((hasFreeSlot || size == 0) && fits) {
+            return;
+        }
+        if (!oldest) {
+            return;
+        }
+        oldest->data.reset();
+        oldest->size = 0;
+    }
+}
+
+bool SnapshotCache::beginCapture(uint8_t key, uint16_t width, uint16_t height) {
+    abortCapture();
+    invalidate(key);
+    if (width == 0 || height == 0 || budget == 0) {
+        return false;
+    }
+    capturing = true;
+    captureKey = key;
+    captureWidth = width;
+    captureHeight = height;
+    capturedRows = 0;
+    // 予算＋1行分を先に確保し、撮影中に再確保しない
+    staging.reserve(budget + rle565::maxEncodedRowSize(width));
+    return true;
+}
+
+bool SnapshotCache::appendRows(const uint16_t* pixels, uint16_t rows) {
+    if (!capturing) {
+        return false;
+    }
+    const size_t rowMax = rle565::maxEncodedRowSize(captureWidth);
+    for (uint16_t r = 0; r < rows && capturedRows < captureHeight; r++) {
+        size_t offset = staging.size();
+        if (offset > budget) {
+            // 圧縮が効かず予算を超えた（この画面はキャッシュしない）
+            overflowCount++;
+            abortCapture();
+            return false;
+        }
+        staging.resize(offset + rowMax);
+        size_t written = rle565::encodeRow(pixels + r * captureWidth, captureWidth,
+                                           staging.data() + offset, rowMax);
+        staging.resize(offset + written);
+        capturedRows++;
+    }
+    if (capturedRows == captureHeight) {
+        return commitCapture();
+    }
+    return true;
+}
+
+bool SnapshotCache::commitCapture() {
+    size_t size = staging.size();
+    if (size > budget) {
+        overflowCount++;
+        abortCapture();
+        return false;
+    }
+
+    evictForSize(size);
+    Entry* slot = nullptr;
+    for (size_t i = 0; i < SNAPSHOT_CACHE_SLOTS; i++) {
+        if (!entries[i].data) {
+            slot = &entries[i];
+            break;
+        }
+    }
+    uint8_t* data = slot ? new (std::nothrow) uint8_t[size] : nullptr;
+    if (!data) {
+        abortCapture();
+        return false;
+    }
+    for (size_t i = 0; i < size; i++) {
+        data[i] = staging[i];
+    }
+
+    slot->data.reset(data);
+    slot->key = captureKey;
+    slot->width = captureWidth;
+    slot->height = captureHeight;
+    slot->size = size;
+    slot->lastUsed = ++useCounter;
+    captureCount++;
+    abortCapture();
+    return true;
+}
+
+void SnapshotCache::abortCapture() {
+    capturing = false;
+    capturedRows = 0;
+    // 作業領域は撮影のたびに確保し直し、撮影していない間はヒープを占有しない
+    std::vector<uint8_t>().swap(staging);
+}
+
+void SnapshotCache::invalidate(uint8_t key) {
+    Entry* entry = find(key);
+    if (entry) {
+        entry->data.reset();
+        entry->size = 0;
+    }
+    if (capturing && captureKey == key) {
+        abortCapture();
+    }
+}
+
+void SnapshotCache::clear() {
+    abortCapture();
+    for (size_t i = 0; i < SNAPSHOT_CACHE_SLOTS; i++) {
+        entries[i].data.reset();
+        entries[i].size = 0;
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef SNAPSHOT_CACHE_H
+#define SNAPSHOT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../shared/Rle565.h"
+
+// 圧縮済みスナップショットのヒープ予算（バイト、撮影中は同じ大きさの作業領域を別に使う）
+#ifndef SNAPSHOT_CACHE_BUDGET
+#define SNAPSHOT_CACHE_BUDGET 40960
+#endif
+
+// 保持するスナップショットの最大数
+#ifndef SNAPSHOT_CACHE_SLOTS
+#define SNAPSHOT_CACHE_SLOTS 4
+#endif
+
+// 画面のスナップショットキャッシュ
+// 描画し終えた画面をRLE圧縮したRGB565で保持し、戻ったときに
+// 行単位で復号しながら転送する。撮影も行の束ごとに少しずつ進められる。
+// パネルへの読み書きは呼び出し側が行い、ここは符号化と予算管理だけを扱う。
+class SnapshotCache {
+private:
+    struct Entry {
+        uint8_t key;
+        uint16_t width;
+        uint16_t height;
+        size_t size;
+        uint32_t lastUsed;
+        std::unique_ptr<uint8_t[]> data;
+    };
+
+    Entry entries[SNAPSHOT_CACHE_SLOTS];
+    size_t budget;
+    uint32_t useCounter;
+
+    // 撮影中の作業領域
+    std::vector<uint8_t> staging;
+    bool capturing;
+    uint8_t captureKey;
+    uint16_t captureWidth;
+    uint16_t captureHeight;
+    uint16_t capturedRows;
+
+    uint32_t hitCount;
+    uint32_t missCount;
+    uint32_t captureCount;
+    uint32_t overflowCount;
+
+    Entry* find(uint8_t key);
+    const Entry* find(uint8_t key) const;
+    bool commitCapture();
+    void evictForSize(size_t size);
+
+public:
+    explicit SnapshotCache(size_t budgetBytes = SNAPSHOT_CACHE_BUDGET);
+
+    // 予算を変更（超えた分は古いものから破棄）
+    void setBudget(size_t bytes);
+    size_t getBudget() const { return budget; }
+    size_t getUsedBytes() const;
+
+    // 撮影を開始（同じキーの古いスナップショットは破棄）
+    bool beginCapture(uint8_t key, uint16_t width, uint16_t height);
+    // 上から順に行を追加。全行そろうと確定する。予算超過で中止したらfalse
+    bool appendRows(const uint16_t* pixels, uint16_t rows);
+    void abortCapture();
+    bool isCapturing() const { return capturing; }
+    uint8_t getCaptureKey() const { return captureKey; }
+    uint16_t getCapturedRows() const { return capturedRows; }
+
+    bool contains(uint8_t key) const { return find(key) != nullptr; }
+    void invalidate(uint8_t key);
+    void clear();
+
+    // スナップショットを復号してsink(y, rows, pixels)へ束ごとに渡す
+    // stripはwidth×stripRows画素の作業領域。見つからなければミスとしてfalse
+    template <typename Sink>
+    bool restore(uint8_t key, uint16_t* strip, uint16_t stripRows, Sink sink) {
+        Entry* entry = find(key);
+        if (!entry || stripRows == 0) {
+            missCount++;
+            return false;
+        }
+        entry->lastUsed = ++useCounter;
+
+        const uint8_t* in = entry->data.get();
+        size_t remaining = entry->size;
+        uint16_t y = 0;
+        while (y < entry->height) {
+            uint16_t rows = entry->height - y < stripRows ? entry->height - y : stripRows;
+            for (uint16_t r = 0; r < rows; r++) {
+                size_t used = rle565::decodeRow(in, remaining, strip + r * entry->width, entry->width);
+                if (used == 0) {
+                    // 壊れたデータは捨てる（途中まで転送した分は呼び出し側で描き直す）
+                    invalidate(key);
+                    missCount++;
+                    return false;
+                }
+                in += used;
+                remaining -= used;
+            }
+            sink(y, rows, static_cast<const uint16_t*>(strip));
+            y += rows;
+        }
+        hitCount++;
+        return true;
+    }
+
+    uint32_t getHitCount() const { return hitCount; }
+    uint32_t getMissCount() const { return missCount; }
+    uint32_t getCaptureCount() const { return captureCount; }
+    uint32_t getOverflowCount() const { return overflowCount; }
+    uint8_t getHitRatePercent() const {
+        uint32_t total = hitCount + missCount;
+        return total > 0 ? static_cast<uint8_t>(hitCount * 100 / total) : 0;
+    }
+};
+
+#endif // SNAPSHOT_CACHE_H
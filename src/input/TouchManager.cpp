@@ -1,12 +1,14 @@
 #define LGFX_USE_V1
 #include <LovyanGFX.hpp>
 #include "TouchManager.h"
+#include "../core/BusArbiter.h"
+#include "../core/Core0Manager.h"
 #include <Arduino.h>
 
 TouchManager::TouchManager(LGFX* display) 
     : tft(display), touching(false), state(TOUCH_IDLE), touchStartTime(0),
       touchStartX(0), touchStartY(0) {
-    lastTouch = {EVENT_NONE, 0, 0, 0, 0, 0, 0};
+    lastTouch = TouchEvent();
 }
 
 void TouchManager::init() {
@@ -16,6 +18,11 @@ void TouchManager::init() {
 }
 
 void TouchManager::update() {
+#if BUS_TOUCH_HOST >= 0
+    // タッチをハードウェアSPIにつないだ構成だけ、同じホストの転送と調停する
+    BusLock lock(g_busArbiter, BUS_CLIENT_TOUCH);
+#endif
+    // XPT2046は専用ピンのソフトウェアSPIなので、LCDやSDの転送を待たずに読める
     processTouchInput();
 }
 
@@ -96,34 +103,23 @@ void TouchManager::detectGesture(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
             direction = (dy > 0) ? GestureEvent::GESTURE_DOWN : GestureEvent::GESTURE_UP;
         }
         
-        if (direction != GestureEvent::GESTURE_NONE && g_touchEventQueue) {
-            Event event;
-            event.type = EVENT_GESTURE_SWIPE;
-            event.data.gesture.type = EVENT_GESTURE_SWIPE;
-            event.data.gesture.direction = direction;
-            event.data.gesture.start_x = x1;  // オフセットを削除
-            event.data.gesture.start_y = y1;  // オフセットを削除
-            event.data.gesture.end_x = x2;    // オフセットを削除
-            event.data.gesture.end_y = y2;    // オフセットを削除
-            event.data.gesture.duration_ms = millis() - touchStartTime;
+        if (direction != GestureEvent::GESTURE_NONE && g_eventBus) {
+            Event event = makeGestureEvent(direction, x1, y1, x2, y2, millis() - touchStartTime);
             
-            g_touchEventQueue->send(event);
+            g_eventBus->publish(event);
         }
     }
 }
 
 void TouchManager::sendTouchEvent(EventType type, int32_t x, int32_t y, int32_t raw_x, int32_t raw_y) {
-    if (g_touchEventQueue) {
-        Event event;
-        event.type = type;
-        event.data.touch.type = type;
-        event.data.touch.x = x;  // オフセットを削除
-        event.data.touch.y = y;  // オフセットを削除
-        event.data.touch.raw_x = raw_x;
-        event.data.touch.raw_y = raw_y;
-        event.data.touch.timestamp = millis();
-        event.data.touch.pressure = 0;  // XPT2046は圧力検出をサポートしていない
+    if (g_eventBus) {
+        // XPT2046は圧力検出をサポートしていないため座標と時刻のみ
+        Event event = makeTouchEvent(type, x, y, raw_x, raw_y, micros());
         
-        g_touchEventQueue->send(event);
+        g_eventBus->publish(event);
+        if (type == EVENT_TOUCH_DOWN) {
+            // 押下の表示と効果音を次のフレームまで待たせない
+            Core0Manager::requestFrame();
+        }
     }
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 #define TOUCH_MANAGER_H
 
 #include "../shared/Events.h"
-#include "../shared/EventQueue.h"
+#include "../shared/EventBus.h"
 
 // 前方宣言
 namespace lgfx {
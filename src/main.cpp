@@ -2,7 +2,15 @@
 #include <LovyanGFX.hpp>
 #include "core/Core0Manager.h"
 #include "core/Core1Manager.h"
-#include "shared/EventQueue.h"
+#include "shared/EventBus.h"
+#include "shared/HeapMonitor.h"
+#include "core/FrameScheduler.h"
+#include "storage/SdService.h"
+#include "storage/LogWriter.h"
+#include "shared/LogBuffer.h"
+#include "core/BusArbiter.h"
+#include "audio/AudioPlayer.h"
+#include "audio/SfxMixer.h"
 
 // Pin definitions for ESP32-3224S028R
 #define LCD_CS 15
@@ -108,6 +116,9 @@ LGFX_ESP32 tft;
 Core0Manager* core0Manager = nullptr;
 Core1Manager* core1Manager = nullptr;
 
+// ログの書き出し（SDサービスのタスクが要求の合間にSerialとSDへ出す）
+LogWriter* logWriter = nullptr;
+
 void setup()
 {
     Serial.begin(115200);
@@ -117,6 +128,18 @@ void setup()
     Serial.printf("CPU Frequency: %d MHz\n", getCpuFrequencyMhz());
     Serial.printf("Free Heap: %d bytes\n", esp_get_free_heap_size());
     
+    // SPIバスの調停（各タスクより先に作成）
+    g_busArbiter.init();
+    
+    // SDカードのバス（VSPI）はLCD（HSPI）より先に設定しておき、以後はSDサービスだけが触る
+    g_sdService = new SdService();
+    g_sdService->init();
+    logWriter = new LogWriter(g_log);
+    logWriter->setEcho([](const char* line, size_t length) {
+        Serial.write(line, length);
+    });
+    g_sdService->attachLog(logWriter);
+    
     // ディスプレイとタッチパネルの初期化
     tft.begin();
     tft.setRotation(1);  // 横向き
@@ -127,9 +150,9 @@ void setup()
     uint8_t touch_state = tft.getTouchRaw(&tp);
     Serial.printf("Touch initialized: %s\n", touch_state ? "Yes" : "No");
     
-    // グローバルイベントキューを作成
-    g_touchEventQueue = new EventQueue(64);  // 64イベント分のキュー
-    Serial.println("Event queue created");
+    // グローバルイベントバスを作成（レーン: 制御/ジェスチャー/移動）
+    g_eventBus = new EventBus();
+    Serial.println("Event bus created");
     
     // Core 0 Manager（表示系）を初期化
     core0Manager = new Core0Manager(static_cast<LGFX*>(&tft));
@@ -143,6 +166,11 @@ void setup()
     Serial.println("Starting dual-core tasks...");
     core0Manager->startTasks();  // Core 0: 表示タスク
     core1Manager->startTasks();  // Core 1: タッチタスク
+    g_sdService->start();        // Core 1: SDサービスタスク（タッチより低優先度）
+    
+    // 再生エンジン（リングとデコーダーの確保、I2S/DACの設定、復号・出力タスク）
+    g_audioPlayer = new AudioPlayer();
+    g_audioPlayer->begin();      // Core 1: 復号・出力タスク（タッチより高優先度）
     
     Serial.println("=== Setup complete ===");
     Serial.printf("Core 0: Display Processing\n");
@@ -156,19 +184,158 @@ void loop()
     uint32_t now = millis();
     
     // 5秒ごとにステータスを表示
+    // 異常の兆し（破棄・予算超過・失敗・途切れ）だけを1行の情報としてリングに入れ、
+    // 詳しい内訳はデバッグの重要度にする（既定ではリングに入らず、警告やエラーを押し出さない。
+    // 見るときはg_log.setMinSeverity(LOG_SEVERITY_DEBUG)かLOG_MIN_SEVERITYで有効にする）
     if (now - lastStatusUpdate > 5000) {
         lastStatusUpdate = now;
         
-        Serial.println("\n=== System Status ===");
-        Serial.printf("Uptime: %lu seconds\n", now / 1000);
-        Serial.printf("Free Heap: %d bytes\n", esp_get_free_heap_size());
-        Serial.printf("Event Queue Size: %d\n", g_touchEventQueue ? g_touchEventQueue->getCount() : 0);
+        g_heapMonitor.sample();
+        unsigned long droppedEvents = 0;
+        if (g_eventBus) {
+            for (int i = 0; i < EVENT_LANE_COUNT; i++) {
+                droppedEvents += g_eventBus->getLanes().getDropCount(static_cast<EventLane>(i));
+            }
+        }
+        logInfo("Status: up %lus, heap %lu B (%u%% frag), %lu events dropped, %lu frames over, "
+                "SD %lu failed, audio %lu underruns, %lu logs lost",
+                (unsigned long)(now / 1000),
+                (unsigned long)esp_get_free_heap_size(),
+                (unsigned)g_heapMonitor.getFragmentationPercent(),
+                droppedEvents,
+                (unsigned long)g_frameScheduler.getOverBudgetFrames(),
+                (unsigned long)(g_sdService ? g_sdService->getFailedCount() : 0),
+                (unsigned long)(g_audioPlayer ? g_audioPlayer->getInputUnderruns() + g_audioPlayer->getOutputUnderruns() : 0),
+                (unsigned long)(logWriter ? logWriter->getLostRecords() : 0));
+        
+        logDebug("=== System Status ===");
+        logDebug("Uptime: %lu seconds", (unsigned long)(now / 1000));
+        logDebug("Free Heap: %lu bytes", (unsigned long)esp_get_free_heap_size());
+        
+        // ヒープ断片化の推移（最大連続空き領域）
+        logDebug("Largest Free Block: %u bytes (min %u, fragmentation %u%%)",
+                (unsigned)g_heapMonitor.getLargestBlock(),
+                (unsigned)g_heapMonitor.getMinLargestBlock(),
+                (unsigned)g_heapMonitor.getFragmentationPercent());
+        if (g_eventBus) {
+            const EventLanes& lanes = g_eventBus->getLanes();
+            // レーンごとの滞留数と破棄数（破棄が増えていれば過負荷）
+            for (int i = 0; i < EVENT_LANE_COUNT; i++) {
+                EventLane lane = static_cast<EventLane>(i);
+                logDebug("Event Lane %-7s: %u/%u queued, %u dropped",
+                        EventLanes::getConfig(lane).name,
+                        (unsigned)lanes.getCount(lane),
+                        (unsigned)EventLanes::getConfig(lane).capacity,
+                        (unsigned)lanes.getDropCount(lane));
+            }
+            logDebug("Motion events coalesced: %u", (unsigned)lanes.getCoalescedCount());
+            logDebug("Events dispatched: %u (unhandled %u)",
+                    (unsigned)g_eventBus->getDispatcher().getDispatchCount(),
+                    (unsigned)g_eventBus->getDispatcher().getUnhandledCount());
+        }
+        
+        // 表示コアのフレーム予算（描画＋後回しの処理）の使用状況
+        logDebug("Frame budget: last %u%%, avg %u%%, peak %u%% of %lu us (%lu over budget)",
+                (unsigned)g_frameScheduler.getLastUtilization(),
+                (unsigned)g_frameScheduler.getAverageUtilization(),
+                (unsigned)g_frameScheduler.getPeakUtilization(),
+                (unsigned long)g_frameScheduler.getBudgetUs(),
+                (unsigned long)g_frameScheduler.getOverBudgetFrames());
+        logDebug("Deferred jobs: %u pending, %lu done, %lu missed deadlines, %lu rejected",
+                (unsigned)g_frameScheduler.getPendingCount(),
+                (unsigned long)g_frameScheduler.getCompletedJobs(),
+                (unsigned long)g_frameScheduler.getMissedDeadlines(),
+                (unsigned long)g_frameScheduler.getRejectedJobs());
+        
+        if (g_sdService) {
+            logDebug("SD service: %s, %u queued, %lu done, %lu failed, %lu rejected, %lu lost",
+                    g_sdService->isMounted() ? "mounted" : "not mounted",
+                    (unsigned)g_sdService->getQueuedCount(),
+                    (unsigned long)g_sdService->getCompletedCount(),
+                    (unsigned long)g_sdService->getFailedCount(),
+                    (unsigned long)g_sdService->getRejectedCount(),
+                    (unsigned long)g_sdService->getLostResults());
+            logDebug("SD catalog: last scan %lu ms, %lu hit / %lu rebuilt",
+                    (unsigned long)g_sdService->getLastScanMs(),
+                    (unsigned long)g_sdService->getCatalogHits(),
+                    (unsigned long)g_sdService->getCatalogRebuilds());
+        }
+        
+        if (logWriter) {
+            // ログ: 書き出しが追いつかずに失った件数と、SDへ書けずに捨てた量
+            logDebug("Log: %lu records (%lu warn, %lu error), %lu lost, %lu B to SD (%lu rotations, %lu B dropped)",
+                    (unsigned long)g_log.getHead(),
+                    (unsigned long)g_log.getCount(LOG_SEVERITY_WARN),
+                    (unsigned long)g_log.getCount(LOG_SEVERITY_ERROR),
+                    (unsigned long)logWriter->getLostRecords(),
+                    (unsigned long)(g_sdService ? g_sdService->getLogBytes() : 0),
+                    (unsigned long)(g_sdService ? g_sdService->getLogRotations() : 0),
+                    (unsigned long)logWriter->getDroppedBytes());
+        }
+        
+        if (g_audioPlayer) {
+            // 途切れ: 入力は先読みが尽きた回数、出力はDMAにPCMを渡せなかった回数
+            const AudioPipeline& pipeline = g_audioPlayer->getPipeline();
+            logDebug("Audio: state %u, %s %lu Hz, %lu frames (avg %lu us, max %lu us)",
+                    (unsigned)g_audioPlayer->getState(),
+                    pipeline.getDecoderName(),
+                    (unsigned long)g_audioPlayer->getSampleRate(),
+                    (unsigned long)pipeline.getDecodedFrames(),
+                    (unsigned long)(pipeline.getDecodedFrames() > 0 ? pipeline.getDecodeUs() / pipeline.getDecodedFrames() : 0),
+                    (unsigned long)pipeline.getMaxDecodeUs());
+            logDebug("Audio: underruns in %lu / out %lu, fill %u B / %u samples, SD stream %lu B (%lu stalls)",
+                    (unsigned long)g_audioPlayer->getInputUnderruns(),
+                    (unsigned long)g_audioPlayer->getOutputUnderruns(),
+                    (unsigned)g_audioPlayer->getInputFill(),
+                    (unsigned)g_audioPlayer->getPcmFill(),
+                    (unsigned long)(g_sdService ? g_sdService->getStreamBytes() : 0),
+                    (unsigned long)(g_sdService ? g_sdService->getStreamStalls() : 0));
+            // 出力段: 係数を作り直した回数と出力タスクが受け取った回数、リミッターが効いたブロック数
+            const DspChain& dsp = g_audioPlayer->getDsp();
+            logDebug("DSP: %lu recomputes / %lu swaps, limited %lu blocks",
+                    (unsigned long)dsp.getRecomputeCount(),
+                    (unsigned long)dsp.getSwapCount(),
+                    (unsigned long)dsp.getLimitedBlocks());
+        }
+        
+        // UI効果音: タッチから音が出るまで（区間: 配信待ち / 出力周期待ち / DMA）
+        const LatencyTracer& sfxLatency = g_sfxMixer.getTracer();
+        logDebug("SFX latency: %lu clips, avg %lu us, max %lu us (%lu over %lu us), %lu dropped",
+                (unsigned long)sfxLatency.getCount(),
+                (unsigned long)sfxLatency.getAverageTotalUs(),
+                (unsigned long)sfxLatency.getMaxTotalUs(),
+                (unsigned long)sfxLatency.getOverBudgetCount(),
+                (unsigned long)sfxLatency.getBudgetUs(),
+                (unsigned long)g_sfxMixer.getDroppedCount());
+        logDebug("SFX latency stages max %lu/%lu/%lu us",
+                (unsigned long)sfxLatency.getStageMaxUs(LatencyTracer::STAGE_DISPATCH),
+                (unsigned long)sfxLatency.getStageMaxUs(LatencyTracer::STAGE_MIX),
+                (unsigned long)sfxLatency.getStageMaxUs(LatencyTracer::STAGE_OUTPUT));
+        
+        // SPIバスごとの使用率とクライアントごとの待ち時間
+        for (size_t bus = 0; bus < g_busArbiter.getBusCount(); bus++) {
+            logDebug("SPI bus %d: %u%% busy", g_busArbiter.getBusHost(bus),
+                    (unsigned)g_busArbiter.getUtilizationPercent(bus));
+        }
+        for (int i = 0; i < BUS_CLIENT_COUNT; i++) {
+            BusClient client = static_cast<BusClient>(i);
+            const BusArbiter::ClientStats& bus = g_busArbiter.getStats(client);
+            logDebug("Bus client %-7s: %lu acquires (%lu contended, %lu yields), wait avg %lu us max %lu us, hold max %lu us",
+                    BusArbiter::clientName(client),
+                    (unsigned long)bus.acquireCount,
+                    (unsigned long)bus.contendedCount,
+                    (unsigned long)bus.yieldCount,
+                    (unsigned long)(bus.acquireCount > 0 ? bus.totalWaitUs / bus.acquireCount : 0),
+                    (unsigned long)bus.maxWaitUs,
+                    (unsigned long)bus.maxHoldUs);
+        }
+        g_busArbiter.resetWindow();
         
         // タスク状態を表示
-        Serial.printf("Core 0 Stack High Water Mark: %d\n", 
-                     uxTaskGetStackHighWaterMark(nullptr));
-        Serial.printf("Core 1 Stack High Water Mark: %d\n", 
-                     uxTaskGetStackHighWaterMark(nullptr));
+        logDebug("Core 0 Stack High Water Mark: %u",
+                (unsigned)uxTaskGetStackHighWaterMark(nullptr));
+        logDebug("Core 1 Stack High Water Mark: %u",
+                (unsigned)uxTaskGetStackHighWaterMark(nullptr));
     }
     
     // CPU負荷を下げるため待機
@@ -1,5 +1,5 @@
 #include "BaseScreen.h"
 
 BaseScreen::BaseScreen(LGFX* display, ScreenID id) 
-    : tft(display), screenId(id), needsRedraw(true) {
+    : tft(display), screenId(id), needsRedraw(true), contentVersion(0) {
 }
\ No newline at end of file
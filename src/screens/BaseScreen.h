@@ -1,6 +1,7 @@
 #ifndef BASE_SCREEN_H
 #define BASE_SCREEN_H
 
+#include <cstddef>
 #include "../shared/Events.h"
 
 // 前方宣言
@@ -22,7 +23,9 @@ enum ScreenID {
     SCREEN_OUTPUT_SETTINGS,    // 出力設定
     SCREEN_TIME_SETTINGS,      // 時間設定
     SCREEN_LOG,                // ログ
-    SCREEN_COUNT
+    SCREEN_FILE_BROWSER,       // ファイル一覧（入力設定から）
+    SCREEN_COUNT,
+    SCREEN_BACK = 0xFF         // 遷移先の指定用: ナビゲーションスタックの1つ前の画面
 };
 
 // 画面遷移アニメーションの種類
@@ -41,6 +44,7 @@ protected:
     LGFX* tft;
     ScreenID screenId;
     bool needsRedraw;
+    uint32_t contentVersion;
     
 public:
     BaseScreen(LGFX* display, ScreenID id);
@@ -48,15 +52,27 @@ public:
     
     // 必須実装メソッド
     virtual void init() = 0;                    // 画面初期化
-    virtual void draw() = 0;                    // 画面描画
+    virtual void draw() = 0;                    // 画面描画（毎フレーム呼ばれる。needsRedrawなら全体、それ以外は変わった部分だけ描く）
     virtual void update() = 0;                  // 状態更新
     virtual void handleEvent(const Event& event) = 0;  // イベント処理
     
     // オプションメソッド
+    virtual void prepare() {}                   // 入る前の準備（先読みで暇なフレームに呼ばれる）。表示や外部の状態には触れない
     virtual void onEnter() {}                   // 画面に入る時
     virtual void onExit() {}                    // 画面から出る時
+    virtual void onPause() {}                   // 別の画面を重ねる時（ウィジェットと状態は保持）
+    virtual void onResume() {}                  // 保持したまま戻ってきた時（onEnterの代わり）
     virtual bool canTransitionTo(ScreenID nextScreen) { return true; }
     
+    // この画面から遷移しうる画面（先読みの候補）。書き込んだ数を返す
+    virtual size_t getNavigationTargets(ScreenID* out, size_t maxCount) const { return 0; }
+    
+    // 入力と関係なく表示が変わる画面はfalse（スナップショットから復元しない）
+    virtual bool isSnapshotStable() const { return true; }
+    
+    // ヒープ予算超過時に破棄してよいか（設定値などの状態を持つ画面はfalse）
+    virtual bool isEvictable() const { return true; }
+    
     // ジェスチャー処理（オーバーライド可能）
     virtual void onSwipeUp() {}
     virtual void onSwipeDown() {}
@@ -67,6 +83,10 @@ public:
     ScreenID getId() const { return screenId; }
     bool isNeedsRedraw() const { return needsRedraw; }
     void setNeedsRedraw(bool needs) { needsRedraw = needs; }
+    
+    // 再描画を伴わずに表示内容を変えたら呼ぶ（古いスナップショットを使わせない）
+    void markContentChanged() { contentVersion++; }
+    uint32_t getContentVersion() const { return contentVersion; }
 };
 
 #endif // BASE_SCREEN_H
\ No newline at end of file
@@ -0,0 +1,350 @@
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+#include "FileBrowserScreen.h"
+#include <Arduino.h>
+#include "../ui/components/ModernButton.h"
+#include "../ui/layout/LayoutTable.h"
+#include "../shared/EventBus.h"
+#include "../storage/SdService.h"
+#include "../audio/AudioPlayer.h"
+#include "../audio/SfxMixer.h"
+
+namespace {
+// 一覧を出すフォルダと対象の拡張子（入力設定の確認と同じ）
+const char BROWSER_DIR[] = "/sound";
+// 目録に載る名前（終端込みでMEDIA_CATALOG_PAGE_NAME_BYTES）は"/sound/"を付けても要求に収まる
+static_assert(sizeof(BROWSER_DIR) + MEDIA_CATALOG_PAGE_NAME_BYTES <= SD_SERVICE_PATH_MAX,
+              "SD_SERVICE_PATH_MAX is too short for a catalog name under BROWSER_DIR");
+const char* const BROWSER_EXTENSION = ".mp3";
+
+// 同時に出しておく読み込み要求の数（SDサービスの要求キューを埋めない）
+const size_t MAX_PAGE_REQUESTS = 2;
+
+const uint16_t ROW_SELECTED_COLOR = rgb565(38, 50, 56);
+const uint16_t ROW_DETAIL_COLOR = rgb565(158, 158, 158);
+const uint16_t ROW_SEPARATOR_COLOR = rgb565(55, 71, 79);
+const uint16_t SCROLLBAR_COLOR = rgb565(120, 144, 156);
+} // namespace
+
+FileBrowserScreen::FileBrowserScreen(LGFX* display)
+    : BaseScreen(display, SCREEN_FILE_BROWSER), list(0, LIST_TOP, UI_SCREEN_WIDTH, LIST_HEIGHT, ROW_HEIGHT) {
+    list.items().setBinder([this](uint32_t item, Row& row) {
+        return bindRow(item, row);
+    });
+    list.items().setRenderer([this](uint32_t item, const Row& row, bool ready, int16_t y) {
+        drawRow(item, row, ready, y);
+    });
+    list.setColors(TFT_BLACK, SCROLLBAR_COLOR);
+}
+
+void FileBrowserScreen::createButtons() {
+    buttons.clear();
+    buttonPool.releaseAll();
+    for (const ButtonDef& def : BACK_ONLY_LAYOUT) {
+        buttons.push_back(acquireButton(buttonPool, tft, def));
+    }
+}
+
+void FileBrowserScreen::startScan() {
+    scannedEntries = 0;
+    // 目録が今のフォルダと一致していれば先頭32バイトの照合だけで件数が返る
+    scanRequestId = g_sdService ? g_sdService->requestScan(BROWSER_DIR, BROWSER_EXTENSION) : 0;
+    statusText = scanRequestId != 0 ? "SDカードを確認中..." : "SDカードの確認を開始できません";
+    statusDirty = true;
+}
+
+void FileBrowserScreen::retireStalePages(uint16_t requestId) {
+    // 要求は順に処理されるので、届いた結果より古い読み込みは終わっている
+    // （結果は画面を離れている間に届いて捨てられた）。空きに戻して行を読み直させる
+    pages.retireOlder(requestId, [this](uint32_t page) {
+        list.invalidate(page * PAGE_ENTRIES, PAGE_ENTRIES);
+    });
+}
+
+void FileBrowserScreen::requestPage(uint32_t page) {
+    const List::List& rows = list.items();
+    if (!g_sdService || !listReady || page * PAGE_ENTRIES >= rows.getItemCount() || pages.contains(page)) {
+        return;
+    }
+    // 空きか、表示中でないページのうちいちばん長く使っていないものを読み直す
+    size_t index = pages.reserve(rows.firstVisible() / PAGE_ENTRIES, rows.lastVisible() / PAGE_ENTRIES,
+                                 MAX_PAGE_REQUESTS);
+    if (index == Pages::NO_SLOT) {
+        return;     // 届いた結果でリストを描き直すときにもう一度頼む
+    }
+    uint16_t id = g_sdService->requestPage(BROWSER_DIR, page * PAGE_ENTRIES, pages.buffer(index), PAGE_ENTRIES);
+    if (id == 0) {
+        return;
+    }
+    pages.markLoading(index, page, id);
+}
+
+void FileBrowserScreen::prefetch() {
+    // 表示範囲の前後のページを先に読んでおく（スクロールで行が空白にならないように）
+    // フリック中は流れていく側を1ページ先まで読む
+    const List::List& rows = list.items();
+    uint32_t first = rows.firstVisible();
+    uint32_t last = rows.lastVisible();
+    if (first == List::NO_ITEM) {
+        return;
+    }
+    float velocity = list.getScroller().getVelocity();
+    uint32_t ahead = velocity > 0.0f ? PAGE_ENTRIES : PAGE_ENTRIES / 2;
+    uint32_t behind = velocity < 0.0f ? PAGE_ENTRIES : PAGE_ENTRIES / 2;
+    if (last + ahead < rows.getItemCount()) {
+        requestPage((last + ahead) / PAGE_ENTRIES);
+    }
+    if (first >= behind) {
+        requestPage((first - behind) / PAGE_ENTRIES);
+    }
+}
+
+bool FileBrowserScreen::bindRow(uint32_t item, Row& row) {
+    const MediaCatalogEntry* found = pages.find(item);
+    if (!found) {
+        requestPage(item / PAGE_ENTRIES);
+        return false;
+    }
+    const MediaCatalogEntry& entry = *found;
+    // タグの題名があればそれを、なければファイル名を出す。2行目はアーティスト・大きさ・再生時間
+    row.title = entry.title.empty() ? entry.name.c_str() : entry.title.c_str();
+    row.detail.clear();
+    if (!entry.artist.empty()) {
+        row.detail.appendFormat("%s  ", entry.artist.c_str());
+    }
+    uint32_t kb = (entry.size + 1023) / 1024;
+    if (kb >= 1024) {
+        row.detail.appendFormat("%lu.%luMB", (unsigned long)(kb / 1024), (unsigned long)(kb % 1024 * 10 / 1024));
+    } else {
+        row.detail.appendFormat("%luKB", (unsigned long)kb);
+    }
+    if (entry.durationMs > 0) {
+        uint32_t seconds = entry.durationMs / 1000;
+        row.detail.appendFormat("  %lu:%02lu", (unsigned long)(seconds / 60), (unsigned long)(seconds % 60));
+    }
+    return true;
+}
+
+void FileBrowserScreen::drawRow(uint32_t item, const Row& row, bool ready, int16_t y) {
+    // 描く先はリストの描画面（確保できなければ画面）
+    lgfx::LovyanGFX* canvas = list.canvas();
+    int16_t x = list.canvasLeft();
+    int16_t width = UI_SCREEN_WIDTH - KINETIC_LIST_SCROLLBAR_WIDTH;
+    canvas->fillRect(x, y, width, ROW_HEIGHT - 1, item == selectedItem ? ROW_SELECTED_COLOR : TFT_BLACK);
+    canvas->drawFastHLine(x, y + ROW_HEIGHT - 1, width, ROW_SEPARATOR_COLOR);
+    canvas->setCursor(x + 10, y + 3);
+    if (!ready) {
+        canvas->setTextColor(ROW_DETAIL_COLOR);
+        canvas->print("読み込み中...");
+        canvas->setTextColor(TFT_WHITE);
+        return;
+    }
+    canvas->print(row.title.c_str());
+    canvas->setTextColor(ROW_DETAIL_COLOR);
+    canvas->setCursor(x + 10, y + 18);
+    canvas->print(row.detail.c_str());
+    canvas->setTextColor(TFT_WHITE);
+}
+
+void FileBrowserScreen::drawList() {
+    // 描き直し待ちの帯（新しく見えた行・読めた行）だけを描いて送る
+    lgfx::LovyanGFX* canvas = list.canvas();
+    canvas->setFont(&fonts::lgfxJapanGothic_12);
+    canvas->setTextColor(TFT_WHITE);
+    list.draw();
+    canvas->setFont(nullptr);
+}
+
+void FileBrowserScreen::drawStatus() {
+    tft->fillRect(0, 52, tft->width(), 24, TFT_BLACK);
+    tft->setFont(&fonts::lgfxJapanGothic_12);
+    tft->setCursor(10, 60);
+    tft->print(statusText.c_str());
+    tft->setFont(nullptr);
+    statusDirty = false;
+}
+
+void FileBrowserScreen::playItem(uint32_t item) {
+    const MediaCatalogEntry* found = pages.find(item);
+    if (!found) {
+        return;
+    }
+    const MediaCatalogEntry& entry = *found;
+    char path[SD_SERVICE_PATH_MAX];
+    int written = snprintf(path, sizeof(path), "%s/%s", BROWSER_DIR, entry.name.c_str());
+    // 名前が長すぎて切り詰められたものは開けない
+    bool fits = written > 0 && static_cast<size_t>(written) < sizeof(path) &&
+                entry.name.size() < MEDIA_CATALOG_PAGE_NAME_BYTES - 1;
+    if (!fits || !g_audioPlayer || !g_audioPlayer->play(path)) {
+        g_sfxMixer.trigger(SFX_ERROR);
+        statusText = "再生できません: ";
+    } else {
+        statusText = "再生: ";
+    }
+    statusText.append(entry.name.c_str());
+    statusDirty = true;
+}
+
+void FileBrowserScreen::handleSdResult(const SdResultEvent& result) {
+    retireStalePages(result.requestId);
+    if (result.op == SD_OP_PAGE) {
+        handlePageResult(result);
+        return;
+    }
+    if (scanRequestId == 0 || result.requestId != scanRequestId) {
+        return;
+    }
+    char buf[64];
+    switch (result.status) {
+        case SD_STATUS_PROGRESS:
+            scannedEntries = result.aux;
+            snprintf(buf, sizeof(buf), "SDカードを確認中... (%lu件)", (unsigned long)scannedEntries);
+            statusText = buf;
+            statusDirty = true;
+            return;
+        case SD_STATUS_OK:
+            listReady = true;
+            snprintf(buf, sizeof(buf), "%s: %lu個", BROWSER_DIR, (unsigned long)result.value);
+            statusText = buf;
+            // 目録が変わっていればページも読み直す（件数が同じならスクロール位置は保つ）
+            pages.reset();
+            list.setItemCount(result.value);
+            break;
+        case SD_STATUS_NO_CARD:
+            statusText = "SDカードが見つかりません";
+            break;
+        case SD_STATUS_NOT_FOUND:
+            statusText = "/sound フォルダがありません";
+            break;
+        default:
+            statusText = "SDカードの読み込みに失敗しました";
+            break;
+    }
+    scanRequestId = 0;
+    statusDirty = true;
+    markContentChanged();
+}
+
+void FileBrowserScreen::handlePageResult(const SdResultEvent& result) {
+    const Pages::Slot* target = pages.complete(result.requestId, result.status == SD_STATUS_OK, result.value);
+    if (!target) {
+        return;
+    }
+    if (target->state != Pages::READY) {
+        statusText = "一覧の読み込みに失敗しました";
+        statusDirty = true;
+        return;
+    }
+    if (result.aux != list.items().getItemCount()) {
+        // 読んでいる間に目録が作り直された
+        pages.reset(target->page);
+        list.setItemCount(result.aux);
+    } else {
+        list.invalidate(target->page * PAGE_ENTRIES, PAGE_ENTRIES);
+    }
+    markContentChanged();
+}
+
+void FileBrowserScreen::init() {
+    tft->fillScreen(TFT_BLACK);
+    tft->setTextColor(TFT_WHITE);
+    tft->setFont(&fonts::lgfxJapanGothic_16);
+    tft->setCursor(10, 20);
+    tft->println("ファイル一覧");
+    tft->setFont(nullptr);
+    drawStatus();
+    list.redrawAll();
+    drawList();
+    for (auto& button : buttons) {
+        button->draw();
+    }
+}
+
+void FileBrowserScreen::draw() {
+    if (needsRedraw) { init(); needsRedraw = false; }
+    else {
+        if (statusDirty) { drawStatus(); }
+        drawList();
+    }
+}
+
+void FileBrowserScreen::update() {
+    // フリックで流れている間は毎フレーム位置を進める
+    if (list.update(millis())) {
+        markContentChanged();
+    }
+    if (listReady) {
+        prefetch();
+    }
+}
+
+void FileBrowserScreen::handleEvent(const Event& event) {
+    switch (event.getType()) {
+        case EVENT_TOUCH_DOWN: {
+            const TouchEvent& touch = event.touch();
+            list.touchDown(touch);
+            for (auto& button : buttons) {
+                button->handleTouch(touch.x, touch.y, true);
+            }
+            break;
+        }
+        case EVENT_TOUCH_MOVE: {
+            const TouchEvent& touch = event.touch();
+            list.touchMove(touch);
+            for (auto& button : buttons) {
+                button->handleTouch(touch.x, touch.y, true);
+            }
+            break;
+        }
+        case EVENT_TOUCH_UP: {
+            const TouchEvent& touch = event.touch();
+            // 離したときの速度は合流で捨てた移動も含めた履歴から求める
+            float vx = 0.0f;
+            float vy = 0.0f;
+            bool hasVelocity = g_eventBus &&
+                               g_eventBus->getLanes().estimateMotionVelocity(KINETIC_VELOCITY_WINDOW_US, vx, vy);
+            uint32_t item = list.touchUp(touch, vy, hasVelocity);
+            if (item != List::NO_ITEM) {
+                list.redrawItem(selectedItem);
+                selectedItem = item;
+                list.redrawItem(item);
+                playItem(item);
+                markContentChanged();
+            }
+            for (auto& button : buttons) {
+                button->handleTouch(touch.x, touch.y, false);
+            }
+            break;
+        }
+        case EVENT_SD_RESULT:
+            handleSdResult(event.sdResult());
+            break;
+        default:
+            break;
+    }
+}
+
+void FileBrowserScreen::prepare() {
+    if (buttons.empty()) {
+        createButtons();
+    }
+}
+
+void FileBrowserScreen::onEnter() {
+    prepare();
+    list.begin(tft);
+    listReady = false;
+    startScan();
+    needsRedraw = true;
+}
+
+void FileBrowserScreen::onExit() {
+    if (scanRequestId != 0 && g_sdService) {
+        g_sdService->cancel(scanRequestId);
+    }
+    scanRequestId = 0;
+    // 描画面（約50KB）は画面を出たら返す
+    list.end();
+    buttons.clear();
+    buttonPool.releaseAll();
+}
@@ -0,0 +1,86 @@
+#ifndef FILE_BROWSER_SCREEN_H
+#define FILE_BROWSER_SCREEN_H
+
+#include "BaseScreen.h"
+#include "../ui/components/KineticList.h"
+#include "../ui/components/WidgetList.h"
+#include "../ui/layout/ButtonPool.h"
+#include "../shared/FixedString.h"
+#include "../storage/MediaCatalog.h"
+#include "../storage/PageCache.h"
+// 前方宣言
+class ModernButton;
+
+// /soundのファイル一覧
+// 件数はSDサービスのスキャン（目録の照合）で知り、名前などは目録ファイルから
+// 表示に必要なページだけを読む。行は慣性スクロールのリストで表示中の分だけを持ち、
+// 動いたときは新しく見えた帯だけを描くので、何千件あってもメモリと1フレームの描画量は
+// 変わらない。フリックで流れ、タップした曲を再生する。
+class FileBrowserScreen : public BaseScreen {
+public:
+    // 1回に読むページの件数と、手元に置くページ数（表示中の2ページ + 先読み1ページ）
+    // 1件にタグの題名・アーティストを持つので、ページは表示行数より少し大きい程度にとどめる
+    static constexpr uint32_t PAGE_ENTRIES = 8;
+    static constexpr size_t CACHE_PAGES = 3;
+
+    // リストの表示領域
+    static constexpr int16_t LIST_TOP = 80;
+    static constexpr uint16_t LIST_HEIGHT = 160;
+    static constexpr uint16_t ROW_HEIGHT = 32;
+
+    // 1行分の表示内容（リストのスロットに置く）
+    struct Row {
+        FixedString<MEDIA_CATALOG_PAGE_NAME_BYTES> title;
+        FixedString<MEDIA_TAG_TEXT_BYTES + 24> detail;     // アーティスト・大きさ・再生時間
+    };
+
+    static constexpr size_t LIST_SLOTS = VirtualList<Row, 1>::slotsFor(LIST_HEIGHT, ROW_HEIGHT);
+    typedef KineticList<Row, LIST_SLOTS> List;
+    static_assert(LIST_SLOTS <= PAGE_ENTRIES + 1, "visible rows must span at most two pages");
+
+private:
+    typedef PageCache<MediaCatalogEntry, CACHE_PAGES, PAGE_ENTRIES> Pages;
+
+    ButtonPool<layoutCount(BACK_ONLY_LAYOUT)> buttonPool;  // 訪問をまたいで再利用
+    WidgetList<ModernButton, layoutCount(BACK_ONLY_LAYOUT)> buttons;
+    List list;
+
+    Pages pages;
+
+    uint16_t scanRequestId = 0;         // 0なら件数の確認中でない
+    uint32_t scannedEntries = 0;
+    bool listReady = false;             // 件数がわかった
+    FixedString<96> statusText;
+    uint32_t selectedItem = List::NO_ITEM;
+
+    bool statusDirty = false;
+
+public:
+    FileBrowserScreen(LGFX* display);
+    void init() override;
+    void draw() override;
+    void update() override;
+    void handleEvent(const Event& event) override;
+    void prepare() override;
+    void onEnter() override;
+    void onExit() override;
+    bool isSnapshotStable() const override { return scanRequestId == 0 && !pages.hasLoading() && !list.isMoving(); }
+    // 読み込み中のページにはSDサービスがあとから書き込むので破棄させない
+    bool isEvictable() const override { return !pages.hasLoading(); }
+
+private:
+    void createButtons();
+    void startScan();
+    void handleSdResult(const SdResultEvent& result);
+    void handlePageResult(const SdResultEvent& result);
+    void retireStalePages(uint16_t requestId);
+    void requestPage(uint32_t page);
+    void prefetch();
+    bool bindRow(uint32_t item, Row& row);
+    void drawRow(uint32_t item, const Row& row, bool ready, int16_t y);
+    void drawList();
+    void drawStatus();
+    void playItem(uint32_t item);
+};
+
+#endif // FILE_BROWSER_SCREEN_H
@@ -42,6 +42,14 @@ void HomeScreen::onExit() {
     Serial.println("Exiting Home Screen");
 }
 
+size_t HomeScreen::getNavigationTargets(ScreenID* out, size_t maxCount) const {
+    if (maxCount == 0) {
+        return 0;
+    }
+    out[0] = SCREEN_MENU;
+    return 1;
+}
+
 void HomeScreen::onSwipeUp() {
     // 何もしない（ホーム固定）
 }
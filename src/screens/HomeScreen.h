@@ -21,6 +21,9 @@ public:
     void onEnter() override;
     void onExit() override;
     
+    // 上スワイプでメニューへ（遷移はDisplayManagerが行う）
+    size_t getNavigationTargets(ScreenID* out, size_t maxCount) const override;
+    
     // ジェスチャー処理
     void onSwipeUp() override;
 };
@@ -2,13 +2,13 @@
 #include <LovyanGFX.hpp>
 #include "InfoScreen.h"
 #include "../ui/components/ModernButton.h"
-#include "../shared/EventQueue.h"
+#include "../ui/layout/LayoutTable.h"
+#include "../shared/EventBus.h"
+#include "../core/FrameScheduler.h"
+#include "../shared/LogBuffer.h"
 #include <Arduino.h>
 #include <WiFi.h>
 
-// グローバルイベントキュー（外部で定義）
-extern EventQueue* g_touchEventQueue;
-
 // スワイプ検出の閾値
 #define SWIPE_THRESHOLD 50  // 最小スワイプ距離
 #define SWIPE_TIME_LIMIT 500  // 最大スワイプ時間（ms）
@@ -39,20 +39,7 @@ InfoScreen::InfoScreen(LGFX* display)
 
 void InfoScreen::createButtons() {
     // 戻るボタン（右上）
-    auto backBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, tft->width() - 70, 10, 60, 30, "戻る")
-    );
-    ButtonStyle backStyle;
-    backStyle.normalColor = tft->color565(96, 125, 139);    // Blue Grey
-    backStyle.pressedColor = tft->color565(69, 90, 100);    // Darker Blue Grey
-    backStyle.cornerRadius = 5;
-    backStyle.shadowOffset = 2;
-    backBtn->setStyle(backStyle);
-    backBtn->setOnClick([this]() {
-        Serial.println("Back button pressed - returning to Settings");
-        returnToSettings();
-    });
-    buttons.push_back(std::move(backBtn));
+    buttons.build(tft, BACK_ONLY_LAYOUT);
 }
 
 void InfoScreen::updateSystemInfo() {
@@ -63,11 +50,12 @@ void InfoScreen::updateSystemInfo() {
     
     // ESP32のチップID（シリアル番号として使用）
     uint64_t chipid = ESP.getEfuseMac();
-    chipId = String((uint32_t)(chipid >> 32), HEX) + String((uint32_t)chipid, HEX);
-    chipId.toUpperCase();
+    chipId.format("%X%X", (unsigned)(uint32_t)(chipid >> 32), (unsigned)(uint32_t)chipid);
     
     // MACアドレス
-    macAddress = WiFi.macAddress();
+    uint8_t mac[6];
+    WiFi.macAddress(mac);
+    macAddress.format("%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
     
     // メモリ情報
     freeHeap = ESP.getFreeHeap();
@@ -108,7 +96,7 @@ void InfoScreen::init() {
     tft->print("ボード: ");
     tft->setTextColor(TFT_WHITE);
     tft->setFont(nullptr);
-    tft->println(boardName);
+    tft->println(boardName.c_str());
     y += lineHeight;
     
     // 製品名
@@ -118,7 +106,7 @@ void InfoScreen::init() {
     tft->print("製品名: ");
     tft->setTextColor(TFT_WHITE);
     tft->setFont(nullptr);
-    tft->println(productName);
+    tft->println(productName.c_str());
     y += lineHeight;
     
     // バージョン
@@ -128,7 +116,7 @@ void InfoScreen::init() {
     tft->print("バージョン: ");
     tft->setTextColor(TFT_WHITE);
     tft->setFont(nullptr);
-    tft->println(version);
+    tft->println(version.c_str());
     y += lineHeight;
     
     // チップID
@@ -138,7 +126,7 @@ void InfoScreen::init() {
     tft->print("チップID: ");
     tft->setTextColor(TFT_WHITE);
     tft->setFont(nullptr);
-    tft->println(chipId);
+    tft->println(chipId.c_str());
     y += lineHeight;
     
     // MACアドレス
@@ -148,7 +136,7 @@ void InfoScreen::init() {
     tft->print("MACアドレス: ");
     tft->setTextColor(TFT_WHITE);
     tft->setFont(nullptr);
-    tft->println(macAddress);
+    tft->println(macAddress.c_str());
     y += lineHeight;
     
     // フラッシュメモリ情報
@@ -184,7 +172,7 @@ void InfoScreen::init() {
     
     // ボタンを描画
     for (auto& button : buttons) {
-        button->draw();
+        button.draw();
     }
 }
 
@@ -233,17 +221,17 @@ void InfoScreen::update() {
 }
 
 void InfoScreen::handleEvent(const Event& event) {
-    switch (event.type) {
+    switch (event.getType()) {
         case EVENT_TOUCH_DOWN: {
             // タッチ開始位置を記録
-            touchStartX = event.data.touch.x;
-            touchStartY = event.data.touch.y;
+            touchStartX = event.touch().x;
+            touchStartY = event.touch().y;
             touchStartTime = millis();
             isTouching = true;
             
             // ボタンのタッチ処理
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button.handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         }
@@ -251,7 +239,7 @@ void InfoScreen::handleEvent(const Event& event) {
         case EVENT_TOUCH_MOVE: {
             // ボタンのタッチ移動処理
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button.handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         }
@@ -260,14 +248,14 @@ void InfoScreen::handleEvent(const Event& event) {
             // ボタンのタッチ終了処理
             bool buttonHandled = false;
             for (auto& button : buttons) {
-                if (button->handleTouch(event.data.touch.x, event.data.touch.y, false)) {
+                if (button.handleTouch(event.touch().x, event.touch().y, false)) {
                     buttonHandled = true;
                 }
             }
             
             // ボタンが処理しなかった場合、スワイプジェスチャーを検出
             if (isTouching && !buttonHandled) {
-                detectSwipeGesture(event.data.touch.x, event.data.touch.y);
+                detectSwipeGesture(event.touch().x, event.touch().y);
             }
             isTouching = false;
             break;
@@ -275,7 +263,7 @@ void InfoScreen::handleEvent(const Event& event) {
             
         case EVENT_GESTURE_SWIPE: {
             // TouchManagerからのジェスチャーイベント
-            switch (event.data.gesture.direction) {
+            switch (event.gestureDirection()) {
                 case GestureEvent::GESTURE_UP:
                     onSwipeUp();
                     break;
@@ -300,32 +288,39 @@ void InfoScreen::handleEvent(const Event& event) {
 }
 
 void InfoScreen::onEnter() {
-    Serial.println("Entered Info Screen");
-    updateSystemInfo();  // 最新の情報を取得
+    logInfo("Entered Info Screen");
     needsRedraw = true;
+    
+    // 前回の値で先に描画し、最新の情報は描画後の空き時間に取得して描き直す
+    g_frameScheduler.post(this, "info.refresh", JOB_PRIORITY_HIGH, 100, [this]() {
+        updateSystemInfo();
+        needsRedraw = true;
+        return true;
+    });
 }
 
 void InfoScreen::onExit() {
-    Serial.println("Exiting Info Screen");
+    logInfo("Exiting Info Screen");
+    g_frameScheduler.cancel(this);
 }
 
 void InfoScreen::onSwipeUp() {
-    Serial.println("Info: Swipe Up - return to Settings");
+    logInfo("Info: Swipe Up - return to Settings");
     returnToSettings();
 }
 
 void InfoScreen::onSwipeDown() {
-    Serial.println("Info: Swipe Down - return to Settings");
+    logInfo("Info: Swipe Down - return to Settings");
     returnToSettings();
 }
 
 void InfoScreen::onSwipeLeft() {
-    Serial.println("Info: Swipe Left - return to Settings");
+    logInfo("Info: Swipe Left - return to Settings");
     returnToSettings();
 }
 
 void InfoScreen::onSwipeRight() {
-    Serial.println("Info: Swipe Right - return to Settings");
+    logInfo("Info: Swipe Right - return to Settings");
     returnToSettings();
 }
 
@@ -358,13 +353,10 @@ void InfoScreen::detectSwipeGesture(int32_t endX, int32_t endY) {
 
 void InfoScreen::returnToSettings() {
     // 設定画面に戻るイベントを送信
-    Event returnEvent;
-    returnEvent.type = EVENT_SCREEN_CHANGE;
-    returnEvent.data.screenChange.targetScreen = SCREEN_SETTINGS;
-    returnEvent.data.screenChange.transition = TRANSITION_SLIDE_RIGHT;
+    Event returnEvent = makeScreenChangeEvent(SCREEN_BACK, TRANSITION_SLIDE_RIGHT);
     
     // イベントキューに送信
-    if (g_touchEventQueue) {
-        g_touchEventQueue->send(returnEvent);
+    if (g_eventBus) {
+        g_eventBus->publish(returnEvent);
     }
 }
\ No newline at end of file
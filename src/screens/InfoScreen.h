@@ -2,11 +2,8 @@
 #define INFO_SCREEN_H
 
 #include "BaseScreen.h"
-#include <memory>
-#include <vector>
-
-// 前方宣言
-class ModernButton;
+#include "../shared/FixedString.h"
+#include "../ui/layout/ButtonSet.h"
 
 class InfoScreen : public BaseScreen {
 private:
@@ -17,19 +14,19 @@ private:
     bool isTouching;
     
     // システム情報
-    String boardName;
-    String productName;
-    String version;
-    String chipId;
-    String macAddress;
+    FixedString<32> boardName;
+    FixedString<32> productName;
+    FixedString<16> version;
+    FixedString<20> chipId;
+    FixedString<20> macAddress;
     uint32_t freeHeap;
     uint32_t totalHeap;
     uint32_t freePsram;
     uint32_t totalPsram;
     uint32_t flashSize;
     
-    // UIコンポーネント
-    std::vector<std::unique_ptr<ModernButton>> buttons;
+    // UIコンポーネント（レイアウト表から生成）
+    ButtonSet<layoutCount(BACK_ONLY_LAYOUT)> buttons;
     
 public:
     InfoScreen(LGFX* display);
@@ -44,6 +41,9 @@ public:
     void onEnter() override;
     void onExit() override;
     
+    // メモリ使用量を毎秒描き換えるのでスナップショットは使わない
+    bool isSnapshotStable() const override { return false; }
+    
     // スワイプで設定画面に戻る
     void onSwipeUp() override;
     void onSwipeDown() override;
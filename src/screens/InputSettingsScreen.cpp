@@ -3,130 +3,101 @@
 #include "InputSettingsScreen.h"
 #include <Arduino.h>
 #include "../ui/components/ModernButton.h"
-#include "../shared/EventQueue.h"
-#include <memory>
-#include <vector>
-#include <SPI.h>
-#include <SD.h>
-
-#ifndef INPUT_SETTINGS_SD_SPI_HOST
-#define INPUT_SETTINGS_SD_SPI_HOST VSPI
-#endif
-
-#ifndef INPUT_SETTINGS_SD_CS_PIN
-#define INPUT_SETTINGS_SD_CS_PIN 5
-#endif
-
-#ifndef INPUT_SETTINGS_SD_SCLK_PIN
-#define INPUT_SETTINGS_SD_SCLK_PIN 18
-#endif
-
-#ifndef INPUT_SETTINGS_SD_MOSI_PIN
-#define INPUT_SETTINGS_SD_MOSI_PIN 23
-#endif
-
-#ifndef INPUT_SETTINGS_SD_MISO_PIN
-#define INPUT_SETTINGS_SD_MISO_PIN 19
-#endif
-
-#ifndef INPUT_SETTINGS_SD_FREQ_HZ
-#define INPUT_SETTINGS_SD_FREQ_HZ 20000000
-#endif
+#include "../ui/layout/LayoutTable.h"
+#include "../storage/SdService.h"
 
 namespace {
-constexpr int SDCARD_CS_PIN = INPUT_SETTINGS_SD_CS_PIN;
-constexpr int SDCARD_SCLK_PIN = INPUT_SETTINGS_SD_SCLK_PIN;
-constexpr int SDCARD_MOSI_PIN = INPUT_SETTINGS_SD_MOSI_PIN;
-constexpr int SDCARD_MISO_PIN = INPUT_SETTINGS_SD_MISO_PIN;
-constexpr uint32_t SDCARD_SPI_FREQ_HZ = INPUT_SETTINGS_SD_FREQ_HZ;
-
-SPIClass sdSPI(INPUT_SETTINGS_SD_SPI_HOST);
-bool sdSpiConfigured = false;
-
-void ensureSdSpiConfigured()
-{
-    if (sdSpiConfigured) {
-        return;
-    }
-    sdSPI.begin(SDCARD_SCLK_PIN, SDCARD_MISO_PIN, SDCARD_MOSI_PIN, SDCARD_CS_PIN);
-    sdSpiConfigured = true;
-}
+constexpr ButtonStyleDef STYLE_BROWSE = {
+    rgb565(76, 175, 80), rgb565(56, 142, 60), 8, 3, 0, 0xFFFF       // Green（メニューと同じ色）
+};
+
+// 入力設定画面のボタン表
+constexpr ButtonDef INPUT_SETTINGS_BUTTONS[InputSettingsScreen::BUTTON_COUNT] = {
+    BACK_TO_MENU_BUTTON,
+    {10, 90, 140, 44, "ファイル一覧", &STYLE_BROWSE, {UI_ACTION_NAVIGATE, SCREEN_FILE_BROWSER, TRANSITION_SLIDE_LEFT}}
+};
 } // namespace
 
-extern EventQueue* g_touchEventQueue;
-
 InputSettingsScreen::InputSettingsScreen(LGFX* display)
     : BaseScreen(display, SCREEN_INPUT_SETTINGS) {}
 
 void InputSettingsScreen::createButtons() {
     buttons.clear();
-    auto backBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, tft->width() - 70, 10, 60, 30, "戻る")
-    );
-    ButtonStyle backStyle;
-    backStyle.normalColor = tft->color565(96, 125, 139);    // Blue Grey
-    backStyle.pressedColor = tft->color565(69, 90, 100);
-    backStyle.cornerRadius = 5;
-    backStyle.shadowOffset = 2;
-    backBtn->setStyle(backStyle);
-    backBtn->setOnClick([this]() {
-        Event e;
-        e.type = EVENT_SCREEN_CHANGE;
-        e.data.screenChange.targetScreen = SCREEN_MENU;
-        e.data.screenChange.transition = TRANSITION_SLIDE_RIGHT;
-        if (g_touchEventQueue) g_touchEventQueue->send(e);
-    });
-    buttons.push_back(std::move(backBtn));
+    buttonPool.releaseAll();
+    for (const ButtonDef& def : INPUT_SETTINGS_BUTTONS) {
+        buttons.push_back(acquireButton(buttonPool, tft, def));
+    }
+}
+
+size_t InputSettingsScreen::getNavigationTargets(ScreenID* out, size_t maxCount) const {
+    return collectNavigationTargets(INPUT_SETTINGS_BUTTONS, out, maxCount);
 }
 
-void InputSettingsScreen::checkSDAndCountMp3() {
+void InputSettingsScreen::startSdScan() {
     sdAvailable = false;
     mp3Count = 0;
+    scannedEntries = 0;
     sdErrorMsg.clear();
-
-    ensureSdSpiConfigured();
-    // LovyanGFX が利用しているバスを再初期化して衝突を避ける
-    if (tft) {
-        tft->initBus();
+    
+    // 画面はすぐに「確認中」で表示し、結果イベントが届いたら描き直す
+    scanRequestId = g_sdService ? g_sdService->requestScan("/sound", ".mp3") : 0;
+    if (scanRequestId == 0) {
+        sdErrorMsg = "SDカードの確認を開始できません";
     }
+}
 
-    if (!SD.begin(SDCARD_CS_PIN, sdSPI, SDCARD_SPI_FREQ_HZ)) {
-        sdErrorMsg = "SDカードが見つかりません（配線やFAT32フォーマットも確認してください）";
-        return;
+void InputSettingsScreen::cancelSdScan() {
+    // 未完了の確認は取り消す（あとから届く結果はIDが合わないので無視される）
+    if (scanRequestId != 0 && g_sdService) {
+        g_sdService->cancel(scanRequestId);
     }
-    File soundDir = SD.open("/sound");
-    if (!soundDir || !soundDir.isDirectory()) {
-        sdErrorMsg = "/sound フォルダがありません";
+    scanRequestId = 0;
+}
+
+void InputSettingsScreen::handleSdResult(const SdResultEvent& result) {
+    if (scanRequestId == 0 || result.requestId != scanRequestId) {
         return;
     }
-    while (true) {
-        File entry = soundDir.openNextFile();
-        if (!entry) {
+    switch (result.status) {
+        case SD_STATUS_PROGRESS:
+            mp3Count = static_cast<int>(result.value);
+            scannedEntries = result.aux;
+            statusDirty = true;
+            return;
+        case SD_STATUS_OK:
+            sdAvailable = true;
+            mp3Count = static_cast<int>(result.value);
+            break;
+        case SD_STATUS_NO_CARD:
+            sdErrorMsg = "SDカードが見つかりません（配線やFAT32フォーマットも確認してください）";
+            break;
+        case SD_STATUS_NOT_FOUND:
+            sdErrorMsg = "/sound フォルダがありません";
+            break;
+        default:
+            sdErrorMsg = "SDカードの読み込みに失敗しました";
             break;
-        }
-        String name = entry.name();
-        name.toLowerCase();
-        if (!entry.isDirectory() && name.endsWith(".mp3")) {
-            mp3Count++;
-        }
-        entry.close();
     }
-    soundDir.close();
-    sdAvailable = true;
+    scanRequestId = 0;
+    statusDirty = true;
+    markContentChanged();
 }
 
-void InputSettingsScreen::init() {
-    tft->fillScreen(TFT_BLACK);
-    tft->setTextColor(TFT_WHITE);
-    tft->setFont(&fonts::lgfxJapanGothic_16);
-    tft->setCursor(10, 20);
-    tft->println("入力設定");
+void InputSettingsScreen::drawStatus() {
     // SDカード状況・楽曲数表示は12ptで
+    tft->fillRect(0, 52, tft->width(), 24, TFT_BLACK);
     tft->setFont(&fonts::lgfxJapanGothic_12);
     tft->setCursor(10, 60);
-    if (sdAvailable) {
-        char buf[32];
-        sprintf(buf, ".mp3音源: %d個", mp3Count);
+    char buf[64];
+    if (scanRequestId != 0) {
+        if (scannedEntries > 0) {
+            snprintf(buf, sizeof(buf), "SDカードを確認中... (%d個 / %lu件)", mp3Count, (unsigned long)scannedEntries);
+            tft->println(buf);
+        } else {
+            tft->println("SDカードを確認中...");
+        }
+    } else if (sdAvailable) {
+        snprintf(buf, sizeof(buf), ".mp3音源: %d個", mp3Count);
         tft->println(buf);
     } else {
         tft->setTextColor(TFT_RED);
@@ -134,6 +105,16 @@ void InputSettingsScreen::init() {
         tft->setTextColor(TFT_WHITE);
     }
     tft->setFont(nullptr);
+    statusDirty = false;
+}
+
+void InputSettingsScreen::init() {
+    tft->fillScreen(TFT_BLACK);
+    tft->setTextColor(TFT_WHITE);
+    tft->setFont(&fonts::lgfxJapanGothic_16);
+    tft->setCursor(10, 20);
+    tft->println("入力設定");
+    drawStatus();
     for (auto& button : buttons) {
         button->draw();
     }
@@ -141,35 +122,66 @@ void InputSettingsScreen::init() {
 
 void InputSettingsScreen::draw() {
     if (needsRedraw) { init(); needsRedraw = false; }
+    else if (statusDirty) { drawStatus(); }
 }
 
 void InputSettingsScreen::update() {
 }
 
 void InputSettingsScreen::handleEvent(const Event& event) {
-    switch (event.type) {
+    switch (event.getType()) {
         case EVENT_TOUCH_DOWN:
         case EVENT_TOUCH_MOVE:
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button->handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         case EVENT_TOUCH_UP: {
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, false);
+                button->handleTouch(event.touch().x, event.touch().y, false);
             }
             break;
         }
+        case EVENT_SD_RESULT:
+            handleSdResult(event.sdResult());
+            break;
         default:
             break;
     }
 }
 
+void InputSettingsScreen::prepare() {
+    if (buttons.empty()) {
+        createButtons();
+    }
+}
+
 void InputSettingsScreen::onEnter() {
-    checkSDAndCountMp3();
-    createButtons();
+    startSdScan();
+    prepare();
     needsRedraw = true;
 }
 
 void InputSettingsScreen::onExit() {
+    cancelSdScan();
+    scanInterrupted = false;
+    
+    // ボタンはプールに返却（破棄せず次回の訪問で再利用）
+    buttons.clear();
+    buttonPool.releaseAll();
+}
+
+void InputSettingsScreen::onPause() {
+    // SDの結果は表示中の画面にしか届かないので、重ねた画面の間に終わった確認は受け取れない
+    // 取り消しておき、戻ってきたらやり直す
+    scanInterrupted = scanRequestId != 0;
+    cancelSdScan();
+}
+
+void InputSettingsScreen::onResume() {
+    if (scanInterrupted) {
+        scanInterrupted = false;
+        startSdScan();
+        statusDirty = true;
+    }
 }
@@ -2,29 +2,49 @@
 #define INPUT_SETTINGS_SCREEN_H
 
 #include "BaseScreen.h"
-#include <memory>
-#include <vector>
-#include <string>
+#include "../ui/components/WidgetList.h"
+#include "../ui/layout/ButtonPool.h"
+#include "../shared/FixedString.h"
 // 前方宣言
 class ModernButton;
 
 class InputSettingsScreen : public BaseScreen {
+public:
+    // レイアウト表のボタン数（戻る + ファイル一覧）
+    static constexpr size_t BUTTON_COUNT = 2;
+
 private:
-    std::vector<std::unique_ptr<ModernButton>> buttons;
+    ButtonPool<BUTTON_COUNT> buttonPool;  // 訪問をまたいで再利用
+    WidgetList<ModernButton, BUTTON_COUNT> buttons;
     bool sdAvailable = false;          // SDカード初期化成功したか
     int mp3Count = 0;                  // mp3ファイル数
-    std::string sdErrorMsg;            // SD失敗時のエラーメッセージ
+    FixedString<128> sdErrorMsg;       // SD失敗時のエラーメッセージ
+    
+    // SDの確認はSDサービスに依頼し、結果イベントで表示を更新する
+    uint16_t scanRequestId = 0;        // 0なら確認中でない
+    uint32_t scannedEntries = 0;       // 途中経過（調べたエントリ数）
+    bool scanInterrupted = false;      // 確認中に別の画面を重ねた（戻ったらやり直す）
+    bool statusDirty = false;          // 状態行だけ描き直す
 public:
     InputSettingsScreen(LGFX* display);
     void init() override;
     void draw() override;
     void update() override;
     void handleEvent(const Event& event) override;
+    void prepare() override;
     void onEnter() override;
     void onExit() override;
+    void onPause() override;
+    void onResume() override;
+    // 確認中は表示が変わるので撮影しない
+    bool isSnapshotStable() const override { return scanRequestId == 0; }
+    size_t getNavigationTargets(ScreenID* out, size_t maxCount) const override;
 private:
     void createButtons();
-    void checkSDAndCountMp3();    // SD初期化・mp3数取得
+    void startSdScan();           // SD初期化・mp3数取得を依頼
+    void cancelSdScan();
+    void handleSdResult(const SdResultEvent& result);
+    void drawStatus();
 };
 
 #endif // INPUT_SETTINGS_SCREEN_H
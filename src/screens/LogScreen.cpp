@@ -1,36 +1,113 @@
 #define LGFX_USE_V1
 #include <LovyanGFX.hpp>
 #include "LogScreen.h"
+#include "../shared/LogBuffer.h"
 #include <Arduino.h>
 #include "../ui/components/ModernButton.h"
-#include "../shared/EventQueue.h"
-#include <memory>
-#include <vector>
+#include "../ui/layout/LayoutTable.h"
+#include "../shared/EventBus.h"
+#include "../storage/SdService.h"
 
-extern EventQueue* g_touchEventQueue;
+namespace {
+// 書き込み中の記録を読み直す回数（書く側はすぐ終わるので数回で足りる）
+const int READ_RETRIES = 3;
+
+// 件数などの表示を更新する間隔
+const uint32_t STATUS_INTERVAL_MS = 1000;
+
+const uint16_t ROW_SEPARATOR_COLOR = rgb565(38, 50, 56);
+const uint16_t SCROLLBAR_COLOR = rgb565(120, 144, 156);
+
+// 重要度ごとの文字色（デバッグ・情報・警告・異常）
+const uint16_t SEVERITY_COLORS[LOG_SEVERITY_COUNT] = {
+    rgb565(158, 158, 158), TFT_WHITE, rgb565(255, 213, 79), rgb565(239, 83, 80)
+};
+} // namespace
 
 LogScreen::LogScreen(LGFX* display)
-    : BaseScreen(display, SCREEN_LOG) {}
+    : BaseScreen(display, SCREEN_LOG), list(0, LIST_TOP, UI_SCREEN_WIDTH, LIST_HEIGHT, ROW_HEIGHT) {
+    list.items().setBinder([this](uint32_t item, Row& row) {
+        return bindRow(item, row);
+    });
+    list.items().setRenderer([this](uint32_t item, const Row& row, bool ready, int16_t y) {
+        drawRow(item, row, ready, y);
+    });
+    list.setColors(TFT_BLACK, SCROLLBAR_COLOR);
+}
 
 void LogScreen::createButtons() {
     buttons.clear();
-    auto backBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, tft->width() - 70, 10, 60, 30, "戻る")
-    );
-    ButtonStyle backStyle;
-    backStyle.normalColor = tft->color565(96, 125, 139);    // Blue Grey
-    backStyle.pressedColor = tft->color565(69, 90, 100);
-    backStyle.cornerRadius = 5;
-    backStyle.shadowOffset = 2;
-    backBtn->setStyle(backStyle);
-    backBtn->setOnClick([this]() {
-        Event e;
-        e.type = EVENT_SCREEN_CHANGE;
-        e.data.screenChange.targetScreen = SCREEN_MENU;
-        e.data.screenChange.transition = TRANSITION_SLIDE_RIGHT;
-        if (g_touchEventQueue) g_touchEventQueue->send(e);
-    });
-    buttons.push_back(std::move(backBtn));
+    buttonPool.releaseAll();
+    for (const ButtonDef& def : BACK_ONLY_LAYOUT) {
+        buttons.push_back(acquireButton(buttonPool, tft, def));
+    }
+}
+
+bool LogScreen::bindRow(uint32_t item, Row& row) {
+    uint32_t sequence = baseSequence + item;
+    LogRecord record;
+    for (int attempt = 0; attempt < READ_RETRIES; attempt++) {
+        if (g_log.read(sequence, record)) {
+            char line[LOG_LINE_BYTES];
+            formatLogLine(record, line, sizeof(line));
+            row.text.assign(line);
+            row.severity = record.severity;
+            return true;
+        }
+        if (static_cast<int32_t>(sequence - g_log.getOldest()) < 0) {
+            // 見ている間に上書きされた（もう読めない）
+            row.text.format("%u （上書きされた記録）", static_cast<unsigned>(sequence));
+            row.severity = LOG_SEVERITY_DEBUG;
+            return true;
+        }
+    }
+    // 書き込み中。次のフレームで読み直す
+    rowsPending = true;
+    return false;
+}
+
+void LogScreen::drawRow(uint32_t item, const Row& row, bool ready, int16_t y) {
+    (void)item;
+    lgfx::LovyanGFX* canvas = list.canvas();
+    int16_t x = list.canvasLeft();
+    int16_t width = UI_SCREEN_WIDTH - KINETIC_LIST_SCROLLBAR_WIDTH;
+    canvas->fillRect(x, y, width, ROW_HEIGHT - 1, TFT_BLACK);
+    canvas->drawFastHLine(x, y + ROW_HEIGHT - 1, width, ROW_SEPARATOR_COLOR);
+    if (!ready) {
+        return;
+    }
+    canvas->setTextColor(SEVERITY_COLORS[row.severity < LOG_SEVERITY_COUNT ? row.severity : static_cast<uint8_t>(LOG_SEVERITY_ERROR)]);
+    canvas->setCursor(x + 4, y + 2);
+    canvas->print(row.text.c_str());
+    canvas->setTextColor(TFT_WHITE);
+}
+
+void LogScreen::drawList() {
+    // 描き直し待ちの帯（新しく見えた行・増えた行）だけを描いて送る
+    lgfx::LovyanGFX* canvas = list.canvas();
+    canvas->setFont(&fonts::lgfxJapanGothic_12);
+    canvas->setTextColor(TFT_WHITE);
+    list.draw();
+    canvas->setFont(nullptr);
+}
+
+void LogScreen::updateStatus() {
+    statusText.format("%lu件 警告%lu 異常%lu", static_cast<unsigned long>(g_log.getHead()),
+                      static_cast<unsigned long>(g_log.getCount(LOG_SEVERITY_WARN)),
+                      static_cast<unsigned long>(g_log.getCount(LOG_SEVERITY_ERROR)));
+    if (g_sdService) {
+        statusText.appendFormat(" SD %luKB", static_cast<unsigned long>(g_sdService->getLogBytes() / 1024));
+    }
+    statusDirty = true;
+}
+
+void LogScreen::drawStatus() {
+    tft->fillRect(0, 52, tft->width(), 24, TFT_BLACK);
+    tft->setFont(&fonts::lgfxJapanGothic_12);
+    tft->setCursor(10, 60);
+    tft->print(statusText.c_str());
+    tft->setFont(nullptr);
+    statusDirty = false;
 }
 
 void LogScreen::init() {
@@ -40,6 +117,9 @@ void LogScreen::init() {
     tft->setCursor(10, 20);
     tft->println("ログ");
     tft->setFont(nullptr);
+    drawStatus();
+    list.redrawAll();
+    drawList();
     for (auto& button : buttons) {
         button->draw();
     }
@@ -47,22 +127,67 @@ void LogScreen::init() {
 
 void LogScreen::draw() {
     if (needsRedraw) { init(); needsRedraw = false; }
+    else {
+        if (statusDirty) { drawStatus(); }
+        drawList();
+    }
 }
 
 void LogScreen::update() {
+    // 増えた記録を末尾に足す（末尾を見ていればそのまま送る）
+    uint32_t head = g_log.getHead();
+    if (head != shownHead) {
+        list.append(head - shownHead);
+        shownHead = head;
+        markContentChanged();
+    }
+    if (rowsPending) {
+        // 書き込み中だった行を読み直させる
+        rowsPending = false;
+        const List::List& rows = list.items();
+        uint32_t first = rows.firstVisible();
+        if (first != List::NO_ITEM) {
+            list.invalidate(first, rows.lastVisible() - first + 1);
+        }
+    }
+    uint32_t now = millis();
+    if (list.update(now)) {
+        markContentChanged();
+    }
+    if (now - lastStatusMs >= STATUS_INTERVAL_MS) {
+        lastStatusMs = now;
+        updateStatus();
+    }
 }
 
 void LogScreen::handleEvent(const Event& event) {
-    switch (event.type) {
-        case EVENT_TOUCH_DOWN:
-        case EVENT_TOUCH_MOVE:
+    switch (event.getType()) {
+        case EVENT_TOUCH_DOWN: {
+            const TouchEvent& touch = event.touch();
+            list.touchDown(touch);
+            for (auto& button : buttons) {
+                button->handleTouch(touch.x, touch.y, true);
+            }
+            break;
+        }
+        case EVENT_TOUCH_MOVE: {
+            const TouchEvent& touch = event.touch();
+            list.touchMove(touch);
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button->handleTouch(touch.x, touch.y, true);
             }
             break;
+        }
         case EVENT_TOUCH_UP: {
+            const TouchEvent& touch = event.touch();
+            // 離したときの速度は合流で捨てた移動も含めた履歴から求める（行のタップは使わない）
+            float vx = 0.0f;
+            float vy = 0.0f;
+            bool hasVelocity = g_eventBus &&
+                               g_eventBus->getLanes().estimateMotionVelocity(KINETIC_VELOCITY_WINDOW_US, vx, vy);
+            list.touchUp(touch, vy, hasVelocity);
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, false);
+                button->handleTouch(touch.x, touch.y, false);
             }
             break;
         }
@@ -71,12 +196,29 @@ void LogScreen::handleEvent(const Event& event) {
     }
 }
 
+void LogScreen::prepare() {
+    if (buttons.empty()) {
+        createButtons();
+    }
+}
+
 void LogScreen::onEnter() {
-    createButtons();
+    prepare();
+    list.begin(tft);
+    // 残っている記録から始めて、末尾を見せる
+    baseSequence = g_log.getOldest();
+    shownHead = g_log.getHead();
+    rowsPending = false;
+    list.setItemCount(0);
+    list.append(shownHead - baseSequence);
+    updateStatus();
+    lastStatusMs = millis();
     needsRedraw = true;
 }
 
 void LogScreen::onExit() {
+    // 描画面は画面を出たら返す
+    list.end();
+    buttons.clear();
+    buttonPool.releaseAll();
 }
-
-
@@ -2,24 +2,66 @@
 #define LOG_SCREEN_H
 
 #include "BaseScreen.h"
-#include <memory>
-#include <vector>
+#include "../ui/components/KineticList.h"
+#include "../ui/components/WidgetList.h"
+#include "../ui/layout/ButtonPool.h"
+#include "../shared/FixedString.h"
 // 前方宣言
 class ModernButton;
 
+// メモリ上のログ（g_log）の表示
+// 入ったときに残っているいちばん古い記録から並べ、新しい記録は末尾に足していく。
+// 末尾を見ている間は新しい記録に合わせて送り、フリックで遡れる。
+// 行は表示中の分だけ整形するので、書き込みの多いタスクの邪魔をしない。
+// 見ている間に上書きされた古い記録はその旨を表示する。
 class LogScreen : public BaseScreen {
+public:
+    // リストの表示領域
+    static constexpr int16_t LIST_TOP = 80;
+    static constexpr uint16_t LIST_HEIGHT = 160;
+    static constexpr uint16_t ROW_HEIGHT = 16;
+
+    // 1行分の表示内容（リストのスロットに置く）
+    struct Row {
+        FixedString<72> text;
+        uint8_t severity;
+    };
+
+    static constexpr size_t LIST_SLOTS = VirtualList<Row, 1>::slotsFor(LIST_HEIGHT, ROW_HEIGHT);
+    typedef KineticList<Row, LIST_SLOTS> List;
+
 private:
-    std::vector<std::unique_ptr<ModernButton>> buttons;
+    ButtonPool<layoutCount(BACK_ONLY_LAYOUT)> buttonPool;  // 訪問をまたいで再利用
+    WidgetList<ModernButton, layoutCount(BACK_ONLY_LAYOUT)> buttons;
+    List list;
+
+    uint32_t baseSequence = 0;          // 項目0の通し番号
+    uint32_t shownHead = 0;             // リストに並べた次の通し番号
+    bool rowsPending = false;           // 書き込み中で読めなかった行がある
+    uint32_t lastStatusMs = 0;
+    FixedString<96> statusText;
+
+    bool statusDirty = false;
+
 public:
     LogScreen(LGFX* display);
     void init() override;
     void draw() override;
     void update() override;
     void handleEvent(const Event& event) override;
+    void prepare() override;
     void onEnter() override;
     void onExit() override;
+    // 記録が増えると入力と関係なく表示が変わる
+    bool isSnapshotStable() const override { return false; }
+
 private:
     void createButtons();
+    bool bindRow(uint32_t item, Row& row);
+    void drawRow(uint32_t item, const Row& row, bool ready, int16_t y);
+    void drawList();
+    void drawStatus();
+    void updateStatus();
 };
 
 #endif // LOG_SCREEN_H
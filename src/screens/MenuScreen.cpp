@@ -1,17 +1,61 @@
 #define LGFX_USE_V1
 #include <LovyanGFX.hpp>
 #include "MenuScreen.h"
-#include "../ui/components/ModernButton.h"
-#include "../shared/EventQueue.h"
+#include "../shared/EventBus.h"
 #include <Arduino.h>
 
-// グローバルイベントキュー（外部で定義）
-extern EventQueue* g_touchEventQueue;
-
 // スワイプ検出の閾値
 #define SWIPE_THRESHOLD 50  // 最小スワイプ距離
 #define SWIPE_TIME_LIMIT 500  // 最大スワイプ時間（ms）
 
+namespace {
+// 2列×3行のグリッド（サイズはデバイス設定と同等: 130x40）
+constexpr uint16_t GRID_BUTTON_W = 130;
+constexpr uint16_t GRID_BUTTON_H = 40;
+constexpr int16_t GRID_COLS = 2;
+constexpr int16_t GRID_ROWS = 3;
+constexpr int16_t GRID_MIN_GAP_X = 10;
+constexpr int16_t GRID_ROW_GAP = 8;     // 縦方向のギャップを少し狭める
+constexpr int16_t GRID_MIN_Y = 60;      // 下線と干渉しないよう少し下げる
+
+constexpr int16_t cellX(int16_t index) {
+    return gridCellX(index % GRID_COLS, GRID_BUTTON_W, GRID_COLS, GRID_MIN_GAP_X);
+}
+
+constexpr int16_t cellY(int16_t index) {
+    return gridCellY(index / GRID_COLS, GRID_BUTTON_H, GRID_ROWS, GRID_ROW_GAP, GRID_MIN_Y);
+}
+
+constexpr ButtonStyleDef gridStyle(uint16_t normal, uint16_t pressed) {
+    return ButtonStyleDef{normal, pressed, 10, 4, 0, 0xFFFF};
+}
+
+constexpr ButtonStyleDef STYLE_STANDBY = gridStyle(rgb565(96, 125, 139), rgb565(69, 90, 100));   // Slate Gray
+constexpr ButtonStyleDef STYLE_INPUT   = gridStyle(rgb565(76, 175, 80), rgb565(56, 142, 60));    // Green
+constexpr ButtonStyleDef STYLE_OUTPUT  = gridStyle(rgb565(255, 152, 0), rgb565(245, 124, 0));    // Orange
+constexpr ButtonStyleDef STYLE_TIME    = gridStyle(rgb565(121, 85, 72), rgb565(93, 64, 55));     // Brown
+constexpr ButtonStyleDef STYLE_LOG     = gridStyle(rgb565(158, 158, 158), rgb565(120, 120, 120)); // Grey
+constexpr ButtonStyleDef STYLE_DEVICE  = gridStyle(rgb565(33, 150, 243), rgb565(25, 118, 210));  // Blue
+
+constexpr UiActionDef navigateLeft(ScreenID target) {
+    return UiActionDef{UI_ACTION_NAVIGATE, target, TRANSITION_SLIDE_LEFT};
+}
+
+// メニュー画面のボタン表（6枠 + 閉じる）
+constexpr ButtonDef MENU_BUTTONS[MenuScreen::BUTTON_COUNT] = {
+    {cellX(0), cellY(0), GRID_BUTTON_W, GRID_BUTTON_H, "待機設定", &STYLE_STANDBY, navigateLeft(SCREEN_STANDBY_SETTINGS)},
+    {cellX(1), cellY(1), GRID_BUTTON_W, GRID_BUTTON_H, "入力設定", &STYLE_INPUT, navigateLeft(SCREEN_INPUT_SETTINGS)},
+    {cellX(2), cellY(2), GRID_BUTTON_W, GRID_BUTTON_H, "出力設定", &STYLE_OUTPUT, navigateLeft(SCREEN_OUTPUT_SETTINGS)},
+    {cellX(3), cellY(3), GRID_BUTTON_W, GRID_BUTTON_H, "時間設定", &STYLE_TIME, navigateLeft(SCREEN_TIME_SETTINGS)},
+    {cellX(4), cellY(4), GRID_BUTTON_W, GRID_BUTTON_H, "ログ", &STYLE_LOG, navigateLeft(SCREEN_LOG)},
+    {cellX(5), cellY(5), GRID_BUTTON_W, GRID_BUTTON_H, "デバイス設定", &STYLE_DEVICE, navigateLeft(SCREEN_SETTINGS)},
+    // 閉じる（右上、リセットボタンと同じスタイル）
+    {UI_SCREEN_WIDTH - 70, 10, 60, 30, "閉じる", &STYLE_CLOSE, {UI_ACTION_NAVIGATE, SCREEN_HOME, TRANSITION_NONE}}
+};
+
+static_assert(cellX(1) == 170 && cellY(0) == 60 && cellY(5) == 156, "menu grid layout changed");
+} // namespace
+
 MenuScreen::MenuScreen(LGFX* display) 
     : BaseScreen(display, SCREEN_MENU),
       touchStartX(0), touchStartY(0), touchStartTime(0), isTouching(false) {
@@ -21,113 +65,12 @@ MenuScreen::MenuScreen(LGFX* display)
 }
 
 void MenuScreen::createButtons() {
-    // 2列×3行のグリッドでボタンを配置（サイズはデバイス設定と同等: 130x40）
-    const int bw = 130;
-    const int bh = 40;
-    const int screenW = tft->width();
-    const int screenH = tft->height();
-    const int cols = 2;
-    const int rows = 3;
-    const int gapX = std::max(10, (screenW - (cols * bw)) / (cols + 1));
-    const int rowGap = 8;  // 縦方向のギャップを少し狭める
-    const int totalGridH = rows * bh + (rows - 1) * rowGap;
-    const int startX = gapX;
-    const int startY = std::max(60, (screenH - totalGridH) / 2);  // 下線と干渉しないよう少し下げる
-
-    struct LabelDef { const char* text; uint16_t r,g,b; uint16_t pr,pg,pb; };
-    std::vector<LabelDef> labels = {
-        {"待機設定", 96,125,139, 69,90,100},     // Slate Gray
-        {"入力設定", 76,175,80,  56,142,60},      // Green
-        {"出力設定", 255,152,0,  245,124,0},      // Orange
-        {"時間設定", 121,85,72,  93,64,55},       // Brown
-        {"ログ",   158,158,158,120,120,120},      // Grey
-        {"デバイス設定", 33,150,243, 25,118,210}  // Blue（6枠目）
-    };
-
-    for (int i = 0; i < (int)labels.size(); ++i) {
-        int r = i / cols;
-        int c = i % cols;
-        int x = startX + c * (bw + gapX);
-        int y = startY + r * (bh + rowGap);
-
-        auto btn = std::unique_ptr<ModernButton>(new ModernButton(tft, x, y, bw, bh, labels[i].text));
-        ButtonStyle st;
-        st.normalColor  = tft->color565(labels[i].r, labels[i].g, labels[i].b);
-        st.pressedColor = tft->color565(labels[i].pr, labels[i].pg, labels[i].pb);
-        st.cornerRadius = 10;
-        st.shadowOffset = 4;
-        btn->setStyle(st);
+    // レイアウト表からボタンを生成（ヒープ確保・文字列比較なし）
+    buttons.build(tft, MENU_BUTTONS);
+}
 
-        // 各ボタンの遷移先を割り当て
-        std::string text = labels[i].text;
-        if (text == "デバイス設定") {
-            btn->setOnClick([this]() {
-                Serial.println("Device Settings button pressed");
-                Event settingsEvent;
-                settingsEvent.type = EVENT_SCREEN_CHANGE;
-                settingsEvent.data.screenChange.targetScreen = SCREEN_SETTINGS;
-                settingsEvent.data.screenChange.transition = TRANSITION_SLIDE_LEFT;
-                if (g_touchEventQueue) { g_touchEventQueue->send(settingsEvent); }
-            });
-        } else if (text == "待機設定") {
-            btn->setOnClick([this](){
-                Event e; e.type = EVENT_SCREEN_CHANGE;
-                e.data.screenChange.targetScreen = SCREEN_STANDBY_SETTINGS;
-                e.data.screenChange.transition = TRANSITION_SLIDE_LEFT;
-                if (g_touchEventQueue) g_touchEventQueue->send(e);
-            });
-        } else if (text == "入力設定") {
-            btn->setOnClick([this](){
-                Event e; e.type = EVENT_SCREEN_CHANGE;
-                e.data.screenChange.targetScreen = SCREEN_INPUT_SETTINGS;
-                e.data.screenChange.transition = TRANSITION_SLIDE_LEFT;
-                if (g_touchEventQueue) g_touchEventQueue->send(e);
-            });
-        } else if (text == "出力設定") {
-            btn->setOnClick([this](){
-                Event e; e.type = EVENT_SCREEN_CHANGE;
-                e.data.screenChange.targetScreen = SCREEN_OUTPUT_SETTINGS;
-                e.data.screenChange.transition = TRANSITION_SLIDE_LEFT;
-                if (g_touchEventQueue) g_touchEventQueue->send(e);
-            });
-        } else if (text == "時間設定") {
-            btn->setOnClick([this](){
-                Event e; e.type = EVENT_SCREEN_CHANGE;
-                e.data.screenChange.targetScreen = SCREEN_TIME_SETTINGS;
-                e.data.screenChange.transition = TRANSITION_SLIDE_LEFT;
-                if (g_touchEventQueue) g_touchEventQueue->send(e);
-            });
-        } else if (text == "ログ") {
-            btn->setOnClick([this](){
-                Event e; e.type = EVENT_SCREEN_CHANGE;
-                e.data.screenChange.targetScreen = SCREEN_LOG;
-                e.data.screenChange.transition = TRANSITION_SLIDE_LEFT;
-                if (g_touchEventQueue) g_touchEventQueue->send(e);
-            });
-        } else {
-            std::string labelStr = labels[i].text;
-            btn->setOnClick([labelStr](){ Serial.printf("%s button pressed\n", labelStr.c_str()); });
-        }
-        buttons.push_back(std::move(btn));
-    }
-    
-    // ボタン5: 閉じる（右上、リセットボタンと同じスタイル）
-    auto closeBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, tft->width() - 70, 10, 60, 30, "閉じる")
-    );
-    ButtonStyle closeStyle;
-    closeStyle.normalColor = tft->color565(244, 67, 54);     // Material Red
-    closeStyle.pressedColor = tft->color565(211, 47, 47);    // Darker Red
-    closeStyle.cornerRadius = 0;  // 角なし
-    closeStyle.shadowOffset = 3;
-    closeStyle.borderWidth = 2;
-    closeStyle.borderColor = tft->color565(183, 28, 28);     // Dark Red Border
-    closeBtn->setStyle(closeStyle);
-    closeBtn->setOnClick([this]() {
-        Serial.println("Close button pressed - returning to Home");
-        returnToHome();
-    });
-    buttons.push_back(std::move(closeBtn));
+size_t MenuScreen::getNavigationTargets(ScreenID* out, size_t maxCount) const {
+    return collectNavigationTargets(MENU_BUTTONS, out, maxCount);
 }
 
 void MenuScreen::init() {
@@ -148,7 +91,7 @@ void MenuScreen::init() {
     
     // ボタンを描画
     for (auto& button : buttons) {
-        button->draw();
+        button.draw();
     }
 }
 
@@ -165,17 +108,17 @@ void MenuScreen::update() {
 }
 
 void MenuScreen::handleEvent(const Event& event) {
-    switch (event.type) {
+    switch (event.getType()) {
         case EVENT_TOUCH_DOWN: {
             // タッチ開始位置を記録
-            touchStartX = event.data.touch.x;
-            touchStartY = event.data.touch.y;
+            touchStartX = event.touch().x;
+            touchStartY = event.touch().y;
             touchStartTime = millis();
             isTouching = true;
             
             // ボタンのタッチ処理
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button.handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         }
@@ -183,7 +126,7 @@ void MenuScreen::handleEvent(const Event& event) {
         case EVENT_TOUCH_MOVE: {
             // ボタンのタッチ移動処理
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button.handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         }
@@ -192,14 +135,14 @@ void MenuScreen::handleEvent(const Event& event) {
             // ボタンのタッチ終了処理
             bool buttonHandled = false;
             for (auto& button : buttons) {
-                if (button->handleTouch(event.data.touch.x, event.data.touch.y, false)) {
+                if (button.handleTouch(event.touch().x, event.touch().y, false)) {
                     buttonHandled = true;
                 }
             }
             
             // ボタンが処理しなかった場合、スワイプジェスチャーを検出
             if (isTouching && !buttonHandled) {
-                detectSwipeGesture(event.data.touch.x, event.data.touch.y);
+                detectSwipeGesture(event.touch().x, event.touch().y);
             }
             isTouching = false;
             break;
@@ -207,7 +150,7 @@ void MenuScreen::handleEvent(const Event& event) {
             
         case EVENT_GESTURE_SWIPE: {
             // TouchManagerからのジェスチャーイベント
-            switch (event.data.gesture.direction) {
+            switch (event.gestureDirection()) {
                 case GestureEvent::GESTURE_UP:
                     onSwipeUp();
                     break;
@@ -289,13 +232,10 @@ void MenuScreen::detectSwipeGesture(int32_t endX, int32_t endY) {
 
 void MenuScreen::returnToHome() {
     // ホーム画面に戻るイベントを送信
-    Event returnEvent;
-    returnEvent.type = EVENT_SCREEN_CHANGE;
-    returnEvent.data.screenChange.targetScreen = SCREEN_HOME;
-    returnEvent.data.screenChange.transition = TRANSITION_NONE;
+    Event returnEvent = makeScreenChangeEvent(SCREEN_BACK, TRANSITION_NONE);
     
     // イベントキューに送信
-    if (g_touchEventQueue) {
-        g_touchEventQueue->send(returnEvent);
+    if (g_eventBus) {
+        g_eventBus->publish(returnEvent);
     }
 }
\ No newline at end of file
@@ -2,13 +2,13 @@
 #define MENU_SCREEN_H
 
 #include "BaseScreen.h"
-#include <memory>
-#include <vector>
-
-// 前方宣言
-class ModernButton;
+#include "../ui/layout/ButtonSet.h"
 
 class MenuScreen : public BaseScreen {
+public:
+    // レイアウト表のボタン数（6枠 + 閉じる）
+    static constexpr size_t BUTTON_COUNT = 7;
+    
 private:
     // タッチ開始位置（スワイプ検出用）
     int32_t touchStartX;
@@ -17,7 +17,7 @@ private:
     bool isTouching;
     
     // UIコンポーネント
-    std::vector<std::unique_ptr<ModernButton>> buttons;
+    ButtonSet<BUTTON_COUNT> buttons;
     
 public:
     MenuScreen(LGFX* display);
@@ -32,6 +32,9 @@ public:
     void onEnter() override;
     void onExit() override;
     
+    // ボタン表の行き先
+    size_t getNavigationTargets(ScreenID* out, size_t maxCount) const override;
+    
     // 全方向のスワイプでホームに戻る
     void onSwipeUp() override;
     void onSwipeDown() override;
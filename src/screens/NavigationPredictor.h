@@ -0,0 +1,104 @@
+#ifndef NAVIGATION_PREDICTOR_H
+#define NAVIGATION_PREDICTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include "BaseScreen.h"
+
+// 先読みする遷移先の候補数
+#ifndef NAV_PREDICT_CANDIDATES
+#define NAV_PREDICT_CANDIDATES 2
+#endif
+
+// 画面遷移の予測
+// 画面が持つ遷移先（ボタン表の行き先など）を重み1の辺として登録し、
+// 実際の遷移を観測するたびにその辺の重みを増やす。
+// 重みが飽和しそうになったら遷移元の行を半分にして、最近の傾向を優先する。
+class NavigationPredictor {
+public:
+    static const uint16_t EDGE_WEIGHT = 1;      // 登録した辺の初期値
+    static const uint16_t VISIT_WEIGHT = 4;     // 観測1回あたりの加算
+    static const uint16_t WEIGHT_LIMIT = 0xF000;
+
+private:
+    uint16_t weights[SCREEN_COUNT][SCREEN_COUNT];
+    uint32_t observedCount;
+
+    static bool isValid(ScreenID id) {
+        return id >= 0 && id < SCREEN_COUNT;
+    }
+
+public:
+    NavigationPredictor() : observedCount(0) {
+        for (size_t from = 0; from < SCREEN_COUNT; from++) {
+            for (size_t to = 0; to < SCREEN_COUNT; to++) {
+                weights[from][to] = 0;
+            }
+        }
+    }
+
+    // 遷移先の候補を登録（観測済みの辺はそのまま）
+    void addEdge(ScreenID from, ScreenID to) {
+        if (!isValid(from) || !isValid(to) || from == to) {
+            return;
+        }
+        if (weights[from][to] == 0) {
+            weights[from][to] = EDGE_WEIGHT;
+        }
+    }
+
+    // 実際の遷移を記録
+    void record(ScreenID from, ScreenID to) {
+        if (!isValid(from) || !isValid(to) || from == to) {
+            return;
+        }
+        uint16_t* row = weights[from];
+        if (row[to] >= WEIGHT_LIMIT - VISIT_WEIGHT) {
+            for (size_t i = 0; i < SCREEN_COUNT; i++) {
+                row[i] /= 2;
+            }
+        }
+        row[to] += VISIT_WEIGHT;
+        observedCount++;
+    }
+
+    // 重みの大きい順に最大maxCount件の遷移先を返す（同じ重みならID順）
+    size_t predict(ScreenID from, ScreenID* out, size_t maxCount) const {
+        if (!isValid(from)) {
+            return 0;
+        }
+        // 挿入ソートが読む枠を先に埋めておく（未使用の枠は返さない）
+        for (size_t i = 0; i < maxCount; i++) {
+            out[i] = from;
+        }
+        size_t count = 0;
+        const uint16_t* row = weights[from];
+        for (size_t to = 0; to < SCREEN_COUNT; to++) {
+            if (row[to] == 0) {
+                continue;
+            }
+            // 挿入ソート（候補数は数件なので十分）
+            size_t pos = count < maxCount ? count : maxCount;
+            while (pos > 0 && row[out[pos - 1]] < row[to]) {
+                if (pos < maxCount) {
+                    out[pos] = out[pos - 1];
+                }
+                pos--;
+            }
+            if (pos < maxCount) {
+                out[pos] = static_cast<ScreenID>(to);
+                if (count < maxCount) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    uint16_t getWeight(ScreenID from, ScreenID to) const {
+        return isValid(from) && isValid(to) ? weights[from][to] : 0;
+    }
+    uint32_t getObservedCount() const { return observedCount; }
+};
+
+#endif // NAVIGATION_PREDICTOR_H
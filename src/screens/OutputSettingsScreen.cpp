@@ -3,35 +3,193 @@
 #include "OutputSettingsScreen.h"
 #include <Arduino.h>
 #include "../ui/components/ModernButton.h"
-#include "../shared/EventQueue.h"
-#include <memory>
-#include <vector>
+#include "../ui/layout/LayoutTable.h"
+#include "../audio/AudioPlayer.h"
+#include "../audio/SfxMixer.h"
 
-// グローバルイベントキュー（外部で定義）
-extern EventQueue* g_touchEventQueue;
+namespace {
+// テスト再生する場所（入力設定で数えたフォルダの先頭の曲）
+const char* const TEST_PLAYBACK_PATH = "/sound";
+
+constexpr ButtonStyleDef STYLE_PLAY = {
+    rgb565(255, 152, 0), rgb565(245, 124, 0), 8, 3, 0, 0xFFFF       // Orange（メニューと同じ色）
+};
+
+constexpr ButtonStyleDef STYLE_STEP = {
+    rgb565(96, 125, 139), rgb565(69, 90, 100), 5, 2, 0, 0xFFFF      // Blue Grey
+};
+
+// 設定の行（上から音量・低音・中音・高音・リミッター）
+enum ControlParam : uint8_t {
+    PARAM_VOLUME = 0,
+    PARAM_EQ_FIRST,
+    PARAM_LIMITER = PARAM_EQ_FIRST + DSP_EQ_BANDS,
+    PARAM_COUNT
+};
+
+constexpr int16_t CONTROL_TOP = 82;
+constexpr int16_t CONTROL_PITCH = 30;
+constexpr uint16_t CONTROL_HEIGHT = 28;
+constexpr int16_t VALUE_X = 196;
+constexpr uint16_t VALUE_WIDTH = 64;
+constexpr int8_t STEP_DB = 2;
+
+constexpr int16_t rowY(int row) { return CONTROL_TOP + row * CONTROL_PITCH; }
+
+constexpr ButtonDef stepButton(int row, bool up) {
+    return {static_cast<int16_t>(up ? 262 : 150), rowY(row), 44, CONTROL_HEIGHT, up ? "+" : "-", &STYLE_STEP,
+            {UI_ACTION_NONE, SCREEN_BACK, TRANSITION_NONE}};
+}
+
+// 出力設定画面のボタン表（押下時の処理は画面側で設定）
+constexpr ButtonDef OUTPUT_SETTINGS_BUTTONS[OutputSettingsScreen::BUTTON_COUNT] = {
+    BACK_TO_MENU_BUTTON,
+    {150, 10, 90, 30, "テスト再生", &STYLE_PLAY, {UI_ACTION_NONE, SCREEN_BACK, TRANSITION_NONE}},
+    stepButton(PARAM_VOLUME, false), stepButton(PARAM_VOLUME, true),
+    stepButton(PARAM_EQ_FIRST, false), stepButton(PARAM_EQ_FIRST, true),
+    stepButton(PARAM_EQ_FIRST + 1, false), stepButton(PARAM_EQ_FIRST + 1, true),
+    stepButton(PARAM_EQ_FIRST + 2, false), stepButton(PARAM_EQ_FIRST + 2, true),
+    {150, rowY(PARAM_LIMITER), 44, CONTROL_HEIGHT, "切替", &STYLE_STEP, {UI_ACTION_NONE, SCREEN_BACK, TRANSITION_NONE}}
+};
+
+// ボタン表と同じ並びの操作（最初の2個は戻る・テスト再生）
+struct ControlDef {
+    uint8_t param;
+    int8_t delta;
+};
+
+constexpr size_t FIRST_CONTROL_BUTTON = 2;
+constexpr ControlDef CONTROLS[OutputSettingsScreen::BUTTON_COUNT - FIRST_CONTROL_BUTTON] = {
+    {PARAM_VOLUME, -STEP_DB}, {PARAM_VOLUME, STEP_DB},
+    {PARAM_EQ_FIRST, -STEP_DB}, {PARAM_EQ_FIRST, STEP_DB},
+    {PARAM_EQ_FIRST + 1, -STEP_DB}, {PARAM_EQ_FIRST + 1, STEP_DB},
+    {PARAM_EQ_FIRST + 2, -STEP_DB}, {PARAM_EQ_FIRST + 2, STEP_DB},
+    {PARAM_LIMITER, 0}
+};
+
+const char* const CONTROL_LABELS[PARAM_COUNT] = {"音量", "低音", "中音", "高音", "リミッター"};
+
+int8_t clampDb(int value, int low, int high) {
+    return static_cast<int8_t>(value < low ? low : (value > high ? high : value));
+}
+} // namespace
 
 OutputSettingsScreen::OutputSettingsScreen(LGFX* display)
     : BaseScreen(display, SCREEN_OUTPUT_SETTINGS) {}
 
 void OutputSettingsScreen::createButtons() {
     buttons.clear();
-    auto backBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, tft->width() - 70, 10, 60, 30, "戻る")
-    );
-    ButtonStyle backStyle;
-    backStyle.normalColor = tft->color565(96, 125, 139);    // Blue Grey
-    backStyle.pressedColor = tft->color565(69, 90, 100);
-    backStyle.cornerRadius = 5;
-    backStyle.shadowOffset = 2;
-    backBtn->setStyle(backStyle);
-    backBtn->setOnClick([this]() {
-        Event e;
-        e.type = EVENT_SCREEN_CHANGE;
-        e.data.screenChange.targetScreen = SCREEN_MENU;
-        e.data.screenChange.transition = TRANSITION_SLIDE_RIGHT;
-        if (g_touchEventQueue) g_touchEventQueue->send(e);
-    });
-    buttons.push_back(std::move(backBtn));
+    buttonPool.releaseAll();
+    for (const ButtonDef& def : OUTPUT_SETTINGS_BUTTONS) {
+        buttons.push_back(acquireButton(buttonPool, tft, def));
+    }
+    playButton = buttons.size() > 1 ? buttons[1] : nullptr;
+    if (playButton) {
+        playButton->setOnClick([this]() {
+            togglePlayback();
+        });
+    }
+    for (size_t i = FIRST_CONTROL_BUTTON; i < buttons.size(); i++) {
+        buttons[i]->setOnClick([this, i]() {
+            applyControl(i);
+        });
+    }
+}
+
+void OutputSettingsScreen::applyControl(size_t buttonIndex) {
+    if (!g_audioPlayer || buttonIndex < FIRST_CONTROL_BUTTON) {
+        return;
+    }
+    const ControlDef& control = CONTROLS[buttonIndex - FIRST_CONTROL_BUTTON];
+    DspSettings settings = g_audioPlayer->getDspSettings();
+    if (control.param == PARAM_VOLUME) {
+        settings.volumeDb = clampDb(settings.volumeDb + control.delta, DSP_VOLUME_MIN_DB, 0);
+    } else if (control.param == PARAM_LIMITER) {
+        settings.limiter = !settings.limiter;
+    } else {
+        int8_t& eq = settings.eqDb[control.param - PARAM_EQ_FIRST];
+        eq = clampDb(eq + control.delta, -DSP_EQ_RANGE_DB, DSP_EQ_RANGE_DB);
+    }
+    // 係数は復号タスクが作るので、ここでは値を置くだけ
+    g_audioPlayer->setDspSettings(settings);
+    controlsDirty = true;
+    markContentChanged();
+}
+
+void OutputSettingsScreen::togglePlayback() {
+    if (!g_audioPlayer) {
+        return;
+    }
+    if (g_audioPlayer->isPlaying()) {
+        g_audioPlayer->stop();
+    } else if (!g_audioPlayer->play(TEST_PLAYBACK_PATH)) {
+        g_sfxMixer.trigger(SFX_ERROR);
+    }
+    statusDirty = true;
+}
+
+bool OutputSettingsScreen::isSnapshotStable() const {
+    return !g_audioPlayer || !g_audioPlayer->isPlaying();
+}
+
+void OutputSettingsScreen::drawStatus() {
+    tft->fillRect(0, 52, tft->width(), 24, TFT_BLACK);
+    tft->setFont(&fonts::lgfxJapanGothic_12);
+    tft->setCursor(10, 60);
+    if (!g_audioPlayer) {
+        tft->println("再生エンジンがありません");
+    } else {
+        static const char* const STATE_LABELS[] = {"停止中", "再生中", "再生終了", "再生できません"};
+        uint8_t stateIndex = static_cast<uint8_t>(g_audioPlayer->getState());
+        char buf[80];
+        int len = snprintf(buf, sizeof(buf), "%s  途切れ: %lu回", STATE_LABELS[stateIndex & 0x03],
+                           (unsigned long)(g_audioPlayer->getInputUnderruns() + g_audioPlayer->getOutputUnderruns()));
+        if (shownLimiterDb < 0 && len > 0 && len < static_cast<int>(sizeof(buf))) {
+            snprintf(buf + len, sizeof(buf) - len, "  制限: %lddB", (long)shownLimiterDb);
+        }
+        tft->println(buf);
+    }
+    tft->setFont(nullptr);
+    statusDirty = false;
+}
+
+void OutputSettingsScreen::drawControls() {
+    DspSettings settings = g_audioPlayer ? g_audioPlayer->getDspSettings() : DspChain::defaultSettings();
+    tft->setFont(&fonts::lgfxJapanGothic_12);
+    for (int row = 0; row < PARAM_COUNT; row++) {
+        int16_t y = rowY(row);
+        char buf[24];
+        tft->fillRect(10, y, 138, CONTROL_HEIGHT, TFT_BLACK);
+        tft->setCursor(10, y + 8);
+        if (row >= PARAM_EQ_FIRST && row < PARAM_LIMITER) {
+            uint32_t hz = DspChain::bandFrequency(row - PARAM_EQ_FIRST);
+            if (hz >= 1000) {
+                snprintf(buf, sizeof(buf), "%s %lukHz", CONTROL_LABELS[row], (unsigned long)(hz / 1000));
+            } else {
+                snprintf(buf, sizeof(buf), "%s %luHz", CONTROL_LABELS[row], (unsigned long)hz);
+            }
+            tft->print(buf);
+        } else {
+            tft->print(CONTROL_LABELS[row]);
+        }
+
+        if (row == PARAM_VOLUME) {
+            if (settings.volumeDb <= DSP_VOLUME_MIN_DB) {
+                snprintf(buf, sizeof(buf), "消音");
+            } else {
+                snprintf(buf, sizeof(buf), "%ddB", settings.volumeDb);
+            }
+        } else if (row == PARAM_LIMITER) {
+            snprintf(buf, sizeof(buf), "%s", settings.limiter ? "入" : "切");
+        } else {
+            snprintf(buf, sizeof(buf), "%+ddB", settings.eqDb[row - PARAM_EQ_FIRST]);
+        }
+        tft->fillRect(VALUE_X, y, VALUE_WIDTH, CONTROL_HEIGHT, TFT_BLACK);
+        tft->setCursor(VALUE_X + 4, y + 8);
+        tft->print(buf);
+    }
+    tft->setFont(nullptr);
+    controlsDirty = false;
 }
 
 void OutputSettingsScreen::init() {
@@ -40,7 +198,8 @@ void OutputSettingsScreen::init() {
     tft->setFont(&fonts::lgfxJapanGothic_16);
     tft->setCursor(10, 20);
     tft->println("出力設定");
-    tft->setFont(nullptr);
+    drawStatus();
+    drawControls();
     // ボタン描画
     for (auto& button : buttons) {
         button->draw();
@@ -49,22 +208,41 @@ void OutputSettingsScreen::init() {
 
 void OutputSettingsScreen::draw() {
     if (needsRedraw) { init(); needsRedraw = false; }
+    else {
+        if (statusDirty) { drawStatus(); }
+        if (controlsDirty) { drawControls(); }
+    }
 }
 
 void OutputSettingsScreen::update() {
+    if (!g_audioPlayer) {
+        return;
+    }
+    // 状態と途切れ回数は再生タスクが更新するので毎フレーム見比べる
+    uint8_t state = static_cast<uint8_t>(g_audioPlayer->getState());
+    uint32_t underruns = g_audioPlayer->getInputUnderruns() + g_audioPlayer->getOutputUnderruns();
+    // リミッターの利得は1dB単位の変化だけ表示に反映する
+    int32_t limiterDb = g_audioPlayer->isPlaying() ? g_audioPlayer->getDsp().getLimiterGainDeciDb() / 10 : 0;
+    if (state != shownState || underruns != shownUnderruns || limiterDb != shownLimiterDb) {
+        shownState = state;
+        shownUnderruns = underruns;
+        shownLimiterDb = limiterDb;
+        statusDirty = true;
+        markContentChanged();
+    }
 }
 
 void OutputSettingsScreen::handleEvent(const Event& event) {
-    switch (event.type) {
+    switch (event.getType()) {
         case EVENT_TOUCH_DOWN:
         case EVENT_TOUCH_MOVE:
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button->handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         case EVENT_TOUCH_UP: {
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, false);
+                button->handleTouch(event.touch().x, event.touch().y, false);
             }
             break;
         }
@@ -73,12 +251,28 @@ void OutputSettingsScreen::handleEvent(const Event& event) {
     }
 }
 
+void OutputSettingsScreen::prepare() {
+    if (buttons.empty()) {
+        createButtons();
+    }
+}
+
 void OutputSettingsScreen::onEnter() {
-    createButtons();
+    prepare();
+    // 設定は再生エンジンが持っているので、画面に戻ると前回の値が出る
+    controlsDirty = false;
     needsRedraw = true;
 }
 
 void OutputSettingsScreen::onExit() {
+    // テスト再生は画面を離れたら止める
+    if (g_audioPlayer && g_audioPlayer->isPlaying()) {
+        g_audioPlayer->stop();
+    }
+    // ボタンはプールに返却（破棄せず次回の訪問で再利用）
+    playButton = nullptr;
+    buttons.clear();
+    buttonPool.releaseAll();
 }
 
 
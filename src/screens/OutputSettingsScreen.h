@@ -2,24 +2,44 @@
 #define OUTPUT_SETTINGS_SCREEN_H
 
 #include "BaseScreen.h"
-#include <memory>
-#include <vector>
+#include "../ui/components/WidgetList.h"
+#include "../ui/layout/ButtonPool.h"
 // 前方宣言
 class ModernButton;
 
 class OutputSettingsScreen : public BaseScreen {
+public:
+    // レイアウト表のボタン数（戻る + テスト再生 + 音量・EQ3帯域の-/+ + リミッター）
+    static constexpr size_t BUTTON_COUNT = 11;
+
 private:
-    std::vector<std::unique_ptr<ModernButton>> buttons;
+    ButtonPool<BUTTON_COUNT> buttonPool;  // 訪問をまたいで再利用
+    WidgetList<ModernButton, BUTTON_COUNT> buttons;
+    ModernButton* playButton = nullptr;
+
+    // 表示中の再生状態（変わったときだけ状態行を描き直す）
+    uint8_t shownState = 0xFF;
+    uint32_t shownUnderruns = 0;
+    int32_t shownLimiterDb = 0;
+    bool statusDirty = false;
+    bool controlsDirty = false;
 public:
     OutputSettingsScreen(LGFX* display);
     void init() override;
     void draw() override;
     void update() override;
     void handleEvent(const Event& event) override;
+    void prepare() override;
     void onEnter() override;
     void onExit() override;
+    // 再生中は状態行が変わるので撮影しない
+    bool isSnapshotStable() const override;
 private:
     void createButtons();
+    void togglePlayback();
+    void applyControl(size_t buttonIndex);
+    void drawStatus();
+    void drawControls();
 };
 
 #endif // OUTPUT_SETTINGS_SCREEN_H
@@ -10,51 +10,298 @@
 #include "OutputSettingsScreen.h"
 #include "TimeSettingsScreen.h"
 #include "LogScreen.h"
+#include "FileBrowserScreen.h"
+#include "../shared/HeapMonitor.h"
+#include "../shared/EventBus.h"
+#include "../audio/SfxMixer.h"
+#include "../shared/LogBuffer.h"
 #include <Arduino.h>
+#include <new>
+
+namespace {
+template <typename T>
+BaseScreen* makeScreen(LGFX* display) {
+    return new T(display);
+}
+
+struct ScreenRegistryEntry {
+    ScreenFactory factory;
+    size_t objectSize;      // 画面オブジェクト本体のサイズ（起動時に節約される最小量）
+};
+
+// ScreenIDの順に並べた画面生成表
+const ScreenRegistryEntry SCREEN_REGISTRY[SCREEN_COUNT] = {
+    {&makeScreen<HomeScreen>, sizeof(HomeScreen)},
+    {&makeScreen<MenuScreen>, sizeof(MenuScreen)},
+    {&makeScreen<SettingsScreen>, sizeof(SettingsScreen)},
+    {&makeScreen<InfoScreen>, sizeof(InfoScreen)},
+    {&makeScreen<StandbySettingsScreen>, sizeof(StandbySettingsScreen)},
+    {&makeScreen<InputSettingsScreen>, sizeof(InputSettingsScreen)},
+    {&makeScreen<OutputSettingsScreen>, sizeof(OutputSettingsScreen)},
+    {&makeScreen<TimeSettingsScreen>, sizeof(TimeSettingsScreen)},
+    {&makeScreen<LogScreen>, sizeof(LogScreen)},
+    {&makeScreen<FileBrowserScreen>, sizeof(FileBrowserScreen)}
+};
+} // namespace
 
 ScreenManager::ScreenManager(LGFX* display) 
-    : tft(display), currentScreen(nullptr), isTransitioning(false) {
+    : tft(display), currentScreen(nullptr), useCounter(0),
+      heapBudget(SCREEN_CACHE_HEAP_BUDGET), isTransitioning(false),
+      fadeBaseBrightness(0), reportedTransitions(0),
+      navDepth(0), retainBudget(NAV_RETAIN_HEAP_BUDGET), resumeCount(0), rebuildCount(0),
+      snapshotSavedUs(0), settleFrames(0), touchHeld(false), touchSwallowed(false), prewarmCount(0), prewarmHits(0),
+      inputHead(0), inputCount(0), inputDropped(0) {
+    for (int i = 0; i < SCREEN_COUNT; ++i) {
+        factories[i] = SCREEN_REGISTRY[i].factory;
+        lastUsed[i] = 0;
+        heapCost[i] = 0;
+        snapshotVersion[i] = 0;
+        fullDrawUs[i] = 0;
+        snapshotRejected[i] = false;
+        prepared[i] = false;
+    }
 }
 
 ScreenManager::~ScreenManager() {
+    if (g_eventBus) {
+        g_eventBus->unsubscribe(this);
+    }
     // unique_ptrが自動的にメモリを解放
 }
 
 void ScreenManager::init() {
-    // 画面を登録
-    registerScreen(SCREEN_HOME, std::unique_ptr<BaseScreen>(new HomeScreen(tft)));
-    registerScreen(SCREEN_MENU, std::unique_ptr<BaseScreen>(new MenuScreen(tft)));
-    registerScreen(SCREEN_SETTINGS, std::unique_ptr<BaseScreen>(new SettingsScreen(tft)));
-    registerScreen(SCREEN_INFO, std::unique_ptr<BaseScreen>(new InfoScreen(tft)));
-    registerScreen(SCREEN_STANDBY_SETTINGS, std::unique_ptr<BaseScreen>(new StandbySettingsScreen(tft)));
-    registerScreen(SCREEN_INPUT_SETTINGS, std::unique_ptr<BaseScreen>(new InputSettingsScreen(tft)));
-    registerScreen(SCREEN_OUTPUT_SETTINGS, std::unique_ptr<BaseScreen>(new OutputSettingsScreen(tft)));
-    registerScreen(SCREEN_TIME_SETTINGS, std::unique_ptr<BaseScreen>(new TimeSettingsScreen(tft)));
-    registerScreen(SCREEN_LOG, std::unique_ptr<BaseScreen>(new LogScreen(tft)));
-    
-    // ホーム画面から開始
+    // 設定画面は遅延生成されるため、起動時の明るさはここで適用
+    tft->setBrightness(SettingsScreen::DEFAULT_BRIGHTNESS * 255 / 100);
+    
+    // スナップショットの撮影・復元用の作業領域（確保できなければキャッシュは使わない）
+    snapshotStrip.reset(new (std::nothrow) uint16_t[tft->width() * SNAPSHOT_STRIP_ROWS]);
+    
+    // 画面遷移要求と入力イベントを購読（入力は現在の画面だけに渡す）
+    if (g_eventBus) {
+        g_eventBus->subscribe(TOPIC_NAVIGATION, this, [this](const Event& event) { onNavigationEvent(event); });
+        g_eventBus->subscribe(TOPIC_TOUCH, this, [this](const Event& event) { forwardToScreen(event); });
+        g_eventBus->subscribe(TOPIC_GESTURE, this, [this](const Event& event) { forwardToScreen(event); });
+        g_eventBus->subscribe(TOPIC_SYSTEM, this, [this](const Event& event) { forwardToScreen(event); });
+    }
+    
+    // ホーム画面から開始（他の画面は初回遷移時に生成）
     transitionTo(SCREEN_HOME);
+    
+    int deferredCount = 0;
+    size_t deferredBytes = 0;
+    for (int i = 0; i < SCREEN_COUNT; ++i) {
+        if (!screens[i]) {
+            deferredCount++;
+            deferredBytes += SCREEN_REGISTRY[i].objectSize;
+        }
+    }
+    logInfo("ScreenManager: %d screens deferred, >= %u bytes saved at boot (free heap %u)",
+            deferredCount, (unsigned)deferredBytes, (unsigned)ESP.getFreeHeap());
+}
+
+void ScreenManager::registerFactory(ScreenID id, ScreenFactory factory) {
+    if (id < 0 || id >= SCREEN_COUNT) {
+        return;
+    }
+    if (screens[id] && screens[id].get() != currentScreen) {
+        screens[id].reset();
+        heapCost[id] = 0;
+        snapshots.invalidate(id);
+        
+        // スタック上にあれば戻ったときに作り直す
+        int index = findInStack(id);
+        if (index >= 0) {
+            navStack[index].retained = false;
+        }
+    }
+    factories[id] = factory;
+}
+
+void ScreenManager::setHeapBudget(size_t bytes) {
+    heapBudget = bytes;
+    if (currentScreen) {
+        enforceHeapBudget(currentScreen->getId());
+    }
+}
+
+size_t ScreenManager::getResidentHeap() const {
+    size_t total = 0;
+    for (int i = 0; i < SCREEN_COUNT; ++i) {
+        if (screens[i]) {
+            total += heapCost[i];
+        }
+    }
+    return total;
+}
+
+BaseScreen* ScreenManager::obtainScreen(ScreenID id) {
+    if (id < 0 || id >= SCREEN_COUNT) {
+        return nullptr;
+    }
+    if (!screens[id]) {
+        if (!factories[id]) {
+            return nullptr;
+        }
+        
+        // 生成コスト（時間とヒープ消費）を計測
+        uint32_t heapBefore = ESP.getFreeHeap();
+        uint32_t startUs = micros();
+        screens[id].reset(factories[id](tft));
+        uint32_t elapsedUs = micros() - startUs;
+        uint32_t heapAfter = ESP.getFreeHeap();
+        heapCost[id] = heapBefore > heapAfter ? heapBefore - heapAfter : 0;
+        
+        logInfo("Screen %d constructed: %lu us, %lu bytes",
+                id, (unsigned long)elapsedUs, (unsigned long)heapCost[id]);
+        
+        // 画面が知っている遷移先を予測の候補に加える
+        ScreenID targets[SCREEN_COUNT];
+        size_t count = screens[id]->getNavigationTargets(targets, SCREEN_COUNT);
+        for (size_t i = 0; i < count; ++i) {
+            predictor.addEdge(id, targets[i]);
+        }
+    }
+    lastUsed[id] = ++useCounter;
+    return screens[id].get();
+}
+
+void ScreenManager::enforceHeapBudget(ScreenID keepId) {
+    if (heapBudget == 0) {
+        return;
+    }
+    
+    size_t resident = getResidentHeap();
+    while (resident > heapBudget) {
+        // 現在の画面・遷移先・退避不可の画面を除いて最も古いものを選ぶ
+        int victim = -1;
+        for (int i = 0; i < SCREEN_COUNT; ++i) {
+            BaseScreen* screen = screens[i].get();
+            if (!screen || i == keepId || screen == currentScreen || !screen->isEvictable() ||
+                isRetained(static_cast<ScreenID>(i))) {
+                continue;
+            }
+            if (victim < 0 || lastUsed[i] < lastUsed[victim]) {
+                victim = i;
+            }
+        }
+        if (victim < 0) {
+            break;
+        }
+        
+        logInfo("Screen %d evicted (%lu bytes)", victim, (unsigned long)heapCost[victim]);
+        resident -= heapCost[victim];
+        screens[victim].reset();
+        snapshots.invalidate(victim);
+        heapCost[victim] = 0;
+        prepared[victim] = false;
+    }
+}
+
+void ScreenManager::setRetainBudget(size_t bytes) {
+    retainBudget = bytes;
+    enforceRetainBudget();
+}
+
+size_t ScreenManager::getRetainedHeap() const {
+    size_t total = 0;
+    for (size_t i = 0; i < navDepth; ++i) {
+        if (navStack[i].retained) {
+            total += heapCost[navStack[i].id];
+        }
+    }
+    return total;
+}
+
+int ScreenManager::findInStack(ScreenID id) const {
+    for (size_t i = 0; i < navDepth; ++i) {
+        if (navStack[i].id == id) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
 }
 
-void ScreenManager::registerScreen(ScreenID id, std::unique_ptr<BaseScreen> screen) {
-    screens[id] = std::move(screen);
+bool ScreenManager::isRetained(ScreenID id) const {
+    int index = findInStack(id);
+    return index >= 0 && navStack[index].retained;
+}
+
+void ScreenManager::releaseEntry(NavEntry& entry) {
+    if (!entry.retained) {
+        return;
+    }
+    entry.retained = false;
+    snapshots.invalidate(entry.id);
+    BaseScreen* screen = screens[entry.id].get();
+    if (screen && screen != currentScreen) {
+        screen->onExit();
+    }
+}
+
+void ScreenManager::pushCurrent() {
+    if (!currentScreen) {
+        return;
+    }
+    if (navDepth == NAV_STACK_DEPTH) {
+        // 満杯なら最も古い段を忘れる
+        releaseEntry(navStack[0]);
+        for (size_t i = 1; i < navDepth; ++i) {
+            navStack[i - 1] = navStack[i];
+        }
+        navDepth--;
+    }
+    navStack[navDepth].id = currentScreen->getId();
+    navStack[navDepth].retained = true;
+    navDepth++;
+    currentScreen->onPause();
+}
+
+bool ScreenManager::unwindTo(size_t index) {
+    while (navDepth > index + 1) {
+        releaseEntry(navStack[--navDepth]);
+    }
+    navDepth = index;
+    return navStack[index].retained;
+}
+
+void ScreenManager::enforceRetainBudget() {
+    if (retainBudget == 0) {
+        return;
+    }
+    
+    // 予算を超えていれば古い段から状態を手放す（戻ったときに作り直す）
+    size_t retained = getRetainedHeap();
+    for (size_t i = 0; i < navDepth && retained > retainBudget; ++i) {
+        if (navStack[i].retained) {
+            retained -= heapCost[navStack[i].id];
+            releaseEntry(navStack[i]);
+            logInfo("Screen %d state released from stack", navStack[i].id);
+        }
+    }
+}
+
+void ScreenManager::requestTransition(ScreenID screenId, TransitionType transition) {
+    // 待ちのない状態で現在の画面への遷移は無視
+    if (!transitions.isBusy() && currentScreen && currentScreen->getId() == screenId) {
+        return;
+    }
+    transitions.request(screenId, transition, millis());
 }
 
 bool ScreenManager::transitionTo(ScreenID screenId, TransitionType transition) {
     if (isTransitioning) {
-        return false;  // 遷移中は新しい遷移を受け付けない
+        // onEnter/onExitなどから呼ばれた場合は捨てずに次のフレームで処理
+        requestTransition(screenId, transition);
+        return true;
     }
     
-    auto it = screens.find(screenId);
-    if (it == screens.end()) {
-        Serial.printf("Screen %d not found\n", screenId);
-        return false;
+    // 戻り先を解決（スタックが空ならホーム）
+    if (screenId == SCREEN_BACK) {
+        screenId = navDepth > 0 ? navStack[navDepth - 1].id : SCREEN_HOME;
     }
     
-    BaseScreen* nextScreen = it->second.get();
-    
     // 同じ画面への遷移はスキップ
-    if (currentScreen == nextScreen) {
+    if (currentScreen && currentScreen->getId() == screenId) {
         return false;
     }
     
@@ -63,22 +310,93 @@ bool ScreenManager::transitionTo(ScreenID screenId, TransitionType transition) {
         return false;
     }
     
+    uint32_t startUs = micros();
+    BaseScreen* nextScreen = obtainScreen(screenId);
+    if (!nextScreen) {
+        logWarn("Screen %d not found", screenId);
+        return false;
+    }
+    
     isTransitioning = true;
     
-    // 画面遷移を実行
-    performTransition(currentScreen, nextScreen, transition);
+    // スタック上の画面ならそこまで戻る。ホームはスタックの根なので、
+    // スタックになければ全段を捨てる。それ以外は現在の画面を積んで進む
+    int stackIndex = findInStack(screenId);
+    bool forward = stackIndex < 0 && screenId != SCREEN_HOME;
+    bool resumed = false;
+    if (stackIndex >= 0) {
+        resumed = unwindTo(static_cast<size_t>(stackIndex));
+    } else if (!forward) {
+        while (navDepth > 0) {
+            releaseEntry(navStack[--navDepth]);
+        }
+    }
+    
+    // 画面遷移を実行。保持していた画面はスナップショットを転送し、
+    // なければウィジェットを作り直さずに描画だけ行う
+    uint32_t drawStartUs = micros();
+    bool restored = resumed && restoreSnapshot(screenId);
+    if (!restored) {
+        performTransition(currentScreen, nextScreen, transition);
+    }
+    uint32_t drawUs = micros() - drawStartUs;
+    uint32_t savedUs = 0;
+    if (restored) {
+        savedUs = fullDrawUs[screenId] > drawUs ? fullDrawUs[screenId] - drawUs : 0;
+        snapshotSavedUs += savedUs;
+    } else {
+        fullDrawUs[screenId] = drawUs;
+    }
     
     // 現在の画面を更新
     if (currentScreen) {
-        currentScreen->onExit();
+        ScreenID leavingId = currentScreen->getId();
+        if (snapshots.isCapturing() && snapshots.getCaptureKey() == leavingId) {
+            snapshots.abortCapture();
+        }
+        if (forward) {
+            pushCurrent();
+        } else {
+            currentScreen->onExit();
+            snapshots.invalidate(leavingId);
+        }
     }
+    settleFrames = 0;
     
+    if (currentScreen) {
+        predictor.record(currentScreen->getId(), screenId);
+    }
     currentScreen = nextScreen;
-    currentScreen->onEnter();
+    bool wasPrepared = prepared[screenId];
+    if (wasPrepared) {
+        prepared[screenId] = false;
+        prewarmHits++;
+    }
+    if (resumed) {
+        currentScreen->onResume();
+        resumeCount++;
+    } else {
+        currentScreen->onEnter();
+        rebuildCount++;
+    }
     
     isTransitioning = false;
     
-    Serial.printf("Transitioned to screen %d\n", screenId);
+    // 遷移完了後に予算を超えていれば保持していた状態や古い画面を破棄
+    enforceRetainBudget();
+    enforceHeapBudget(screenId);
+    g_heapMonitor.sample();
+    
+    logInfo("Transitioned to screen %d (%lu us, %s%s, stack %u, resumed %lu/%lu)",
+            screenId, (unsigned long)(micros() - startUs), resumed ? "resumed" : "entered",
+            wasPrepared ? " prepared" : "",
+            (unsigned)navDepth, (unsigned long)resumeCount,
+            (unsigned long)(resumeCount + rebuildCount));
+    if (resumed) {
+        logInfo("Snapshot %s: screen %d drawn in %lu us, saved %lu us (hit rate %u%%, total saved %lu us)",
+                restored ? "hit" : "miss", screenId, (unsigned long)drawUs, (unsigned long)savedUs,
+                snapshots.getHitRatePercent(), (unsigned long)snapshotSavedUs);
+    }
     return true;
 }
 
@@ -90,28 +408,61 @@ ScreenID ScreenManager::getCurrentScreenId() const {
 }
 
 BaseScreen* ScreenManager::getScreen(ScreenID id) {
-    auto it = screens.find(id);
-    if (it != screens.end()) {
-        return it->second.get();
+    if (id < 0 || id >= SCREEN_COUNT) {
+        return nullptr;
     }
-    return nullptr;
+    return screens[id].get();
 }
 
-void ScreenManager::handleEvent(const Event& event) {
-    if (!currentScreen || isTransitioning) {
+void ScreenManager::onNavigationEvent(const Event& event) {
+    requestTransition((ScreenID)event.screenChange().targetScreen, 
+                      (TransitionType)event.screenChange().transition);
+}
+
+void ScreenManager::forwardToScreen(const Event& event) {
+    if (!currentScreen) {
+        return;
+    }
+    
+    // 入力中は押下表示などが写り込むので撮影しない（撮り終えたものは残す）
+    if (event.is(EVENT_TOUCH_DOWN)) {
+        touchHeld = true;
+        // 押下音の遅延をタッチの時刻から測る
+        g_sfxMixer.markInput(event.touch().timestampUs);
+    } else if (event.is(EVENT_TOUCH_UP)) {
+        touchHeld = false;
+    }
+    settleFrames = 0;
+    if (snapshots.isCapturing()) {
+        snapshots.abortCapture();
+    }
+    
+    // 遷移前に始まった押下の残り（MOVE/UP）は新しい画面に渡さない
+    bool isTouch = event.is(EVENT_TOUCH_DOWN) || event.is(EVENT_TOUCH_UP) ||
+                   event.is(EVENT_TOUCH_MOVE) || event.is(EVENT_TOUCH_DRAG);
+    if (isTouch && touchSwallowed) {
+        if (event.is(EVENT_TOUCH_UP)) {
+            touchSwallowed = false;
+        }
+        inputDropped++;
         return;
     }
     
-    // 画面遷移イベントの処理
-    if (event.type == EVENT_SCREEN_CHANGE) {
-        transitionTo((ScreenID)event.data.screenChange.targetScreen, 
-                    (TransitionType)event.data.screenChange.transition);
+    // 遷移待ち・遷移中のタップは古い画面を見て押したものなので捨て、
+    // スワイプなどの操作だけを保留して新しい画面に渡す
+    if (isTransitioning || transitions.isBusy()) {
+        if (isTouch) {
+            touchSwallowed = !event.is(EVENT_TOUCH_UP);
+            inputDropped++;
+        } else {
+            bufferInput(event);
+        }
         return;
     }
     
     // スワイプイベントの特別処理
-    if (event.type == EVENT_GESTURE_SWIPE || 
-        (event.type == EVENT_TOUCH_UP && currentScreen)) {
+    if (event.getType() == EVENT_GESTURE_SWIPE || 
+        (event.getType() == EVENT_TOUCH_UP && currentScreen)) {
         handleSwipeEvent(event);
     }
     
@@ -119,17 +470,185 @@ void ScreenManager::handleEvent(const Event& event) {
     currentScreen->handleEvent(event);
 }
 
+void ScreenManager::processTransitions() {
+    if (!transitions.isBusy()) {
+        return;
+    }
+    
+    TransitionQueue::Step step = transitions.advance(millis());
+    if (step.started) {
+        fadeBaseBrightness = tft->getBrightness();
+    }
+    if (step.swap) {
+        transitionTo(step.request.target, step.request.type);
+    }
+    if (step.setLevel) {
+        tft->setBrightness(fadeBaseBrightness * step.level / 255);
+    }
+    
+    if (!transitions.isBusy()) {
+        if (transitions.getCompletedCount() != reportedTransitions) {
+            reportedTransitions = transitions.getCompletedCount();
+            logInfo("Navigation settled on screen %d in %lu ms (collapsed %lu, cancelled %lu)",
+                    getCurrentScreenId(), (unsigned long)transitions.getLastLatencyMs(),
+                    (unsigned long)transitions.getCollapsedCount(),
+                    (unsigned long)transitions.getCancelledCount());
+        }
+        replayBufferedInput();
+    }
+}
+
+void ScreenManager::bufferInput(const Event& event) {
+    if (inputCount == INPUT_BUFFER_SIZE) {
+        // 満杯なら最も古い入力を捨てる
+        inputHead = (inputHead + 1) % INPUT_BUFFER_SIZE;
+        inputCount--;
+        inputDropped++;
+    }
+    inputBuffer[(inputHead + inputCount) % INPUT_BUFFER_SIZE] = event;
+    inputCount++;
+}
+
+void ScreenManager::replayBufferedInput() {
+    while (inputCount > 0 && currentScreen && !transitions.isBusy()) {
+        Event event = inputBuffer[inputHead];
+        inputHead = (inputHead + 1) % INPUT_BUFFER_SIZE;
+        inputCount--;
+        forwardToScreen(event);
+    }
+}
+
 void ScreenManager::update() {
+    processTransitions();
+    
     if (!currentScreen || isTransitioning) {
         return;
     }
     
     currentScreen->update();
     
-    // 再描画が必要な場合
+    // 再描画が必要な場合（撮影済みのスナップショットは古くなる）
     if (currentScreen->isNeedsRedraw()) {
-        currentScreen->draw();
+        ScreenID id = currentScreen->getId();
+        snapshots.invalidate(id);
+        snapshotRejected[id] = false;
+        settleFrames = 0;
+    }
+    // 描画は毎フレーム呼ぶ。全体の再描画か、状態表示や一覧など変わった部分だけの描画かは
+    // 各画面のdraw()が判断する（needsRedrawのときだけ呼ぶと部分描画が一度も走らない）
+    currentScreen->draw();
+
+    // 入力も再描画もないフレームを数え、落ち着いたら撮影と先読みを進める
+    if (settleFrames < SNAPSHOT_SETTLE_FRAMES) {
+        settleFrames++;
+    }
+    captureSnapshotStep();
+    prewarmStep();
+}
+
+void ScreenManager::prewarmStep() {
+    if (!currentScreen || touchHeld || transitions.isBusy() || snapshots.isCapturing() ||
+        settleFrames < SNAPSHOT_SETTLE_FRAMES) {
+        return;
+    }
+    
+    ScreenID candidates[NAV_PREDICT_CANDIDATES];
+    size_t count = predictor.predict(currentScreen->getId(), candidates, NAV_PREDICT_CANDIDATES);
+    for (size_t i = 0; i < count; ++i) {
+        ScreenID id = candidates[i];
+        // 準備済み・スタックで保持中（ウィジェットが残っている）の画面は不要
+        if (prepared[id] || isRetained(id) || !factories[id]) {
+            continue;
+        }
+        
+        // ヒープに余裕がなければ先読みしない（予算を超える生成で他の画面を追い出さない）
+        bool constructed = static_cast<bool>(screens[id]);
+        if (!constructed &&
+            (ESP.getFreeHeap() < PREWARM_MIN_FREE_HEAP ||
+             (heapBudget > 0 && getResidentHeap() + SCREEN_REGISTRY[id].objectSize > heapBudget))) {
+            return;
+        }
+        
+        // 生成に加えて、onEnterで行うボタンの組み立てを先に済ませておく
+        ScreenID fromId = currentScreen->getId();
+        uint32_t startUs = micros();
+        BaseScreen* screen = obtainScreen(id);
+        if (!screen) {
+            continue;
+        }
+        uint32_t constructUs = micros() - startUs;
+        screen->prepare();
+        uint32_t prepareUs = micros() - startUs - constructUs;
+        prepared[id] = true;
+        prewarmCount++;
+        logInfo("Prewarmed screen %d from screen %d (weight %u, construct %lu us, prepare %lu us, hits %lu/%lu)",
+                id, fromId, predictor.getWeight(fromId, id), (unsigned long)constructUs,
+                (unsigned long)prepareUs, (unsigned long)prewarmHits, (unsigned long)prewarmCount);
+        return;     // 1フレームに1画面まで
+    }
+}
+
+void ScreenManager::captureSnapshotStep() {
+    if (!currentScreen || !snapshotStrip || touchHeld || transitions.isBusy() ||
+        !currentScreen->isSnapshotStable()) {
+        return;
     }
+    
+    ScreenID id = currentScreen->getId();
+    uint32_t version = currentScreen->getContentVersion();
+    if (snapshots.isCapturing() && snapshots.getCaptureKey() == id) {
+        if (snapshotVersion[id] != version) {
+            // 撮影中に表示が変わった
+            snapshots.abortCapture();
+            settleFrames = 0;
+            return;
+        }
+    } else {
+        if (snapshotVersion[id] == version && (snapshots.contains(id) || snapshotRejected[id])) {
+            return;
+        }
+        // 表示が落ち着いてから撮影を始める
+        if (settleFrames < SNAPSHOT_SETTLE_FRAMES) {
+            return;
+        }
+        if (!snapshots.beginCapture(id, tft->width(), tft->height())) {
+            return;
+        }
+        snapshotVersion[id] = version;
+        snapshotRejected[id] = false;
+    }
+    
+    // 1フレームに1束ずつ読み出して圧縮
+    uint16_t height = tft->height();
+    uint16_t y = snapshots.getCapturedRows();
+    uint16_t rows = height - y < SNAPSHOT_STRIP_ROWS ? height - y : SNAPSHOT_STRIP_ROWS;
+    tft->readRect(0, y, tft->width(), rows, snapshotStrip.get());
+    if (!snapshots.appendRows(snapshotStrip.get(), rows)) {
+        snapshotRejected[id] = true;
+        logWarn("Snapshot of screen %d does not fit in %u bytes", id, (unsigned)snapshots.getBudget());
+    } else if (!snapshots.isCapturing()) {
+        logInfo("Snapshot of screen %d cached (%u / %u bytes)",
+                id, (unsigned)snapshots.getUsedBytes(), (unsigned)snapshots.getBudget());
+    }
+}
+
+bool ScreenManager::restoreSnapshot(ScreenID id) {
+    BaseScreen* screen = screens[id].get();
+    if (!snapshotStrip || !screen || !screen->isSnapshotStable()) {
+        return false;
+    }
+    if (snapshotVersion[id] != screen->getContentVersion()) {
+        snapshots.invalidate(id);
+    }
+    
+    const int32_t width = tft->width();
+    tft->startWrite();
+    bool restored = snapshots.restore(id, snapshotStrip.get(), SNAPSHOT_STRIP_ROWS,
+        [this, width](uint16_t y, uint16_t rows, const uint16_t* pixels) {
+            tft->pushImage(0, y, width, rows, pixels);
+        });
+    tft->endWrite();
+    return restored;
 }
 
 void ScreenManager::performTransition(BaseScreen* fromScreen, BaseScreen* toScreen, TransitionType transition) {
@@ -156,7 +675,7 @@ void ScreenManager::handleSwipeEvent(const Event& event) {
     ScreenID currentId = currentScreen->getId();
     
     // ホーム画面での上スワイプ → 設定画面
-    if (currentId == SCREEN_HOME && event.type == EVENT_TOUCH_UP) {
+    if (currentId == SCREEN_HOME && event.getType() == EVENT_TOUCH_UP) {
         // HomeScreenクラス内でスワイプ検出を行い、onSwipeUp()を呼ぶ
         // その結果、ここで画面遷移を実行
         HomeScreen* homeScreen = static_cast<HomeScreen*>(currentScreen);
@@ -2,9 +2,27 @@
 #define SCREEN_MANAGER_H
 
 #include "BaseScreen.h"
+#include "TransitionQueue.h"
+#include "NavigationPredictor.h"
+#include "../display/SnapshotCache.h"
 #include "../shared/Events.h"
 #include <memory>
-#include <map>
+#include <cstddef>
+
+// 画面キャッシュのヒープ予算（バイト、0で無制限＝退避しない）
+#ifndef SCREEN_CACHE_HEAP_BUDGET
+#define SCREEN_CACHE_HEAP_BUDGET 0
+#endif
+
+// ナビゲーションスタックの最大段数（超えた分は最も古い段から忘れる）
+#ifndef NAV_STACK_DEPTH
+#define NAV_STACK_DEPTH 6
+#endif
+
+// スタック上で状態を保持する画面のヒープ予算（バイト、0で無制限）
+#ifndef NAV_RETAIN_HEAP_BUDGET
+#define NAV_RETAIN_HEAP_BUDGET 0
+#endif
 
 // 前方宣言
 class HomeScreen;
@@ -12,15 +30,83 @@ class MenuScreen;
 class SettingsScreen;
 class InfoScreen;
 
+// スナップショットの撮影・復元で一度に転送する行数
+#ifndef SNAPSHOT_STRIP_ROWS
+#define SNAPSHOT_STRIP_ROWS 8
+#endif
+
+// 表示が落ち着いてから撮影を始めるまでのフレーム数
+#ifndef SNAPSHOT_SETTLE_FRAMES
+#define SNAPSHOT_SETTLE_FRAMES 30
+#endif
+
+// 先読みで画面を生成するのに必要な最小の空きヒープ（バイト）
+#ifndef PREWARM_MIN_FREE_HEAP
+#define PREWARM_MIN_FREE_HEAP 60000
+#endif
+
+// 画面の生成関数
+typedef BaseScreen* (*ScreenFactory)(LGFX* display);
+
 class ScreenManager {
 private:
     LGFX* tft;
     BaseScreen* currentScreen;
-    std::map<ScreenID, std::unique_ptr<BaseScreen>> screens;
     
-    // 画面遷移中フラグ
+    // 画面は初回遷移時に生成し、ScreenIDで引く固定配列に保持
+    std::unique_ptr<BaseScreen> screens[SCREEN_COUNT];
+    ScreenFactory factories[SCREEN_COUNT];
+    
+    // LRU管理と生成コストの記録
+    uint32_t lastUsed[SCREEN_COUNT];
+    uint32_t heapCost[SCREEN_COUNT];
+    uint32_t useCounter;
+    size_t heapBudget;
+    
+    // 画面遷移中フラグ（切り替え処理の実行中）
     bool isTransitioning;
     
+    // 遷移の待ち行列とフェードの基準の明るさ
+    TransitionQueue transitions;
+    uint8_t fadeBaseBrightness;
+    uint32_t reportedTransitions;
+    
+    // ナビゲーションスタック（戻り先の画面。retainedなら状態を保持したまま）
+    struct NavEntry {
+        ScreenID id;
+        bool retained;
+    };
+    NavEntry navStack[NAV_STACK_DEPTH];
+    size_t navDepth;
+    size_t retainBudget;
+    uint32_t resumeCount;
+    uint32_t rebuildCount;
+    
+    // 戻ったときに描き直す代わりに復元する画面のスナップショット
+    SnapshotCache snapshots;
+    std::unique_ptr<uint16_t[]> snapshotStrip;
+    uint32_t snapshotVersion[SCREEN_COUNT];     // 撮影時の表示内容の版
+    uint32_t fullDrawUs[SCREEN_COUNT];          // 直近の全体描画にかかった時間
+    uint32_t snapshotSavedUs;                   // 復元で節約した時間の累計
+    bool snapshotRejected[SCREEN_COUNT];        // 予算に収まらなかった（表示が変わるまで撮り直さない）
+    uint16_t settleFrames;
+    bool touchHeld;
+    bool touchSwallowed;                        // 遷移中に始まった押下をUPまで捨てている
+    
+    // 遷移の予測と、暇なフレームでの遷移先の先行生成と準備（prepare）
+    NavigationPredictor predictor;
+    bool prepared[SCREEN_COUNT];                // 先読みで準備済み（まだ入っていない）
+    uint32_t prewarmCount;
+    uint32_t prewarmHits;                       // 準備済みの画面に遷移した回数
+    
+    // 遷移中に届いたスワイプなどの入力（遷移完了後に新しい画面へ渡す）。
+    // タップは古い画面を見て押したものなので保留せずに捨てる
+    static constexpr size_t INPUT_BUFFER_SIZE = 8;
+    Event inputBuffer[INPUT_BUFFER_SIZE];
+    size_t inputHead;
+    size_t inputCount;
+    uint32_t inputDropped;
+    
 public:
     ScreenManager(LGFX* display);
     ~ScreenManager();
@@ -28,29 +114,86 @@ public:
     // 初期化
     void init();
     
-    // 画面の登録
-    void registerScreen(ScreenID id, std::unique_ptr<BaseScreen> screen);
+    // 画面生成関数の登録（既存の生成済み画面は破棄される）
+    void registerFactory(ScreenID id, ScreenFactory factory);
+    
+    // 画面キャッシュのヒープ予算を設定（0で無制限）
+    void setHeapBudget(size_t bytes);
+    size_t getResidentHeap() const;
     
-    // 画面遷移
+    // 画面遷移を要求（次のupdateから処理。連続した要求は最後の行き先にまとめる）
+    void requestTransition(ScreenID screenId, TransitionType transition = TRANSITION_NONE);
+    bool isTransitionPending() const { return transitions.isBusy(); }
+    
+    // 画面を即座に切り替え（切り替え中に呼ばれた場合は要求として積む）
+    // 新しい画面へ進むときは現在の画面をスタックに積み、SCREEN_BACKまたは
+    // スタック上の画面を指定した場合はそこまで戻る
     bool transitionTo(ScreenID screenId, TransitionType transition = TRANSITION_NONE);
     
+    // スタック操作（requestTransitionと同じく次のupdateで処理）
+    void pushScreen(ScreenID screenId, TransitionType transition = TRANSITION_NONE) { requestTransition(screenId, transition); }
+    void popScreen(TransitionType transition = TRANSITION_NONE) { requestTransition(SCREEN_BACK, transition); }
+    size_t getStackDepth() const { return navDepth; }
+    
+    // スタック上で状態を保持する画面のヒープ予算を設定（0で無制限）
+    void setRetainBudget(size_t bytes);
+    size_t getRetainedHeap() const;
+    
+    // スナップショットキャッシュ（予算の変更と統計）
+    SnapshotCache& getSnapshotCache() { return snapshots; }
+    uint32_t getSnapshotSavedUs() const { return snapshotSavedUs; }
+    
+    // 遷移の予測（統計と候補の確認用）
+    const NavigationPredictor& getPredictor() const { return predictor; }
+    uint32_t getPrewarmCount() const { return prewarmCount; }
+    uint32_t getPrewarmHits() const { return prewarmHits; }
+    
     // 現在の画面取得
     BaseScreen* getCurrentScreen() { return currentScreen; }
     ScreenID getCurrentScreenId() const;
     
-    // 特定の画面取得
+    // 特定の画面取得（未生成ならnullptr）
     BaseScreen* getScreen(ScreenID id);
     
-    // イベント処理
-    void handleEvent(const Event& event);
-    
     // 更新と描画
     void update();
     
 private:
+    // 画面を取得（未生成なら生成する）
+    BaseScreen* obtainScreen(ScreenID id);
+    
+    // 予算超過時に最も使われていない画面を破棄
+    void enforceHeapBudget(ScreenID keepId);
+    
+    // ナビゲーションスタックの操作
+    int findInStack(ScreenID id) const;
+    bool isRetained(ScreenID id) const;
+    void releaseEntry(NavEntry& entry);         // 保持していた状態を手放す（onExit）
+    void pushCurrent();
+    bool unwindTo(size_t index);                // index以降を取り除き、その段が保持されていたか返す
+    void enforceRetainBudget();
+    
     // 画面遷移アニメーション
     void performTransition(BaseScreen* fromScreen, BaseScreen* toScreen, TransitionType transition);
     
+    // スナップショットの撮影を1束進める／復元する
+    void captureSnapshotStep();
+    bool restoreSnapshot(ScreenID id);
+    
+    // 予測した遷移先を1画面だけ先に生成する
+    void prewarmStep();
+    
+    // 遷移の待ち行列を1フレーム進める
+    void processTransitions();
+    
+    // 遷移中の入力の保留と再送
+    void bufferInput(const Event& event);
+    void replayBufferedInput();
+    
+    // イベントバスの購読ハンドラ
+    void onNavigationEvent(const Event& event);
+    void forwardToScreen(const Event& event);   // 現在の画面へ転送
+    
     // スワイプイベントの処理
     void handleSwipeEvent(const Event& event);
 };
@@ -2,21 +2,50 @@
 #include <LovyanGFX.hpp>
 #include "SettingsScreen.h"
 #include "../ui/components/ModernButton.h"
-#include "../ui/components/ConfirmDialog.h"
-#include "../shared/EventQueue.h"
+#include "../ui/layout/LayoutTable.h"
+#include "../shared/EventBus.h"
+#include "../shared/LogBuffer.h"
 #include <Arduino.h>
 
-// グローバルイベントキュー（外部で定義）
-extern EventQueue* g_touchEventQueue;
-
 // スワイプ検出の閾値
 #define SWIPE_THRESHOLD 50  // 最小スワイプ距離
 #define SWIPE_TIME_LIMIT 500  // 最大スワイプ時間（ms）
 
+namespace {
+// ボタンの並び（明るさとリセットの動作はcreateButtonsで付ける）
+enum SettingsButtonIndex {
+    SETTINGS_BUTTON_BRIGHTNESS = 0,
+    SETTINGS_BUTTON_INFO,
+    SETTINGS_BUTTON_RESET,
+    SETTINGS_BUTTON_BACK
+};
+
+constexpr ButtonStyleDef STYLE_BRIGHTNESS = {
+    rgb565(33, 150, 243), rgb565(25, 118, 210), 10, 4, 0, 0xFFFF     // Material Blue
+};
+
+constexpr ButtonStyleDef STYLE_INFO = {
+    rgb565(76, 175, 80), rgb565(56, 142, 60), 10, 4, 0, 0xFFFF       // Material Green
+};
+
+constexpr UiActionDef NO_ACTION = {UI_ACTION_NONE, SCREEN_SETTINGS, TRANSITION_NONE};
+
+constexpr ButtonDef SETTINGS_BUTTONS[SettingsScreen::BUTTON_COUNT] = {
+    {20, 70, 130, 40, "明るさ", &STYLE_BRIGHTNESS, NO_ACTION},
+    {170, 70, 130, 40, "情報", &STYLE_INFO, {UI_ACTION_NAVIGATE, SCREEN_INFO, TRANSITION_SLIDE_LEFT}},
+    // リセット（角なし・赤枠）
+    {95, 180, 130, 35, "リセット", &STYLE_CLOSE, NO_ACTION},
+    BACK_TO_MENU_BUTTON
+};
+} // namespace
+
+constexpr size_t SettingsScreen::BUTTON_COUNT;
+
 SettingsScreen::SettingsScreen(LGFX* display) 
     : BaseScreen(display, SCREEN_SETTINGS),
       touchStartX(0), touchStartY(0), touchStartTime(0), isTouching(false),
-      brightness(80), showingDialog(false) {
+      brightness(DEFAULT_BRIGHTNESS),
+      confirmDialog(display, "確認", "本当にリセットしてもいいですか？"), showingDialog(false) {
     
     // ボタンを作成
     createButtons();
@@ -26,19 +55,11 @@ SettingsScreen::SettingsScreen(LGFX* display)
 }
 
 void SettingsScreen::createButtons() {
-    // ボタン1: 明るさ調整（青いボタン）
-    char brightnessText[20];
-    sprintf(brightnessText, "明るさ: %d%%", brightness);
-    auto brightnessBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, 20, 70, 130, 40, brightnessText)
-    );
-    ButtonStyle blueStyle;
-    blueStyle.normalColor = tft->color565(33, 150, 243);    // Material Blue
-    blueStyle.pressedColor = tft->color565(25, 118, 210);   // Darker Blue
-    blueStyle.cornerRadius = 10;
-    blueStyle.shadowOffset = 4;
-    brightnessBtn->setStyle(blueStyle);
-    brightnessBtn->setOnClick([this]() {
+    // レイアウト表からボタンを生成（情報・戻るは表の遷移のまま）
+    buttons.build(tft, SETTINGS_BUTTONS);
+    refreshBrightnessLabel();
+    
+    buttons[SETTINGS_BUTTON_BRIGHTNESS].setOnClick([this]() {
         // 次の値に更新: 80% → 100% → 20% → 40% → 60% → 80%
         brightness = brightness + 20;
         if (brightness > 100) {
@@ -46,116 +67,57 @@ void SettingsScreen::createButtons() {
         }
         
         // 新しい値を表示と実際の明るさに適用
-        char buf[20];
-        sprintf(buf, "明るさ: %d%%", brightness);
-        buttons[0]->setText(buf);
-        buttons[0]->draw();  // 即座に再描画
+        refreshBrightnessLabel();
+        buttons[SETTINGS_BUTTON_BRIGHTNESS].draw();  // 即座に再描画
+        markContentChanged();
         tft->setBrightness(brightness * 255 / 100);
         
-        Serial.printf("Brightness changed to %d%%\n", brightness);
+        logInfo("Brightness changed to %d%%", brightness);
     });
-    buttons.push_back(std::move(brightnessBtn));
     
-    // ボタン2: 情報（緑のボタン）
-    auto infoBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, 170, 70, 130, 40, "情報")
-    );
-    ButtonStyle greenStyle;
-    greenStyle.normalColor = tft->color565(76, 175, 80);    // Material Green
-    greenStyle.pressedColor = tft->color565(56, 142, 60);   // Darker Green
-    greenStyle.cornerRadius = 10;
-    greenStyle.shadowOffset = 4;
-    infoBtn->setStyle(greenStyle);
-    infoBtn->setOnClick([this]() {
-        Serial.println("Information button pressed");
-        // 情報画面への遷移
-        Event infoEvent;
-        infoEvent.type = EVENT_SCREEN_CHANGE;
-        infoEvent.data.screenChange.targetScreen = SCREEN_INFO;
-        infoEvent.data.screenChange.transition = TRANSITION_SLIDE_LEFT;
+    buttons[SETTINGS_BUTTON_RESET].setOnClick([this]() {
+        logInfo("Reset button pressed - showing confirmation");
         
-        if (g_touchEventQueue) {
-            g_touchEventQueue->send(infoEvent);
-        }
+        // ダイアログを表示
+        showingDialog = true;
+        confirmDialog.show();
+        markContentChanged();
     });
-    buttons.push_back(std::move(infoBtn));
     
-    
-    // ボタン3: リセット（赤いボタン）
-    auto resetBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, 95, 180, 130, 35, "リセット")
-    );
-    ButtonStyle redStyle;
-    redStyle.normalColor = tft->color565(244, 67, 54);     // Material Red
-    redStyle.pressedColor = tft->color565(211, 47, 47);    // Darker Red
-    redStyle.cornerRadius = 0;  // 角なし
-    redStyle.shadowOffset = 3;
-    redStyle.borderWidth = 2;
-    redStyle.borderColor = tft->color565(183, 28, 28);     // Dark Red Border
-    resetBtn->setStyle(redStyle);
-    resetBtn->setOnClick([this]() {
-        Serial.println("Reset button pressed - showing confirmation");
-        
-        // 確認ダイアログを作成
-        confirmDialog.reset(new ConfirmDialog(
-            tft,
-            "確認",
-            "本当にリセットしてもいいですか？"
-        ));
+    // はいボタンのコールバック
+    confirmDialog.setOnYes([this]() {
+        logInfo("Reset confirmed - going to home");
+        showingDialog = false;
         
-        // はいボタンのコールバック
-        confirmDialog->setOnYes([this]() {
-            Serial.println("Reset confirmed - going to home");
-            showingDialog = false;
-            
-            // 明るさを初期値（80%）に戻す
-            brightness = 80;
-            tft->setBrightness(brightness * 255 / 100);
-            
-            // ホーム画面に戻る
-            Event homeEvent;
-            homeEvent.type = EVENT_SCREEN_CHANGE;
-            homeEvent.data.screenChange.targetScreen = SCREEN_HOME;
-            homeEvent.data.screenChange.transition = TRANSITION_FADE;
-            
-            if (g_touchEventQueue) {
-                g_touchEventQueue->send(homeEvent);
-                
-                // リセットメッセージ表示イベントを送信
-                Event resetMsgEvent;
-                resetMsgEvent.type = EVENT_SHOW_RESET_MESSAGE;
-                g_touchEventQueue->send(resetMsgEvent);
-            }
-        });
+        // 明るさを初期値（80%）に戻す
+        brightness = DEFAULT_BRIGHTNESS;
+        refreshBrightnessLabel();
+        tft->setBrightness(brightness * 255 / 100);
         
-        // いいえボタンのコールバック
-        confirmDialog->setOnNo([this]() {
-            Serial.println("Reset cancelled");
-            showingDialog = false;
-            needsRedraw = true;  // 画面を再描画
-        });
+        // ホーム画面に戻る
+        Event homeEvent = makeScreenChangeEvent(SCREEN_HOME, TRANSITION_FADE);
         
-        // ダイアログを表示
-        showingDialog = true;
-        confirmDialog->show();
+        if (g_eventBus) {
+            g_eventBus->publish(homeEvent);
+            
+            // リセットメッセージ表示イベントを送信
+            Event resetMsgEvent = makeEvent(EVENT_SHOW_RESET_MESSAGE);
+            g_eventBus->publish(resetMsgEvent);
+        }
     });
-    buttons.push_back(std::move(resetBtn));
     
-    // ボタン4: 戻る（右上）
-    auto backBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, tft->width() - 70, 10, 60, 30, "戻る")
-    );
-    ButtonStyle backStyle;
-    backStyle.normalColor = tft->color565(96, 125, 139);    // Blue Grey
-    backStyle.pressedColor = tft->color565(69, 90, 100);    // Darker Blue Grey
-    backStyle.cornerRadius = 5;
-    backStyle.shadowOffset = 2;
-    backBtn->setStyle(backStyle);
-    backBtn->setOnClick([this]() {
-        Serial.println("Back button pressed - returning to Menu");
-        returnToMenu();
+    // いいえボタンのコールバック
+    confirmDialog.setOnNo([this]() {
+        logInfo("Reset cancelled");
+        showingDialog = false;
+        needsRedraw = true;  // 画面を再描画
     });
-    buttons.push_back(std::move(backBtn));
+}
+
+void SettingsScreen::refreshBrightnessLabel() {
+    WidgetText label;
+    label.format("明るさ: %d%%", brightness);
+    buttons[SETTINGS_BUTTON_BRIGHTNESS].setText(label);
 }
 
 void SettingsScreen::init() {
@@ -176,7 +138,7 @@ void SettingsScreen::init() {
     
     // ボタンを描画
     for (auto& button : buttons) {
-        button->draw();
+        button.draw();
     }
 }
 
@@ -194,15 +156,15 @@ void SettingsScreen::update() {
 
 void SettingsScreen::handleEvent(const Event& event) {
     // ダイアログ表示中は、ダイアログのみがタッチイベントを処理
-    if (showingDialog && confirmDialog) {
-        switch (event.type) {
+    if (showingDialog) {
+        switch (event.getType()) {
             case EVENT_TOUCH_DOWN:
             case EVENT_TOUCH_MOVE:
-                confirmDialog->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                confirmDialog.handleTouch(event.touch().x, event.touch().y, true);
                 return;
                 
             case EVENT_TOUCH_UP:
-                confirmDialog->handleTouch(event.data.touch.x, event.data.touch.y, false);
+                confirmDialog.handleTouch(event.touch().x, event.touch().y, false);
                 return;
                 
             default:
@@ -210,17 +172,17 @@ void SettingsScreen::handleEvent(const Event& event) {
         }
     }
     
-    switch (event.type) {
+    switch (event.getType()) {
         case EVENT_TOUCH_DOWN: {
             // タッチ開始位置を記録
-            touchStartX = event.data.touch.x;
-            touchStartY = event.data.touch.y;
+            touchStartX = event.touch().x;
+            touchStartY = event.touch().y;
             touchStartTime = millis();
             isTouching = true;
             
             // ボタンのタッチ処理
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button.handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         }
@@ -228,7 +190,7 @@ void SettingsScreen::handleEvent(const Event& event) {
         case EVENT_TOUCH_MOVE: {
             // ボタンのタッチ移動処理
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button.handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         }
@@ -237,14 +199,14 @@ void SettingsScreen::handleEvent(const Event& event) {
             // ボタンのタッチ終了処理
             bool buttonHandled = false;
             for (auto& button : buttons) {
-                if (button->handleTouch(event.data.touch.x, event.data.touch.y, false)) {
+                if (button.handleTouch(event.touch().x, event.touch().y, false)) {
                     buttonHandled = true;
                 }
             }
             
             // ボタンが処理しなかった場合、スワイプジェスチャーを検出
             if (isTouching && !buttonHandled) {
-                detectSwipeGesture(event.data.touch.x, event.data.touch.y);
+                detectSwipeGesture(event.touch().x, event.touch().y);
             }
             isTouching = false;
             break;
@@ -252,7 +214,7 @@ void SettingsScreen::handleEvent(const Event& event) {
             
         case EVENT_GESTURE_SWIPE: {
             // TouchManagerからのジェスチャーイベント
-            switch (event.data.gesture.direction) {
+            switch (event.gestureDirection()) {
                 case GestureEvent::GESTURE_UP:
                     onSwipeUp();
                     break;
@@ -277,44 +239,42 @@ void SettingsScreen::handleEvent(const Event& event) {
 }
 
 void SettingsScreen::onEnter() {
-    Serial.println("Entered Settings Screen");
-    Serial.printf("Current brightness: %d%%\n", brightness);
+    logInfo("Entered Settings Screen");
+    logInfo("Current brightness: %d%%", brightness);
     needsRedraw = true;
     
     // 現在の明るさを適用
     tft->setBrightness(brightness * 255 / 100);
     
     // 明るさボタンの表示を現在の値に同期
-    if (buttons.size() > 0) {
-        char buf[20];
-        sprintf(buf, "明るさ: %d%%", brightness);
-        buttons[0]->setText(buf);
-        buttons[0]->redraw();  // 強制的に再描画
-        Serial.printf("Updated button text to: %s\n", buf);
-    }
+    refreshBrightnessLabel();
 }
 
 void SettingsScreen::onExit() {
-    Serial.println("Exiting Settings Screen");
+    logInfo("Exiting Settings Screen");
+}
+
+size_t SettingsScreen::getNavigationTargets(ScreenID* out, size_t maxCount) const {
+    return collectNavigationTargets(SETTINGS_BUTTONS, out, maxCount);
 }
 
 void SettingsScreen::onSwipeUp() {
-    Serial.println("Settings: Swipe Up - return to Menu");
+    logInfo("Settings: Swipe Up - return to Menu");
     returnToMenu();
 }
 
 void SettingsScreen::onSwipeDown() {
-    Serial.println("Settings: Swipe Down - return to Menu");
+    logInfo("Settings: Swipe Down - return to Menu");
     returnToMenu();
 }
 
 void SettingsScreen::onSwipeLeft() {
-    Serial.println("Settings: Swipe Left - return to Menu");
+    logInfo("Settings: Swipe Left - return to Menu");
     returnToMenu();
 }
 
 void SettingsScreen::onSwipeRight() {
-    Serial.println("Settings: Swipe Right - return to Menu");
+    logInfo("Settings: Swipe Right - return to Menu");
     returnToMenu();
 }
 
@@ -347,13 +307,10 @@ void SettingsScreen::detectSwipeGesture(int32_t endX, int32_t endY) {
 
 void SettingsScreen::returnToMenu() {
     // メニュー画面に戻るイベントを送信
-    Event returnEvent;
-    returnEvent.type = EVENT_SCREEN_CHANGE;
-    returnEvent.data.screenChange.targetScreen = SCREEN_MENU;
-    returnEvent.data.screenChange.transition = TRANSITION_SLIDE_RIGHT;
+    Event returnEvent = makeScreenChangeEvent(SCREEN_BACK, TRANSITION_SLIDE_RIGHT);
     
     // イベントキューに送信
-    if (g_touchEventQueue) {
-        g_touchEventQueue->send(returnEvent);
+    if (g_eventBus) {
+        g_eventBus->publish(returnEvent);
     }
 }
\ No newline at end of file
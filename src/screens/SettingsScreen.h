@@ -2,14 +2,15 @@
 #define SETTINGS_SCREEN_H
 
 #include "BaseScreen.h"
-#include <memory>
-#include <vector>
-
-// 前方宣言
-class ModernButton;
-class ConfirmDialog;
+#include "../ui/components/ConfirmDialog.h"
+#include "../ui/layout/ButtonSet.h"
 
 class SettingsScreen : public BaseScreen {
+public:
+    // 起動時の明るさ（%）
+    static constexpr int DEFAULT_BRIGHTNESS = 80;
+    static constexpr size_t BUTTON_COUNT = 4;  // 明るさ・情報・リセット・戻る
+    
 private:
     // タッチ開始位置（スワイプ検出用）
     int32_t touchStartX;
@@ -20,11 +21,11 @@ private:
     // 設定項目
     int brightness;
     
-    // UIコンポーネント
-    std::vector<std::unique_ptr<ModernButton>> buttons;
+    // UIコンポーネント（レイアウト表から生成し、ダイアログと一緒に画面内に置く）
+    ButtonSet<BUTTON_COUNT> buttons;
     
     // 確認ダイアログ
-    std::unique_ptr<ConfirmDialog> confirmDialog;
+    ConfirmDialog confirmDialog;
     bool showingDialog;
     
 public:
@@ -40,6 +41,12 @@ public:
     void onEnter() override;
     void onExit() override;
     
+    // 情報ボタンの行き先
+    size_t getNavigationTargets(ScreenID* out, size_t maxCount) const override;
+    
+    // 明るさ設定を保持するため常駐
+    bool isEvictable() const override { return false; }
+    
     // 全方向のスワイプでメニューに戻る
     void onSwipeUp() override;
     void onSwipeDown() override;
@@ -49,6 +56,7 @@ public:
 private:
     // ボタンの作成
     void createButtons();
+    void refreshBrightnessLabel();
     
     // スワイプジェスチャーの検出
     void detectSwipeGesture(int32_t endX, int32_t endY);
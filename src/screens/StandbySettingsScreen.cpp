@@ -3,34 +3,17 @@
 #include "StandbySettingsScreen.h"
 #include <Arduino.h>
 #include "../ui/components/ModernButton.h"
-#include "../shared/EventQueue.h"
-#include <memory>
-#include <vector>
-
-extern EventQueue* g_touchEventQueue;
+#include "../ui/layout/LayoutTable.h"
 
 StandbySettingsScreen::StandbySettingsScreen(LGFX* display)
     : BaseScreen(display, SCREEN_STANDBY_SETTINGS) {}
 
 void StandbySettingsScreen::createButtons() {
     buttons.clear();
-    auto backBtn = std::unique_ptr<ModernButton>(
-        new ModernButton(tft, tft->width() - 70, 10, 60, 30, "戻る")
-    );
-    ButtonStyle backStyle;
-    backStyle.normalColor = tft->color565(96, 125, 139);    // Blue Grey
-    backStyle.pressedColor = tft->color565(69, 90, 100);
-    backStyle.cornerRadius = 5;
-    backStyle.shadowOffset = 2;
-    backBtn->setStyle(backStyle);
-    backBtn->setOnClick([this]() {
-        Event e;
-        e.type = EVENT_SCREEN_CHANGE;
-        e.data.screenChange.targetScreen = SCREEN_MENU;
-        e.data.screenChange.transition = TRANSITION_SLIDE_RIGHT;
-        if (g_touchEventQueue) g_touchEventQueue->send(e);
-    });
-    buttons.push_back(std::move(backBtn));
+    buttonPool.releaseAll();
+    for (const ButtonDef& def : BACK_ONLY_LAYOUT) {
+        buttons.push_back(acquireButton(buttonPool, tft, def));
+    }
 }
 
 void StandbySettingsScreen::init() {
@@ -53,16 +36,16 @@ void StandbySettingsScreen::update() {
 }
 
 void StandbySettingsScreen::handleEvent(const Event& event) {
-    switch (event.type) {
+    switch (event.getType()) {
         case EVENT_TOUCH_DOWN:
         case EVENT_TOUCH_MOVE:
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button->handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         case EVENT_TOUCH_UP: {
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, false);
+                button->handleTouch(event.touch().x, event.touch().y, false);
             }
             break;
         }
@@ -71,12 +54,21 @@ void StandbySettingsScreen::handleEvent(const Event& event) {
     }
 }
 
+void StandbySettingsScreen::prepare() {
+    if (buttons.empty()) {
+        createButtons();
+    }
+}
+
 void StandbySettingsScreen::onEnter() {
-    createButtons();
+    prepare();
     needsRedraw = true;
 }
 
 void StandbySettingsScreen::onExit() {
+    // ボタンはプールに返却（破棄せず次回の訪問で再利用）
+    buttons.clear();
+    buttonPool.releaseAll();
 }
 
 
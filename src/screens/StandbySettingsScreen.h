@@ -2,20 +2,22 @@
 #define STANDBY_SETTINGS_SCREEN_H
 
 #include "BaseScreen.h"
-#include <memory>
-#include <vector>
+#include "../ui/components/WidgetList.h"
+#include "../ui/layout/ButtonPool.h"
 // 前方宣言
 class ModernButton;
 
 class StandbySettingsScreen : public BaseScreen {
 private:
-    std::vector<std::unique_ptr<ModernButton>> buttons;
+    ButtonPool<layoutCount(BACK_ONLY_LAYOUT)> buttonPool;  // 訪問をまたいで再利用
+    WidgetList<ModernButton, layoutCount(BACK_ONLY_LAYOUT)> buttons;
 public:
     StandbySettingsScreen(LGFX* display);
     void init() override;
     void draw() override;
     void update() override;
     void handleEvent(const Event& event) override;
+    void prepare() override;
     void onEnter() override;
     void onExit() override;
 private:
@@ -3,58 +3,81 @@
 #include "TimeSettingsScreen.h"
 #include <Arduino.h>
 #include "../ui/components/ModernButton.h"
-#include "../shared/EventQueue.h"
-#include <memory>
-#include <vector>
-#include <functional>
+#include "../ui/layout/LayoutTable.h"
+#include "../shared/EventBus.h"
 #include <cstdio>
 
-extern EventQueue* g_touchEventQueue;
+namespace {
+// ボタンと入力欄の色（Dark blue grey）
+constexpr ButtonStyleDef STYLE_TIME_FIELD = {
+    rgb565(55, 71, 79), rgb565(38, 50, 56), 6, 2, 0, 0xFFFF
+};
+
+const uint16_t POPUP_OVERLAY_COLOR = rgb565(33, 33, 33);
+const uint16_t POPUP_BORDER_COLOR = rgb565(100, 181, 246);
+
+// ボタン配置（動作はcreateButtonsで個別に設定する）
+constexpr UiActionDef NO_ACTION = {UI_ACTION_NONE, SCREEN_TIME_SETTINGS, TRANSITION_NONE};
+
+enum TimeButtonIndex {
+    TIME_BUTTON_BACK = 0,
+    TIME_BUTTON_YEAR,
+    TIME_BUTTON_MONTH,
+    TIME_BUTTON_DAY,
+    TIME_BUTTON_TIME
+};
+
+constexpr ButtonDef TIME_BUTTONS[] = {
+    {UI_SCREEN_WIDTH - 70, 10, 60, 30, "戻る", &STYLE_TIME_FIELD, NO_ACTION},
+    {10, 60, 90, 40, "", &STYLE_TIME_FIELD, NO_ACTION},
+    {110, 60, 90, 40, "", &STYLE_TIME_FIELD, NO_ACTION},
+    {210, 60, 90, 40, "", &STYLE_TIME_FIELD, NO_ACTION},
+    {10, 120, 190, 40, "", &STYLE_TIME_FIELD, NO_ACTION},
+};
+
+static_assert(layoutCount(TIME_BUTTONS) == TimeSettingsScreen::BUTTON_COUNT,
+              "TIME_BUTTONS must match the button pool size");
+} // namespace
+
+constexpr size_t TimeSettingsScreen::BUTTON_COUNT;
 
 TimeSettingsScreen::TimeSettingsScreen(LGFX* display)
     : BaseScreen(display, SCREEN_TIME_SETTINGS) {}
 
 void TimeSettingsScreen::createButtons() {
     buttons.clear();
-    ButtonStyle defaultStyle;
-    defaultStyle.normalColor = tft->color565(55, 71, 79);   // Dark blue grey
-    defaultStyle.pressedColor = tft->color565(38, 50, 56);
-    defaultStyle.cornerRadius = 6;
-    defaultStyle.shadowOffset = 2;
-    defaultStyle.useJapaneseFont = true;
-
-    auto makeButton = [&](int16_t x, int16_t y, uint16_t w, uint16_t h, const char* label, std::function<void()> onClick) {
-        auto btn = std::unique_ptr<ModernButton>(new ModernButton(tft, x, y, w, h, label));
-        btn->setStyle(defaultStyle);
+    buttonPool.releaseAll();
+    auto makeButton = [&](TimeButtonIndex index, const ButtonCallback& onClick) {
+        ModernButton* btn = acquireButton(buttonPool, tft, TIME_BUTTONS[index]);
+        if (!btn) {
+            return static_cast<ModernButton*>(nullptr);
+        }
         btn->setOnClick(onClick);
-        buttons.push_back(std::move(btn));
-        return buttons.back().get();
+        buttons.push_back(btn);
+        return btn;
     };
 
     backButton = makeButton(
-        tft->width() - 70, 10, 60, 30, "戻る", [this]() {
+        TIME_BUTTON_BACK, [this]() {
             closePopup(false);
-            Event e;
-            e.type = EVENT_SCREEN_CHANGE;
-            e.data.screenChange.targetScreen = SCREEN_MENU;
-            e.data.screenChange.transition = TRANSITION_SLIDE_RIGHT;
-            if (g_touchEventQueue) g_touchEventQueue->send(e);
+            Event e = makeScreenChangeEvent(SCREEN_BACK, TRANSITION_SLIDE_RIGHT);
+            if (g_eventBus) g_eventBus->publish(e);
         }
     );
 
-    yearButton = makeButton(10, 60, 90, 40, "", [this]() {
+    yearButton = makeButton(TIME_BUTTON_YEAR, [this]() {
         openPopup(TimeField::Year);
     });
 
-    monthButton = makeButton(110, 60, 90, 40, "", [this]() {
+    monthButton = makeButton(TIME_BUTTON_MONTH, [this]() {
         openPopup(TimeField::Month);
     });
 
-    dayButton = makeButton(210, 60, 90, 40, "", [this]() {
+    dayButton = makeButton(TIME_BUTTON_DAY, [this]() {
         openPopup(TimeField::Day);
     });
 
-    timeButton = makeButton(10, 120, 190, 40, "", [this]() {
+    timeButton = makeButton(TIME_BUTTON_TIME, [this]() {
         openPopup(TimeField::Time);
     });
 
@@ -100,16 +123,16 @@ void TimeSettingsScreen::handleEvent(const Event& event) {
         handlePopupTouch(event);
         return;
     }
-    switch (event.type) {
+    switch (event.getType()) {
         case EVENT_TOUCH_DOWN:
         case EVENT_TOUCH_MOVE:
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, true);
+                button->handleTouch(event.touch().x, event.touch().y, true);
             }
             break;
         case EVENT_TOUCH_UP: {
             for (auto& button : buttons) {
-                button->handleTouch(event.data.touch.x, event.data.touch.y, false);
+                button->handleTouch(event.touch().x, event.touch().y, false);
             }
             break;
         }
@@ -118,12 +141,24 @@ void TimeSettingsScreen::handleEvent(const Event& event) {
     }
 }
 
+void TimeSettingsScreen::prepare() {
+    if (buttons.empty()) {
+        createButtons();
+    }
+}
+
 void TimeSettingsScreen::onEnter() {
-    createButtons();
+    prepare();
+    // 先読みで組み立てた後に時刻が進んでいるかもしれない
+    refreshButtonLabels();
     needsRedraw = true;
 }
 
 void TimeSettingsScreen::onExit() {
+    // ボタンはプールに返却（破棄せず次回の訪問で再利用）
+    buttons.clear();
+    backButton = yearButton = monthButton = dayButton = timeButton = nullptr;
+    buttonPool.releaseAll();
 }
 
 
@@ -132,19 +167,19 @@ void TimeSettingsScreen::refreshButtonLabels() {
         return;
     }
 
-    char buffer[16];
+    WidgetText label;
 
-    snprintf(buffer, sizeof(buffer), "%04d年", year);
-    yearButton->setText(buffer);
+    label.format("%04d年", year);
+    yearButton->setText(label);
 
-    snprintf(buffer, sizeof(buffer), "%02d月", month);
-    monthButton->setText(buffer);
+    label.format("%02d月", month);
+    monthButton->setText(label);
 
-    snprintf(buffer, sizeof(buffer), "%02d日", day);
-    dayButton->setText(buffer);
+    label.format("%02d日", day);
+    dayButton->setText(label);
 
-    snprintf(buffer, sizeof(buffer), "%02d:%02d", hour, minute);
-    timeButton->setText(buffer);
+    label.format("%02d:%02d", hour, minute);
+    timeButton->setText(label);
 
     // 再描画
     yearButton->draw();
@@ -224,9 +259,9 @@ void TimeSettingsScreen::drawPopup() {
         return;
     }
 
-    const uint16_t overlayColor = tft->color565(33, 33, 33);
-    const uint16_t borderColor = tft->color565(100, 181, 246);
-    const uint16_t buttonColor = tft->color565(55, 71, 79);
+    const uint16_t overlayColor = POPUP_OVERLAY_COLOR;
+    const uint16_t borderColor = POPUP_BORDER_COLOR;
+    const uint16_t buttonColor = STYLE_TIME_FIELD.normalColor;
 
     tft->fillRoundRect(popupRect.x - 4, popupRect.y - 4, popupRect.w + 8, popupRect.h + 8, 10, TFT_BLACK);
     tft->fillRoundRect(popupRect.x, popupRect.y, popupRect.w, popupRect.h, 8, overlayColor);
@@ -327,10 +362,10 @@ void TimeSettingsScreen::handlePopupTouch(const Event& event) {
         return;
     }
 
-    const int32_t x = event.data.touch.x;
-    const int32_t y = event.data.touch.y;
+    const int32_t x = event.touch().x;
+    const int32_t y = event.touch().y;
 
-    switch (event.type) {
+    switch (event.getType()) {
         case EVENT_TOUCH_DOWN:
             if (popupField != TimeField::Time) {
                 if (isPointInside(popupIncrementRect, x, y)) {
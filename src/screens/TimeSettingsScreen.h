@@ -2,14 +2,17 @@
 #define TIME_SETTINGS_SCREEN_H
 
 #include "BaseScreen.h"
-#include <memory>
-#include <vector>
+#include "../ui/components/WidgetList.h"
+#include "../ui/layout/ButtonPool.h"
 // 前方宣言
 class ModernButton;
 
 class TimeSettingsScreen : public BaseScreen {
+public:
+    static constexpr size_t BUTTON_COUNT = 5;  // 戻る + 年/月/日/時刻
 private:
-    std::vector<std::unique_ptr<ModernButton>> buttons;
+    ButtonPool<BUTTON_COUNT> buttonPool;  // 訪問をまたいで再利用
+    WidgetList<ModernButton, BUTTON_COUNT> buttons;
     ModernButton* backButton = nullptr;
     ModernButton* yearButton = nullptr;
     ModernButton* monthButton = nullptr;
@@ -64,8 +67,10 @@ public:
     void draw() override;
     void update() override;
     void handleEvent(const Event& event) override;
+    void prepare() override;
     void onEnter() override;
     void onExit() override;
+    bool isEvictable() const override { return false; }  // 設定値を保持するため常駐
 private:
     void createButtons();
     void refreshButtonLabels();
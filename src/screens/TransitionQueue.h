@@ -0,0 +1,187 @@
+#ifndef TRANSITION_QUEUE_H
+#define TRANSITION_QUEUE_H
+
+#include <cstdint>
+#include "BaseScreen.h"
+
+// フェード遷移の全体時間（ミリ秒、暗転と復帰で半分ずつ）
+#ifndef TRANSITION_FADE_MS
+#define TRANSITION_FADE_MS 160
+#endif
+
+struct TransitionRequest {
+    ScreenID target;
+    TransitionType type;
+};
+
+// 画面遷移の待ち行列
+// 要求は1件だけ保持し、処理前に次の要求が来たら置き換える（A→B→CはA→C）。
+// フェードはバックライトの段階的な変化として複数フレームで進め、
+// 途中で新しい要求が来たら現在の明るさから新しい遷移に切り替える。
+// 時刻は呼び出し側から渡すので、実機なしで動作を検証できる。
+class TransitionQueue {
+public:
+    // advance()が返す1フレーム分の指示
+    struct Step {
+        bool started;           // 遷移の連鎖が始まった（基準の明るさを記録する）
+        bool setLevel;          // 明るさを変更する
+        uint8_t level;          // 基準の明るさに対する割合（0-255）
+        bool swap;              // 画面を切り替える
+        TransitionRequest request;
+    };
+
+private:
+    enum Phase {
+        PHASE_IDLE = 0,
+        PHASE_FADE_OUT,
+        PHASE_FADE_IN
+    };
+
+    Phase phase;
+    bool hasPending;
+    TransitionRequest pending;
+    uint16_t fadeMs;
+    uint32_t phaseStartMs;
+    uint8_t phaseStartLevel;
+    uint8_t currentLevel;
+    uint32_t chainStartMs;
+
+    uint32_t requestCount;
+    uint32_t collapsedCount;
+    uint32_t cancelledCount;
+    uint32_t completedCount;
+    uint32_t lastLatencyMs;
+
+    static Step emptyStep() {
+        Step step;
+        step.started = false;
+        step.setLevel = false;
+        step.level = 255;
+        step.swap = false;
+        step.request.target = SCREEN_HOME;
+        step.request.type = TRANSITION_NONE;
+        return step;
+    }
+
+    // 開始時の明るさから目標へ線形に変化させた現在値
+    uint8_t rampLevel(uint32_t nowMs, uint8_t target, uint32_t durationMs) const {
+        uint32_t elapsed = nowMs - phaseStartMs;
+        if (durationMs == 0 || elapsed >= durationMs) {
+            return target;
+        }
+        int32_t delta = static_cast<int32_t>(target) - phaseStartLevel;
+        return static_cast<uint8_t>(phaseStartLevel + delta * static_cast<int32_t>(elapsed) / static_cast<int32_t>(durationMs));
+    }
+
+    void enterPhase(Phase next, uint32_t nowMs) {
+        phase = next;
+        phaseStartMs = nowMs;
+        phaseStartLevel = currentLevel;
+    }
+
+    void finishChain(uint32_t nowMs) {
+        phase = PHASE_IDLE;
+        completedCount++;
+        lastLatencyMs = nowMs - chainStartMs;
+    }
+
+public:
+    explicit TransitionQueue(uint16_t fadeDurationMs = TRANSITION_FADE_MS)
+        : phase(PHASE_IDLE), hasPending(false), fadeMs(fadeDurationMs),
+          phaseStartMs(0), phaseStartLevel(255), currentLevel(255), chainStartMs(0),
+          requestCount(0), collapsedCount(0), cancelledCount(0), completedCount(0),
+          lastLatencyMs(0) {
+        pending.target = SCREEN_HOME;
+        pending.type = TRANSITION_NONE;
+    }
+
+    // 遷移を要求（未処理の要求があれば置き換える）
+    void request(ScreenID target, TransitionType type, uint32_t nowMs) {
+        requestCount++;
+        if (hasPending) {
+            collapsedCount++;
+        } else if (phase == PHASE_FADE_IN) {
+            // 復帰中のアニメーションは打ち切り、次のadvanceで新しい遷移を始める
+            cancelledCount++;
+        } else if (phase == PHASE_IDLE) {
+            chainStartMs = nowMs;
+        }
+        pending.target = target;
+        pending.type = type;
+        hasPending = true;
+    }
+
+    // 1フレーム進める
+    Step advance(uint32_t nowMs) {
+        Step step = emptyStep();
+        const uint32_t halfMs = fadeMs / 2;
+
+        if (phase == PHASE_FADE_IN && hasPending) {
+            // 新しい要求が来たので、現在の明るさから切り替える
+            if (pending.type == TRANSITION_FADE) {
+                enterPhase(PHASE_FADE_OUT, nowMs);
+            } else {
+                phase = PHASE_IDLE;
+            }
+        }
+
+        if (phase == PHASE_IDLE) {
+            if (!hasPending) {
+                return step;
+            }
+            if (pending.type == TRANSITION_FADE) {
+                step.started = currentLevel == 255;
+                enterPhase(PHASE_FADE_OUT, nowMs);
+            } else {
+                // アニメーションなし: 即座に切り替えて明るさを戻す
+                step.swap = true;
+                step.request = pending;
+                hasPending = false;
+                if (currentLevel != 255) {
+                    currentLevel = 255;
+                    step.setLevel = true;
+                    step.level = currentLevel;
+                }
+                finishChain(nowMs);
+                return step;
+            }
+        }
+
+        if (phase == PHASE_FADE_OUT) {
+            uint32_t remaining = halfMs * phaseStartLevel / 255;
+            currentLevel = rampLevel(nowMs, 0, remaining);
+            step.setLevel = true;
+            step.level = currentLevel;
+            if (currentLevel == 0) {
+                // 暗転しきったら最新の要求先に切り替えて復帰を始める
+                step.swap = true;
+                step.request = pending;
+                hasPending = false;
+                enterPhase(PHASE_FADE_IN, nowMs);
+            }
+            return step;
+        }
+
+        if (phase == PHASE_FADE_IN) {
+            currentLevel = rampLevel(nowMs, 255, halfMs);
+            step.setLevel = true;
+            step.level = currentLevel;
+            if (currentLevel == 255) {
+                finishChain(nowMs);
+            }
+        }
+        return step;
+    }
+
+    // 遷移待ちまたはアニメーション中
+    bool isBusy() const { return hasPending || phase != PHASE_IDLE; }
+
+    uint8_t getLevel() const { return currentLevel; }
+    uint32_t getRequestCount() const { return requestCount; }
+    uint32_t getCollapsedCount() const { return collapsedCount; }
+    uint32_t getCancelledCount() const { return cancelledCount; }
+    uint32_t getCompletedCount() const { return completedCount; }
+    uint32_t getLastLatencyMs() const { return lastLatencyMs; }
+};
+
+#endif // TRANSITION_QUEUE_H
@@ -0,0 +1,61 @@
+#ifndef DELEGATE_H
+#define DELEGATE_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// キャプチャ領域の既定サイズ（ポインタ2個分: thisと追加の値1つ）
+#ifndef DELEGATE_DEFAULT_CAPACITY
+#define DELEGATE_DEFAULT_CAPACITY (2 * sizeof(void*))
+#endif
+
+template <typename Signature, size_t Capacity = DELEGATE_DEFAULT_CAPACITY>
+class Delegate;
+
+// ヒープを使わない固定サイズのコールバック
+// キャプチャはメンバ内の領域に保持し、サイズ超過はコンパイルエラーにする。
+// キャプチャはトリビアルにコピー可能なものに限るため、Delegate自体も
+// memcpyで移動できる（std::functionのような確保・解放が発生しない）。
+template <typename R, typename... Args, size_t Capacity>
+class Delegate<R(Args...), Capacity> {
+private:
+    typedef R (*Invoker)(void* storage, Args... args);
+    typedef typename std::aligned_storage<Capacity, alignof(void*)>::type Storage;
+
+    mutable Storage storage;
+    Invoker invoker;
+
+    template <typename F>
+    static R invokeCallable(void* target, Args... args) {
+        return (*static_cast<F*>(target))(std::forward<Args>(args)...);
+    }
+
+public:
+    Delegate() : storage(), invoker(nullptr) {}
+    Delegate(std::nullptr_t) : storage(), invoker(nullptr) {}
+
+    template <typename F,
+              typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Delegate>::value>::type>
+    Delegate(F callable) : storage(), invoker(&invokeCallable<F>) {
+        static_assert(sizeof(F) <= Capacity, "Delegate: capture is larger than the inline buffer");
+        static_assert(alignof(F) <= alignof(Storage), "Delegate: capture alignment is too strict");
+        static_assert(std::is_trivially_copyable<F>::value,
+                      "Delegate: captures must be trivially copyable (capture pointers or values, not std::string)");
+        static_assert(std::is_trivially_destructible<F>::value, "Delegate: captures must be trivially destructible");
+        new (&storage) F(callable);
+    }
+
+    R operator()(Args... args) const {
+        return invoker(&storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return invoker != nullptr; }
+
+    void reset() { invoker = nullptr; }
+
+    static constexpr size_t capacity() { return Capacity; }
+};
+
+#endif // DELEGATE_H
@@ -0,0 +1,14 @@
+#include "EventBus.h"
+
+// グローバルイベントバスのインスタンス
+EventBus* g_eventBus = nullptr;
+
+size_t EventBus::dispatchPending() {
+    size_t dispatched = 0;
+    Event event;
+    while (lanes.receive(event)) {
+        dispatcher.dispatch(event);
+        dispatched++;
+    }
+    return dispatched;
+}
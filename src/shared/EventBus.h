@@ -0,0 +1,40 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <cstddef>
+#include "Events.h"
+#include "EventLanes.h"
+#include "EventDispatcher.h"
+
+// トピック別のpublish/subscribeイベントバス
+// publish()はどのコアからでも呼べ、イベントはEventLanesで表示コアへ運ばれる。
+// 表示コアはdispatchPending()で取り出し、トピックの購読者だけに参照で配信する。
+class EventBus {
+private:
+    EventLanes lanes;
+    EventDispatcher dispatcher;
+
+public:
+    EventBus() {}
+
+    // イベントを発行（ノンブロッキング、満杯時はレーンのポリシーに従う）
+    bool publish(const Event& event) { return lanes.send(event); }
+
+    // 購読（表示コアから呼ぶこと）
+    bool subscribe(EventTopic topic, const void* owner, const EventHandler& handler) {
+        return dispatcher.subscribe(topic, owner, handler);
+    }
+    void unsubscribe(const void* owner) { dispatcher.unsubscribe(owner); }
+
+    // 溜まっているイベントを優先度順にすべて配信（配信した数を返す）
+    size_t dispatchPending();
+
+    EventLanes& getLanes() { return lanes; }
+    const EventLanes& getLanes() const { return lanes; }
+    const EventDispatcher& getDispatcher() const { return dispatcher; }
+};
+
+// グローバルイベントバス（Core1 → Core0、画面内の通知も同じ経路）
+extern EventBus* g_eventBus;
+
+#endif // EVENT_BUS_H
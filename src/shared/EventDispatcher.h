@@ -0,0 +1,108 @@
+#ifndef EVENT_DISPATCHER_H
+#define EVENT_DISPATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Delegate.h"
+#include "Events.h"
+
+// トピックごとの最大購読数
+#ifndef EVENT_BUS_MAX_SUBSCRIBERS
+#define EVENT_BUS_MAX_SUBSCRIBERS 4
+#endif
+
+// イベントのトピック（購読の単位）
+enum EventTopic : uint8_t {
+    TOPIC_TOUCH = 0,        // タッチ開始/移動/終了
+    TOPIC_GESTURE,          // スワイプ
+    TOPIC_NAVIGATION,       // 画面遷移要求
+    TOPIC_SYSTEM,           // その他の通知
+    TOPIC_COUNT
+};
+
+// 種別からトピックをコンパイル時に決定
+constexpr EventTopic topicOf(EventType type) {
+    return (type == EVENT_TOUCH_DOWN || type == EVENT_TOUCH_UP ||
+            type == EVENT_TOUCH_MOVE || type == EVENT_TOUCH_DRAG) ? TOPIC_TOUCH :
+           (type == EVENT_GESTURE_SWIPE) ? TOPIC_GESTURE :
+           (type == EVENT_SCREEN_CHANGE) ? TOPIC_NAVIGATION :
+           TOPIC_SYSTEM;
+}
+
+static_assert(topicOf(EVENT_TOUCH_MOVE) == TOPIC_TOUCH, "touch events map to TOPIC_TOUCH");
+static_assert(topicOf(EVENT_SCREEN_CHANGE) == TOPIC_NAVIGATION, "screen changes map to TOPIC_NAVIGATION");
+
+// 購読者のハンドラ（イベントは参照で渡し、コピーしない）
+typedef Delegate<void(const Event&)> EventHandler;
+
+// トピック別の購読表とディスパッチ
+// 購読・解除・配信はすべて表示コアから行う前提（ロックなし）。
+// ハンドラの中で購読の登録・解除は行わないこと。
+// 配信はイベントのトピックの購読者だけを呼ぶので、コストは
+// 画面数やイベント種別数ではなく、そのトピックの購読者数に比例する。
+class EventDispatcher {
+private:
+    struct Subscriber {
+        const void* owner;
+        EventHandler handler;
+    };
+
+    Subscriber subscribers[TOPIC_COUNT][EVENT_BUS_MAX_SUBSCRIBERS];
+    uint8_t counts[TOPIC_COUNT];
+    uint32_t dispatchCount;
+    uint32_t unhandledCount;
+
+public:
+    EventDispatcher() : dispatchCount(0), unhandledCount(0) {
+        for (size_t i = 0; i < TOPIC_COUNT; i++) {
+            counts[i] = 0;
+        }
+    }
+
+    // 購読を登録（ownerは解除時のキー）。表が満杯ならfalse
+    // 同じトピックの購読者は登録順に呼ばれる
+    bool subscribe(EventTopic topic, const void* owner, const EventHandler& handler) {
+        if (topic >= TOPIC_COUNT || !handler || counts[topic] >= EVENT_BUS_MAX_SUBSCRIBERS) {
+            return false;
+        }
+        Subscriber& entry = subscribers[topic][counts[topic]++];
+        entry.owner = owner;
+        entry.handler = handler;
+        return true;
+    }
+
+    // ownerの購読をすべて解除（残りの登録順は保つ）
+    void unsubscribe(const void* owner) {
+        for (size_t topic = 0; topic < TOPIC_COUNT; topic++) {
+            uint8_t kept = 0;
+            for (uint8_t i = 0; i < counts[topic]; i++) {
+                if (subscribers[topic][i].owner != owner) {
+                    subscribers[topic][kept++] = subscribers[topic][i];
+                }
+            }
+            counts[topic] = kept;
+        }
+    }
+
+    // 購読者へ配信（購読者がいなければfalse）
+    bool dispatch(const Event& event) {
+        EventTopic topic = topicOf(event.getType());
+        uint8_t count = counts[topic];
+        dispatchCount++;
+        if (count == 0) {
+            unhandledCount++;
+            return false;
+        }
+        const Subscriber* list = subscribers[topic];
+        for (uint8_t i = 0; i < count; i++) {
+            list[i].handler(event);
+        }
+        return true;
+    }
+
+    size_t getSubscriberCount(EventTopic topic) const { return topic < TOPIC_COUNT ? counts[topic] : 0; }
+    uint32_t getDispatchCount() const { return dispatchCount; }
+    uint32_t getUnhandledCount() const { return unhandledCount; }
+};
+
+#endif // EVENT_DISPATCHER_H
@@ -0,0 +1,146 @@
+#include "EventLanes.h"
+
+namespace {
+// レーンごとの容量と満杯時のポリシー
+const EventLaneConfig LANE_CONFIG[EVENT_LANE_COUNT] = {
+    {"control", 8,  EVENT_DROP_NEWEST},
+    {"gesture", 24, EVENT_KEEP_TOUCH_PAIRS},
+    {"motion",  MotionChannel::DEPTH, EVENT_COALESCE},
+};
+
+// 16bitの通し番号を一周を考慮して比較
+bool sequenceBefore(uint16_t a, uint16_t b) {
+    return static_cast<int16_t>(a - b) < 0;
+}
+} // namespace
+
+EventLanes::EventLanes() : nextSequence(0), pressOpen(false), pressDropped(false) {
+    for (int i = 0; i < EVENT_LANE_COUNT; i++) {
+        if (LANE_CONFIG[i].policy != EVENT_COALESCE) {
+            lanes[i].reset(new EventQueue(LANE_CONFIG[i].capacity));
+        }
+        dropCounts[i].store(0);
+    }
+}
+
+EventLane EventLanes::laneFor(EventType type) {
+    switch (type) {
+        case EVENT_TOUCH_MOVE:
+        case EVENT_TOUCH_DRAG:
+            return EVENT_LANE_MOTION;
+        case EVENT_TOUCH_DOWN:
+        case EVENT_TOUCH_UP:
+        case EVENT_GESTURE_SWIPE:
+            return EVENT_LANE_GESTURE;
+        default:
+            return EVENT_LANE_CONTROL;
+    }
+}
+
+const EventLaneConfig& EventLanes::getConfig(EventLane lane) {
+    return LANE_CONFIG[lane];
+}
+
+bool EventLanes::send(const Event& event) {
+    EventLane lane = laneFor(event.getType());
+
+    Event stamped = event;
+    stamped.sequence = static_cast<uint16_t>(nextSequence.fetch_add(1));
+
+    if (lane == EVENT_LANE_MOTION) {
+        if (pressDropped) {
+            // 押下を捨てたタッチの移動も渡さない（ボタンが押されたまま残らないように）
+            dropCounts[lane].fetch_add(1);
+            return false;
+        }
+        motion.post(stamped);
+        return true;
+    }
+    if (stamped.is(EVENT_TOUCH_DOWN)) {
+        // 新しいタッチでは前回の軌跡を速度計算に使わない
+        motion.clearHistory();
+    }
+
+    if (LANE_CONFIG[lane].policy == EVENT_KEEP_TOUCH_PAIRS) {
+        return sendTouchPair(lane, stamped);
+    }
+
+    if (lanes[lane]->send(stamped)) {
+        return true;
+    }
+    dropCounts[lane].fetch_add(1);
+    return false;
+}
+
+bool EventLanes::sendTouchPair(EventLane lane, const Event& event) {
+    EventQueue& queue = *lanes[lane];
+    if (event.is(EVENT_TOUCH_UP)) {
+        if (pressDropped) {
+            // 押下を捨てたタッチの解放（画面は押下を見ていない）
+            pressDropped = false;
+            dropCounts[lane].fetch_add(1);
+            return false;
+        }
+        // 押下を受け付けたときに空けておいた枠に入る
+        pressOpen = false;
+        if (queue.send(event)) {
+            return true;
+        }
+        dropCounts[lane].fetch_add(1);
+        return false;
+    }
+
+    // 押下は自分と対の解放の2枠、それ以外は受け付け済みの押下の解放の枠を残して1枠
+    // （受信側が同時に取り出しても空きが増えるだけ）
+    bool press = event.is(EVENT_TOUCH_DOWN);
+    size_t needed = press ? 2 : 1 + (pressOpen ? 1 : 0);
+    if (queue.getCount() + needed <= LANE_CONFIG[lane].capacity && queue.send(event)) {
+        if (press) {
+            pressOpen = true;
+            pressDropped = false;
+        }
+        return true;
+    }
+    if (press) {
+        pressDropped = true;
+    }
+    dropCounts[lane].fetch_add(1);
+    return false;
+}
+
+bool EventLanes::receive(Event& event) {
+    // 制御イベントは常に先に処理
+    if (lanes[EVENT_LANE_CONTROL]->receive(event)) {
+        return true;
+    }
+
+    // ジェスチャーと移動は送信順に合流（DOWN→MOVE→UPの順序を保つ）
+    Event nextGesture;
+    Event nextMotion;
+    bool hasGesture = lanes[EVENT_LANE_GESTURE]->peek(nextGesture);
+    bool hasMotion = motion.peek(nextMotion);
+
+    if (hasGesture && (!hasMotion || sequenceBefore(nextGesture.sequence, nextMotion.sequence))) {
+        return lanes[EVENT_LANE_GESTURE]->receive(event);
+    }
+    if (hasMotion) {
+        return motion.take(event);
+    }
+    return false;
+}
+
+size_t EventLanes::getCount(EventLane lane) const {
+    return lanes[lane] ? lanes[lane]->getCount() : motion.getCount();
+}
+
+size_t EventLanes::getTotalCount() const {
+    size_t total = 0;
+    for (int i = 0; i < EVENT_LANE_COUNT; i++) {
+        total += getCount(static_cast<EventLane>(i));
+    }
+    return total;
+}
+
+uint32_t EventLanes::getDropCount(EventLane lane) const {
+    return dropCounts[lane].load() + (lane == EVENT_LANE_MOTION ? motion.getDropCount() : 0);
+}
@@ -0,0 +1,78 @@
+#ifndef EVENT_LANES_H
+#define EVENT_LANES_H
+
+#include <atomic>
+#include <memory>
+#include "Events.h"
+#include "EventQueue.h"
+#include "MotionChannel.h"
+
+// イベントのレーン（優先度順）
+enum EventLane {
+    EVENT_LANE_CONTROL = 0,     // 画面遷移・システム通知（最優先、少量）
+    EVENT_LANE_GESTURE,         // タッチ開始/終了・スワイプ
+    EVENT_LANE_MOTION,          // 高頻度のタッチ移動（未処理分は最新位置に合流）
+    EVENT_LANE_COUNT
+};
+
+// レーンが満杯の時の扱い
+enum EventDropPolicy {
+    EVENT_DROP_NEWEST = 0,      // 新しいイベントを捨てる（キュー内の順序を保つ）
+    EVENT_KEEP_TOUCH_PAIRS,     // 新しいものを捨てるが、タッチの押下と解放は片方だけを捨てない
+    EVENT_COALESCE              // 未処理の同種イベントを最新の内容で上書き
+};
+
+struct EventLaneConfig {
+    const char* name;
+    size_t capacity;
+    EventDropPolicy policy;
+};
+
+// 優先度付きの複数レーンイベントキュー
+// 種別ごとにレーンを分け、TOUCH_MOVEの連続で画面遷移イベントが
+// 押し出されないようにする。受信側は制御レーンを先に取り出し、
+// ジェスチャーと移動は送信順（sequence）で合流させて順序を保つ。
+// 移動レーンはキューではなくMotionChannelで、受信側が遅れている間の
+// TOUCH_MOVEを最新位置にまとめる（滞留数は常に小さく抑えられる）。
+// ジェスチャーレーンは押下を受け付けるときに対になる解放の枠も空けておくので、
+// 画面が押したままの状態で取り残されることはない。溢れたときは押下ごと
+// （対の解放も一緒に）捨てるか、スワイプを捨てる。
+class EventLanes {
+private:
+    std::unique_ptr<EventQueue> lanes[EVENT_LANE_COUNT];   // 制御・ジェスチャー（移動はnullptr）
+    MotionChannel motion;
+    std::atomic<uint32_t> dropCounts[EVENT_LANE_COUNT];
+    std::atomic<uint32_t> nextSequence;
+
+    // 押下と解放の対（ジェスチャーレーンへ送るのはタッチのタスクだけ）
+    bool pressOpen;             // 受け付けた押下の解放がまだ来ていない（1枠確保済み）
+    bool pressDropped;          // 押下を捨てたので、対の解放も捨てる
+
+    bool sendTouchPair(EventLane lane, const Event& event);
+
+public:
+    EventLanes();
+
+    // イベントを種別に応じたレーンへ送信（ノンブロッキング）
+    // 満杯時はレーンのポリシーに従って捨て、捨てた数を記録する
+    bool send(const Event& event);
+
+    // 優先度順にイベントを1つ受信（ノンブロッキング）
+    bool receive(Event& event);
+
+    // 種別からレーンを決定
+    static EventLane laneFor(EventType type);
+    static const EventLaneConfig& getConfig(EventLane lane);
+
+    size_t getCount(EventLane lane) const;
+    size_t getTotalCount() const;
+    uint32_t getDropCount(EventLane lane) const;
+    uint32_t getCoalescedCount() const { return motion.getCoalescedCount(); }
+
+    // 現在のタッチの移動速度（px/秒）。合流で捨てた座標も含めて計算する
+    bool estimateMotionVelocity(uint32_t windowUs, float& vx, float& vy) const {
+        return motion.estimateVelocity(windowUs, vx, vy);
+    }
+};
+
+#endif // EVENT_LANES_H
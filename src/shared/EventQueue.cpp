@@ -1,4 +0,0 @@
-#include "EventQueue.h"
-
-// グローバルイベントキューのインスタンス
-EventQueue* g_touchEventQueue = nullptr;
\ No newline at end of file
@@ -41,6 +41,11 @@ public:
         return xQueueReceive(queue, &event, wait_ticks) == pdTRUE;
     }
     
+    // 先頭のイベントを取り出さずに参照（ノンブロッキング）
+    bool peek(Event& event) {
+        return xQueuePeek(queue, &event, 0) == pdTRUE;
+    }
+    
     // キューが空かチェック
     bool isEmpty() const {
         return uxQueueMessagesWaiting(queue) == 0;
@@ -50,9 +55,11 @@ public:
     size_t getCount() const {
         return uxQueueMessagesWaiting(queue);
     }
+    
+    // キューの容量を取得
+    size_t getCapacity() const {
+        return queue_size;
+    }
 };
 
-// グローバルイベントキュー（Core1 → Core0）
-extern EventQueue* g_touchEventQueue;
-
 #endif // EVENT_QUEUE_H
\ No newline at end of file
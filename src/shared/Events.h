@@ -2,6 +2,7 @@
 #define EVENTS_H
 
 #include <cstdint>
+#include <type_traits>
 
 // イベントタイプ定義
 enum EventType {
@@ -14,52 +15,144 @@ enum EventType {
     EVENT_DISPLAY_UPDATE,
     EVENT_SYSTEM_STATUS,
     EVENT_SCREEN_CHANGE,
-    EVENT_SHOW_RESET_MESSAGE
+    EVENT_SHOW_RESET_MESSAGE,
+    EVENT_SD_RESULT             // SDサービスの要求結果（途中経過を含む）
 };
 
-// タッチイベントデータ
+// タッチイベントデータ（座標は画面サイズに収まるので16bit）
 struct TouchEvent {
-    EventType type;
-    int32_t x;
-    int32_t y;
-    int32_t raw_x;
-    int32_t raw_y;
-    uint32_t timestamp;
-    uint8_t pressure;
+    int16_t x;
+    int16_t y;
+    int16_t rawX;
+    int16_t rawY;
+    uint32_t timestampUs;   // micros()の下位32bit（約71分で一周）
 };
 
 // ジェスチャーイベントデータ
 struct GestureEvent {
-    EventType type;
     enum Direction {
         GESTURE_NONE,
         GESTURE_UP,
         GESTURE_DOWN,
         GESTURE_LEFT,
         GESTURE_RIGHT
-    } direction;
-    int32_t start_x;
-    int32_t start_y;
-    int32_t end_x;
-    int32_t end_y;
-    uint32_t duration_ms;
+    };
+    int16_t startX;
+    int16_t startY;
+    int16_t endX;
+    int16_t endY;
+    uint16_t durationMs;
+    uint8_t direction;      // Direction
+    uint8_t reserved;
 };
 
 // 画面遷移イベントデータ
 struct ScreenChangeEvent {
-    EventType type;
-    int targetScreen;  // ScreenID
-    int transition;    // TransitionType
+    uint8_t targetScreen;   // ScreenID
+    uint8_t transition;     // TransitionType
 };
 
-// 汎用イベント構造体
+// SDサービスの要求結果
+struct SdResultEvent {
+    uint16_t requestId;     // 要求時に返されたID
+    uint8_t op;             // SdOp
+    uint8_t status;         // SdStatus
+    uint32_t value;         // 件数・バイト数など（要求の種類による）
+    uint32_t aux;           // 補助値（スキャンでは調べたエントリ数）
+};
+
+// 汎用イベント構造体（キューの1スロット = 16バイト）
+// 種別とフラグは1バイトずつに詰め、ペイロードは種別ごとの共用体。
+// 読み書きはアクセサとmake*Event()を通して行う。
 struct Event {
-    EventType type;
+    uint8_t typeCode;       // EventType
+    uint8_t flags;          // 種別ごとの補助フラグ（未使用時は0）
+    uint16_t sequence;      // 送信順の通し番号（EventLanesが付与、レーン間の順序復元用）
     union {
         TouchEvent touch;
         GestureEvent gesture;
         ScreenChangeEvent screenChange;
+        SdResultEvent sdResult;
     } data;
+
+    EventType getType() const { return static_cast<EventType>(typeCode); }
+    bool is(EventType type) const { return typeCode == static_cast<uint8_t>(type); }
+
+    const TouchEvent& touch() const { return data.touch; }
+    const GestureEvent& gesture() const { return data.gesture; }
+    const ScreenChangeEvent& screenChange() const { return data.screenChange; }
+    const SdResultEvent& sdResult() const { return data.sdResult; }
+
+    GestureEvent::Direction gestureDirection() const {
+        return static_cast<GestureEvent::Direction>(data.gesture.direction);
+    }
+};
+
+// Event::flags
+enum : uint8_t {
+    EVENT_FLAG_COALESCED = 0x01     // 未処理の移動イベントを最新位置にまとめたもの
 };
 
-#endif // EVENTS_H
\ No newline at end of file
+static_assert(sizeof(TouchEvent) == 12, "TouchEvent must stay 12 bytes");
+static_assert(sizeof(GestureEvent) == 12, "GestureEvent must stay 12 bytes");
+static_assert(sizeof(SdResultEvent) == 12, "SdResultEvent must stay 12 bytes");
+static_assert(sizeof(Event) == 16, "Event must fit a 16-byte queue slot");
+static_assert(std::is_trivially_copyable<Event>::value, "Event is copied by memcpy into the queue");
+
+// 16bitに収まるよう座標を丸める
+inline int16_t clampEventCoord(int32_t value) {
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return static_cast<int16_t>(value);
+}
+
+inline Event makeEvent(EventType type) {
+    Event event;
+    event.typeCode = static_cast<uint8_t>(type);
+    event.flags = 0;
+    event.sequence = 0;
+    event.data.touch = TouchEvent();
+    return event;
+}
+
+inline Event makeTouchEvent(EventType type, int32_t x, int32_t y, int32_t rawX, int32_t rawY, uint32_t timestampUs) {
+    Event event = makeEvent(type);
+    event.data.touch.x = clampEventCoord(x);
+    event.data.touch.y = clampEventCoord(y);
+    event.data.touch.rawX = clampEventCoord(rawX);
+    event.data.touch.rawY = clampEventCoord(rawY);
+    event.data.touch.timestampUs = timestampUs;
+    return event;
+}
+
+inline Event makeGestureEvent(GestureEvent::Direction direction, int32_t startX, int32_t startY,
+                              int32_t endX, int32_t endY, uint32_t durationMs) {
+    Event event = makeEvent(EVENT_GESTURE_SWIPE);
+    event.data.gesture.startX = clampEventCoord(startX);
+    event.data.gesture.startY = clampEventCoord(startY);
+    event.data.gesture.endX = clampEventCoord(endX);
+    event.data.gesture.endY = clampEventCoord(endY);
+    event.data.gesture.durationMs = static_cast<uint16_t>(durationMs > UINT16_MAX ? UINT16_MAX : durationMs);
+    event.data.gesture.direction = static_cast<uint8_t>(direction);
+    event.data.gesture.reserved = 0;
+    return event;
+}
+
+inline Event makeScreenChangeEvent(int targetScreen, int transition) {
+    Event event = makeEvent(EVENT_SCREEN_CHANGE);
+    event.data.screenChange.targetScreen = static_cast<uint8_t>(targetScreen);
+    event.data.screenChange.transition = static_cast<uint8_t>(transition);
+    return event;
+}
+
+inline Event makeSdResultEvent(uint16_t requestId, uint8_t op, uint8_t status, uint32_t value, uint32_t aux) {
+    Event event = makeEvent(EVENT_SD_RESULT);
+    event.data.sdResult.requestId = requestId;
+    event.data.sdResult.op = op;
+    event.data.sdResult.status = status;
+    event.data.sdResult.value = value;
+    event.data.sdResult.aux = aux;
+    return event;
+}
+
+#endif // EVENTS_H
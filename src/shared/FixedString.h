@@ -0,0 +1,178 @@
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// 文字列ハッシュ（FNV-1a 32bit）
+inline uint32_t hashString(const char* text, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(text[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// 大文字小文字を区別しない末尾一致（ASCIIのみ）
+inline bool endsWithIgnoreCase(const char* text, const char* suffix) {
+    size_t textLength = strlen(text);
+    size_t suffixLength = strlen(suffix);
+    if (suffixLength > textLength) {
+        return false;
+    }
+    const char* tail = text + textLength - suffixLength;
+    for (size_t i = 0; i < suffixLength; ++i) {
+        char a = tail[i];
+        char b = suffix[i];
+        if (a >= 'A' && a <= 'Z') a = static_cast<char>(a - 'A' + 'a');
+        if (b >= 'A' && b <= 'Z') b = static_cast<char>(b - 'A' + 'a');
+        if (a != b) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// UTF-8の文字境界で切り詰めた長さを返す（末尾の不完全な文字を落とす）
+inline size_t utf8TruncatedLength(const char* text, size_t length) {
+    size_t start = length;
+    size_t continuation = 0;
+    while (start > 0 && continuation < 4 && (static_cast<uint8_t>(text[start - 1]) & 0xC0) == 0x80) {
+        --start;
+        ++continuation;
+    }
+    if (start == 0) {
+        return continuation > 0 ? 0 : length;
+    }
+    uint8_t lead = static_cast<uint8_t>(text[start - 1]);
+    size_t expected = 1;
+    if ((lead & 0xE0) == 0xC0) expected = 2;
+    else if ((lead & 0xF0) == 0xE0) expected = 3;
+    else if ((lead & 0xF8) == 0xF0) expected = 4;
+    if (expected == 1) {
+        // ASCIIの後ろに孤立した継続バイトがある場合は落とす
+        return start;
+    }
+    return (continuation + 1 < expected) ? start - 1 : length;
+}
+
+// 固定容量のインラインUTF-8文字列
+// ウィジェットのテキストをヒープを使わずに保持する。内容が変わるたびに
+// ハッシュと「マルチバイト文字を含むか」をキャッシュするため、比較は
+// 通常ハッシュ1回で済み、描画時にフォント判定で全文を走査しなくてよい。
+template <size_t N>
+class FixedString {
+private:
+    static_assert(N > 1 && N <= 256, "FixedString capacity must be 2..256 bytes");
+
+    char buffer[N];
+    uint8_t length;
+    bool multibyte;
+    uint32_t hashValue;
+
+    void finish(size_t newLength) {
+        length = static_cast<uint8_t>(utf8TruncatedLength(buffer, newLength));
+        buffer[length] = '\0';
+        multibyte = false;
+        for (size_t i = 0; i < length; ++i) {
+            if (static_cast<uint8_t>(buffer[i]) >= 0x80) {
+                multibyte = true;
+                break;
+            }
+        }
+        hashValue = hashString(buffer, length);
+    }
+
+public:
+    FixedString() : length(0), multibyte(false), hashValue(hashString("", 0)) { buffer[0] = '\0'; }
+    FixedString(const char* text) : length(0), multibyte(false), hashValue(0) { assign(text); }
+
+    // 代入（容量を超える場合は文字境界で切り詰め）
+    void assign(const char* text) {
+        assign(text, text ? strlen(text) : 0);
+    }
+
+    void assign(const char* text, size_t textLength) {
+        if (textLength > N - 1) {
+            textLength = N - 1;
+        }
+        if (textLength > 0) {
+            memmove(buffer, text, textLength);
+        }
+        finish(textLength);
+    }
+
+    FixedString& operator=(const char* text) {
+        assign(text);
+        return *this;
+    }
+
+    void append(const char* text) {
+        size_t textLength = strlen(text);
+        size_t room = N - 1 - length;
+        if (textLength > room) {
+            textLength = room;
+        }
+        memcpy(buffer + length, text, textLength);
+        finish(length + textLength);
+    }
+
+    // printf形式で整形して代入
+    int format(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        int written = vsnprintf(buffer, N, fmt, args);
+        va_end(args);
+        finish(written < 0 ? 0 : (static_cast<size_t>(written) > N - 1 ? N - 1 : static_cast<size_t>(written)));
+        return written;
+    }
+
+    // printf形式で整形して末尾に追加
+    int appendFormat(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        size_t room = N - length;
+        va_list args;
+        va_start(args, fmt);
+        int written = vsnprintf(buffer + length, room, fmt, args);
+        va_end(args);
+        size_t added = written < 0 ? 0 : (static_cast<size_t>(written) > room - 1 ? room - 1 : static_cast<size_t>(written));
+        finish(length + added);
+        return written;
+    }
+
+    void clear() { finish(0); }
+
+    // ASCII部分を大文字に変換
+    void toUpperAscii() {
+        for (size_t i = 0; i < length; ++i) {
+            if (buffer[i] >= 'a' && buffer[i] <= 'z') {
+                buffer[i] = static_cast<char>(buffer[i] - 'a' + 'A');
+            }
+        }
+        hashValue = hashString(buffer, length);
+    }
+
+    const char* c_str() const { return buffer; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    bool hasMultibyte() const { return multibyte; }
+    uint32_t hash() const { return hashValue; }
+    static constexpr size_t capacity() { return N - 1; }
+
+    // ハッシュが異なれば即座に不一致と判定
+    template <size_t M>
+    bool operator==(const FixedString<M>& other) const {
+        return hashValue == other.hash() && length == other.size() &&
+               memcmp(buffer, other.c_str(), length) == 0;
+    }
+
+    template <size_t M>
+    bool operator!=(const FixedString<M>& other) const {
+        return !(*this == other);
+    }
+};
+
+#endif // FIXED_STRING_H
@@ -0,0 +1,29 @@
+#include "HeapMonitor.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+HeapMonitor g_heapMonitor;
+
+HeapMonitor::HeapMonitor()
+    : freeBytes(0), largestBlock(0), minLargestBlock(UINT32_MAX),
+      minFreeBytes(UINT32_MAX), sampleCount(0) {
+}
+
+void HeapMonitor::sample() {
+    freeBytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    if (largestBlock < minLargestBlock) {
+        minLargestBlock = largestBlock;
+    }
+    if (freeBytes < minFreeBytes) {
+        minFreeBytes = freeBytes;
+    }
+    sampleCount++;
+}
+
+uint8_t HeapMonitor::getFragmentationPercent() const {
+    if (freeBytes == 0) {
+        return 0;
+    }
+    return static_cast<uint8_t>(100 - (static_cast<uint64_t>(largestBlock) * 100 / freeBytes));
+}
@@ -0,0 +1,37 @@
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ヒープ断片化の監視
+// 最大連続空き領域（largest free block）を定期的にサンプリングし、
+// 起動後の最小値と断片化率を記録する
+class HeapMonitor {
+private:
+    uint32_t freeBytes;
+    uint32_t largestBlock;
+    uint32_t minLargestBlock;
+    uint32_t minFreeBytes;
+    uint32_t sampleCount;
+
+public:
+    HeapMonitor();
+
+    // 現在のヒープ状態を取得して統計を更新
+    void sample();
+
+    uint32_t getFreeBytes() const { return freeBytes; }
+    uint32_t getLargestBlock() const { return largestBlock; }
+    uint32_t getMinLargestBlock() const { return minLargestBlock; }
+    uint32_t getMinFreeBytes() const { return minFreeBytes; }
+    uint32_t getSampleCount() const { return sampleCount; }
+
+    // 断片化率（%）: 100 * (1 - 最大連続空き / 総空き)
+    uint8_t getFragmentationPercent() const;
+};
+
+// グローバルヒープモニター
+extern HeapMonitor g_heapMonitor;
+
+#endif // HEAP_MONITOR_H
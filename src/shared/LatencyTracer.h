@@ -0,0 +1,83 @@
+#ifndef LATENCY_TRACER_H
+#define LATENCY_TRACER_H
+
+#include <cstdint>
+
+// 入力から出力までの遅延の計測
+// 1回の反応を「入力の時刻 → 処理を受け付けた時刻 → 出力を組み立てた時刻 → 実際に出る時刻」の
+// 4つのタイムスタンプで記録し、区間ごとと合計の最大・平均、予算超過の回数を集計する。
+// 時刻は呼び出し側が渡す（μs、32bitの折り返しは差で吸収）ので、ホストでもそのまま検証できる。
+class LatencyTracer {
+public:
+    enum Stage : uint8_t {
+        STAGE_DISPATCH = 0,     // 入力 → 受け付け（イベントの配信待ち）
+        STAGE_MIX,              // 受け付け → 組み立て（出力タスクの周期待ち）
+        STAGE_OUTPUT,           // 組み立て → 出力（DMAにたまっている分）
+        STAGE_COUNT
+    };
+
+private:
+    uint32_t budgetUs;
+    uint32_t count;
+    uint32_t overBudget;
+    uint32_t lastTotalUs;
+    uint32_t maxTotalUs;
+    uint64_t sumTotalUs;
+    uint32_t stageMaxUs[STAGE_COUNT];
+    uint64_t stageSumUs[STAGE_COUNT];
+
+public:
+    explicit LatencyTracer(uint32_t latencyBudgetUs) : budgetUs(latencyBudgetUs) {
+        reset();
+    }
+
+    // 入力の時刻が0なら受け付けた時刻を入力とみなす（タッチ以外からの要求）
+    void record(uint32_t inputUs, uint32_t dispatchUs, uint32_t mixUs, uint32_t outputUs) {
+        if (inputUs == 0) {
+            inputUs = dispatchUs;
+        }
+        const uint32_t stages[STAGE_COUNT] = {
+            dispatchUs - inputUs, mixUs - dispatchUs, outputUs - mixUs
+        };
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            stageSumUs[i] += stages[i];
+            if (stages[i] > stageMaxUs[i]) {
+                stageMaxUs[i] = stages[i];
+            }
+        }
+        lastTotalUs = outputUs - inputUs;
+        sumTotalUs += lastTotalUs;
+        if (lastTotalUs > maxTotalUs) {
+            maxTotalUs = lastTotalUs;
+        }
+        if (lastTotalUs > budgetUs) {
+            overBudget++;
+        }
+        count++;
+    }
+
+    void reset() {
+        count = 0;
+        overBudget = 0;
+        lastTotalUs = 0;
+        maxTotalUs = 0;
+        sumTotalUs = 0;
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            stageMaxUs[i] = 0;
+            stageSumUs[i] = 0;
+        }
+    }
+
+    uint32_t getBudgetUs() const { return budgetUs; }
+    uint32_t getCount() const { return count; }
+    uint32_t getOverBudgetCount() const { return overBudget; }
+    uint32_t getLastTotalUs() const { return lastTotalUs; }
+    uint32_t getMaxTotalUs() const { return maxTotalUs; }
+    uint32_t getAverageTotalUs() const { return count > 0 ? static_cast<uint32_t>(sumTotalUs / count) : 0; }
+    uint32_t getStageMaxUs(Stage stage) const { return stageMaxUs[stage]; }
+    uint32_t getStageAverageUs(Stage stage) const {
+        return count > 0 ? static_cast<uint32_t>(stageSumUs[stage] / count) : 0;
+    }
+};
+
+#endif // LATENCY_TRACER_H
@@ -0,0 +1,10 @@
+#include "LogBuffer.h"
+#include <Arduino.h>
+
+namespace {
+uint32_t logClockMs() {
+    return static_cast<uint32_t>(millis());
+}
+} // namespace
+
+LogBuffer g_log(&logClockMs);
@@ -0,0 +1,243 @@
+#ifndef LOG_BUFFER_H
+#define LOG_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// 保持する記録の数（2のべき乗。1件は約120バイト）
+#ifndef LOG_BUFFER_RECORDS
+#define LOG_BUFFER_RECORDS 128
+#endif
+
+// 1件に持てる引数の数（超えるとコンパイルエラー。行を分けること）
+#ifndef LOG_MAX_ARGS
+#define LOG_MAX_ARGS 8
+#endif
+
+// 文字列の引数をコピーしておく領域（1件あたり、終端を含む。溢れた分は切り詰める）
+#ifndef LOG_TEXT_BYTES
+#define LOG_TEXT_BYTES 32
+#endif
+
+// 整形した1行の最大長（終端を含む）
+#ifndef LOG_LINE_BYTES
+#define LOG_LINE_BYTES 192
+#endif
+
+// 重要度
+enum LogSeverity : uint8_t {
+    LOG_SEVERITY_DEBUG = 0,
+    LOG_SEVERITY_INFO,
+    LOG_SEVERITY_WARN,
+    LOG_SEVERITY_ERROR,
+    LOG_SEVERITY_COUNT
+};
+
+// リングに入れる最低の重要度（起動時から変えられる。既定ではデバッグの記録を捨てて、
+// 周期的な統計で警告やエラーを押し出さない。SDとログ画面にもデバッグは届かない）
+#ifndef LOG_MIN_SEVERITY
+#define LOG_MIN_SEVERITY LOG_SEVERITY_INFO
+#endif
+
+// 1つの引数（整数は64bitに広げ、文字列は記録内のコピーの位置）
+union LogArg {
+    int64_t i;
+    uint64_t u;
+    double f;
+    const void* p;
+};
+
+// 1件の記録。書式は文字列リテラルなど消えないものを指すこと
+// 整形は読み出す側（SDへの書き出し・ログ画面）で行うので、書く側は値をコピーするだけで済む
+struct LogRecord {
+    uint32_t timestampMs;
+    const char* format;
+    uint8_t severity;       // LogSeverity
+    uint8_t argCount;
+    uint8_t textBytes;      // textの使用量
+    LogArg args[LOG_MAX_ARGS];
+    char text[LOG_TEXT_BYTES];
+};
+
+// 記録の整形（LogFormat.cpp）。書いた長さを返す（outは常に終端される）
+// 本文だけ: "Screen 3 constructed"
+size_t formatLogMessage(const LogRecord& record, char* out, size_t capacity);
+// 時刻と重要度つき: "   12.345 I Screen 3 constructed"（改行なし）
+size_t formatLogLine(const LogRecord& record, char* out, size_t capacity);
+// 重要度の1文字（D/I/W/E）
+char logSeverityMark(uint8_t severity);
+
+// メモリ上のログ（複数の書き込み側・ロックなし）
+// 書く側は通し番号をfetch_addで取って、その番号のスロットに値をコピーするだけ
+// （書式の整形もSerialへの出力もしない）なので、タッチや表示のタスクから呼んでも数百ns程度。
+// 満杯なら古いものから上書きし、書く側は待たない。
+// 読む側は通し番号で読む。スロットのスタンプ（番号×2+2で書き終わり、+1で書き込み中）を
+// コピーの前後で確かめ、上書きされていた・書き込み中だったものは読めなかったことにする。
+// 読む側はそれぞれ自分の位置を持つので、SDへの書き出しとログ画面が互いに邪魔をしない。
+// 容量分の記録のあいだ止められた書き込みがあると、その1件は混ざった内容になりうる。
+class LogBuffer {
+public:
+    typedef uint32_t (*ClockFn)();
+
+    static const uint32_t CAPACITY = LOG_BUFFER_RECORDS;
+
+private:
+    static_assert((LOG_BUFFER_RECORDS & (LOG_BUFFER_RECORDS - 1)) == 0, "LOG_BUFFER_RECORDS must be a power of two");
+
+    struct Slot {
+        std::atomic<uint32_t> stamp;
+        LogRecord record;
+    };
+
+    Slot slots[LOG_BUFFER_RECORDS];
+    std::atomic<uint32_t> head;     // 次に書く通し番号
+    ClockFn clock;
+    std::atomic<uint8_t> minSeverity;
+    std::atomic<uint32_t> severityCounts[LOG_SEVERITY_COUNT];
+
+    static uint32_t committedStamp(uint32_t sequence) { return sequence * 2 + 2; }
+
+    // 引数の取り込み（整数・列挙は64bitへ、浮動小数点はdouble、文字列は記録内へコピー）
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, LogArg>::type
+    capture(LogRecord&, T value) {
+        LogArg arg;
+        arg.i = static_cast<int64_t>(value);
+        return arg;
+    }
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, LogArg>::type
+    capture(LogRecord&, T value) {
+        LogArg arg;
+        arg.u = static_cast<uint64_t>(value);
+        return arg;
+    }
+    template <typename T>
+    static typename std::enable_if<std::is_enum<T>::value, LogArg>::type capture(LogRecord&, T value) {
+        LogArg arg;
+        arg.i = static_cast<int64_t>(value);
+        return arg;
+    }
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, LogArg>::type capture(LogRecord&, T value) {
+        LogArg arg;
+        arg.f = static_cast<double>(value);
+        return arg;
+    }
+    static LogArg capture(LogRecord& record, const char* text) {
+        // 位置を記録内のオフセットで持つ（呼び出し側の文字列が消えても読める）
+        LogArg arg;
+        arg.u = record.textBytes;
+        if (!text) {
+            text = "(null)";
+        }
+        size_t at = record.textBytes;
+        while (at + 1 < LOG_TEXT_BYTES && *text) {
+            record.text[at++] = *text++;
+        }
+        if (at < LOG_TEXT_BYTES) {
+            record.text[at++] = '\0';
+        }
+        record.textBytes = static_cast<uint8_t>(at);
+        return arg;
+    }
+    static LogArg capture(LogRecord& record, char* text) { return capture(record, static_cast<const char*>(text)); }
+    static LogArg capture(LogRecord&, const void* pointer) {
+        LogArg arg;
+        arg.u = 0;
+        arg.p = pointer;
+        return arg;
+    }
+
+    static void store(LogRecord&, size_t) {
+    }
+    template <typename T, typename... Rest>
+    static void store(LogRecord& record, size_t index, T value, Rest... rest) {
+        record.args[index] = capture(record, value);
+        store(record, index + 1, rest...);
+    }
+
+public:
+    explicit LogBuffer(ClockFn clockFn) : head(0), clock(clockFn), minSeverity(LOG_MIN_SEVERITY) {
+        for (Slot& slot : slots) {
+            slot.stamp.store(0, std::memory_order_relaxed);
+        }
+        for (auto& count : severityCounts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // 1件書く（printfと同じ書式。%sの文字列はコピーする）。どのタスクからでもよい
+    template <typename... Args>
+    void write(LogSeverity severity, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments; split the line");
+        if (severity < minSeverity.load(std::memory_order_relaxed)) {
+            return;
+        }
+        uint32_t sequence = head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots[sequence & (LOG_BUFFER_RECORDS - 1)];
+        slot.stamp.store(committedStamp(sequence) - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        LogRecord& record = slot.record;
+        record.timestampMs = clock ? clock() : 0;
+        record.format = format;
+        record.severity = severity;
+        record.argCount = static_cast<uint8_t>(sizeof...(Args));
+        record.textBytes = 0;
+        store(record, 0, args...);
+        slot.stamp.store(committedStamp(sequence), std::memory_order_release);
+        severityCounts[severity < LOG_SEVERITY_COUNT ? severity : LOG_SEVERITY_ERROR].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+    // 通し番号sequenceの記録を読む。上書き・書き込み中・まだ書かれていなければfalse
+    bool read(uint32_t sequence, LogRecord& out) const {
+        const Slot& slot = slots[sequence & (LOG_BUFFER_RECORDS - 1)];
+        uint32_t before = slot.stamp.load(std::memory_order_acquire);
+        if (before != committedStamp(sequence)) {
+            return false;
+        }
+        out = slot.record;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.stamp.load(std::memory_order_relaxed) == before;
+    }
+
+    // 次に書かれる通し番号（= これまでに書かれた件数）
+    uint32_t getHead() const { return head.load(std::memory_order_acquire); }
+    // まだ残っているいちばん古い通し番号
+    uint32_t getOldest() const {
+        uint32_t next = getHead();
+        return next > LOG_BUFFER_RECORDS ? next - LOG_BUFFER_RECORDS : 0;
+    }
+    // これより低い重要度は書かずに捨てる（デバッグの記録を見たいときにLOG_SEVERITY_DEBUGへ）
+    void setMinSeverity(LogSeverity severity) { minSeverity.store(severity, std::memory_order_relaxed); }
+    LogSeverity getMinSeverity() const { return static_cast<LogSeverity>(minSeverity.load(std::memory_order_relaxed)); }
+    uint32_t getCount(LogSeverity severity) const { return severityCounts[severity].load(std::memory_order_relaxed); }
+};
+
+// グローバルログ（時刻はmillis()）
+extern LogBuffer g_log;
+
+template <typename... Args>
+inline void logDebug(const char* format, Args... args) { g_log.write(LOG_SEVERITY_DEBUG, format, args...); }
+template <typename... Args>
+inline void logInfo(const char* format, Args... args) { g_log.write(LOG_SEVERITY_INFO, format, args...); }
+template <typename... Args>
+inline void logWarn(const char* format, Args... args) { g_log.write(LOG_SEVERITY_WARN, format, args...); }
+template <typename... Args>
+inline void logError(const char* format, Args... args) { g_log.write(LOG_SEVERITY_ERROR, format, args...); }
+
+// 書式の検査（-D LOG_CHECK_FORMAT）。呼び出しごとに書式と引数の型をprintfと同じ規則で
+// コンパイラーに確かめさせる。検査用の関数はsizeofの中でしか使わないので定義も呼び出しもない
+#if defined(LOG_CHECK_FORMAT) && defined(__GNUC__)
+__attribute__((format(printf, 1, 2))) int logFormatCheck(const char* format, ...);
+#define LOG_FORMAT_CHECK(...) static_cast<void>(sizeof(logFormatCheck(__VA_ARGS__)))
+#define logDebug(...) (LOG_FORMAT_CHECK(__VA_ARGS__), g_log.write(LOG_SEVERITY_DEBUG, __VA_ARGS__))
+#define logInfo(...) (LOG_FORMAT_CHECK(__VA_ARGS__), g_log.write(LOG_SEVERITY_INFO, __VA_ARGS__))
+#define logWarn(...) (LOG_FORMAT_CHECK(__VA_ARGS__), g_log.write(LOG_SEVERITY_WARN, __VA_ARGS__))
+#define logError(...) (LOG_FORMAT_CHECK(__VA_ARGS__), g_log.write(LOG_SEVERITY_ERROR, __VA_ARGS__))
+#endif
+
+#endif // LOG_BUFFER_H
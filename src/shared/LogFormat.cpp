@@ -0,0 +1,141 @@
+#include "LogBuffer.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+// 書式の1つの変換（%の次から変換文字まで）を解析した結果
+struct Conversion {
+    char spec[24];          // snprintfに渡す書式（長さ修飾子は取り込んだ値の型に合わせて付け直す）
+    char type;              // 変換文字
+    bool wide;              // 64bitの整数（ll・j、またはlongが64bitの環境のl）
+    size_t length;          // 書式文字列で消費した長さ（%を含む）
+};
+
+bool parseConversion(const char* at, Conversion& out) {
+    // %[flags][width][.precision][length]type
+    const char* p = at + 1;
+    size_t used = 0;
+    out.spec[used++] = '%';
+    while (*p && strchr("-+ #0", *p) && used < 12) {
+        out.spec[used++] = *p++;
+    }
+    while (*p >= '0' && *p <= '9' && used < 16) {
+        out.spec[used++] = *p++;
+    }
+    if (*p == '.') {
+        out.spec[used++] = *p++;
+        while (*p >= '0' && *p <= '9' && used < 20) {
+            out.spec[used++] = *p++;
+        }
+    }
+    int longs = 0;
+    bool sizeModifier = false;
+    out.wide = false;
+    while (*p && strchr("hlLjztq", *p)) {
+        if (*p == 'l') {
+            longs++;
+        } else if (*p == 'j' || *p == 'q') {
+            out.wide = true;
+        } else if (*p == 'z' || *p == 't') {
+            sizeModifier = true;
+        }
+        p++;
+    }
+    if (!*p || !strchr("diuoxXcsfFeEgGaAp", *p)) {
+        return false;
+    }
+    out.wide = out.wide || longs >= 2 || (longs == 1 && sizeof(long) == 8) || (sizeModifier && sizeof(size_t) == 8);
+    out.type = *p;
+    if (strchr("diuoxX", out.type)) {
+        out.spec[used++] = 'l';
+        out.spec[used++] = 'l';
+    }
+    out.spec[used++] = out.type;
+    out.spec[used] = '\0';
+    out.length = static_cast<size_t>(p + 1 - at);
+    return true;
+}
+
+// 1つの変換を書く。書いた長さ（切り詰め前）を返す
+int formatArg(const LogRecord& record, const Conversion& conversion, const LogArg& arg, char* out, size_t capacity) {
+    switch (conversion.type) {
+        case 'd':
+        case 'i': {
+            long long value = conversion.wide ? static_cast<long long>(arg.i)
+                                              : static_cast<long long>(static_cast<int32_t>(arg.u));
+            return snprintf(out, capacity, conversion.spec, value);
+        }
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X': {
+            unsigned long long value = conversion.wide ? static_cast<unsigned long long>(arg.u)
+                                                       : static_cast<unsigned long long>(static_cast<uint32_t>(arg.u));
+            return snprintf(out, capacity, conversion.spec, value);
+        }
+        case 'c':
+            return snprintf(out, capacity, conversion.spec, static_cast<int>(arg.i));
+        case 's': {
+            const char* text = arg.u < record.textBytes ? record.text + arg.u : "";
+            return snprintf(out, capacity, conversion.spec, text);
+        }
+        case 'p':
+            return snprintf(out, capacity, conversion.spec, arg.p);
+        default:
+            return snprintf(out, capacity, conversion.spec, arg.f);
+    }
+}
+} // namespace
+
+char logSeverityMark(uint8_t severity) {
+    static const char marks[LOG_SEVERITY_COUNT] = {'D', 'I', 'W', 'E'};
+    return severity < LOG_SEVERITY_COUNT ? marks[severity] : '?';
+}
+
+size_t formatLogMessage(const LogRecord& record, char* out, size_t capacity) {
+    if (capacity == 0) {
+        return 0;
+    }
+    size_t written = 0;
+    size_t argIndex = 0;
+    const char* p = record.format ? record.format : "";
+    // 書いた長さは容量-1で止める（切り詰めてもoutは終端される）
+    while (*p && written + 1 < capacity) {
+        if (*p != '%') {
+            out[written++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[written++] = '%';
+            p += 2;
+            continue;
+        }
+        Conversion conversion;
+        if (!parseConversion(p, conversion) || argIndex >= record.argCount) {
+            // 解釈できない・引数が足りない変換はそのまま出す
+            out[written++] = *p++;
+            continue;
+        }
+        int length = formatArg(record, conversion, record.args[argIndex++], out + written, capacity - written);
+        if (length > 0) {
+            written += static_cast<size_t>(length) < capacity - written ? static_cast<size_t>(length)
+                                                                          : capacity - written - 1;
+        }
+        p += conversion.length;
+    }
+    // 末尾の改行は落とす（行として扱う側が付ける）
+    while (written > 0 && (out[written - 1] == '\n' || out[written - 1] == '\r')) {
+        written--;
+    }
+    out[written] = '\0';
+    return written;
+}
+
+size_t formatLogLine(const LogRecord& record, char* out, size_t capacity) {
+    int prefix = snprintf(out, capacity, "%6lu.%03lu %c ", (unsigned long)(record.timestampMs / 1000),
+                          (unsigned long)(record.timestampMs % 1000), logSeverityMark(record.severity));
+    if (prefix < 0 || static_cast<size_t>(prefix) >= capacity) {
+        return capacity > 0 ? strlen(out) : 0;
+    }
+    return static_cast<size_t>(prefix) + formatLogMessage(record, out + prefix, capacity - prefix);
+}
@@ -0,0 +1,114 @@
+#include "MotionChannel.h"
+
+constexpr size_t MotionChannel::DEPTH;
+constexpr size_t MotionChannel::HISTORY_SIZE;
+
+MotionChannel::MotionChannel()
+    : head(0), count(0), historyHead(0), historyCount(0),
+      coalescedCount(0), dropCount(0) {
+    lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+void MotionChannel::post(const Event& event) {
+    portENTER_CRITICAL(&lock);
+
+    // 履歴は合流の有無に関係なく全サンプルを記録
+    MotionSample& sample = history[(historyHead + historyCount) % HISTORY_SIZE];
+    sample.x = event.touch().x;
+    sample.y = event.touch().y;
+    sample.timestampUs = event.touch().timestampUs;
+    if (historyCount < HISTORY_SIZE) {
+        historyCount++;
+    } else {
+        historyHead = (historyHead + 1) % HISTORY_SIZE;
+    }
+
+    Event* tail = count > 0 ? &ring[(head + count - 1) % DEPTH] : nullptr;
+    if (tail && tail->sequence == static_cast<uint16_t>(event.sequence - 1)) {
+        // 直前のイベントがまだ取り出されていない移動 → 最新位置で上書き
+        *tail = event;
+        tail->flags |= EVENT_FLAG_COALESCED;
+        coalescedCount++;
+    } else {
+        if (count == DEPTH) {
+            // 他レーンのイベントを挟んで溜まり続けた場合は最古を捨てる
+            head = (head + 1) % DEPTH;
+            count--;
+            dropCount++;
+        }
+        ring[(head + count) % DEPTH] = event;
+        count++;
+    }
+
+    portEXIT_CRITICAL(&lock);
+}
+
+bool MotionChannel::peek(Event& event) const {
+    portENTER_CRITICAL(&lock);
+    bool available = count > 0;
+    if (available) {
+        event = ring[head];
+    }
+    portEXIT_CRITICAL(&lock);
+    return available;
+}
+
+bool MotionChannel::take(Event& event) {
+    portENTER_CRITICAL(&lock);
+    bool available = count > 0;
+    if (available) {
+        event = ring[head];
+        head = (head + 1) % DEPTH;
+        count--;
+    }
+    portEXIT_CRITICAL(&lock);
+    return available;
+}
+
+void MotionChannel::clearHistory() {
+    portENTER_CRITICAL(&lock);
+    historyHead = 0;
+    historyCount = 0;
+    portEXIT_CRITICAL(&lock);
+}
+
+size_t MotionChannel::copyHistory(MotionSample* out, size_t maxSamples) const {
+    portENTER_CRITICAL(&lock);
+    size_t n = historyCount < maxSamples ? historyCount : maxSamples;
+    size_t start = historyCount - n;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = history[(historyHead + start + i) % HISTORY_SIZE];
+    }
+    portEXIT_CRITICAL(&lock);
+    return n;
+}
+
+bool MotionChannel::estimateVelocity(uint32_t windowUs, float& vx, float& vy) const {
+    MotionSample samples[HISTORY_SIZE];
+    size_t n = copyHistory(samples, HISTORY_SIZE);
+    if (n < 2) {
+        return false;
+    }
+
+    // 最新サンプルからwindowUs以内で最も古いサンプルとの差分
+    const MotionSample& newest = samples[n - 1];
+    size_t oldest = n - 1;
+    while (oldest > 0 && newest.timestampUs - samples[oldest - 1].timestampUs <= windowUs) {
+        oldest--;
+    }
+    uint32_t dt = newest.timestampUs - samples[oldest].timestampUs;
+    if (oldest == n - 1 || dt == 0) {
+        return false;
+    }
+
+    vx = (newest.x - samples[oldest].x) * 1000000.0f / dt;
+    vy = (newest.y - samples[oldest].y) * 1000000.0f / dt;
+    return true;
+}
+
+size_t MotionChannel::getCount() const {
+    portENTER_CRITICAL(&lock);
+    size_t n = count;
+    portEXIT_CRITICAL(&lock);
+    return n;
+}
@@ -0,0 +1,62 @@
+#ifndef MOTION_CHANNEL_H
+#define MOTION_CHANNEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <freertos/FreeRTOS.h>
+#include "Events.h"
+
+// 移動イベントの履歴サンプル（速度計算用）
+struct MotionSample {
+    int16_t x;
+    int16_t y;
+    uint32_t timestampUs;
+};
+
+// TOUCH_MOVE用の合流チャネル
+// 受信側が取り出す前に次の移動が来たら、末尾のイベントを最新の座標で
+// 上書きする（受信側は常に最新位置だけを見る）。上書きされた座標も
+// 履歴リングには残すので、スワイプやフリックの速度は正確に計算できる。
+// 送受信はコアをまたぐため、スピンロックで保護する。
+class MotionChannel {
+public:
+    static constexpr size_t DEPTH = 4;          // 合流できない場合（間に他レーンのイベント）の最大滞留数
+    static constexpr size_t HISTORY_SIZE = 16;  // 速度計算用の履歴数
+
+private:
+    mutable portMUX_TYPE lock;
+    Event ring[DEPTH];
+    size_t head;
+    size_t count;
+    MotionSample history[HISTORY_SIZE];
+    size_t historyHead;
+    size_t historyCount;
+    uint32_t coalescedCount;
+    uint32_t dropCount;
+
+public:
+    MotionChannel();
+
+    // 移動イベントを追加（sequenceは付与済みであること）
+    // 直前に送られたイベントが未取得の移動なら、それを上書きして合流する
+    void post(const Event& event);
+
+    // 先頭を参照/取り出し（ノンブロッキング）
+    bool peek(Event& event) const;
+    bool take(Event& event);
+
+    // 新しいタッチの開始時に履歴を破棄
+    void clearHistory();
+
+    // 履歴を古い順にコピー（コピーした数を返す）
+    size_t copyHistory(MotionSample* out, size_t maxSamples) const;
+
+    // 直近windowUs内の履歴から速度を推定（px/秒）。サンプル不足ならfalse
+    bool estimateVelocity(uint32_t windowUs, float& vx, float& vy) const;
+
+    size_t getCount() const;
+    uint32_t getCoalescedCount() const { return coalescedCount; }
+    uint32_t getDropCount() const { return dropCount; }
+};
+
+#endif // MOTION_CHANNEL_H
@@ -0,0 +1,122 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// 型付きの固定長オブジェクトプール
+// 領域はプール内に静的に持ち、release()してもデストラクタは呼ばない。
+// 次のacquire()では構築済みのオブジェクトをそのまま返すので、
+// 呼び出し側はreset系のメソッドで状態だけを入れ替えて再利用する。
+// （ボタンなら計測済みのテキスト寸法などがそのまま残る）
+template <typename T, size_t N>
+class ObjectPool {
+private:
+    static_assert(N > 0, "ObjectPool needs at least one slot");
+
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    Slot slots[N];
+    bool constructed[N];
+    bool inUse[N];
+    size_t usedCount;
+    uint32_t acquireCount;
+    uint32_t reuseCount;
+    uint32_t exhaustedCount;
+
+    T* slotObject(size_t index) {
+        return reinterpret_cast<T*>(&slots[index]);
+    }
+
+    size_t indexOf(const T* object) const {
+        const Slot* slot = reinterpret_cast<const Slot*>(object);
+        return static_cast<size_t>(slot - slots);
+    }
+
+public:
+    ObjectPool() : usedCount(0), acquireCount(0), reuseCount(0), exhaustedCount(0) {
+        for (size_t i = 0; i < N; ++i) {
+            constructed[i] = false;
+            inUse[i] = false;
+        }
+    }
+
+    ~ObjectPool() {
+        for (size_t i = 0; i < N; ++i) {
+            if (constructed[i]) {
+                slotObject(i)->~T();
+            }
+        }
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // 空きスロットを取得（構築済みを優先し、なければ引数で新規構築）
+    // 構築済みのオブジェクトを返した場合、引数は使われない。
+    template <typename... Args>
+    T* acquire(Args&&... args) {
+        acquireCount++;
+        for (size_t i = 0; i < N; ++i) {
+            if (constructed[i] && !inUse[i]) {
+                inUse[i] = true;
+                usedCount++;
+                reuseCount++;
+                return slotObject(i);
+            }
+        }
+        for (size_t i = 0; i < N; ++i) {
+            if (!constructed[i]) {
+                new (&slots[i]) T(std::forward<Args>(args)...);
+                constructed[i] = true;
+                inUse[i] = true;
+                usedCount++;
+                return slotObject(i);
+            }
+        }
+        exhaustedCount++;
+        return nullptr;
+    }
+
+    // スロットを返却（オブジェクトは破棄せず次回に再利用）
+    void release(T* object) {
+        if (!owns(object)) {
+            return;
+        }
+        size_t index = indexOf(object);
+        if (inUse[index]) {
+            inUse[index] = false;
+            usedCount--;
+        }
+    }
+
+    void releaseAll() {
+        for (size_t i = 0; i < N; ++i) {
+            inUse[i] = false;
+        }
+        usedCount = 0;
+    }
+
+    bool owns(const T* object) const {
+        if (!object) {
+            return false;
+        }
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(object);
+        const uint8_t* first = reinterpret_cast<const uint8_t*>(slots);
+        if (p < first || p >= first + sizeof(slots)) {
+            return false;
+        }
+        return (p - first) % sizeof(Slot) == 0;
+    }
+
+    size_t size() const { return usedCount; }
+    static constexpr size_t capacity() { return N; }
+    uint32_t getAcquireCount() const { return acquireCount; }
+    uint32_t getReuseCount() const { return reuseCount; }
+    uint32_t getExhaustedCount() const { return exhaustedCount; }
+};
+
+#endif // OBJECT_POOL_H
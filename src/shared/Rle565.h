@@ -0,0 +1,110 @@
+#ifndef RLE565_H
+#define RLE565_H
+
+#include <cstddef>
+#include <cstdint>
+
+// RGB565画像の行単位ランレングス符号
+// 制御バイトの最上位ビットが1なら（下位7ビット+1）画素の同色ラン（色2バイトが続く）、
+// 0なら（下位7ビット+1）画素のリテラル（色2バイト×画素数が続く）。
+// ランは行をまたがないので、1行ずつ復号してそのまま転送できる。
+namespace rle565 {
+
+constexpr size_t MAX_CHUNK = 128;
+constexpr uint8_t RUN_FLAG = 0x80;
+
+// 1行を符号化した結果の最大サイズ（すべてリテラルの場合）
+constexpr size_t maxEncodedRowSize(size_t width) {
+    return width * 2 + (width + MAX_CHUNK - 1) / MAX_CHUNK;
+}
+
+inline void putColor(uint8_t* out, uint16_t color) {
+    out[0] = static_cast<uint8_t>(color & 0xFF);
+    out[1] = static_cast<uint8_t>(color >> 8);
+}
+
+inline uint16_t getColor(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+// 1行を符号化してoutに書く。書いたバイト数を返す（容量不足なら0）
+inline size_t encodeRow(const uint16_t* pixels, size_t width, uint8_t* out, size_t capacity) {
+    size_t written = 0;
+    size_t i = 0;
+    while (i < width) {
+        // 同色が続く長さ
+        size_t run = 1;
+        while (i + run < width && run < MAX_CHUNK && pixels[i + run] == pixels[i]) {
+            run++;
+        }
+        if (run >= 2) {
+            if (written + 3 > capacity) {
+                return 0;
+            }
+            out[written] = static_cast<uint8_t>(RUN_FLAG | (run - 1));
+            putColor(out + written + 1, pixels[i]);
+            written += 3;
+            i += run;
+            continue;
+        }
+
+        // 3画素以上のランが始まる手前までをリテラルにする
+        size_t literal = 1;
+        while (i + literal < width && literal < MAX_CHUNK) {
+            size_t j = i + literal;
+            if (j + 2 < width && pixels[j] == pixels[j + 1] && pixels[j] == pixels[j + 2]) {
+                break;
+            }
+            literal++;
+        }
+        if (written + 1 + literal * 2 > capacity) {
+            return 0;
+        }
+        out[written++] = static_cast<uint8_t>(literal - 1);
+        for (size_t k = 0; k < literal; k++) {
+            putColor(out + written, pixels[i + k]);
+            written += 2;
+        }
+        i += literal;
+    }
+    return written;
+}
+
+// 1行を復号してpixelsに書く。消費したバイト数を返す（データ不足・不正なら0）
+inline size_t decodeRow(const uint8_t* in, size_t available, uint16_t* pixels, size_t width) {
+    size_t consumed = 0;
+    size_t x = 0;
+    while (x < width) {
+        if (consumed >= available) {
+            return 0;
+        }
+        uint8_t control = in[consumed++];
+        size_t count = (control & ~RUN_FLAG) + 1u;
+        if (x + count > width) {
+            return 0;
+        }
+        if (control & RUN_FLAG) {
+            if (consumed + 2 > available) {
+                return 0;
+            }
+            uint16_t color = getColor(in + consumed);
+            consumed += 2;
+            for (size_t k = 0; k < count; k++) {
+                pixels[x++] = color;
+            }
+        } else {
+            if (consumed + count * 2 > available) {
+                return 0;
+            }
+            for (size_t k = 0; k < count; k++) {
+                pixels[x++] = getColor(in + consumed);
+                consumed += 2;
+            }
+        }
+    }
+    return consumed;
+}
+
+} // namespace rle565
+
+#endif // RLE565_H
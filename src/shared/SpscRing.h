@@ -0,0 +1,95 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+// 1書き込み側・1読み出し側のリングバッファ（ロックなし）
+// 書き込み側と読み出し側が別のタスク・別のコアでもよい。
+// 容量は2のべき乗に切り上げ、位置は折り返さずに数えて差で残量を求める。
+// close()は書き込み側が「これ以上来ない」ことを伝えるためのもので、
+// 読み出し側は残りを読み切ってから終端と判断する。
+template <typename T>
+class SpscRing {
+private:
+    std::unique_ptr<T[]> storage;
+    size_t capacity;
+    size_t mask;
+    std::atomic<size_t> writePos;
+    std::atomic<size_t> readPos;
+    std::atomic<bool> closed;
+
+    static size_t roundUp(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+public:
+    explicit SpscRing(size_t minCapacity)
+        : storage(new T[roundUp(minCapacity)]), capacity(roundUp(minCapacity)),
+          mask(roundUp(minCapacity) - 1), writePos(0), readPos(0), closed(false) {}
+
+    size_t getCapacity() const { return capacity; }
+    size_t available() const { return writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_acquire); }
+    size_t space() const { return capacity - available(); }
+    bool isClosed() const { return closed.load(std::memory_order_acquire); }
+    // 閉じられていて読み残しもない
+    bool isDrained() const { return isClosed() && available() == 0; }
+
+    // 書き込み側: 書けた数を返す（空きが足りなければ一部だけ）
+    size_t write(const T* data, size_t count) {
+        size_t head = writePos.load(std::memory_order_relaxed);
+        size_t free = capacity - (head - readPos.load(std::memory_order_acquire));
+        if (count > free) {
+            count = free;
+        }
+        size_t offset = head & mask;
+        size_t first = count < capacity - offset ? count : capacity - offset;
+        memcpy(&storage[offset], data, first * sizeof(T));
+        memcpy(&storage[0], data + first, (count - first) * sizeof(T));
+        writePos.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    void close() { closed.store(true, std::memory_order_release); }
+
+    // 読み出し側: 読めた数を返す
+    size_t read(T* out, size_t count) {
+        size_t copied = peek(out, count);
+        skip(copied);
+        return copied;
+    }
+
+    // 取り出さずにコピー
+    size_t peek(T* out, size_t count) const {
+        size_t tail = readPos.load(std::memory_order_relaxed);
+        size_t filled = writePos.load(std::memory_order_acquire) - tail;
+        if (count > filled) {
+            count = filled;
+        }
+        size_t offset = tail & mask;
+        size_t first = count < capacity - offset ? count : capacity - offset;
+        memcpy(out, &storage[offset], first * sizeof(T));
+        memcpy(out + first, &storage[0], (count - first) * sizeof(T));
+        return count;
+    }
+
+    void skip(size_t count) {
+        readPos.store(readPos.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // 両側が止まっているときだけ呼ぶこと
+    void reset() {
+        writePos.store(0);
+        readPos.store(0);
+        closed.store(false);
+    }
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,88 @@
+#include "LogWriter.h"
+#include <cstdio>
+#include <cstring>
+
+LogWriter::LogWriter(const LogBuffer& buffer)
+    : source(buffer), cursor(buffer.getOldest()), filled(0), tailSinceMs(0), lineCount(0), lostRecords(0),
+      writtenBytes(0), droppedBytes(0), paddedBytes(0) {
+}
+
+bool LogWriter::append(const char* line, size_t length, uint32_t nowMs) {
+    if (filled + length > sizeof(block)) {
+        return false;
+    }
+    size_t before = filled;
+    memcpy(block + filled, line, length);
+    filled += length;
+    // 末尾の半端なセクタがこの行から始まったなら、溜め始めた時刻はいま
+    if (before % LOG_SECTOR_BYTES == 0 || before / LOG_SECTOR_BYTES != filled / LOG_SECTOR_BYTES) {
+        tailSinceMs = nowMs;
+    }
+    if (echo) {
+        echo(line, length);
+    }
+    lineCount++;
+    return true;
+}
+
+size_t LogWriter::collect(uint32_t nowMs) {
+    char line[LOG_LINE_BYTES + 1];
+    size_t collected = 0;
+    while (true) {
+        // 追い越されていたら読めるところまで進め、失った数を1行残す
+        uint32_t oldest = source.getOldest();
+        if (static_cast<int32_t>(oldest - cursor) > 0) {
+            int length = snprintf(line, sizeof(line), "-- %lu log records lost --\n",
+                                  (unsigned long)(oldest - cursor));
+            if (!append(line, static_cast<size_t>(length), nowMs)) {
+                break;
+            }
+            lostRecords += oldest - cursor;
+            cursor = oldest;
+        }
+        if (cursor == source.getHead()) {
+            break;
+        }
+        LogRecord record;
+        if (!source.read(cursor, record)) {
+            // 書き込み中（上書きされたのなら次の周で追い越しとして数える）
+            break;
+        }
+        size_t length = formatLogLine(record, line, LOG_LINE_BYTES);
+        line[length++] = '\n';
+        if (!append(line, length, nowMs)) {
+            break;
+        }
+        cursor++;
+        collected++;
+    }
+    return collected;
+}
+
+size_t LogWriter::ready(uint32_t nowMs, bool force) {
+    size_t whole = filled - filled % LOG_SECTOR_BYTES;
+    size_t tail = filled - whole;
+    if (tail == 0 || (!force && nowMs - tailSinceMs < LOG_WRITER_MAX_HOLD_MS)) {
+        return whole;
+    }
+    // 半端なセクタを空白で埋め、最後を改行にする（テキストとして読んでも空行が1つ増えるだけ）
+    size_t padding = LOG_SECTOR_BYTES - tail;
+    memset(block + filled, ' ', padding);
+    block[filled + padding - 1] = '\n';
+    filled += padding;
+    paddedBytes += static_cast<uint32_t>(padding);
+    return filled;
+}
+
+void LogWriter::consume(size_t bytes, bool written) {
+    if (bytes > filled) {
+        bytes = filled;
+    }
+    if (written) {
+        writtenBytes += static_cast<uint32_t>(bytes);
+    } else {
+        droppedBytes += static_cast<uint32_t>(bytes);
+    }
+    memmove(block, block + bytes, filled - bytes);
+    filled -= bytes;
+}
@@ -0,0 +1,90 @@
+#ifndef LOG_WRITER_H
+#define LOG_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../shared/Delegate.h"
+#include "../shared/LogBuffer.h"
+
+// SDのセクタの大きさ（書き出しはこの倍数だけにする）
+#ifndef LOG_SECTOR_BYTES
+#define LOG_SECTOR_BYTES 512
+#endif
+
+// 1回に書き出す最大（セクタの倍数）
+#ifndef LOG_WRITER_BLOCK_BYTES
+#define LOG_WRITER_BLOCK_BYTES 2048
+#endif
+
+// 半端なセクタを溜めておく最長時間（過ぎたら空白で埋めて書く）
+#ifndef LOG_WRITER_MAX_HOLD_MS
+#define LOG_WRITER_MAX_HOLD_MS 5000
+#endif
+
+// ログファイル（大きさの上限を超えたら1世代前の名前に移して作り直す）
+#ifndef LOG_FILE_PATH
+#define LOG_FILE_PATH "/log.txt"
+#endif
+
+#ifndef LOG_FILE_OLD_PATH
+#define LOG_FILE_OLD_PATH "/log.old.txt"
+#endif
+
+#ifndef LOG_FILE_MAX_BYTES
+#define LOG_FILE_MAX_BYTES (256 * 1024)
+#endif
+
+static_assert(LOG_WRITER_BLOCK_BYTES % LOG_SECTOR_BYTES == 0, "LOG_WRITER_BLOCK_BYTES must be a multiple of the sector size");
+
+// ログのSDへの書き出し（ブロックの組み立て）
+// ログの新しい記録を1行ずつ整形してブロックに詰め、セクタの倍数になった分だけを渡す。
+// 1セクタに満たない末尾は溜めておき、LOG_WRITER_MAX_HOLD_MSを過ぎたら空白と改行で
+// セクタの終わりまで埋めて書く。ファイルは常にセクタの倍数で伸びるので、
+// 追記が途中のセクタの読み直し・書き直しにならない。
+// 書く側（LogBuffer）に追い越されて読めなかった記録は数えて、失ったことを1行残す。
+// ファイルの操作はしない（SdServiceがサービスタスクで呼ぶ）ので、ホストで確かめられる。
+class LogWriter {
+public:
+    // 整形した1行（改行つき）。Serialへの出力など
+    typedef Delegate<void(const char*, size_t)> EchoFn;
+
+private:
+    const LogBuffer& source;
+    uint32_t cursor;            // 次に読む通し番号
+    char block[LOG_WRITER_BLOCK_BYTES];
+    size_t filled;
+    uint32_t tailSinceMs;       // 半端なセクタに最初の行が入った時刻
+    EchoFn echo;
+
+    uint32_t lineCount;
+    uint32_t lostRecords;
+    uint32_t writtenBytes;
+    uint32_t droppedBytes;      // 書けずに捨てた分（カードがないときなど）
+    uint32_t paddedBytes;
+
+    bool append(const char* line, size_t length, uint32_t nowMs);
+
+public:
+    explicit LogWriter(const LogBuffer& buffer);
+
+    void setEcho(const EchoFn& fn) { echo = fn; }
+
+    // 新しい記録を整形してブロックに詰める（入りきらない分は次回）。詰めた行数を返す
+    size_t collect(uint32_t nowMs);
+    // 書き出せるバイト数（セクタの倍数、なければ0）
+    // 半端なセクタは溜めた時間が過ぎたか、forceなら埋めて含める
+    size_t ready(uint32_t nowMs, bool force);
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(block); }
+    // ready()が返した分を書き終えた（writtenがfalseなら捨てた）。残りを先頭へ詰める
+    void consume(size_t bytes, bool written);
+
+    uint32_t getCursor() const { return cursor; }
+    size_t getPendingBytes() const { return filled; }
+    uint32_t getLineCount() const { return lineCount; }
+    uint32_t getLostRecords() const { return lostRecords; }
+    uint32_t getWrittenBytes() const { return writtenBytes; }
+    uint32_t getDroppedBytes() const { return droppedBytes; }
+    uint32_t getPaddedBytes() const { return paddedBytes; }
+};
+
+#endif // LOG_WRITER_H
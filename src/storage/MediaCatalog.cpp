@@ -0,0 +1,451 @@
+#include "MediaCatalog.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "../shared/FixedString.h"
+
+namespace {
+const uint16_t FLAG_SEEN = 0x0001;
+
+bool isDotEntry(const char* name) {
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+char lowerAscii(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// 大文字小文字を区別しない比較（同じなら区別して並べ、順序を一意にする）
+int compareNames(const char* a, const char* b) {
+    const char* pa = a;
+    const char* pb = b;
+    while (*pa && lowerAscii(*pa) == lowerAscii(*pb)) {
+        pa++;
+        pb++;
+    }
+    int diff = static_cast<uint8_t>(lowerAscii(*pa)) - static_cast<uint8_t>(lowerAscii(*pb));
+    return diff != 0 ? diff : strcmp(a, b);
+}
+
+bool joinPath(char* out, size_t capacity, const char* dir, const char* name) {
+    int written = snprintf(out, capacity, "%s/%s", dir, name);
+    return written > 0 && static_cast<size_t>(written) < capacity;
+}
+
+size_t payloadSizeFor(size_t count, size_t nameBytes) {
+    return count * (sizeof(MediaCatalog::Record) + sizeof(uint16_t)) + nameBytes;
+}
+} // namespace
+
+MediaCatalog::MediaCatalog()
+    : stamp(), filterHash(0), reusedCount(0), addedCount(0), removedCount(0), modifiedCount(0), taggedCount(0),
+      tagBytesRead(0) {
+}
+
+bool MediaCatalog::readStamp(const char* dirPath, MediaCatalogStamp& out) {
+    struct stat info;
+    if (stat(dirPath, &info) != 0 || !S_ISDIR(info.st_mode)) {
+        return false;
+    }
+    DIR* dir = opendir(dirPath);
+    if (!dir) {
+        return false;
+    }
+    out.dirMtime = static_cast<uint32_t>(info.st_mtime);
+    out.entryCount = 0;
+    out.nameHash = 0;
+    while (struct dirent* entry = readdir(dir)) {
+        if (isDotEntry(entry->d_name)) {
+            continue;
+        }
+        out.entryCount++;
+        out.nameHash += hashString(entry->d_name, strlen(entry->d_name));
+    }
+    closedir(dir);
+    return true;
+}
+
+bool MediaCatalog::readHeader(const char* indexPath, MediaCatalogHeader& out) {
+    FILE* file = fopen(indexPath, "rb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fread(&out, sizeof(out), 1, file) == 1;
+    fclose(file);
+    return ok && out.magic == MAGIC && out.version == VERSION;
+}
+
+uint32_t MediaCatalog::hashFilter(const char* extension) {
+    char lowered[16];
+    size_t length = 0;
+    for (; extension && extension[length] && length < sizeof(lowered); length++) {
+        lowered[length] = lowerAscii(extension[length]);
+    }
+    return hashString(lowered, length);
+}
+
+bool MediaCatalog::isCurrent(const MediaCatalogHeader& header, const MediaCatalogStamp& current,
+                             const char* extension) {
+    return header.magic == MAGIC && header.version == VERSION && header.stamp == current &&
+           header.filterHash == hashFilter(extension);
+}
+
+void MediaCatalog::clear() {
+    records.clear();
+    order.clear();
+    names.clear();
+    std::vector<uint8_t>().swap(tagWindow);
+    stamp = MediaCatalogStamp();
+    filterHash = 0;
+}
+
+size_t MediaCatalog::getSerializedSize() const {
+    return sizeof(MediaCatalogHeader) + payloadSizeFor(records.size(), names.size());
+}
+
+bool MediaCatalog::readPage(const char* indexPath, uint32_t first, MediaCatalogEntry* out, uint32_t count,
+                            uint32_t& written, uint32_t& total) {
+    written = 0;
+    total = 0;
+    FILE* file = fopen(indexPath, "rb");
+    if (!file) {
+        return false;
+    }
+    MediaCatalogHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == MAGIC &&
+              header.version == VERSION && header.entryCount <= MEDIA_CATALOG_MAX_ENTRIES &&
+              header.payloadSize >= payloadSizeFor(header.entryCount, 0);
+    if (ok) {
+        total = header.entryCount;
+    }
+    // 並びの表は連続しているので1回で読み、各件の記録と文字列だけを拾う
+    // （本体のハッシュは確かめられないので、添字と文字列の範囲だけ確かめる）
+    const long recordsAt = static_cast<long>(sizeof(MediaCatalogHeader));
+    const long orderAt = recordsAt + static_cast<long>(header.entryCount * sizeof(Record));
+    const long namesAt = recordsAt + static_cast<long>(payloadSizeFor(header.entryCount, 0));
+    const uint32_t nameBytes = ok ? header.payloadSize - static_cast<uint32_t>(payloadSizeFor(header.entryCount, 0)) : 0;
+    uint32_t length = ok && first < total ? std::min<uint32_t>(count, total - first) : 0;
+    uint16_t slice[16];
+    char name[MEDIA_CATALOG_PAGE_NAME_BYTES];
+    char tags[2 * MEDIA_TAG_TEXT_BYTES];
+    while (ok && written < length) {
+        uint32_t batch = std::min<uint32_t>(length - written, sizeof(slice) / sizeof(slice[0]));
+        ok = fseek(file, orderAt + static_cast<long>((first + written) * sizeof(uint16_t)), SEEK_SET) == 0 &&
+             fread(slice, sizeof(uint16_t), batch, file) == batch;
+        for (uint32_t i = 0; ok && i < batch; i++) {
+            Record record;
+            ok = slice[i] < header.entryCount &&
+                 fseek(file, recordsAt + static_cast<long>(slice[i] * sizeof(Record)), SEEK_SET) == 0 &&
+                 fread(&record, sizeof(record), 1, file) == 1 &&
+                 static_cast<uint64_t>(record.nameOffset) + stringBytes(record) <= nameBytes;
+            // 名前は先頭だけ、題名とアーティストは続けて1回で読む
+            size_t readLength = std::min<size_t>(record.nameLength, sizeof(name));
+            size_t tagLength = record.titleLength + record.artistLength + 2u;
+            ok = ok && tagLength <= sizeof(tags) &&
+                 fseek(file, namesAt + static_cast<long>(record.nameOffset), SEEK_SET) == 0 &&
+                 fread(name, 1, readLength, file) == readLength &&
+                 fseek(file, namesAt + static_cast<long>(record.nameOffset + record.nameLength + 1), SEEK_SET) == 0 &&
+                 fread(tags, 1, tagLength, file) == tagLength;
+            if (ok) {
+                MediaCatalogEntry& entry = out[written];
+                entry.name.assign(name, readLength);
+                entry.title.assign(tags, record.titleLength);
+                entry.artist.assign(tags + record.titleLength + 1, record.artistLength);
+                entry.size = record.size;
+                entry.durationMs = record.durationMs;
+                written++;
+            }
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
+bool MediaCatalog::load(const char* indexPath) {
+    clear();
+    FILE* file = fopen(indexPath, "rb");
+    if (!file) {
+        return false;
+    }
+    MediaCatalogHeader header;
+    std::vector<uint8_t> payload;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == MAGIC &&
+              header.version == VERSION && header.entryCount <= MEDIA_CATALOG_MAX_ENTRIES &&
+              header.payloadSize >= payloadSizeFor(header.entryCount, 0);
+    if (ok) {
+        payload.resize(header.payloadSize);
+        ok = payload.empty() || fread(payload.data(), payload.size(), 1, file) == 1;
+    }
+    fclose(file);
+    if (!ok || hashString(reinterpret_cast<const char*>(payload.data()), payload.size()) != header.payloadHash) {
+        return false;
+    }
+
+    size_t count = header.entryCount;
+    const uint8_t* in = payload.data();
+    records.resize(count);
+    order.resize(count);
+    if (count > 0) {
+        memcpy(records.data(), in, count * sizeof(Record));
+        memcpy(order.data(), in + count * sizeof(Record), count * sizeof(uint16_t));
+    }
+    size_t nameBytes = header.payloadSize - payloadSizeFor(count, 0);
+    names.assign(in + payloadSizeFor(count, 0), in + header.payloadSize);
+
+    // 添字と文字列の範囲を確かめる（ハッシュが合っても形式違いは受け付けない）
+    for (size_t i = 0; i < count; i++) {
+        const Record& record = records[i];
+        if (order[i] >= count || static_cast<size_t>(record.nameOffset) + stringBytes(record) > nameBytes ||
+            nameOf(record)[record.nameLength] != '\0' || titleOf(record)[record.titleLength] != '\0' ||
+            artistOf(record)[record.artistLength] != '\0') {
+            clear();
+            return false;
+        }
+    }
+    stamp = header.stamp;
+    filterHash = header.filterHash;
+    return true;
+}
+
+bool MediaCatalog::save(const char* indexPath) const {
+    char tempPath[128];
+    if (snprintf(tempPath, sizeof(tempPath), "%s.tmp", indexPath) >= static_cast<int>(sizeof(tempPath))) {
+        return false;
+    }
+
+    size_t count = records.size();
+    std::vector<uint8_t> payload(payloadSizeFor(count, names.size()));
+    uint8_t* out = payload.data();
+    if (count > 0) {
+        memcpy(out, records.data(), count * sizeof(Record));
+        memcpy(out + count * sizeof(Record), order.data(), count * sizeof(uint16_t));
+    }
+    if (!names.empty()) {
+        memcpy(out + payloadSizeFor(count, 0), names.data(), names.size());
+    }
+
+    MediaCatalogHeader header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.entryCount = static_cast<uint16_t>(count);
+    header.stamp = stamp;
+    header.filterHash = filterHash;
+    header.payloadSize = static_cast<uint32_t>(payload.size());
+    header.payloadHash = hashString(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+    FILE* file = fopen(tempPath, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (payload.empty() || fwrite(payload.data(), payload.size(), 1, file) == 1);
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        remove(tempPath);
+        return false;
+    }
+    // FATのrenameは上書きできないので先に消す
+    remove(indexPath);
+    return rename(tempPath, indexPath) == 0;
+}
+
+int MediaCatalog::findRecord(const char* name) const {
+    int position = find(name);
+    return position >= 0 ? order[position] : -1;
+}
+
+int MediaCatalog::find(const char* name) const {
+    size_t low = 0;
+    size_t high = order.size();
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        int diff = compareNames(nameOf(records[order[mid]]), name);
+        if (diff == 0) {
+            return static_cast<int>(mid);
+        }
+        if (diff < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return -1;
+}
+
+bool MediaCatalog::setDuration(const char* name, uint32_t durationMs) {
+    int index = findRecord(name);
+    if (index < 0) {
+        return false;
+    }
+    records[index].durationMs = durationMs;
+    return true;
+}
+
+void MediaCatalog::storeStrings(Record& record, const char* name, const MediaTags& tags) {
+    // 末尾に積み直す（変更で置き換わった古い文字列はcompact()で消える）
+    static_assert(MEDIA_TAG_TEXT_BYTES - 1 <= UINT8_MAX, "tag length must fit in a byte");
+    record.nameOffset = static_cast<uint32_t>(names.size());
+    record.nameLength = static_cast<uint16_t>(strlen(name));
+    record.titleLength = static_cast<uint8_t>(tags.title.size());
+    record.artistLength = static_cast<uint8_t>(tags.artist.size());
+    names.insert(names.end(), name, name + record.nameLength + 1);
+    names.insert(names.end(), tags.title.c_str(), tags.title.c_str() + record.titleLength + 1);
+    names.insert(names.end(), tags.artist.c_str(), tags.artist.c_str() + record.artistLength + 1);
+}
+
+void MediaCatalog::readTags(const char* path, uint32_t size, MediaTags& out) {
+    if (tagWindow.empty()) {
+        tagWindow.resize(MEDIA_TAG_HEAD_WINDOW > MEDIA_TAG_FRAME_WINDOW ? MEDIA_TAG_HEAD_WINDOW
+                                                                        : MEDIA_TAG_FRAME_WINDOW);
+    }
+    uint32_t bytes = MediaTagReader::read(path, size, out, tagWindow.data(), tagWindow.size());
+    if (bytes > 0) {
+        taggedCount++;
+        tagBytesRead += bytes;
+    }
+}
+
+bool MediaCatalog::appendRecord(const char* name, uint32_t size, uint32_t mtime, const MediaTags& tags) {
+    if (records.size() >= MEDIA_CATALOG_MAX_ENTRIES || strlen(name) > UINT16_MAX) {
+        return false;
+    }
+    Record record;
+    record.size = size;
+    record.mtime = mtime;
+    record.durationMs = tags.durationMs;
+    record.flags = FLAG_SEEN;
+    record.reserved = 0;
+    storeStrings(record, name, tags);
+    records.push_back(record);
+    return true;
+}
+
+void MediaCatalog::compact() {
+    // 見つからなかったものを除き、文字列領域を詰め直す
+    std::vector<Record> kept;
+    std::vector<char> packed;
+    kept.reserve(records.size());
+    packed.reserve(names.size());
+    for (const Record& record : records) {
+        if (!(record.flags & FLAG_SEEN)) {
+            removedCount++;
+            continue;
+        }
+        Record moved = record;
+        moved.nameOffset = static_cast<uint32_t>(packed.size());
+        moved.flags = 0;
+        const char* name = nameOf(record);
+        packed.insert(packed.end(), name, name + stringBytes(record));
+        kept.push_back(moved);
+    }
+    records.swap(kept);
+    names.swap(packed);
+}
+
+void MediaCatalog::sortOrder() {
+    order.resize(records.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<uint16_t>(i);
+    }
+    std::sort(order.begin(), order.end(), [this](uint16_t a, uint16_t b) {
+        return compareNames(nameOf(records[a]), nameOf(records[b])) < 0;
+    });
+}
+
+MediaCatalog::UpdateResult MediaCatalog::update(const char* dirPath, const char* extension,
+                                                const ProgressFn& progress) {
+    struct stat info;
+    if (stat(dirPath, &info) != 0 || !S_ISDIR(info.st_mode)) {
+        return UPDATE_FAILED;
+    }
+    DIR* dir = opendir(dirPath);
+    if (!dir) {
+        return UPDATE_FAILED;
+    }
+
+    reusedCount = 0;
+    addedCount = 0;
+    removedCount = 0;
+    modifiedCount = 0;
+    taggedCount = 0;
+    tagBytesRead = 0;
+    for (Record& record : records) {
+        record.flags = 0;
+    }
+
+    MediaCatalogStamp next;
+    next.dirMtime = static_cast<uint32_t>(info.st_mtime);
+    next.entryCount = 0;
+    next.nameHash = 0;
+    uint32_t matched = 0;
+    bool overflow = false;
+    char path[320];
+
+    // orderは更新前の目録のまま（追加分は末尾に積むだけなので探索には影響しない）
+    while (struct dirent* entry = readdir(dir)) {
+        const char* name = entry->d_name;
+        if (isDotEntry(name)) {
+            continue;
+        }
+        next.entryCount++;
+        next.nameHash += hashString(name, strlen(name));
+
+        struct stat fileInfo;
+        if (!endsWithIgnoreCase(name, extension ? extension : "") || !joinPath(path, sizeof(path), dirPath, name) ||
+            stat(path, &fileInfo) != 0 || !S_ISREG(fileInfo.st_mode)) {
+            continue;
+        }
+        matched++;
+        uint32_t size = static_cast<uint32_t>(fileInfo.st_size);
+        uint32_t mtime = static_cast<uint32_t>(fileInfo.st_mtime);
+
+        int index = findRecord(name);
+        if (index >= 0 && records[index].size == size && records[index].mtime == mtime) {
+            records[index].flags = FLAG_SEEN;
+            reusedCount++;
+        } else if (index >= 0) {
+            // 中身が変わったのでタグを読み直し、計測済みの値は捨てる
+            MediaTags tags;
+            readTags(path, size, tags);
+            Record& record = records[index];
+            record.flags = FLAG_SEEN;
+            record.size = size;
+            record.mtime = mtime;
+            record.durationMs = tags.durationMs;
+            storeStrings(record, name, tags);
+            modifiedCount++;
+        } else if (records.size() < MEDIA_CATALOG_MAX_ENTRIES) {
+            MediaTags tags;
+            readTags(path, size, tags);
+            if (appendRecord(name, size, mtime, tags)) {
+                addedCount++;
+            } else {
+                overflow = true;
+            }
+        } else {
+            overflow = true;
+        }
+
+        if (progress && !progress(matched, next.entryCount)) {
+            closedir(dir);
+            clear();
+            return UPDATE_ABORTED;
+        }
+    }
+    closedir(dir);
+    std::vector<uint8_t>().swap(tagWindow);
+
+    compact();
+    sortOrder();
+    uint32_t nextFilter = hashFilter(extension);
+    bool changed = addedCount > 0 || removedCount > 0 || modifiedCount > 0 ||
+                   next != stamp || nextFilter != filterHash;
+    stamp = next;
+    filterHash = nextFilter;
+    if (overflow) {
+        return UPDATE_FAILED;
+    }
+    return changed ? UPDATE_CHANGED : UPDATE_UNCHANGED;
+}
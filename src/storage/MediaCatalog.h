@@ -0,0 +1,176 @@
+#ifndef MEDIA_CATALOG_H
+#define MEDIA_CATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../shared/Delegate.h"
+#include "../shared/FixedString.h"
+#include "MediaTags.h"
+
+// 目録に載せるファイル数の上限（更新中は全件をメモリに載せる）
+#ifndef MEDIA_CATALOG_MAX_ENTRIES
+#define MEDIA_CATALOG_MAX_ENTRIES 4096
+#endif
+
+// ページ読み出しで1件あたりに持つ名前の長さ（超える分はUTF-8の境界で切り詰める）
+#ifndef MEDIA_CATALOG_PAGE_NAME_BYTES
+#define MEDIA_CATALOG_PAGE_NAME_BYTES 64
+#endif
+
+// ディレクトリの識別値
+// ファイルを開かずにディレクトリの一覧（名前）だけを読んで求める。
+// 追加・削除・改名があれば件数か名前のハッシュが変わる。
+struct MediaCatalogStamp {
+    uint32_t dirMtime;      // ディレクトリ自体の更新時刻（FATでは中身を変えても変わらないことがある）
+    uint32_t entryCount;    // 一覧のエントリ数（対象外のファイル・サブディレクトリを含む）
+    uint32_t nameHash;      // 名前ごとのFNV-1aの和（並び順に依存しない）
+
+    bool operator==(const MediaCatalogStamp& other) const {
+        return dirMtime == other.dirMtime && entryCount == other.entryCount && nameHash == other.nameHash;
+    }
+    bool operator!=(const MediaCatalogStamp& other) const { return !(*this == other); }
+};
+
+// 目録ファイルの先頭（これだけ読めば件数と有効性がわかる）
+struct MediaCatalogHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entryCount;
+    MediaCatalogStamp stamp;
+    uint32_t filterHash;    // 対象の拡張子のハッシュ
+    uint32_t payloadSize;
+    uint32_t payloadHash;   // 本体のFNV-1a
+};
+
+static_assert(sizeof(MediaCatalogHeader) == 32, "MediaCatalogHeader must stay 32 bytes");
+
+// 目録ファイルから直接読んだ1件（一覧表示用）
+struct MediaCatalogEntry {
+    FixedString<MEDIA_CATALOG_PAGE_NAME_BYTES> name;
+    MediaTagText title;     // 空ならタグなし
+    MediaTagText artist;
+    uint32_t size;
+    uint32_t durationMs;
+};
+
+// メディアファイルの目録
+// ディレクトリ内の対象ファイルの名前・サイズ・更新時刻・再生時間を
+// バイナリ形式でカードに保存しておき、次回は32バイトの先頭と一覧の識別値の照合だけで済ませる。
+// 変化があったときは前回の目録と突き合わせて差分だけ調べ直す（再生時間などは引き継ぐ）。
+// 追加・変更されたファイルだけはタグ（題名・アーティスト・再生時間の見積もり）を読む
+// （MediaTagReaderが決まった窓だけを読むので、大きなファイルでも全体は読まない）。
+//
+// ファイル形式（リトルエンディアン、ESP32とホストで共通）:
+//   MediaCatalogHeader
+//   Record × entryCount      （見つけた順）
+//   uint16_t × entryCount    （名前順の並び、Recordの添字）
+//   文字列の連結（1件ごとに 名前\0題名\0アーティスト\0）
+// パスはVFSのパス（SDなら"/sd/sound"）で、stdioとdirentで読み書きする。
+class MediaCatalog {
+public:
+    static const uint32_t MAGIC = 0x5441434D;  // "MCAT"
+    static const uint16_t VERSION = 2;
+
+    struct Record {
+        uint32_t size;
+        uint32_t mtime;
+        uint32_t durationMs;    // 0なら不明（フレームヘッダーからの見積もり。setDuration()で上書きできる）
+        uint32_t nameOffset;    // 文字列領域の先頭からの位置
+        uint16_t nameLength;    // NULを含まないバイト数
+        uint8_t titleLength;    // 題名とアーティストは名前の直後に続く
+        uint8_t artistLength;
+        uint16_t flags;         // 更新中の作業用（保存時は0）
+        uint16_t reserved;
+    };
+
+    enum UpdateResult : uint8_t {
+        UPDATE_UNCHANGED = 0,   // 前回の目録のまま
+        UPDATE_CHANGED,         // 追加・削除・変更を反映した
+        UPDATE_ABORTED,         // 途中経過のコールバックが中止した
+        UPDATE_FAILED           // ディレクトリを開けない・上限超過
+    };
+
+    static_assert(sizeof(Record) == 24, "Record is written to the card as-is");
+
+    // 途中経過（対象ファイル数, 調べたエントリ数）。falseを返すと中止
+    typedef Delegate<bool(uint32_t, uint32_t)> ProgressFn;
+
+private:
+    std::vector<Record> records;
+    std::vector<uint16_t> order;    // 名前順
+    std::vector<char> names;
+    MediaCatalogStamp stamp;
+    uint32_t filterHash;
+
+    uint32_t reusedCount;
+    uint32_t addedCount;
+    uint32_t removedCount;
+    uint32_t modifiedCount;
+
+    uint32_t taggedCount;
+    uint32_t tagBytesRead;
+    std::vector<uint8_t> tagWindow;     // タグを読むときだけ確保する
+
+    const char* nameOf(const Record& record) const { return &names[record.nameOffset]; }
+    const char* titleOf(const Record& record) const { return nameOf(record) + record.nameLength + 1; }
+    const char* artistOf(const Record& record) const { return titleOf(record) + record.titleLength + 1; }
+    static size_t stringBytes(const Record& record) {
+        return record.nameLength + record.titleLength + record.artistLength + 3u;
+    }
+    int findRecord(const char* name) const;
+    void storeStrings(Record& record, const char* name, const MediaTags& tags);
+    void readTags(const char* path, uint32_t size, MediaTags& out);
+    bool appendRecord(const char* name, uint32_t size, uint32_t mtime, const MediaTags& tags);
+    void compact();
+    void sortOrder();
+
+public:
+    MediaCatalog();
+
+    // 一覧の識別値を求める（ファイルは開かない）
+    static bool readStamp(const char* dirPath, MediaCatalogStamp& out);
+    // 目録ファイルの先頭だけを読む（形式が違えばfalse）
+    static bool readHeader(const char* indexPath, MediaCatalogHeader& out);
+    // 先頭が今のディレクトリと拡張子に一致するか
+    static bool isCurrent(const MediaCatalogHeader& header, const MediaCatalogStamp& stamp, const char* extension);
+    static uint32_t hashFilter(const char* extension);
+
+    // 名前順のfirst番目からcount件を目録ファイルから直接読む（全体は読み込まない）
+    // 読んだ件数をwritten、目録の全件数をtotalに返す。firstが末尾を越えていれば0件でtrue
+    static bool readPage(const char* indexPath, uint32_t first, MediaCatalogEntry* out, uint32_t count,
+                         uint32_t& written, uint32_t& total);
+
+    // 目録ファイル全体を読む（壊れていれば空のままfalse）
+    bool load(const char* indexPath);
+    // 一時ファイルに書いてから置き換える
+    bool save(const char* indexPath) const;
+
+    // ディレクトリを調べ直して差分を反映
+    UpdateResult update(const char* dirPath, const char* extension, const ProgressFn& progress = ProgressFn());
+
+    void clear();
+    size_t size() const { return records.size(); }
+    // 名前順のi番目
+    const char* nameAt(size_t index) const { return nameOf(records[order[index]]); }
+    const Record& recordAt(size_t index) const { return records[order[index]]; }
+    const char* titleAt(size_t index) const { return titleOf(records[order[index]]); }
+    const char* artistAt(size_t index) const { return artistOf(records[order[index]]); }
+    // 名前から名前順の位置を探す（なければ-1）
+    int find(const char* name) const;
+    bool setDuration(const char* name, uint32_t durationMs);
+
+    const MediaCatalogStamp& getStamp() const { return stamp; }
+    size_t getSerializedSize() const;
+
+    // 直近のupdate()の内訳
+    uint32_t getReusedCount() const { return reusedCount; }
+    uint32_t getAddedCount() const { return addedCount; }
+    uint32_t getRemovedCount() const { return removedCount; }
+    uint32_t getModifiedCount() const { return modifiedCount; }
+    // タグを読んだファイル数と、そのために読んだバイト数
+    uint32_t getTaggedCount() const { return taggedCount; }
+    uint32_t getTagBytesRead() const { return tagBytesRead; }
+};
+
+#endif // MEDIA_CATALOG_H
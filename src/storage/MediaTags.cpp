@@ -0,0 +1,418 @@
+#include "MediaTags.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+const size_t ID3V1_SIZE = 128;
+const size_t ID3V2_HEADER_SIZE = 10;
+
+uint32_t readBe32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+uint32_t readBe24(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+}
+
+// ID3v2の7bit×4の大きさ（上位ビットが立っていれば壊れている）
+bool readSyncsafe(const uint8_t* p, uint32_t& out) {
+    if ((p[0] | p[1] | p[2] | p[3]) & 0x80) {
+        return false;
+    }
+    out = (static_cast<uint32_t>(p[0]) << 21) | (static_cast<uint32_t>(p[1]) << 14) |
+          (static_cast<uint32_t>(p[2]) << 7) | p[3];
+    return true;
+}
+
+// 容量に収まる分だけUTF-8を書き足す
+struct Utf8Writer {
+    char* out;
+    size_t capacity;
+    size_t length;
+
+    bool put(uint32_t code) {
+        char bytes[4];
+        size_t count;
+        if (code < 0x80) {
+            bytes[0] = static_cast<char>(code);
+            count = 1;
+        } else if (code < 0x800) {
+            bytes[0] = static_cast<char>(0xC0 | (code >> 6));
+            bytes[1] = static_cast<char>(0x80 | (code & 0x3F));
+            count = 2;
+        } else if (code < 0x10000) {
+            bytes[0] = static_cast<char>(0xE0 | (code >> 12));
+            bytes[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            bytes[2] = static_cast<char>(0x80 | (code & 0x3F));
+            count = 3;
+        } else {
+            bytes[0] = static_cast<char>(0xF0 | (code >> 18));
+            bytes[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            bytes[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            bytes[3] = static_cast<char>(0x80 | (code & 0x3F));
+            count = 4;
+        }
+        if (length + count > capacity) {
+            return false;
+        }
+        memcpy(out + length, bytes, count);
+        length += count;
+        return true;
+    }
+};
+
+// 前後の空白と終端を落として入れる
+void assignTrimmed(MediaTagText& out, const char* text, size_t length) {
+    while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '\0')) {
+        length--;
+    }
+    while (length > 0 && *text == ' ') {
+        text++;
+        length--;
+    }
+    out.assign(text, length);
+}
+
+// テキストフレームの本体（先頭が文字コード）をUTF-8にする。複数の値があれば最初だけ
+void decodeText(const uint8_t* data, size_t length, MediaTagText& out) {
+    if (length < 1) {
+        return;
+    }
+    uint8_t encoding = data[0];
+    data++;
+    length--;
+    char text[MEDIA_TAG_TEXT_BYTES + 4];
+    Utf8Writer writer = {text, sizeof(text), 0};
+
+    if (encoding == 0) {
+        // ISO-8859-1はバイト値がそのままコードポイント
+        for (size_t i = 0; i < length && data[i] != 0; i++) {
+            if (!writer.put(data[i])) {
+                break;
+            }
+        }
+    } else if (encoding == 3) {
+        // UTF-8はそのまま写す（はみ出した分はassignが文字境界で切り詰める）
+        for (size_t i = 0; i < length && data[i] != 0 && writer.length < writer.capacity; i++) {
+            text[writer.length++] = static_cast<char>(data[i]);
+        }
+    } else if (encoding == 1 || encoding == 2) {
+        // UTF-16（1はBOM付き、BOMがなければリトルエンディアンとみなす。2はビッグエンディアン）
+        bool bigEndian = encoding == 2;
+        size_t i = 0;
+        if (encoding == 1 && length >= 2) {
+            if (data[0] == 0xFE && data[1] == 0xFF) {
+                bigEndian = true;
+                i = 2;
+            } else if (data[0] == 0xFF && data[1] == 0xFE) {
+                i = 2;
+            }
+        }
+        while (i + 1 < length) {
+            uint32_t unit = bigEndian ? (data[i] << 8) | data[i + 1] : (data[i + 1] << 8) | data[i];
+            i += 2;
+            if (unit == 0) {
+                break;
+            }
+            if (unit >= 0xD800 && unit < 0xDC00 && i + 1 < length) {
+                uint32_t low = bigEndian ? (data[i] << 8) | data[i + 1] : (data[i + 1] << 8) | data[i];
+                if (low >= 0xDC00 && low < 0xE000) {
+                    unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+                    i += 2;
+                }
+            }
+            if (unit >= 0xD800 && unit < 0xE000) {
+                unit = 0xFFFD;  // 対のないサロゲート
+            }
+            if (!writer.put(unit)) {
+                break;
+            }
+        }
+    } else {
+        return;
+    }
+    assignTrimmed(out, text, writer.length);
+}
+
+// TLEN（ミリ秒の10進数）
+uint32_t decodeLength(const uint8_t* data, size_t length) {
+    MediaTagText text;
+    decodeText(data, length, text);
+    uint32_t value = 0;
+    for (const char* p = text.c_str(); *p >= '0' && *p <= '9'; p++) {
+        if (value > 0xFFFFFFFFu / 10 - 9) {
+            return 0;
+        }
+        value = value * 10 + static_cast<uint32_t>(*p - '0');
+    }
+    return value;
+}
+
+// MPEGオーディオのフレームヘッダー
+struct FrameHeader {
+    uint8_t version;        // 1: MPEG1, 2: MPEG2, 3: MPEG2.5
+    uint8_t layer;          // 1〜3
+    bool mono;
+    uint16_t bitrateKbps;
+    uint32_t sampleRate;
+    uint32_t frameBytes;
+    uint32_t samplesPerFrame;
+};
+
+const uint16_t BITRATES_V1[3][15] = {
+    {0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448},     // Layer I
+    {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384},        // Layer II
+    {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320}          // Layer III
+};
+const uint16_t BITRATES_V2[2][15] = {
+    {0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256},        // Layer I
+    {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160}              // Layer II/III
+};
+const uint32_t SAMPLE_RATES_V1[3] = {44100, 48000, 32000};
+
+bool decodeFrameHeader(const uint8_t* p, FrameHeader& out) {
+    if (p[0] != 0xFF || (p[1] & 0xE0) != 0xE0) {
+        return false;
+    }
+    uint8_t versionBits = (p[1] >> 3) & 0x03;
+    uint8_t layerBits = (p[1] >> 1) & 0x03;
+    uint8_t bitrateIndex = p[2] >> 4;
+    uint8_t rateIndex = (p[2] >> 2) & 0x03;
+    // 予約値と自由ビットレート（長さが決まらない）は扱わない
+    if (versionBits == 1 || layerBits == 0 || bitrateIndex == 0 || bitrateIndex == 15 || rateIndex == 3) {
+        return false;
+    }
+    out.version = versionBits == 3 ? 1 : (versionBits == 2 ? 2 : 3);
+    out.layer = static_cast<uint8_t>(4 - layerBits);
+    out.mono = (p[3] >> 6) == 3;
+    out.bitrateKbps = out.version == 1 ? BITRATES_V1[out.layer - 1][bitrateIndex]
+                                       : BITRATES_V2[out.layer == 1 ? 0 : 1][bitrateIndex];
+    out.sampleRate = SAMPLE_RATES_V1[rateIndex] >> (out.version - 1);
+    uint32_t padding = (p[2] >> 1) & 0x01;
+    if (out.layer == 1) {
+        out.samplesPerFrame = 384;
+        out.frameBytes = (12 * out.bitrateKbps * 1000 / out.sampleRate + padding) * 4;
+    } else {
+        out.samplesPerFrame = (out.layer == 3 && out.version != 1) ? 576 : 1152;
+        out.frameBytes = out.samplesPerFrame / 8 * out.bitrateKbps * 1000 / out.sampleRate + padding;
+    }
+    return true;
+}
+} // namespace
+
+uint32_t MediaTagReader::parseId3v2(const uint8_t* data, size_t length, MediaTags& out) {
+    uint32_t size;
+    if (length < ID3V2_HEADER_SIZE || memcmp(data, "ID3", 3) != 0 || data[3] == 0xFF || data[4] == 0xFF ||
+        !readSyncsafe(data + 6, size)) {
+        return 0;
+    }
+    uint8_t major = data[3];
+    uint8_t flags = data[5];
+    uint32_t total = static_cast<uint32_t>(ID3V2_HEADER_SIZE) + size + ((major == 4 && (flags & 0x10)) ? 10 : 0);
+    // 知らない版と、タグ全体の非同期化（v2.2/2.3）は大きさだけ使って中身は読まない
+    if (major < 2 || major > 4 || (major < 4 && (flags & 0x80))) {
+        return total;
+    }
+    out.id3v2Version = major;
+
+    const size_t tagEnd = ID3V2_HEADER_SIZE + size;
+    const size_t end = tagEnd < length ? tagEnd : length;
+    const size_t idLength = major == 2 ? 3 : 4;
+    const size_t headerLength = major == 2 ? 6 : 10;
+    size_t pos = ID3V2_HEADER_SIZE;
+    if (major >= 3 && (flags & 0x40) && pos + 4 <= end) {
+        // 拡張ヘッダー（v2.3は自身の4バイトを含まない、v2.4は含む）
+        uint32_t extended = 0;
+        if (major == 4) {
+            if (!readSyncsafe(data + pos, extended)) {
+                return total;
+            }
+        } else {
+            extended = readBe32(data + pos) + 4;
+        }
+        pos += extended;
+    }
+
+    while (pos + headerLength <= end && data[pos] != 0) {
+        const uint8_t* frame = data + pos;
+        uint32_t frameSize;
+        if (major == 2) {
+            frameSize = readBe24(frame + 3);
+        } else if (major == 4) {
+            if (!readSyncsafe(frame + 4, frameSize)) {
+                break;
+            }
+        } else {
+            frameSize = readBe32(frame + 4);
+        }
+        size_t body = pos + headerLength;
+        if (frameSize == 0 || frameSize > tagEnd - body) {
+            break;      // 壊れている
+        }
+        if (body + frameSize > end) {
+            break;      // 窓の外（大きな画像など）。ここから先は読まない
+        }
+        pos = body + frameSize;
+
+        // 圧縮・暗号化・フレーム単位の非同期化は読まない。グループ番号と元の長さは読み飛ばす
+        const uint8_t* payload = data + body;
+        size_t payloadLength = frameSize;
+        if (major == 3) {
+            uint8_t format = frame[9];
+            if (format & 0xC0) {
+                continue;
+            }
+            if (format & 0x20) {
+                payload++;
+                payloadLength--;
+            }
+        } else if (major == 4) {
+            uint8_t format = frame[9];
+            if (format & 0x0E) {
+                continue;
+            }
+            size_t skip = ((format & 0x40) ? 1 : 0) + ((format & 0x01) ? 4 : 0);
+            if (skip > payloadLength) {
+                continue;
+            }
+            payload += skip;
+            payloadLength -= skip;
+        }
+
+        if (memcmp(frame, idLength == 3 ? "TT2" : "TIT2", idLength) == 0) {
+            decodeText(payload, payloadLength, out.title);
+        } else if (memcmp(frame, idLength == 3 ? "TP1" : "TPE1", idLength) == 0) {
+            decodeText(payload, payloadLength, out.artist);
+        } else if (memcmp(frame, idLength == 3 ? "TLE" : "TLEN", idLength) == 0) {
+            out.durationMs = decodeLength(payload, payloadLength);
+        }
+    }
+    return total;
+}
+
+bool MediaTagReader::parseId3v1(const uint8_t* data, size_t length, MediaTags& out) {
+    if (length < ID3V1_SIZE) {
+        return false;
+    }
+    const uint8_t* tag = data + length - ID3V1_SIZE;
+    if (memcmp(tag, "TAG", 3) != 0) {
+        return false;
+    }
+    out.hasId3v1 = true;
+    // 30バイトの固定欄（ISO-8859-1）
+    const uint8_t* fields[2] = {tag + 3, tag + 33};
+    MediaTagText* targets[2] = {&out.title, &out.artist};
+    for (int f = 0; f < 2; f++) {
+        if (!targets[f]->empty()) {
+            continue;
+        }
+        uint8_t frame[31];
+        frame[0] = 0;
+        memcpy(frame + 1, fields[f], 30);
+        decodeText(frame, sizeof(frame), *targets[f]);
+    }
+    return true;
+}
+
+bool MediaTagReader::parseMpegFrames(const uint8_t* data, size_t length, uint32_t audioBytes, MediaTags& out,
+                                     uint32_t& syncOffset) {
+    FrameHeader header;
+    size_t pos = 0;
+    for (; pos + 4 <= length; pos++) {
+        if (!decodeFrameHeader(data + pos, header)) {
+            continue;
+        }
+        // 偶然の0xFFFを避けるため、窓の中に次のフレームがあれば同じ形式か確かめる
+        size_t next = pos + header.frameBytes;
+        FrameHeader following;
+        if (next + 4 <= length && (!decodeFrameHeader(data + next, following) ||
+                                   following.version != header.version || following.layer != header.layer ||
+                                   following.sampleRate != header.sampleRate)) {
+            continue;
+        }
+        break;
+    }
+    if (pos + 4 > length) {
+        return false;
+    }
+    syncOffset = static_cast<uint32_t>(pos);
+
+    // 最初のフレームにあるVBRのフレーム数（XingとInfoはサイド情報の後ろ、VBRIは32バイト後ろ）
+    uint32_t frames = 0;
+    if (header.layer == 3) {
+        size_t sideInfo = header.version == 1 ? (header.mono ? 17 : 32) : (header.mono ? 9 : 17);
+        size_t xing = pos + 4 + sideInfo;
+        size_t vbri = pos + 4 + 32;
+        if (xing + 12 <= length && (memcmp(data + xing, "Xing", 4) == 0 || memcmp(data + xing, "Info", 4) == 0) &&
+            (readBe32(data + xing + 4) & 0x01)) {
+            frames = readBe32(data + xing + 8);
+        } else if (vbri + 18 <= length && memcmp(data + vbri, "VBRI", 4) == 0) {
+            frames = readBe32(data + vbri + 14);
+        }
+    }
+    if (frames > 0) {
+        out.durationMs = static_cast<uint32_t>(static_cast<uint64_t>(frames) * header.samplesPerFrame * 1000 /
+                                               header.sampleRate);
+        out.fromFrameCount = true;
+    } else if (out.durationMs == 0 && audioBytes > pos) {
+        // 固定ビットレートとみなす（kbpsなので、ビット数 / kbps = ミリ秒）
+        out.durationMs = static_cast<uint32_t>(static_cast<uint64_t>(audioBytes - pos) * 8 / header.bitrateKbps);
+    }
+    return true;
+}
+
+uint32_t MediaTagReader::read(const char* path, uint32_t fileSize, MediaTags& out, uint8_t* window,
+                              size_t windowSize) {
+    out = MediaTags();
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return 0;
+    }
+    uint32_t bytesRead = 0;
+
+    // 先頭: ID3v2
+    size_t headLength = windowSize < MEDIA_TAG_HEAD_WINDOW ? windowSize : MEDIA_TAG_HEAD_WINDOW;
+    if (headLength > fileSize) {
+        headLength = fileSize;
+    }
+    headLength = fread(window, 1, headLength, file);
+    bytesRead += static_cast<uint32_t>(headLength);
+    uint32_t audioStart = parseId3v2(window, headLength, out);
+    if (audioStart > fileSize) {
+        audioStart = fileSize;
+    }
+
+    // 末尾: ID3v1（音声部分の大きさにも関わるので先に読む）
+    uint32_t audioEnd = fileSize;
+    if (fileSize >= audioStart + ID3V1_SIZE) {
+        uint8_t tail[ID3V1_SIZE];
+        if (fseek(file, static_cast<long>(fileSize - ID3V1_SIZE), SEEK_SET) == 0 &&
+            fread(tail, 1, sizeof(tail), file) == sizeof(tail)) {
+            bytesRead += static_cast<uint32_t>(sizeof(tail));
+            if (parseId3v1(tail, sizeof(tail), out)) {
+                audioEnd -= static_cast<uint32_t>(ID3V1_SIZE);
+            }
+        }
+    }
+
+    // 音声の先頭: 最初のフレーム（先頭の窓に収まっていれば読み直さない）
+    size_t frameLength = windowSize < MEDIA_TAG_FRAME_WINDOW ? windowSize : MEDIA_TAG_FRAME_WINDOW;
+    if (frameLength > audioEnd - audioStart) {
+        frameLength = audioEnd - audioStart;
+    }
+    const uint8_t* frames = window + audioStart;
+    if (audioStart + frameLength > headLength) {
+        frames = window;
+        frameLength = fseek(file, static_cast<long>(audioStart), SEEK_SET) == 0
+                          ? fread(window, 1, frameLength, file)
+                          : 0;
+        bytesRead += static_cast<uint32_t>(frameLength);
+    }
+    uint32_t syncOffset = 0;
+    if (parseMpegFrames(frames, frameLength, audioEnd - audioStart, out, syncOffset)) {
+        out.audioOffset = audioStart + syncOffset;
+    }
+    fclose(file);
+    return bytesRead;
+}
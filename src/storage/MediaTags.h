@@ -0,0 +1,62 @@
+#ifndef MEDIA_TAGS_H
+#define MEDIA_TAGS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../shared/FixedString.h"
+
+// 目録に残すタグの文字列の容量（終端を含む。超える分はUTF-8の境界で切り詰める）
+#ifndef MEDIA_TAG_TEXT_BYTES
+#define MEDIA_TAG_TEXT_BYTES 48
+#endif
+
+// ファイルの先頭から読む範囲（ID3v2のフレームはこの中にあるものだけを見る）
+#ifndef MEDIA_TAG_HEAD_WINDOW
+#define MEDIA_TAG_HEAD_WINDOW 4096
+#endif
+
+// 音声の先頭から読む範囲（最初のフレームヘッダーとXing/VBRIを探す）
+#ifndef MEDIA_TAG_FRAME_WINDOW
+#define MEDIA_TAG_FRAME_WINDOW 2048
+#endif
+
+typedef FixedString<MEDIA_TAG_TEXT_BYTES> MediaTagText;
+
+// 1ファイル分のタグと再生時間の見積もり
+struct MediaTags {
+    MediaTagText title;
+    MediaTagText artist;
+    uint32_t durationMs;    // 0ならわからない
+    uint32_t audioOffset;   // 最初のMPEGフレームの位置
+    uint8_t id3v2Version;   // 0ならID3v2なし（2〜4）
+    bool hasId3v1;
+    bool fromFrameCount;    // 再生時間をXing/VBRIのフレーム数から求めた（falseならTLENか平均ビットレート）
+
+    MediaTags() : durationMs(0), audioOffset(0), id3v2Version(0), hasId3v1(false), fromFrameCount(false) {}
+};
+
+// MP3のタグ読み取り
+// ファイル全体は読まず、次の3か所だけを読む（1ファイルあたり最大で約6KB）。
+//   先頭: ID3v2（画像など窓に収まらないフレームとその先は読まない）
+//   音声の先頭: 最初のフレームヘッダーとXing/Info/VBRI（VBRのフレーム数）
+//   末尾128バイト: ID3v1（ID3v2に題名・アーティストがなかったときの代わり）
+// 再生時間はフレーム数 → TLEN → 音声部分の大きさと最初のフレームのビットレートの順に求める。
+// 文字列はUTF-8にそろえる（ISO-8859-1とUTF-16は変換し、Shift_JISなどはそのまま）。
+class MediaTagReader {
+public:
+    // pathのファイルを読む。windowは作業領域（MEDIA_TAG_HEAD_WINDOW以上）
+    // 読んだバイト数を返す（開けなければ0）
+    static uint32_t read(const char* path, uint32_t fileSize, MediaTags& out, uint8_t* window, size_t windowSize);
+
+    // 以下は読み込み済みのバッファを調べる（ホストのテストからも使う）
+    // ID3v2を調べてタグ全体の大きさ（ヘッダー込み）を返す。タグがなければ0
+    static uint32_t parseId3v2(const uint8_t* data, size_t length, MediaTags& out);
+    // 末尾128バイトのID3v1。空いている題名・アーティストだけを埋める
+    static bool parseId3v1(const uint8_t* data, size_t length, MediaTags& out);
+    // 音声の先頭から最初のフレームを探し、再生時間を求める
+    // audioBytesは音声部分（タグを除く）の大きさ。見つけたフレームの位置をsyncOffsetに返す
+    static bool parseMpegFrames(const uint8_t* data, size_t length, uint32_t audioBytes, MediaTags& out,
+                                uint32_t& syncOffset);
+};
+
+#endif // MEDIA_TAGS_H
@@ -0,0 +1,170 @@
+#ifndef PAGE_CACHE_H
+#define PAGE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// SDサービスに読ませる一覧のページの置き場
+// 固定数のページ枠を持ち、読み込み中の枠にはSDサービスがあとから書き込むので触らない。
+// SDサービスは要求を届いた順に1つずつ処理するので、ある要求の結果が届いたら
+// それより古い要求はすべて終わっている。結果を受け取れなかった（画面を離れていた・
+// レーンが満杯で捨てられた）読み込みはretireOlder()で空きに戻す。
+// 画面やSDサービスには依存しない（要求IDと結果の件数だけを扱う）。
+template <typename Entry, size_t Pages, uint32_t PageEntries>
+class PageCache {
+public:
+    static_assert(Pages > 0 && PageEntries > 0 && PageEntries <= 255, "page size must fit the slot count");
+
+    enum State : uint8_t {
+        EMPTY = 0,
+        LOADING,        // SDサービスが書き込み中（触らない）
+        READY
+    };
+
+    struct Slot {
+        uint32_t page;
+        uint32_t lastUse;
+        uint16_t requestId;
+        uint8_t state;
+        uint8_t count;
+    };
+
+    static const size_t NO_SLOT = Pages;
+
+    // 要求IDの新旧（16bitで一周するので差で比べる）
+    static bool isOlderRequest(uint16_t id, uint16_t than) {
+        return static_cast<int16_t>(static_cast<uint16_t>(than - id)) > 0;
+    }
+
+private:
+    Slot slots[Pages];
+    Entry entries[Pages][PageEntries];
+    uint32_t useCounter;
+
+public:
+    PageCache() : useCounter(0) {
+        for (Slot& slot : slots) {
+            slot = Slot();
+        }
+    }
+
+    // 読めている項目（なければnullptr）。使った印を付ける
+    const Entry* find(uint32_t item) {
+        Slot* slot = findSlot(item / PageEntries);
+        uint32_t offset = item % PageEntries;
+        if (!slot || slot->state != READY || offset >= slot->count) {
+            return nullptr;
+        }
+        slot->lastUse = ++useCounter;
+        return &entries[slot - slots][offset];
+    }
+
+    // ページが読めているか読み込み中ならtrue（もう頼まなくてよい）
+    bool contains(uint32_t page) const {
+        for (const Slot& slot : slots) {
+            if (slot.state != EMPTY && slot.page == page) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ページを読み込む枠を選ぶ（なければNO_SLOT）
+    // 空きか、[keepFirst, keepLast]（表示中）以外でいちばん長く使っていないページを読み直す。
+    // 読み込み中がmaxLoading個以上あるときは選ばない（SDサービスの要求キューを埋めない）
+    size_t reserve(uint32_t keepFirst, uint32_t keepLast, size_t maxLoading) const {
+        size_t loading = 0;
+        const Slot* victim = nullptr;
+        for (const Slot& slot : slots) {
+            if (slot.state == LOADING) {
+                loading++;
+            } else if (slot.state == EMPTY) {
+                victim = &slot;
+            } else if (slot.page < keepFirst || slot.page > keepLast) {
+                if (!victim || (victim->state == READY && slot.lastUse < victim->lastUse)) {
+                    victim = &slot;
+                }
+            }
+        }
+        if (!victim || loading >= maxLoading) {
+            return NO_SLOT;
+        }
+        return static_cast<size_t>(victim - slots);
+    }
+
+    // reserve()で選んだ枠の書き込み先（SDサービスに渡す）
+    Entry* buffer(size_t index) { return entries[index]; }
+
+    // 要求を出した枠を読み込み中にする
+    void markLoading(size_t index, uint32_t page, uint16_t requestId) {
+        Slot& slot = slots[index];
+        slot.page = page;
+        slot.requestId = requestId;
+        slot.state = LOADING;
+        slot.count = 0;
+    }
+
+    // requestIdより古い読み込みを空きに戻し、そのページ番号をretired(page)で知らせる
+    // requestIdはどの種類の要求の結果でもよい（件数の確認や進捗でも）
+    template <typename Fn>
+    size_t retireOlder(uint16_t requestId, Fn retired) {
+        size_t count = 0;
+        for (Slot& slot : slots) {
+            if (slot.state == LOADING && isOlderRequest(slot.requestId, requestId)) {
+                slot.state = EMPTY;
+                retired(slot.page);
+                count++;
+            }
+        }
+        return count;
+    }
+
+    // 読み込みの結果を反映する。該当する枠があればそれを返す（読めなかった枠は空きに戻す）
+    const Slot* complete(uint16_t requestId, bool ok, uint32_t count) {
+        for (Slot& slot : slots) {
+            if (slot.state != LOADING || slot.requestId != requestId) {
+                continue;
+            }
+            if (!ok) {
+                slot.state = EMPTY;
+            } else {
+                slot.state = READY;
+                slot.count = static_cast<uint8_t>(count < PageEntries ? count : PageEntries);
+                slot.lastUse = ++useCounter;
+            }
+            return &slot;
+        }
+        return nullptr;
+    }
+
+    // 読めているページを捨てる（目録が変わったとき）。keepのページは残す
+    // 読み込み中のページはSDサービスが書き終えるまでそのままにする
+    void reset(uint32_t keep = 0xFFFFFFFF) {
+        for (Slot& slot : slots) {
+            if (slot.state == READY && slot.page != keep) {
+                slot.state = EMPTY;
+            }
+        }
+    }
+
+    bool hasLoading() const {
+        for (const Slot& slot : slots) {
+            if (slot.state == LOADING) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    Slot* findSlot(uint32_t page) {
+        for (Slot& slot : slots) {
+            if (slot.state != EMPTY && slot.page == page) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+};
+
+#endif // PAGE_CACHE_H
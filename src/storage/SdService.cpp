@@ -0,0 +1,570 @@
+#include "SdService.h"
+#include <SD.h>
+#include <cstring>
+#include "../shared/EventBus.h"
+#include "MediaCatalog.h"
+#include "LogWriter.h"
+
+// 最終結果を送れなかったときの再試行（制御レーンが一時的に満杯のとき）
+#ifndef SD_SERVICE_RESULT_RETRIES
+#define SD_SERVICE_RESULT_RETRIES 10
+#endif
+
+SdService* g_sdService = nullptr;
+
+namespace {
+const uint32_t LOG_FILE_UNKNOWN = 0xFFFFFFFF;
+
+bool copyText(char* dst, size_t capacity, const char* src) {
+    if (!src) {
+        return false;
+    }
+    size_t length = strlen(src);
+    if (length >= capacity) {
+        return false;
+    }
+    memcpy(dst, src, length + 1);
+    return true;
+}
+} // namespace
+
+SdService::SdService()
+    : spi(SD_CARD_SPI_HOST), queue(nullptr), taskHandle(nullptr), busConfigured(false),
+      mounted(false), nextId(0), cancelledId(0), completedCount(0), failedCount(0),
+      rejectedCount(0), lostResults(0), catalogHits(0), catalogRebuilds(0), taggedFiles(0), lastScanMs(0),
+      streamLock(nullptr), streamRing(nullptr), streamDetachedId(0), streamBytes(0), streamStalls(0),
+      logWriter(nullptr), lastLogFlushMs(0), lastLogMountMs(0), logFileBytes(LOG_FILE_UNKNOWN), logBytes(0),
+      logRotations(0) {
+}
+
+void SdService::init() {
+    if (busConfigured) {
+        return;
+    }
+    spi.begin(SD_CARD_SCLK_PIN, SD_CARD_MISO_PIN, SD_CARD_MOSI_PIN, SD_CARD_CS_PIN);
+    busConfigured = true;
+}
+
+bool SdService::start() {
+    if (taskHandle) {
+        return true;
+    }
+    init();
+    queue = xQueueCreate(SD_SERVICE_QUEUE_LENGTH, sizeof(Request));
+    streamLock = xSemaphoreCreateMutex();
+    if (!queue || !streamLock) {
+        return false;
+    }
+    xTaskCreatePinnedToCore(
+        serviceTask,              // タスク関数
+        "SdService",              // タスク名
+        SD_SERVICE_STACK_SIZE,    // スタックサイズ
+        this,                     // パラメータ（thisポインタ）
+        SD_SERVICE_PRIORITY,      // 優先度（タッチより低い）
+        &taskHandle,              // タスクハンドル
+        SD_SERVICE_CORE           // 表示コアとは別のコア
+    );
+    Serial.println("SD service task started");
+    return taskHandle != nullptr;
+}
+
+uint16_t SdService::enqueue(Request& request) {
+    if (!queue) {
+        rejectedCount++;
+        return 0;
+    }
+    // 0は「要求なし」を表すので飛ばす
+    uint16_t id = ++nextId;
+    if (id == 0) {
+        id = ++nextId;
+    }
+    request.id = id;
+    if (xQueueSend(queue, &request, 0) != pdTRUE) {
+        rejectedCount++;
+        return 0;
+    }
+    return id;
+}
+
+uint16_t SdService::requestMount() {
+    Request request = Request();
+    request.op = SD_OP_MOUNT;
+    return enqueue(request);
+}
+
+uint16_t SdService::requestScan(const char* dir, const char* extension) {
+    Request request = Request();
+    request.op = SD_OP_SCAN;
+    if (!copyText(request.path, sizeof(request.path), dir) ||
+        !copyText(request.extension, sizeof(request.extension), extension ? extension : "")) {
+        rejectedCount++;
+        return 0;
+    }
+    return enqueue(request);
+}
+
+uint16_t SdService::requestRead(const char* path, uint32_t offset, uint8_t* buffer, uint32_t length) {
+    Request request = Request();
+    request.op = SD_OP_READ;
+    request.buffer = buffer;
+    request.length = length;
+    request.offset = offset;
+    if (!buffer || !copyText(request.path, sizeof(request.path), path)) {
+        rejectedCount++;
+        return 0;
+    }
+    return enqueue(request);
+}
+
+uint16_t SdService::requestPage(const char* dir, uint32_t first, MediaCatalogEntry* entries, uint32_t count) {
+    Request request = Request();
+    request.op = SD_OP_PAGE;
+    request.entries = entries;
+    request.length = count;
+    request.offset = first;
+    if (!entries || count == 0 || !copyText(request.path, sizeof(request.path), dir)) {
+        rejectedCount++;
+        return 0;
+    }
+    return enqueue(request);
+}
+
+uint16_t SdService::requestWrite(const char* path, const uint8_t* data, uint32_t length, bool append) {
+    Request request = Request();
+    request.op = SD_OP_WRITE;
+    request.data = data;
+    request.length = length;
+    request.append = append;
+    if ((!data && length > 0) || !copyText(request.path, sizeof(request.path), path)) {
+        rejectedCount++;
+        return 0;
+    }
+    return enqueue(request);
+}
+
+uint16_t SdService::requestStream(const char* path, SpscRing<uint8_t>* ring) {
+    Request request = Request();
+    request.op = SD_OP_STREAM;
+    request.ring = ring;
+    if (!ring || !copyText(request.path, sizeof(request.path), path)) {
+        rejectedCount++;
+        return 0;
+    }
+    return enqueue(request);
+}
+
+void SdService::detachStream() {
+    if (!streamLock) {
+        return;
+    }
+    // 補充中ならその1回が終わるまで待つ。キューに残っている要求もここまでのIDは開かない
+    xSemaphoreTake(streamLock, portMAX_DELAY);
+    streamRing = nullptr;
+    streamDetachedId.store(nextId.load());
+    xSemaphoreGive(streamLock);
+}
+
+size_t SdService::getQueuedCount() const {
+    return queue ? uxQueueMessagesWaiting(queue) : 0;
+}
+
+void SdService::serviceTask(void* parameter) {
+    SdService* service = static_cast<SdService*>(parameter);
+    service->runServiceTask();
+}
+
+void SdService::runServiceTask() {
+    Request request;
+    while (true) {
+        // 要求が来るまで眠る（ストリーム中は短い周期で起きてリングを補充し、ログがあればその周期で書き出す）
+        bool streaming = streamRing != nullptr || streamFile;
+        TickType_t wait = streaming ? pdMS_TO_TICKS(SD_SERVICE_STREAM_POLL_MS)
+                                    : (logWriter ? pdMS_TO_TICKS(LOG_WRITER_INTERVAL_MS) : portMAX_DELAY);
+        if (xQueueReceive(queue, &request, wait) == pdTRUE) {
+            process(request);
+        }
+        refillStream();
+        flushLog();
+    }
+}
+
+void SdService::process(const Request& request) {
+    uint8_t status = SD_STATUS_IO_ERROR;
+    uint32_t value = 0;
+    uint32_t aux = 0;
+    // 結果の送信（再試行で待つことがある）はバスを手放してから行う
+    g_busArbiter.acquire(BUS_CLIENT_SD);
+    switch (request.op) {
+        case SD_OP_MOUNT:
+            status = mount();
+            break;
+        case SD_OP_SCAN:
+            status = scan(request, value, aux);
+            break;
+        case SD_OP_READ:
+            status = read(request, value);
+            break;
+        case SD_OP_WRITE:
+            status = write(request, value);
+            break;
+        case SD_OP_STREAM:
+            status = openStream(request, value);
+            break;
+        case SD_OP_PAGE:
+            status = readPage(request, value, aux);
+            break;
+        default:
+            break;
+    }
+    g_busArbiter.release(BUS_CLIENT_SD);
+    if (status == SD_STATUS_OK) {
+        completedCount++;
+    } else {
+        failedCount++;
+    }
+    postResult(request.id, request.op, status, value, aux);
+}
+
+uint8_t SdService::mount() {
+    if (mounted.load()) {
+        return SD_STATUS_OK;
+    }
+    if (!SD.begin(SD_CARD_CS_PIN, spi, SD_CARD_FREQ_HZ)) {
+        return SD_STATUS_NO_CARD;
+    }
+    mounted.store(true);
+    return SD_STATUS_OK;
+}
+
+uint8_t SdService::scan(const Request& request, uint32_t& matched, uint32_t& examined) {
+    uint8_t status = mount();
+    if (status != SD_STATUS_OK) {
+        return status;
+    }
+    char dirPath[sizeof(SD_CARD_MOUNT_POINT) + SD_SERVICE_PATH_MAX];
+    char indexPath[sizeof(SD_CARD_MOUNT_POINT) + SD_SERVICE_PATH_MAX + 4];
+    snprintf(dirPath, sizeof(dirPath), "%s%s", SD_CARD_MOUNT_POINT, request.path);
+    snprintf(indexPath, sizeof(indexPath), "%s%s.idx", SD_CARD_MOUNT_POINT, request.path);
+    uint32_t startMs = millis();
+
+    // 一覧の名前だけを読み、目録の先頭（32バイト）と一致すればそれで終わり
+    MediaCatalogStamp stamp;
+    if (!MediaCatalog::readStamp(dirPath, stamp)) {
+        return SD_STATUS_NOT_FOUND;
+    }
+    MediaCatalogHeader header;
+    if (MediaCatalog::readHeader(indexPath, header) &&
+        MediaCatalog::isCurrent(header, stamp, request.extension)) {
+        matched = header.entryCount;
+        examined = stamp.entryCount;
+        catalogHits++;
+        lastScanMs = millis() - startMs;
+        return SD_STATUS_OK;
+    }
+
+    // 変化があれば前回の目録と突き合わせて差分だけ調べ直す
+    // （追加・変更されたファイルはタグも読むので、1件ごとにバスを譲る）
+    struct ScanProgress {
+        uint16_t id;
+        uint32_t lastMs;
+    } progress = { request.id, startMs };
+    ScanProgress* state = &progress;
+    MediaCatalog catalog;
+    catalog.load(indexPath);
+    MediaCatalog::UpdateResult result = catalog.update(dirPath, request.extension,
+        [this, state](uint32_t found, uint32_t seen) {
+            if (cancelledId.load() == state->id) {
+                return false;
+            }
+            // バスを共有している構成では、待っている表示やタッチに一度譲る
+            g_busArbiter.yield(BUS_CLIENT_SD);
+            // 途中経過は間引いて送る（落ちても最終結果で追いつく）
+            uint32_t nowMs = millis();
+            if (nowMs - state->lastMs >= SD_SERVICE_PROGRESS_INTERVAL_MS) {
+                state->lastMs = nowMs;
+                if (g_eventBus) {
+                    g_eventBus->publish(makeSdResultEvent(state->id, SD_OP_SCAN, SD_STATUS_PROGRESS, found, seen));
+                }
+            }
+            return true;
+        });
+    catalogRebuilds++;
+    taggedFiles += catalog.getTaggedCount();
+    lastScanMs = millis() - startMs;
+    if (result == MediaCatalog::UPDATE_ABORTED) {
+        return SD_STATUS_CANCELLED;
+    }
+    if (result == MediaCatalog::UPDATE_FAILED) {
+        return SD_STATUS_IO_ERROR;
+    }
+    matched = static_cast<uint32_t>(catalog.size());
+    examined = catalog.getStamp().entryCount;
+    // 保存に失敗しても数えた結果は返す（次回また調べ直すだけ）
+    catalog.save(indexPath);
+    return SD_STATUS_OK;
+}
+
+uint8_t SdService::read(const Request& request, uint32_t& bytes) {
+    uint8_t status = mount();
+    if (status != SD_STATUS_OK) {
+        return status;
+    }
+    File file = SD.open(request.path, FILE_READ);
+    if (!file || file.isDirectory()) {
+        if (file) {
+            file.close();
+        }
+        return SD_STATUS_NOT_FOUND;
+    }
+    if (request.offset > 0 && !file.seek(request.offset)) {
+        file.close();
+        return SD_STATUS_IO_ERROR;
+    }
+    bytes = file.read(request.buffer, request.length);
+    file.close();
+    return SD_STATUS_OK;
+}
+
+uint8_t SdService::write(const Request& request, uint32_t& bytes) {
+    uint8_t status = mount();
+    if (status != SD_STATUS_OK) {
+        return status;
+    }
+    File file = SD.open(request.path, request.append ? FILE_APPEND : FILE_WRITE);
+    if (!file) {
+        // 書き込みで開けないのはカードが抜かれた可能性が高いので次回はマウントからやり直す
+        mounted.store(false);
+        SD.end();
+        return SD_STATUS_IO_ERROR;
+    }
+    bytes = request.length > 0 ? file.write(request.data, request.length) : 0;
+    file.close();
+    return bytes == request.length ? SD_STATUS_OK : SD_STATUS_IO_ERROR;
+}
+
+uint8_t SdService::readPage(const Request& request, uint32_t& written, uint32_t& total) {
+    uint8_t status = mount();
+    if (status != SD_STATUS_OK) {
+        return status;
+    }
+    char indexPath[sizeof(SD_CARD_MOUNT_POINT) + SD_SERVICE_PATH_MAX + 4];
+    snprintf(indexPath, sizeof(indexPath), "%s%s.idx", SD_CARD_MOUNT_POINT, request.path);
+    if (!MediaCatalog::readPage(indexPath, request.offset, request.entries, request.length, written, total)) {
+        return total == 0 ? SD_STATUS_NOT_FOUND : SD_STATUS_IO_ERROR;
+    }
+    return SD_STATUS_OK;
+}
+
+bool SdService::resolveStreamPath(const char* path, char* out, size_t capacity) {
+    File entry = SD.open(path, FILE_READ);
+    if (!entry) {
+        return false;
+    }
+    bool isDirectory = entry.isDirectory();
+    entry.close();
+    if (!isDirectory) {
+        return snprintf(out, capacity, "%s", path) < static_cast<int>(capacity);
+    }
+    // ディレクトリなら目録の名前順で先頭のファイル（一覧を歩かずに済む）
+    char indexPath[sizeof(SD_CARD_MOUNT_POINT) + SD_SERVICE_PATH_MAX + 4];
+    snprintf(indexPath, sizeof(indexPath), "%s%s.idx", SD_CARD_MOUNT_POINT, path);
+    MediaCatalog catalog;
+    if (!catalog.load(indexPath) || catalog.size() == 0) {
+        return false;
+    }
+    return snprintf(out, capacity, "%s/%s", path, catalog.nameAt(0)) < static_cast<int>(capacity);
+}
+
+uint8_t SdService::openStream(const Request& request, uint32_t& size) {
+    // 要求のあとで切り離されていれば開かない
+    if (static_cast<int16_t>(request.id - streamDetachedId.load()) <= 0) {
+        return SD_STATUS_CANCELLED;
+    }
+    // 前のストリームは置き換える（バスはprocess()が取得済み）
+    xSemaphoreTake(streamLock, portMAX_DELAY);
+    streamRing = nullptr;
+    xSemaphoreGive(streamLock);
+    closeStream();
+    uint8_t status = mount();
+    char path[SD_SERVICE_PATH_MAX * 2];
+    if (status == SD_STATUS_OK && !resolveStreamPath(request.path, path, sizeof(path))) {
+        status = SD_STATUS_NOT_FOUND;
+    }
+    File file;
+    if (status == SD_STATUS_OK) {
+        file = SD.open(path, FILE_READ);
+        if (!file || file.isDirectory()) {
+            status = SD_STATUS_NOT_FOUND;
+        }
+    }
+    xSemaphoreTake(streamLock, portMAX_DELAY);
+    if (static_cast<int16_t>(request.id - streamDetachedId.load()) <= 0) {
+        status = SD_STATUS_CANCELLED;
+    } else if (status != SD_STATUS_OK) {
+        // 読み手が待ち続けないよう終端にする
+        request.ring->close();
+    } else {
+        size = static_cast<uint32_t>(file.size());
+        streamFile = file;
+        streamRing = request.ring;
+    }
+    xSemaphoreGive(streamLock);
+    if (status != SD_STATUS_OK && file) {
+        file.close();
+    }
+    return status;
+}
+
+void SdService::refillStream() {
+    if (!streamLock || (!streamRing && !streamFile)) {
+        return;
+    }
+    // streamLockを持ったままバスを待たない（LCDとSDが同じバスだと、フレーム中に
+    // detachStream()を呼んだ表示タスクと互いに待ち合う）。リングの確認と書き込みだけを守る
+    bool first = true;
+    while (true) {
+        xSemaphoreTake(streamLock, portMAX_DELAY);
+        SpscRing<uint8_t>* ring = streamRing;
+        bool hasSpace = ring && ring->space() >= SD_SERVICE_STREAM_CHUNK;
+        xSemaphoreGive(streamLock);
+        if (!ring) {
+            // 切り離されたので後片付けだけ
+            BusLock bus(g_busArbiter, BUS_CLIENT_SD);
+            closeStream();
+            return;
+        }
+        if (!hasSpace) {
+            if (first) {
+                streamStalls++;
+            }
+            return;
+        }
+        first = false;
+        
+        // 空きがある限りチャンク単位で読む（チャンクごとにバスを取り直して表示やタッチを待たせない）
+        size_t bytes;
+        {
+            BusLock bus(g_busArbiter, BUS_CLIENT_SD);
+            bytes = streamFile.read(streamChunk, sizeof(streamChunk));
+        }
+        bool ended = bytes < sizeof(streamChunk);
+        xSemaphoreTake(streamLock, portMAX_DELAY);
+        if (streamRing == ring) {
+            ring->write(streamChunk, bytes);
+            streamBytes += static_cast<uint32_t>(bytes);
+            if (ended) {
+                // 終端（読み込みエラーも終端として扱う）
+                ring->close();
+                streamRing = nullptr;
+            }
+        }
+        xSemaphoreGive(streamLock);
+        if (ended) {
+            BusLock bus(g_busArbiter, BUS_CLIENT_SD);
+            closeStream();
+            return;
+        }
+    }
+}
+
+// 呼び出し側がSDのバスを持っていること
+void SdService::closeStream() {
+    if (streamFile) {
+        streamFile.close();
+    }
+    streamFile = File();
+}
+
+void SdService::flushLog() {
+    if (!logWriter) {
+        return;
+    }
+    uint32_t nowMs = millis();
+    if (nowMs - lastLogFlushMs < LOG_WRITER_INTERVAL_MS) {
+        return;
+    }
+    lastLogFlushMs = nowMs;
+    // 整形とSerialへの出力は毎回、SDへはセクタの倍数が溜まったときだけ
+    logWriter->collect(nowMs);
+    size_t bytes = logWriter->ready(nowMs, false);
+    if (bytes == 0) {
+        return;
+    }
+    bool written;
+    {
+        BusLock bus(g_busArbiter, BUS_CLIENT_SD);
+        written = appendLog(logWriter->data(), bytes);
+    }
+    logWriter->consume(bytes, written);
+}
+
+// 呼び出し側がSDのバスを持っていること
+bool SdService::appendLog(const uint8_t* data, size_t length) {
+    if (!mounted.load()) {
+        // カードがないときに毎回SD.begin()で待たないよう、試す間隔を空ける
+        uint32_t nowMs = millis();
+        if (lastLogMountMs != 0 && nowMs - lastLogMountMs < LOG_WRITER_MOUNT_RETRY_MS) {
+            return false;
+        }
+        lastLogMountMs = nowMs;
+        if (mount() != SD_STATUS_OK) {
+            return false;
+        }
+        logFileBytes = LOG_FILE_UNKNOWN;
+    }
+    if (logFileBytes == LOG_FILE_UNKNOWN) {
+        File existing = SD.open(LOG_FILE_PATH, FILE_READ);
+        logFileBytes = existing ? static_cast<uint32_t>(existing.size()) : 0;
+        if (existing) {
+            existing.close();
+        }
+    }
+    // セクタの倍数でない（ほかで書き換えられた）か、上限を超えるなら作り直す
+    if (logFileBytes % LOG_SECTOR_BYTES != 0 || logFileBytes + length > LOG_FILE_MAX_BYTES) {
+        rotateLog();
+    }
+    File file = SD.open(LOG_FILE_PATH, FILE_APPEND);
+    if (!file) {
+        mounted.store(false);
+        SD.end();
+        logFileBytes = LOG_FILE_UNKNOWN;
+        return false;
+    }
+    size_t written = file.write(data, length);
+    file.close();
+    logFileBytes += static_cast<uint32_t>(written);
+    logBytes += static_cast<uint32_t>(written);
+    if (written != length) {
+        // 半端に書けたときは大きさがセクタの倍数でなくなるので、次回は作り直す
+        return false;
+    }
+    return true;
+}
+
+void SdService::rotateLog() {
+    if (SD.exists(LOG_FILE_OLD_PATH)) {
+        SD.remove(LOG_FILE_OLD_PATH);
+    }
+    if (SD.exists(LOG_FILE_PATH)) {
+        SD.rename(LOG_FILE_PATH, LOG_FILE_OLD_PATH);
+    }
+    logFileBytes = 0;
+    logRotations++;
+}
+
+bool SdService::postResult(uint16_t id, uint8_t op, uint8_t status, uint32_t value, uint32_t aux) {
+    if (!g_eventBus) {
+        lostResults++;
+        return false;
+    }
+    Event event = makeSdResultEvent(id, op, status, value, aux);
+    // 制御レーンは満杯時に新しいものを捨てるので、最終結果は空くまで少し待って送り直す
+    for (int attempt = 0; attempt < SD_SERVICE_RESULT_RETRIES; attempt++) {
+        if (g_eventBus->publish(event)) {
+            return true;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    lostResults++;
+    return false;
+}
@@ -0,0 +1,240 @@
+#ifndef SD_SERVICE_H
+#define SD_SERVICE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <Arduino.h>
+#include <SPI.h>
+#include <SD.h>
+#include "../core/BusArbiter.h"
+#include "../shared/SpscRing.h"
+
+struct MediaCatalogEntry;
+class LogWriter;
+
+// SDカードの配線（ESP32-2432S028RのmicroSDスロット、ホストはバス調停の設定に従う）
+#ifndef SD_CARD_SPI_HOST
+#define SD_CARD_SPI_HOST BUS_SD_HOST
+#endif
+
+#ifndef SD_CARD_CS_PIN
+#define SD_CARD_CS_PIN 5
+#endif
+
+#ifndef SD_CARD_SCLK_PIN
+#define SD_CARD_SCLK_PIN 18
+#endif
+
+#ifndef SD_CARD_MOSI_PIN
+#define SD_CARD_MOSI_PIN 23
+#endif
+
+#ifndef SD_CARD_MISO_PIN
+#define SD_CARD_MISO_PIN 19
+#endif
+
+#ifndef SD_CARD_FREQ_HZ
+#define SD_CARD_FREQ_HZ 20000000
+#endif
+
+// SD.begin()の既定のマウント先（目録はstdio/direntでこの下を読む）
+#ifndef SD_CARD_MOUNT_POINT
+#define SD_CARD_MOUNT_POINT "/sd"
+#endif
+
+// 受け付けておける要求の数（満杯なら要求は0を返す）
+#ifndef SD_SERVICE_QUEUE_LENGTH
+#define SD_SERVICE_QUEUE_LENGTH 4
+#endif
+
+// サービスタスクの設定（タッチタスクより低い優先度でCore 1に置く）
+#ifndef SD_SERVICE_STACK_SIZE
+#define SD_SERVICE_STACK_SIZE 6144
+#endif
+
+#ifndef SD_SERVICE_PRIORITY
+#define SD_SERVICE_PRIORITY 1
+#endif
+
+#ifndef SD_SERVICE_CORE
+#define SD_SERVICE_CORE 1
+#endif
+
+// スキャンの途中経過を送る最短間隔（制御レーンを埋めないよう間引く）
+#ifndef SD_SERVICE_PROGRESS_INTERVAL_MS
+#define SD_SERVICE_PROGRESS_INTERVAL_MS 100
+#endif
+
+// パスの最大長（終端を含む）。"/sound/"に目録の名前（MEDIA_CATALOG_PAGE_NAME_BYTES）が収まる長さ
+#ifndef SD_SERVICE_PATH_MAX
+#define SD_SERVICE_PATH_MAX 72
+#endif
+
+// ストリームの先読みで一度に読む大きさ（1回のバス占有の上限）
+#ifndef SD_SERVICE_STREAM_CHUNK
+#define SD_SERVICE_STREAM_CHUNK 1024
+#endif
+
+// ストリーム中に要求キューを待つ間隔（この周期でリングを補充する）
+#ifndef SD_SERVICE_STREAM_POLL_MS
+#define SD_SERVICE_STREAM_POLL_MS 5
+#endif
+
+// ログを書き出す間隔（この周期でサービスタスクが起きる）
+#ifndef LOG_WRITER_INTERVAL_MS
+#define LOG_WRITER_INTERVAL_MS 250
+#endif
+
+// カードがないとき、ログのためにマウントを試し直す間隔
+#ifndef LOG_WRITER_MOUNT_RETRY_MS
+#define LOG_WRITER_MOUNT_RETRY_MS 10000
+#endif
+
+// 要求の種類（SdResultEvent::op）
+enum SdOp : uint8_t {
+    SD_OP_MOUNT = 0,
+    SD_OP_SCAN,             // value: 拡張子が一致したファイル数, aux: 一覧のエントリ数
+    SD_OP_READ,             // value: 読んだバイト数
+    SD_OP_WRITE,            // value: 書いたバイト数
+    SD_OP_STREAM,           // value: ファイルの大きさ（開けた時点で結果が届く）
+    SD_OP_PAGE              // value: 読んだ件数, aux: 目録の全件数
+};
+
+// 要求の結果（SdResultEvent::status）
+enum SdStatus : uint8_t {
+    SD_STATUS_OK = 0,
+    SD_STATUS_PROGRESS,     // 途中経過（このあと最終結果が届く）
+    SD_STATUS_NO_CARD,      // マウントできない
+    SD_STATUS_NOT_FOUND,    // パスがない・ディレクトリでない
+    SD_STATUS_IO_ERROR,
+    SD_STATUS_CANCELLED
+};
+
+// SDカードのサービス
+// カードはこのタスクだけが触り、他のタスクは要求をキューに入れるだけにする。
+// 各要求の実行中はバス調停からSDのバスを取得し、長いスキャンは区切りごとに譲る。
+// 結果はEVENT_SD_RESULTとしてイベントバスに流れ、要求時に返したIDで照合する。
+// 読み書きのバッファは結果が届くまで呼び出し側が保持すること。
+// ストリームは1本だけで、要求の合間にリングの空きを埋め続け、終端でリングを閉じる。
+// ログも要求の合間に書き出す（セクタの倍数のブロックを追記し、大きくなったら1世代残して作り直す）。
+class SdService {
+private:
+    struct Request {
+        uint8_t op;             // SdOp
+        bool append;
+        uint16_t id;
+        char path[SD_SERVICE_PATH_MAX];
+        char extension[8];
+        uint8_t* buffer;        // 読み込み先
+        const uint8_t* data;    // 書き込み元
+        uint32_t length;
+        uint32_t offset;
+        SpscRing<uint8_t>* ring;  // ストリームの書き込み先
+        MediaCatalogEntry* entries; // 目録のページの書き込み先
+    };
+
+    SPIClass spi;
+    QueueHandle_t queue;
+    TaskHandle_t taskHandle;
+    bool busConfigured;
+    std::atomic<bool> mounted;
+    std::atomic<uint16_t> nextId;
+    std::atomic<uint16_t> cancelledId;
+
+    std::atomic<uint32_t> completedCount;
+    std::atomic<uint32_t> failedCount;
+    std::atomic<uint32_t> rejectedCount;
+    std::atomic<uint32_t> lostResults;
+    std::atomic<uint32_t> catalogHits;      // 目録の先頭だけで済んだスキャン
+    std::atomic<uint32_t> catalogRebuilds;  // 目録を調べ直したスキャン
+    std::atomic<uint32_t> taggedFiles;      // 目録の更新でタグを読んだファイル
+    uint32_t lastScanMs;
+
+    // ストリーム（ファイルとリングはサービスタスクだけが触る。切り離しはstreamLockで同期し、
+    // streamLockを持ったままSDのバスは待たない）
+    SemaphoreHandle_t streamLock;
+    SpscRing<uint8_t>* streamRing;
+    std::atomic<uint16_t> streamDetachedId;  // このID以前のストリーム要求は開かない
+    File streamFile;
+    uint8_t streamChunk[SD_SERVICE_STREAM_CHUNK];
+    std::atomic<uint32_t> streamBytes;
+    std::atomic<uint32_t> streamStalls;     // リングが満杯で補充を見送った回数
+
+    // ログ（書き出し側はサービスタスクだけが触る）
+    LogWriter* logWriter;
+    uint32_t lastLogFlushMs;
+    uint32_t lastLogMountMs;
+    uint32_t logFileBytes;                  // 追記先の大きさ（LOG_FILE_UNKNOWNなら開いて調べる）
+    std::atomic<uint32_t> logBytes;
+    std::atomic<uint32_t> logRotations;
+
+    uint16_t enqueue(Request& request);
+    static void serviceTask(void* parameter);
+    void runServiceTask();
+
+    void process(const Request& request);
+    uint8_t mount();
+    uint8_t scan(const Request& request, uint32_t& matched, uint32_t& examined);
+    uint8_t read(const Request& request, uint32_t& bytes);
+    uint8_t write(const Request& request, uint32_t& bytes);
+    uint8_t readPage(const Request& request, uint32_t& written, uint32_t& total);
+    uint8_t openStream(const Request& request, uint32_t& size);
+    bool resolveStreamPath(const char* path, char* out, size_t capacity);
+    void refillStream();
+    void closeStream();
+    void flushLog();
+    bool appendLog(const uint8_t* data, size_t length);
+    void rotateLog();
+    bool postResult(uint16_t id, uint8_t op, uint8_t status, uint32_t value, uint32_t aux);
+
+public:
+    SdService();
+
+    // SPIバスの設定（LCDの初期化より前に一度呼ぶ）
+    void init();
+    // 要求キューとサービスタスクを作成
+    bool start();
+    // ログの書き出し先（start()の前に一度だけ）。Serialへの出力もこのタスクから行う
+    void attachLog(LogWriter* writer) { logWriter = writer; }
+
+    // 各要求はIDを返す（キューが満杯・引数が不正なら0）
+    uint16_t requestMount();
+    // dirの直下でextensionに一致するファイルを数える（未マウントならマウントから行う）
+    // 結果は隣の目録ファイル（"/sound"なら"/sound.idx"）に保存し、次回は照合だけで返す
+    uint16_t requestScan(const char* dir, const char* extension);
+    uint16_t requestRead(const char* path, uint32_t offset, uint8_t* buffer, uint32_t length);
+    uint16_t requestWrite(const char* path, const uint8_t* data, uint32_t length, bool append);
+    // dirの目録（requestScanが保存したもの）から名前順のfirst番目以降をcount件読む
+    // 目録を全部は読み込まないので、件数が多くても1回の読み出しはcount件分で済む
+    uint16_t requestPage(const char* dir, uint32_t first, MediaCatalogEntry* entries, uint32_t count);
+    // pathのファイルを先読みしてringに流す（ディレクトリなら目録の先頭のファイル）
+    // 開けなければringを閉じる。前のストリームは置き換える
+    uint16_t requestStream(const char* path, SpscRing<uint8_t>* ring);
+    // ストリームを止め、以後リングに書かないことを保証して戻る（どのタスクからでもよい）
+    void detachStream();
+    // 実行中のスキャンを打ち切る（結果はSD_STATUS_CANCELLEDで届く）
+    void cancel(uint16_t requestId) { cancelledId.store(requestId); }
+
+    bool isMounted() const { return mounted.load(); }
+
+    // 統計
+    size_t getQueuedCount() const;
+    uint32_t getCompletedCount() const { return completedCount.load(); }
+    uint32_t getFailedCount() const { return failedCount.load(); }
+    uint32_t getRejectedCount() const { return rejectedCount.load(); }
+    uint32_t getLostResults() const { return lostResults.load(); }
+    uint32_t getCatalogHits() const { return catalogHits.load(); }
+    uint32_t getCatalogRebuilds() const { return catalogRebuilds.load(); }
+    uint32_t getTaggedFiles() const { return taggedFiles.load(); }
+    uint32_t getLastScanMs() const { return lastScanMs; }
+    uint32_t getStreamBytes() const { return streamBytes.load(); }
+    uint32_t getStreamStalls() const { return streamStalls.load(); }
+    uint32_t getLogBytes() const { return logBytes.load(); }
+    uint32_t getLogRotations() const { return logRotations.load(); }
+};
+
+// グローバルSDサービス
+extern SdService* g_sdService;
+
+#endif // SD_SERVICE_H
@@ -2,59 +2,46 @@
 #include <LovyanGFX.hpp>
 #include "ConfirmDialog.h"
 #include <Arduino.h>
+#include "../layout/LayoutTable.h"
 
-ConfirmDialog::ConfirmDialog(LGFX* display, const String& title, const String& message) 
-    : tft(display), title(title), message(message) {
-    
-    // ダイアログのサイズと位置を計算（画面中央）
-    width = 240;
-    height = 140;
-    x = (tft->width() - width) / 2;
-    y = (tft->height() - height) / 2;
-    
+namespace {
+// ダイアログの大きさ（画面中央に置く）
+const int16_t DIALOG_WIDTH = 240;
+const int16_t DIALOG_HEIGHT = 140;
+
+constexpr ButtonStyleDef STYLE_YES = {
+    rgb565(76, 175, 80), rgb565(56, 142, 60), 8, 0, 0, 0xFFFF        // Material Green（影なし）
+};
+
+constexpr ButtonStyleDef STYLE_NO = {
+    rgb565(158, 158, 158), rgb565(97, 97, 97), 8, 0, 0, 0xFFFF       // Material Grey（影なし）
+};
+
+const uint16_t DIALOG_BORDER_COLOR = rgb565(200, 200, 200);
+const uint16_t DIALOG_TITLE_COLOR = rgb565(33, 150, 243);
+} // namespace
+
+ConfirmDialog::ConfirmDialog(LGFX* display, const char* title, const char* message) 
+    : tft(display), title(title), message(message),
+      x((display->width() - DIALOG_WIDTH) / 2), y((display->height() - DIALOG_HEIGHT) / 2),
+      width(DIALOG_WIDTH), height(DIALOG_HEIGHT),
+      yesButton(display, x + 20, y + height - 50, 90, 35, "はい"),
+      noButton(display, x + width - 110, y + height - 50, 90, 35, "いいえ") {
     createButtons();
 }
 
 void ConfirmDialog::createButtons() {
     // はいボタン（左側）
-    yesButton.reset(new ModernButton(
-        tft, 
-        x + 20,                    // 左側
-        y + height - 50,           // 下部
-        90,                        // 幅
-        35,                        // 高さ
-        "はい"
-    ));
-    
-    ButtonStyle yesStyle;
-    yesStyle.normalColor = tft->color565(76, 175, 80);     // Material Green
-    yesStyle.pressedColor = tft->color565(56, 142, 60);    // Darker Green
-    yesStyle.cornerRadius = 8;
-    yesStyle.shadowOffset = 0;  // 影を無くす
-    yesButton->setStyle(yesStyle);
-    yesButton->setOnClick([this]() {
+    yesButton.setStyle(toButtonStyle(STYLE_YES));
+    yesButton.setOnClick([this]() {
         if (onYesCallback) {
             onYesCallback();
         }
     });
     
     // いいえボタン（右側）
-    noButton.reset(new ModernButton(
-        tft, 
-        x + width - 110,           // 右側
-        y + height - 50,           // 下部
-        90,                        // 幅
-        35,                        // 高さ
-        "いいえ"
-    ));
-    
-    ButtonStyle noStyle;
-    noStyle.normalColor = tft->color565(158, 158, 158);    // Material Grey
-    noStyle.pressedColor = tft->color565(97, 97, 97);      // Darker Grey
-    noStyle.cornerRadius = 8;
-    noStyle.shadowOffset = 0;  // 影を無くす
-    noButton->setStyle(noStyle);
-    noButton->setOnClick([this]() {
+    noButton.setStyle(toButtonStyle(STYLE_NO));
+    noButton.setOnClick([this]() {
         if (onNoCallback) {
             onNoCallback();
         }
@@ -81,36 +68,36 @@ void ConfirmDialog::drawDialog() {
     tft->fillRoundRect(x, y, width, height, 12, TFT_WHITE);
     
     // 枠線
-    tft->drawRoundRect(x, y, width, height, 12, tft->color565(200, 200, 200));
+    tft->drawRoundRect(x, y, width, height, 12, DIALOG_BORDER_COLOR);
     
     // タイトル背景
-    tft->fillRoundRect(x, y, width, 40, 12, tft->color565(33, 150, 243));
-    tft->fillRect(x, y + 20, width, 20, tft->color565(33, 150, 243));
+    tft->fillRoundRect(x, y, width, 40, 12, DIALOG_TITLE_COLOR);
+    tft->fillRect(x, y + 20, width, 20, DIALOG_TITLE_COLOR);
     
     // タイトルテキスト
     tft->setTextColor(TFT_WHITE);
     tft->setFont(&fonts::lgfxJapanGothic_16);
     
     // タイトルを中央揃え
-    int32_t titleWidth = tft->textWidth(title);
+    int32_t titleWidth = tft->textWidth(title.c_str());
     tft->setCursor(x + (width - titleWidth) / 2, y + 12);
-    tft->print(title);
+    tft->print(title.c_str());
     
     // メッセージ
     tft->setTextColor(TFT_BLACK);
     tft->setFont(&fonts::lgfxJapanGothic_12);
     
     // メッセージを中央揃え
-    int32_t messageWidth = tft->textWidth(message);
+    int32_t messageWidth = tft->textWidth(message.c_str());
     tft->setCursor(x + (width - messageWidth) / 2, y + 60);
-    tft->print(message);
+    tft->print(message.c_str());
     
     // デフォルトフォントに戻す
     tft->setFont(nullptr);
     
     // ボタンを描画
-    yesButton->draw();
-    noButton->draw();
+    yesButton.draw();
+    noButton.draw();
 }
 
 bool ConfirmDialog::handleTouch(int32_t touchX, int32_t touchY, bool pressed) {
@@ -122,9 +109,9 @@ bool ConfirmDialog::handleTouch(int32_t touchX, int32_t touchY, bool pressed) {
     // ボタンのタッチ処理
     bool handled = false;
     
-    if (yesButton->handleTouch(touchX, touchY, pressed)) {
+    if (yesButton.handleTouch(touchX, touchY, pressed)) {
         handled = true;
-    } else if (noButton->handleTouch(touchX, touchY, pressed)) {
+    } else if (noButton.handleTouch(touchX, touchY, pressed)) {
         handled = true;
     }
     
@@ -3,36 +3,34 @@
 
 #include <LovyanGFX.hpp>
 #include "ModernButton.h"
-#include <memory>
-#include <functional>
 
 class ConfirmDialog {
 private:
     LGFX* tft;
-    String title;
-    String message;
+    FixedString<64> title;
+    FixedString<64> message;
     
     // ダイアログの位置とサイズ
     int16_t x, y, width, height;
     
-    // ボタン
-    std::unique_ptr<ModernButton> yesButton;
-    std::unique_ptr<ModernButton> noButton;
+    // ボタン（ダイアログと一緒に置く）
+    ModernButton yesButton;
+    ModernButton noButton;
     
     // コールバック
-    std::function<void()> onYesCallback;
-    std::function<void()> onNoCallback;
+    ButtonCallback onYesCallback;
+    ButtonCallback onNoCallback;
     
     // 背景を暗くするための設定
     static constexpr uint16_t OVERLAY_COLOR = 0x0000;  // 半透明の黒
     static constexpr uint8_t OVERLAY_ALPHA = 128;      // 透明度
     
 public:
-    ConfirmDialog(LGFX* display, const String& title, const String& message);
+    ConfirmDialog(LGFX* display, const char* title, const char* message);
     
     // コールバック設定
-    void setOnYes(std::function<void()> callback) { onYesCallback = callback; }
-    void setOnNo(std::function<void()> callback) { onNoCallback = callback; }
+    void setOnYes(const ButtonCallback& callback) { onYesCallback = callback; }
+    void setOnNo(const ButtonCallback& callback) { onNoCallback = callback; }
     
     // 表示
     void show();
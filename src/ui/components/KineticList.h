@@ -0,0 +1,218 @@
+#ifndef KINETIC_LIST_H
+#define KINETIC_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include "VirtualList.h"
+#include "KineticScroller.h"
+#include "ScrollSurface.h"
+#include "../../shared/Events.h"
+
+// これ以上動いたらタップではなくスクロール（px）
+#ifndef KINETIC_LIST_TAP_SLOP
+#define KINETIC_LIST_TAP_SLOP 8
+#endif
+
+// 離したときの速度を求める範囲（直近の移動の時間、µs）。これより長く止めてから離したらフリックしない
+#ifndef KINETIC_VELOCITY_WINDOW_US
+#define KINETIC_VELOCITY_WINDOW_US 80000
+#endif
+
+// スクロールバーの幅（リストの右端）
+#ifndef KINETIC_LIST_SCROLLBAR_WIDTH
+#define KINETIC_LIST_SCROLLBAR_WIDTH 4
+#endif
+
+// 慣性スクロールする固定高さのリスト
+// 行の割り当てはVirtualList（表示中の行だけを持つ）、動きはKineticScroller（ドラッグとフリック）、
+// 描画はScrollSurface（リング状の描画面に新しく見えた帯だけを描いて送る）に任せる。
+// 1フレームの仕事は、bindが新しく見えた行、描画が動いた分の帯、転送がビューポート1枚で、
+// どれも項目数に依らない。行の中身の作り方と描き方はVirtualListと同じく呼び出し側が決め、
+// 描くときはcanvas()とcanvasLeft()を使う（描画面か、確保できなければ画面）。
+//
+// 使い方: タッチはtouchDown/Move/Upに渡し（離したときの速度はタッチの移動履歴から）、
+// 毎フレームupdate()で位置を進めてdraw()で描く。
+template <typename Row, size_t Slots>
+class KineticList {
+public:
+    typedef VirtualList<Row, Slots> List;
+
+    static const uint32_t NO_ITEM = List::NO_ITEM;
+
+private:
+    List list;
+    KineticScroller scroller;
+    ScrollSurface surface;
+    int16_t left;
+    uint16_t width;
+    uint16_t scrollbarColor;
+
+    bool dragging;
+    bool dragMoved;
+    bool stoppedFling;          // 触れたときに流れていた（止めるだけでタップにしない）
+    int16_t dragStartY;
+    int16_t dragLastY;
+    uint32_t lastMoveUs;
+    uint32_t lastUpdateMs;
+    bool scrollbarDirty;
+
+    int32_t itemTop(uint32_t item) const { return static_cast<int32_t>(item) * list.getRowHeight(); }
+
+public:
+    KineticList(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t rowHeight)
+        : list(y, h, rowHeight), surface(x, y, w - KINETIC_LIST_SCROLLBAR_WIDTH, h), left(x), width(w),
+          scrollbarColor(0x7BEF), dragging(false), dragMoved(false), stoppedFling(false), dragStartY(0),
+          dragLastY(0), lastMoveUs(0), lastUpdateMs(0), scrollbarDirty(true) {
+    }
+
+    // 行の割り当て（setBinder/setRenderer、項目の位置など）
+    List& items() { return list; }
+    const List& items() const { return list; }
+
+    // 描画面を確保する（画面に入るとき）。確保できなくても直接描いて動く
+    bool begin(LGFX* display) {
+        lastUpdateMs = 0;
+        scrollbarDirty = true;
+        return surface.begin(display);
+    }
+    // 描画面を返す（画面を出るとき）
+    void end() {
+        scroller.stop();
+        dragging = false;
+        surface.end();
+    }
+
+    void setColors(uint16_t background, uint16_t scrollbar) {
+        surface.setBackground(background);
+        scrollbarColor = scrollbar;
+    }
+
+    // 項目数を変える（位置は範囲内に収め、全体を描き直す）
+    void setItemCount(uint32_t count) {
+        list.setItemCount(count);
+        scroller.setRange(list.getMaxScroll());
+        scroller.setPosition(list.getScrollY());
+        surface.invalidateAll();
+        scrollbarDirty = true;
+    }
+
+    // 末尾に項目を足す（増えた分だけ描き直す）
+    // 末尾を見ていて動かしていなければ、足した分だけ送って末尾を見せ続ける
+    void append(uint32_t count) {
+        if (count == 0) {
+            return;
+        }
+        bool followEnd = !dragging && !scroller.isFlinging() && list.getScrollY() >= list.getMaxScroll();
+        int32_t oldBottom = itemTop(list.getItemCount());
+        list.append(count);
+        scroller.setRange(list.getMaxScroll());
+        if (followEnd) {
+            scroller.setPosition(list.getMaxScroll());
+        }
+        surface.invalidate(oldBottom, itemTop(list.getItemCount()));
+        scrollbarDirty = true;
+    }
+
+    // first〜first+count-1の項目を作り直して描き直させる（表示範囲外は何もしない）
+    void invalidate(uint32_t first, uint32_t count) {
+        list.invalidate(first, count);
+        surface.invalidate(itemTop(first), itemTop(first) + static_cast<int32_t>(count) * list.getRowHeight());
+    }
+    // 行の中身は変えずに描き直させる（選択の表示など）
+    void redrawItem(uint32_t item) {
+        if (item != NO_ITEM) {
+            surface.invalidate(itemTop(item), itemTop(item) + list.getRowHeight());
+        }
+    }
+    // 全体を描き直させる（画面全体を描き直したとき）
+    void redrawAll() {
+        surface.invalidateAll();
+        scrollbarDirty = true;
+    }
+
+    // タッチ。リストの中で押されたらtrue
+    bool touchDown(const TouchEvent& touch) {
+        dragging = list.contains(touch.y) && touch.x >= left && touch.x < left + static_cast<int16_t>(width);
+        if (!dragging) {
+            return false;
+        }
+        stoppedFling = scroller.isFlinging();
+        scroller.grab();
+        dragMoved = false;
+        dragStartY = touch.y;
+        dragLastY = touch.y;
+        lastMoveUs = touch.timestampUs;
+        return true;
+    }
+
+    void touchMove(const TouchEvent& touch) {
+        if (!dragging) {
+            return;
+        }
+        int16_t fromStart = touch.y - dragStartY;
+        dragMoved = dragMoved || fromStart > KINETIC_LIST_TAP_SLOP || fromStart < -KINETIC_LIST_TAP_SLOP;
+        // 指の動きに合わせて内容を動かす（上へなぞると下の行が出る）
+        if (dragMoved) {
+            scroller.dragBy(dragLastY - touch.y);
+        }
+        dragLastY = touch.y;
+        lastMoveUs = touch.timestampUs;
+    }
+
+    // 離したとき。velocityYは指の速度（px/秒、下向きが正）
+    // タップならその項目を返す（流れているのを止めただけのときと、行のない所はNO_ITEM）
+    uint32_t touchUp(const TouchEvent& touch, float velocityY, bool hasVelocity) {
+        if (!dragging) {
+            return NO_ITEM;
+        }
+        dragging = false;
+        if (!dragMoved) {
+            return stoppedFling ? NO_ITEM : list.itemAt(touch.y);
+        }
+        // 指を止めてから離したときは、止める前の速度を使わない
+        if (hasVelocity && touch.timestampUs - lastMoveUs <= KINETIC_VELOCITY_WINDOW_US) {
+            scroller.fling(-velocityY);
+        }
+        return NO_ITEM;
+    }
+
+    // 位置を進めて表示中の行を割り当てる。動いたらtrue
+    bool update(uint32_t nowMs) {
+        uint32_t dt = lastUpdateMs != 0 ? nowMs - lastUpdateMs : 0;
+        lastUpdateMs = nowMs;
+        scroller.step(dt);
+        bool moved = list.scrollTo(scroller.getPosition());
+        list.layout();
+        surface.scrollTo(list.getScrollY());
+        scrollbarDirty = scrollbarDirty || moved;
+        return moved;
+    }
+
+    // 描き直し待ちの帯を描いて送る。送ったらtrue
+    bool draw() {
+        List* rows = &list;
+        bool pushed = surface.flush([rows](int32_t from, int32_t to, int32_t origin) {
+            rows->drawBand(from, to, origin);
+        });
+        if (scrollbarDirty) {
+            surface.drawScrollbar(static_cast<int16_t>(left + width - KINETIC_LIST_SCROLLBAR_WIDTH),
+                                  KINETIC_LIST_SCROLLBAR_WIDTH, list.getScrollY(), list.getMaxScroll(),
+                                  scrollbarColor);
+            scrollbarDirty = false;
+        }
+        return pushed;
+    }
+
+    lgfx::v1::LovyanGFX* canvas() const { return surface.canvas(); }
+    int16_t canvasLeft() const { return surface.canvasLeft(); }
+
+    bool isDragging() const { return dragging; }
+    bool isMoving() const { return dragging || scroller.isFlinging(); }
+    const KineticScroller& getScroller() const { return scroller; }
+    const ScrollSurface& getSurface() const { return surface; }
+};
+
+template <typename Row, size_t Slots>
+const uint32_t KineticList<Row, Slots>::NO_ITEM;
+
+#endif // KINETIC_LIST_H
@@ -0,0 +1,77 @@
+#include "KineticScroller.h"
+#include <cmath>
+
+KineticScroller::KineticScroller()
+    : position(0.0f), velocity(0.0f), maxPosition(0), flinging(false), flingCount(0) {
+}
+
+void KineticScroller::clamp() {
+    if (position < 0.0f) {
+        position = 0.0f;
+    } else if (position > static_cast<float>(maxPosition)) {
+        position = static_cast<float>(maxPosition);
+    }
+}
+
+void KineticScroller::setRange(int32_t maxScroll) {
+    maxPosition = maxScroll > 0 ? maxScroll : 0;
+    clamp();
+}
+
+void KineticScroller::setPosition(int32_t y) {
+    position = static_cast<float>(y);
+    clamp();
+}
+
+void KineticScroller::grab() {
+    stop();
+}
+
+void KineticScroller::stop() {
+    velocity = 0.0f;
+    flinging = false;
+}
+
+bool KineticScroller::dragBy(int32_t dy) {
+    int32_t before = getPosition();
+    position += static_cast<float>(dy);
+    clamp();
+    return getPosition() != before;
+}
+
+bool KineticScroller::fling(float velocityPxPerSec) {
+    if (std::fabs(velocityPxPerSec) < KINETIC_MIN_FLING_VELOCITY) {
+        stop();
+        return false;
+    }
+    if (velocityPxPerSec > KINETIC_MAX_VELOCITY) {
+        velocityPxPerSec = KINETIC_MAX_VELOCITY;
+    } else if (velocityPxPerSec < -KINETIC_MAX_VELOCITY) {
+        velocityPxPerSec = -KINETIC_MAX_VELOCITY;
+    }
+    velocity = velocityPxPerSec;
+    flinging = true;
+    flingCount++;
+    return true;
+}
+
+bool KineticScroller::step(uint32_t dtMs) {
+    if (!flinging || dtMs == 0) {
+        return false;
+    }
+    if (dtMs > KINETIC_MAX_STEP_MS) {
+        dtMs = KINETIC_MAX_STEP_MS;
+    }
+    // v(t) = v0·e^(-t/τ) を積分した分だけ進める（フレーム間隔が揺れても同じ軌跡になる）
+    const float tau = KINETIC_TIME_CONSTANT_MS / 1000.0f;
+    float decay = std::exp(-static_cast<float>(dtMs) / KINETIC_TIME_CONSTANT_MS);
+    int32_t before = getPosition();
+    position += velocity * tau * (1.0f - decay);
+    velocity *= decay;
+    if (position <= 0.0f || position >= static_cast<float>(maxPosition) ||
+        std::fabs(velocity) < KINETIC_STOP_VELOCITY) {
+        clamp();
+        stop();
+    }
+    return getPosition() != before;
+}
@@ -0,0 +1,70 @@
+#ifndef KINETIC_SCROLLER_H
+#define KINETIC_SCROLLER_H
+
+#include <cstdint>
+
+// フリックの減速の時定数（ms、速度がおよそ1/eに落ちるまで。移動距離は速度×時定数）
+#ifndef KINETIC_TIME_CONSTANT_MS
+#define KINETIC_TIME_CONSTANT_MS 325
+#endif
+
+// 指を離したときこれより遅ければフリックにしない（px/秒）
+#ifndef KINETIC_MIN_FLING_VELOCITY
+#define KINETIC_MIN_FLING_VELOCITY 120
+#endif
+
+// これより遅くなったら止める（px/秒）
+#ifndef KINETIC_STOP_VELOCITY
+#define KINETIC_STOP_VELOCITY 15
+#endif
+
+// 速度の上限（px/秒、タッチの跳びで飛んでいかないように）
+#ifndef KINETIC_MAX_VELOCITY
+#define KINETIC_MAX_VELOCITY 4000
+#endif
+
+// 1回のstep()で進める時間の上限（ms、フレームが詰まっても一度に大きく跳ばない）
+#ifndef KINETIC_MAX_STEP_MS
+#define KINETIC_MAX_STEP_MS 50
+#endif
+
+// 慣性スクロールの位置計算
+// 指で動かしている間はその分だけ動き、離したときの速度（タッチの移動履歴から求めたもの）で
+// フリックを始める。速度は指数関数的に減り、端に当たったらそこで止まる（跳ね返りはしない）。
+// 位置は0〜最大値のpx。描画には関わらないので、リストの実装に依らずホストで確かめられる。
+class KineticScroller {
+private:
+    float position;
+    float velocity;         // px/秒（正なら内容が上へ流れる = 位置が増える）
+    int32_t maxPosition;
+    bool flinging;
+
+    uint32_t flingCount;
+
+    void clamp();
+
+public:
+    KineticScroller();
+
+    // スクロールできる範囲（0〜maxScroll）。位置は範囲内に収める
+    void setRange(int32_t maxScroll);
+    void setPosition(int32_t y);
+
+    // 指が触れたらフリックを止める
+    void grab();
+    // 指の移動分だけ動かす。動いたらtrue
+    bool dragBy(int32_t dy);
+    // 指を離したときの速度でフリックを始める。始めたらtrue
+    bool fling(float velocityPxPerSec);
+    // dtMsだけ進める。位置（整数px）が変わったらtrue
+    bool step(uint32_t dtMs);
+    void stop();
+
+    int32_t getPosition() const { return static_cast<int32_t>(position + 0.5f); }
+    float getVelocity() const { return velocity; }
+    int32_t getMaxPosition() const { return maxPosition; }
+    bool isFlinging() const { return flinging; }
+    uint32_t getFlingCount() const { return flingCount; }
+};
+
+#endif // KINETIC_SCROLLER_H
@@ -4,7 +4,7 @@
 #include <Arduino.h>
 
 
-Label::Label(LGFX* display, int16_t x, int16_t y, uint16_t w, uint16_t h, const std::string& text)
+Label::Label(LGFX* display, int16_t x, int16_t y, uint16_t w, uint16_t h, const char* text)
     : tft(display), text(text), x(x), y(y), width(w), height(h),
       textColor(TFT_WHITE), backgroundColor(TFT_BLACK), hasBackground(false),
       alignment(CENTER), useJapaneseFont(false), fontSize(16), visible(true) {
@@ -61,7 +61,12 @@ void Label::draw() {
     }
 }
 
-void Label::setText(const std::string& newText) {
+void Label::setText(const char* newText) {
+    setText(LabelText(newText));
+}
+
+void Label::setText(const LabelText& newText) {
+    // キャッシュ済みハッシュで比較
     if (text != newText) {
         text = newText;
         // 文字の長さに合わせて幅を再調整
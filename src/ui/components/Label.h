@@ -3,7 +3,7 @@
 
 #define LGFX_USE_V1
 #include <LovyanGFX.hpp>
-#include <string>
+#include "../../shared/FixedString.h"
 
 // 前方宣言
 namespace lgfx {
@@ -13,6 +13,9 @@ namespace lgfx {
 }
 using LGFX = lgfx::v1::LGFX_Device;
 
+// ラベルのテキスト（インライン固定長）
+typedef FixedString<64> LabelText;
+
 class Label {
 public:
     enum Alignment {
@@ -23,7 +26,7 @@ public:
 
 private:
     LGFX* tft;
-    std::string text;
+    LabelText text;
     int16_t x, y;
     uint16_t width, height;
     uint16_t textColor;
@@ -36,13 +39,14 @@ private:
 
 public:
     // コンストラクタ
-    Label(LGFX* display, int16_t x, int16_t y, uint16_t w, uint16_t h, const std::string& text);
+    Label(LGFX* display, int16_t x, int16_t y, uint16_t w, uint16_t h, const char* text);
     
     // 描画
     void draw();
     
     // プロパティ設定
-    void setText(const std::string& newText);
+    void setText(const char* newText);
+    void setText(const LabelText& newText);
     void setTextColor(uint16_t color) { textColor = color; }
     void setBackgroundColor(uint16_t color) { backgroundColor = color; hasBackground = true; }
     void clearBackground() { hasBackground = false; }
@@ -54,7 +58,7 @@ public:
     
     // 状態取得
     bool isVisible() const { return visible; }
-    const std::string& getText() const { return text; }
+    const LabelText& getText() const { return text; }
     
     // 中央配置用のヘルパー
     void centerInScreen(LGFX* display);
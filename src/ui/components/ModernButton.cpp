@@ -2,11 +2,31 @@
 #include <LovyanGFX.hpp>
 #include "ModernButton.h"
 #include <Arduino.h>
+#include "../../audio/SfxMixer.h"
 
-ModernButton::ModernButton(LGFX* display, int16_t x, int16_t y, uint16_t w, uint16_t h, const std::string& text)
+ModernButton::ModernButton(LGFX* display, int16_t x, int16_t y, uint16_t w, uint16_t h, const char* text)
     : tft(display), x(x), y(y), width(w), height(h), 
       state(BUTTON_NORMAL), text(text), style(), 
-      enabled(true), visible(true), needsRedraw(true) {
+      enabled(true), visible(true), touchActive(false), downInside(false), needsRedraw(true),
+      metricsHash(0), metricsFontKey(0), metricsValid(false),
+      cachedTextWidth(0), cachedTextHeight(0) {
+}
+
+void ModernButton::reset(int16_t newX, int16_t newY, uint16_t w, uint16_t h, const char* newText) {
+    // 画面全体を描き直す前提なので、古い位置のクリアは行わない
+    x = newX;
+    y = newY;
+    width = w;
+    height = h;
+    state = BUTTON_NORMAL;
+    style = ButtonStyle();
+    enabled = true;
+    visible = true;
+    touchActive = false;
+    downInside = false;
+    onClick.reset();
+    setText(newText);
+    needsRedraw = true;
 }
 
 void ModernButton::draw() {
@@ -104,13 +124,7 @@ void ModernButton::drawText() {
     }
     
     // 日本語フォントを設定（日本語が含まれている場合）
-    bool hasJapanese = false;
-    for (size_t i = 0; i < text.length(); i++) {
-        if ((unsigned char)text[i] >= 0x80) {
-            hasJapanese = true;
-            break;
-        }
-    }
+    bool hasJapanese = text.hasMultibyte();
     
     if (hasJapanese && style.useJapaneseFont) {
         // 日本語フォントを使用
@@ -163,21 +177,25 @@ void ModernButton::getTextBounds(int16_t& tx, int16_t& ty) {
     getTextBoundsForSize(tx, ty, width, height);
 }
 
-void ModernButton::getTextBoundsForSize(int16_t& tx, int16_t& ty, uint16_t buttonWidth, uint16_t buttonHeight) {
-    // 日本語フォントかどうかを判定
-    bool hasJapanese = false;
-    for (size_t i = 0; i < text.length(); i++) {
-        if ((unsigned char)text[i] >= 0x80) {
-            hasJapanese = true;
-            break;
-        }
+uint8_t ModernButton::fontKey() const {
+    // 使用するフォントを決める要素（日本語フォントかどうか + テキストサイズ）
+    bool japanese = text.hasMultibyte() && style.useJapaneseFont;
+    return static_cast<uint8_t>((japanese ? 0x80 : 0x00) | (style.fontSize & 0x7F));
+}
+
+void ModernButton::measureText(int16_t& textWidth, int16_t& textHeight) {
+    uint8_t key = fontKey();
+    if (metricsValid && metricsHash == text.hash() && metricsFontKey == key) {
+        textWidth = cachedTextWidth;
+        textHeight = cachedTextHeight;
+        return;
     }
     
     // 現在のフォント設定を保存
     const lgfx::v1::IFont* originalFont = tft->getFont();
     
     // 実際に使用するフォントを設定して正確な幅を測定
-    if (hasJapanese && style.useJapaneseFont) {
+    if (key & 0x80) {
         tft->setFont(&fonts::lgfxJapanGothic_12);
     } else {
         tft->setFont(nullptr);
@@ -185,12 +203,23 @@ void ModernButton::getTextBoundsForSize(int16_t& tx, int16_t& ty, uint16_t butto
     }
     
     // LovyanGFXのtextWidth()とfontHeight()を使用して正確なサイズを取得
-    int32_t textWidth = tft->textWidth(text.c_str());
-    int32_t textHeight = tft->fontHeight();
+    cachedTextWidth = static_cast<int16_t>(tft->textWidth(text.c_str()));
+    cachedTextHeight = static_cast<int16_t>(tft->fontHeight());
     
     // フォント設定を元に戻す
     tft->setFont(originalFont);
     
+    metricsHash = text.hash();
+    metricsFontKey = key;
+    metricsValid = true;
+    textWidth = cachedTextWidth;
+    textHeight = cachedTextHeight;
+}
+
+void ModernButton::getTextBoundsForSize(int16_t& tx, int16_t& ty, uint16_t buttonWidth, uint16_t buttonHeight) {
+    int16_t textWidth, textHeight;
+    measureText(textWidth, textHeight);
+    
     // 中央配置の計算（指定されたボタンサイズに対して）
     tx = (buttonWidth - textWidth) / 2;
     ty = (buttonHeight - textHeight) / 2;
@@ -201,14 +230,27 @@ void ModernButton::getTextBoundsForSize(int16_t& tx, int16_t& ty, uint16_t butto
 }
 
 bool ModernButton::handleTouch(int16_t touchX, int16_t touchY, bool touching) {
+    bool isInside = contains(touchX, touchY);
+    
+    // タッチの始まり（離した後の最初の呼び出し）がボタン内だったかを覚えておく。
+    // 外で押してから滑り込んだ指では押下にしない
+    bool touchDown = touching && !touchActive;
+    if (touchDown) {
+        downInside = isInside;
+    }
+    touchActive = touching;
+    
     if (!enabled || !visible) return false;
     
     bool wasPressed = (state == BUTTON_PRESSED);
-    bool isInside = contains(touchX, touchY);
     
-    if (touching && isInside) {
+    if (touching && isInside && downInside) {
         // タッチ中でボタン内
         if (state != BUTTON_PRESSED) {
+            // 押下音はボタン内に触れた瞬間だけ、描画より先に要求する（描画の間に出力タスクが拾える）
+            if (touchDown) {
+                g_sfxMixer.trigger(SFX_CLICK);
+            }
             state = BUTTON_PRESSED;
             needsRedraw = true;
             draw();
@@ -235,7 +277,12 @@ bool ModernButton::contains(int16_t px, int16_t py) const {
     return px >= x && px < (x + width) && py >= y && py < (y + height);
 }
 
-void ModernButton::setText(const std::string& newText) {
+void ModernButton::setText(const char* newText) {
+    setText(WidgetText(newText));
+}
+
+void ModernButton::setText(const WidgetText& newText) {
+    // キャッシュ済みハッシュで比較（同じ内容なら再描画しない）
     if (text != newText) {
         text = newText;
         needsRedraw = true;
@@ -1,8 +1,8 @@
 #ifndef MODERN_BUTTON_H
 #define MODERN_BUTTON_H
 
-#include <functional>
-#include <string>
+#include "../../shared/Delegate.h"
+#include "../../shared/FixedString.h"
 
 // 前方宣言
 namespace lgfx {
@@ -12,6 +12,12 @@ namespace lgfx {
 }
 using LGFX = lgfx::v1::LGFX_Device;
 
+// クリック時のコールバック（ヒープを使わない）
+typedef Delegate<void()> ButtonCallback;
+
+// ボタンのテキスト（インライン固定長）
+typedef FixedString<32> WidgetText;
+
 // ボタンの状態
 enum ButtonState {
     BUTTON_NORMAL = 0,
@@ -60,30 +66,43 @@ private:
     
     // 状態
     ButtonState state;
-    std::string text;
+    WidgetText text;
     ButtonStyle style;
     bool enabled;
     bool visible;
+    bool touchActive;       // 指が触れている間true
+    bool downInside;        // 今のタッチがボタン内で始まった
     
     // コールバック
-    std::function<void()> onClick;
+    ButtonCallback onClick;
     
     // 内部状態
     bool needsRedraw;
     
+    // 計測済みテキスト寸法（テキストのハッシュとフォント設定が同じなら再計測しない）
+    uint32_t metricsHash;
+    uint8_t metricsFontKey;
+    bool metricsValid;
+    int16_t cachedTextWidth;
+    int16_t cachedTextHeight;
+    
 public:
     // コンストラクタ
-    ModernButton(LGFX* display, int16_t x, int16_t y, uint16_t w, uint16_t h, const std::string& text);
+    ModernButton(LGFX* display, int16_t x, int16_t y, uint16_t w, uint16_t h, const char* text);
     
     // 描画
     void draw();
     void redraw() { needsRedraw = true; draw(); }
     
+    // プールから再利用する際に状態を初期化（同じテキストなら計測結果を保持）
+    void reset(int16_t newX, int16_t newY, uint16_t w, uint16_t h, const char* newText);
+    
     // タッチ処理
     bool handleTouch(int16_t touchX, int16_t touchY, bool touching);
     
     // プロパティ設定
-    void setText(const std::string& newText);
+    void setText(const char* newText);
+    void setText(const WidgetText& newText);
     void setStyle(const ButtonStyle& newStyle);
     void setEnabled(bool enable);
     void setVisible(bool show);
@@ -91,13 +110,14 @@ public:
     void setSize(uint16_t newWidth, uint16_t newHeight);
     
     // コールバック設定
-    void setOnClick(std::function<void()> callback) { onClick = callback; }
+    void setOnClick(const ButtonCallback& callback) { onClick = callback; }
     
     // 状態取得
     bool isPressed() const { return state == BUTTON_PRESSED; }
     bool isEnabled() const { return enabled; }
     bool isVisible() const { return visible; }
     bool contains(int16_t px, int16_t py) const;
+    const WidgetText& getText() const { return text; }
     
 private:
     // 内部描画関数
@@ -106,6 +126,10 @@ private:
     void drawShadow();
     uint16_t getCurrentColor() const;
     
+    // テキスト寸法の取得（キャッシュ付き）
+    uint8_t fontKey() const;
+    void measureText(int16_t& textWidth, int16_t& textHeight);
+    
     // 文字の中央配置計算
     void getTextBounds(int16_t& tx, int16_t& ty);
     void getTextBoundsForSize(int16_t& tx, int16_t& ty, uint16_t buttonWidth, uint16_t buttonHeight);
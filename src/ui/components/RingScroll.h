@@ -0,0 +1,130 @@
+#ifndef RING_SCROLL_H
+#define RING_SCROLL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// リング状の描画面の縦スクロール
+// ILI9341の縦スクロール（VSCRSADD: 表示を始めるメモリの行）と同じ考え方で、
+// 内容のy座標を高さで割った余りの行に描いておき、表示は「開始行」から折り返して送る。
+// スクロールしても描いてある行はそのまま使えるので、描き直すのは新しく見えた帯だけになる。
+// （パネルの縦スクロールは320ライン側にしか効かず、横向きでは左右に流れてしまうため、
+//   同じ仕組みをメモリ上の描画面で行う。位置と帯の計算だけを持ち、描画はしない）
+// 座標はすべて内容のy座標（先頭の行の上端が0）。
+class RingScroll {
+public:
+    // 内容座標の範囲 [top, bottom)
+    struct Band {
+        int32_t top;
+        int32_t bottom;
+
+        bool empty() const { return bottom <= top; }
+        int32_t height() const { return bottom - top; }
+    };
+
+    // 折り返しをまたがない区間。リングの行 = 内容のy - offset
+    struct Segment {
+        int32_t top;
+        int32_t bottom;
+        int32_t offset;
+    };
+
+private:
+    uint16_t height;
+    int32_t scrollY;
+    Band dirty;             // 描き直し待ち（表示範囲の中だけ）
+    bool valid;             // 描画面に今の表示範囲が描いてある
+
+    void addDirty(int32_t top, int32_t bottom) {
+        if (top < scrollY) top = scrollY;
+        if (bottom > scrollY + height) bottom = scrollY + height;
+        if (bottom <= top) {
+            return;
+        }
+        if (dirty.empty()) {
+            dirty.top = top;
+            dirty.bottom = bottom;
+        } else {
+            dirty.top = top < dirty.top ? top : dirty.top;
+            dirty.bottom = bottom > dirty.bottom ? bottom : dirty.bottom;
+        }
+    }
+
+public:
+    explicit RingScroll(uint16_t viewHeight) : height(viewHeight), scrollY(0), valid(false) {
+        dirty.top = dirty.bottom = 0;
+    }
+
+    // 表示位置を変える。新しく見えた帯を描き直し待ちにし、前の待ちは表示範囲に切り詰める
+    // 高さ以上動いたら全体を描き直す
+    void scrollTo(int32_t y) {
+        int32_t delta = y - scrollY;
+        int32_t before = scrollY;
+        scrollY = y;
+        Band pending = dirty;
+        dirty.top = dirty.bottom = 0;
+        if (!valid || delta >= height || -delta >= height) {
+            invalidateAll();
+            return;
+        }
+        addDirty(pending.top, pending.bottom);
+        if (delta > 0) {
+            addDirty(before + height, y + height);
+        } else if (delta < 0) {
+            addDirty(y, before);
+        }
+    }
+
+    // 内容が変わった範囲を描き直し待ちにする（表示範囲の外は無視）
+    void invalidate(int32_t top, int32_t bottom) { addDirty(top, bottom); }
+    void invalidateAll() {
+        valid = true;
+        dirty.top = scrollY;
+        dirty.bottom = scrollY + height;
+    }
+    // 描画面を失った（次のscrollTo()かinvalidateAll()で全体を描き直す）
+    void reset() {
+        valid = false;
+        dirty.top = dirty.bottom = 0;
+    }
+
+    // 描き直し待ちの帯を取り出す（なければfalse）
+    bool takeDirty(Band& out) {
+        if (dirty.empty()) {
+            return false;
+        }
+        out = dirty;
+        dirty.top = dirty.bottom = 0;
+        return true;
+    }
+
+    // 帯をリングの折り返しで分ける（最大2つ）。書き込んだ数を返す
+    size_t split(const Band& band, Segment out[2]) const {
+        size_t count = 0;
+        int32_t top = band.top;
+        while (top < band.bottom && count < 2) {
+            int32_t base = top - ringRow(top);
+            int32_t end = base + height < band.bottom ? base + height : band.bottom;
+            out[count].top = top;
+            out[count].bottom = end;
+            out[count].offset = base;
+            count++;
+            top = end;
+        }
+        return count;
+    }
+
+    // 内容のy座標が入っているリングの行
+    uint16_t ringRow(int32_t y) const {
+        int32_t row = y % height;
+        return static_cast<uint16_t>(row < 0 ? row + height : row);
+    }
+    // 表示の先頭に来るリングの行（VSCRSADDに相当）
+    uint16_t startRow() const { return ringRow(scrollY); }
+
+    int32_t getScrollY() const { return scrollY; }
+    uint16_t getHeight() const { return height; }
+    bool isValid() const { return valid; }
+};
+
+#endif // RING_SCROLL_H
@@ -0,0 +1,134 @@
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+#include "ScrollSurface.h"
+#include <Arduino.h>
+#include "../../shared/LogBuffer.h"
+
+ScrollSurface::ScrollSurface(int16_t x, int16_t y, uint16_t w, uint16_t h)
+    : display(nullptr), sprite(nullptr), left(x), top(y), width(w), height(h), background(TFT_BLACK),
+      ring(h), pushPending(false), renderedLines(0), pushCount(0) {
+}
+
+ScrollSurface::~ScrollSurface() {
+    end();
+}
+
+bool ScrollSurface::begin(LGFX* target) {
+    display = target;
+    ring.reset();
+    if (sprite) {
+        return true;
+    }
+    size_t bytes = static_cast<size_t>(width) * height * SCROLL_SURFACE_COLOR_DEPTH / 8;
+    if (ESP.getFreeHeap() < bytes + SCROLL_SURFACE_HEAP_RESERVE) {
+        logWarn("ScrollSurface: %u bytes not available, drawing directly", (unsigned)bytes);
+        return false;
+    }
+    sprite = new LGFX_Sprite(display);
+    sprite->setColorDepth(SCROLL_SURFACE_COLOR_DEPTH);
+    if (!sprite->createSprite(width, height)) {
+        delete sprite;
+        sprite = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void ScrollSurface::end() {
+    if (sprite) {
+        sprite->deleteSprite();
+        delete sprite;
+        sprite = nullptr;
+    }
+    ring.reset();
+    pushPending = false;
+}
+
+lgfx::v1::LovyanGFX* ScrollSurface::canvas() const {
+    if (sprite) {
+        return sprite;
+    }
+    return display;
+}
+
+void ScrollSurface::scrollTo(int32_t y) {
+    if (ring.isValid() && y == ring.getScrollY()) {
+        return;
+    }
+    ring.scrollTo(y);
+    if (!sprite) {
+        // 画面のメモリはずらせないので全体を描き直す
+        ring.invalidateAll();
+    }
+    pushPending = true;
+}
+
+bool ScrollSurface::flush(const RenderFn& render) {
+    if (!display) {
+        return false;
+    }
+    if (!ring.isValid()) {
+        ring.invalidateAll();
+    }
+    RingScroll::Band band;
+    if (ring.takeDirty(band)) {
+        if (sprite) {
+            RingScroll::Segment segments[2];
+            size_t count = ring.split(band, segments);
+            for (size_t i = 0; i < count; i++) {
+                const RingScroll::Segment& segment = segments[i];
+                int32_t y = segment.top - segment.offset;
+                int32_t h = segment.bottom - segment.top;
+                sprite->setClipRect(0, y, width, h);
+                sprite->fillRect(0, y, width, h, background);
+                if (render) {
+                    render(segment.top, segment.bottom, segment.offset);
+                }
+            }
+            sprite->clearClipRect();
+        } else {
+            int32_t origin = ring.getScrollY() - top;
+            int32_t y = band.top - origin;
+            display->setClipRect(left, y, width, band.height());
+            display->fillRect(left, y, width, band.height(), background);
+            if (render) {
+                render(band.top, band.bottom, origin);
+            }
+            display->clearClipRect();
+        }
+        renderedLines += static_cast<uint32_t>(band.height());
+        pushPending = true;
+    }
+    if (!pushPending) {
+        return false;
+    }
+    pushPending = false;
+    if (sprite) {
+        // 開始行から下を上へ、開始行より上を下へ（VSCRSADDで折り返して表示するのと同じ並び）
+        uint16_t start = ring.startRow();
+        display->setClipRect(left, top, width, height);
+        sprite->pushSprite(display, left, top - start);
+        if (start > 0) {
+            sprite->pushSprite(display, left, top + height - start);
+        }
+        display->clearClipRect();
+    }
+    pushCount++;
+    return true;
+}
+
+void ScrollSurface::drawScrollbar(int16_t x, uint16_t barWidth, int32_t position, int32_t maxPosition,
+                                  uint16_t color) {
+    if (!display) {
+        return;
+    }
+    display->fillRect(x, top, barWidth, height, background);
+    if (maxPosition <= 0) {
+        return;
+    }
+    int32_t contentHeight = maxPosition + height;
+    int32_t thumb = static_cast<int32_t>(height) * height / contentHeight;
+    thumb = thumb < 12 ? 12 : thumb;
+    int32_t thumbY = top + static_cast<int32_t>(static_cast<int64_t>(height - thumb) * position / maxPosition);
+    display->fillRect(x, thumbY, barWidth, thumb, color);
+}
@@ -0,0 +1,85 @@
+#ifndef SCROLL_SURFACE_H
+#define SCROLL_SURFACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "RingScroll.h"
+#include "../../shared/Delegate.h"
+
+// 前方宣言
+namespace lgfx {
+    namespace v1 {
+        class LGFX_Device;
+        class LGFX_Sprite;
+        class LovyanGFX;
+    }
+}
+using LGFX = lgfx::v1::LGFX_Device;
+
+// 描画面の色深度（8ならRGB332で約50KB、16なら倍の容量で色がそのまま出る）
+#ifndef SCROLL_SURFACE_COLOR_DEPTH
+#define SCROLL_SURFACE_COLOR_DEPTH 8
+#endif
+
+// 描画面を確保したあとに残しておくヒープ（足りなければ画面へ直接描く）
+#ifndef SCROLL_SURFACE_HEAP_RESERVE
+#define SCROLL_SURFACE_HEAP_RESERVE 60000
+#endif
+
+// 縦スクロールする領域の描画面
+// ビューポートと同じ大きさのスプライトをリングとして使い（RingScroll）、スクロールしたら
+// 新しく見えた帯だけを描いて、開始行で折り返した2回の転送で画面へ送る。
+// 1フレームに送る量はビューポート1枚分で一定、描く行は動いた分だけになる。
+// ヒープが足りずスプライトを確保できないときは画面へ直接描く（動くたびに全体を描き直す）。
+class ScrollSurface {
+public:
+    // 内容座標 [from, to) を描く。描画面のy = 内容のy - origin（描画面はcanvas()）
+    typedef Delegate<void(int32_t, int32_t, int32_t)> RenderFn;
+
+private:
+    LGFX* display;
+    lgfx::v1::LGFX_Sprite* sprite;
+    int16_t left;
+    int16_t top;
+    uint16_t width;
+    uint16_t height;
+    uint16_t background;
+    RingScroll ring;
+    bool pushPending;
+
+    uint32_t renderedLines;     // 描いた行（px）の累計
+    uint32_t pushCount;
+
+public:
+    ScrollSurface(int16_t x, int16_t y, uint16_t w, uint16_t h);
+    ~ScrollSurface();
+
+    // 描画面を確保する（できなければfalseで、直接描画になる）
+    bool begin(LGFX* target);
+    void end();
+
+    void setBackground(uint16_t color) { background = color; }
+
+    // 表示位置（内容座標で先頭に来るy）を変える
+    void scrollTo(int32_t y);
+    // 内容が変わった範囲を描き直させる
+    void invalidate(int32_t from, int32_t to) { ring.invalidate(from, to); }
+    void invalidateAll() { ring.invalidateAll(); }
+
+    // 描き直し待ちの帯を背景で塗ってから描き、動いたか描いたなら画面へ送る。送ったらtrue
+    bool flush(const RenderFn& render);
+
+    // 右端のスクロールバー（描画面の外、画面へ直接描く）
+    void drawScrollbar(int16_t x, uint16_t barWidth, int32_t position, int32_t maxPosition, uint16_t color);
+
+    // 行を描く先と、その左端のx
+    lgfx::v1::LovyanGFX* canvas() const;
+    int16_t canvasLeft() const { return sprite ? 0 : left; }
+
+    bool hasRing() const { return sprite != nullptr; }
+    int32_t getScrollY() const { return ring.getScrollY(); }
+    uint32_t getRenderedLines() const { return renderedLines; }
+    uint32_t getPushCount() const { return pushCount; }
+};
+
+#endif // SCROLL_SURFACE_H
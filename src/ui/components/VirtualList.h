@@ -0,0 +1,204 @@
+#ifndef VIRTUAL_LIST_H
+#define VIRTUAL_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../../shared/Delegate.h"
+
+// 仮想化リスト（固定高さの行）
+// 項目がいくつあっても、持つのは表示に必要な行数（部分的に見える上下の行を含む）の
+// スロットだけ。項目iはスロット i % Slots に割り当てるので、スクロールで画面外に
+// 出た行のスロットがそのまま新しく見えた行に使い回され、作り直す（bind）のは
+// 新しく見えた行だけになる。描画も表示範囲の行だけを呼ぶ。
+// 行の中身（Row）を作るのも描くのも呼び出し側で、このクラスは位置と割り当てだけを扱う。
+//   bind: 項目の内容をRowに詰める。まだ読めていなければfalse（invalidate()で作り直す）
+//   draw: 1行を描く（yは画面座標、drawBand()では描画面の座標。行は上下にはみ出すことがある）
+template <typename Row, size_t Slots>
+class VirtualList {
+public:
+    typedef Delegate<bool(uint32_t, Row&)> BindFn;
+    typedef Delegate<void(uint32_t, const Row&, bool, int16_t)> DrawFn;   // 項目, 行, 読めたか, y
+
+    static const uint32_t NO_ITEM = 0xFFFFFFFF;
+
+private:
+    struct Slot {
+        uint32_t item;
+        bool ready;
+        Row row;
+    };
+
+    Slot slots[Slots];
+    int16_t top;
+    uint16_t height;
+    uint16_t rowHeight;
+    uint32_t itemCount;
+    int32_t scrollY;            // 先頭からのスクロール量（px）
+    BindFn binder;
+    DrawFn renderer;
+
+    uint32_t bindCount;
+    uint32_t drawCount;
+
+    int32_t contentHeight() const { return static_cast<int32_t>(itemCount) * rowHeight; }
+
+public:
+    VirtualList(int16_t viewTop, uint16_t viewHeight, uint16_t itemHeight)
+        : top(viewTop), height(viewHeight), rowHeight(itemHeight), itemCount(0), scrollY(0),
+          bindCount(0), drawCount(0) {
+        clearSlots();
+    }
+
+    // 表示範囲の行数（部分的に見える上下の行を含む）がスロットに収まること
+    static constexpr size_t slotsFor(uint16_t viewHeight, uint16_t itemHeight) {
+        return (viewHeight + itemHeight - 1) / itemHeight + 1;
+    }
+
+    void setBinder(const BindFn& fn) { binder = fn; }
+    void setRenderer(const DrawFn& fn) { renderer = fn; }
+
+    // 項目数を変える（スクロール位置は範囲内に収め、割り当ては作り直す）
+    void setItemCount(uint32_t count) {
+        itemCount = count;
+        scrollTo(scrollY);
+        clearSlots();
+    }
+
+    // 末尾に項目を足す（今の割り当てとスクロール位置はそのまま）
+    void append(uint32_t count) {
+        itemCount += count;
+    }
+
+    // 割り当てをすべて捨てる（次のlayout()で表示中の行だけ作り直す）
+    void clearSlots() {
+        for (Slot& slot : slots) {
+            slot.item = NO_ITEM;
+            slot.ready = false;
+        }
+    }
+
+    // first〜first+count-1の項目を作り直させる（ページが読めたときなど）
+    void invalidate(uint32_t first, uint32_t count) {
+        for (Slot& slot : slots) {
+            if (slot.item != NO_ITEM && slot.item >= first && slot.item - first < count) {
+                slot.ready = false;
+            }
+        }
+    }
+
+    // スクロール位置を変える。変わったらtrue
+    bool scrollTo(int32_t y) {
+        int32_t maxScroll = getMaxScroll();
+        y = y < 0 ? 0 : (y > maxScroll ? maxScroll : y);
+        if (y == scrollY) {
+            return false;
+        }
+        scrollY = y;
+        return true;
+    }
+    bool scrollBy(int32_t dy) { return scrollTo(scrollY + dy); }
+
+    // 表示範囲の行をスロットに割り当て、内容が変わった行・未読の行だけbindする
+    // 作り直した行があればtrue
+    bool layout() {
+        bool changed = false;
+        uint32_t last = lastVisible();
+        for (uint32_t item = firstVisible(); item != NO_ITEM && item <= last; item++) {
+            Slot& slot = slots[item % Slots];
+            if (slot.item == item && slot.ready) {
+                continue;
+            }
+            slot.item = item;
+            slot.ready = binder ? binder(item, slot.row) : true;
+            bindCount++;
+            changed = true;
+        }
+        return changed;
+    }
+
+    // 表示範囲の行だけを描く（呼び出し側でビューポートにクリップしておく）
+    void draw() {
+        if (!renderer) {
+            return;
+        }
+        uint32_t last = lastVisible();
+        for (uint32_t item = firstVisible(); item != NO_ITEM && item <= last; item++) {
+            const Slot& slot = slots[item % Slots];
+            if (slot.item != item) {
+                continue;   // layout()前
+            }
+            renderer(item, slot.row, slot.ready, itemY(item));
+            drawCount++;
+        }
+    }
+
+    // 内容のy座標 [from, to) にかかる表示中の行だけを描く（リング状の描画面用）
+    // 行のyは画面座標ではなく「内容のy - origin」で渡す
+    void drawBand(int32_t from, int32_t to, int32_t origin) {
+        if (!renderer || itemCount == 0 || to <= from || to <= 0) {
+            return;
+        }
+        uint32_t first = static_cast<uint32_t>((from > 0 ? from : 0) / rowHeight);
+        uint32_t last = static_cast<uint32_t>((to - 1) / rowHeight);
+        first = first > firstVisible() ? first : firstVisible();
+        last = last < lastVisible() ? last : lastVisible();
+        for (uint32_t item = first; item <= last; item++) {
+            const Slot& slot = slots[item % Slots];
+            if (slot.item != item) {
+                continue;
+            }
+            renderer(item, slot.row, slot.ready, static_cast<int16_t>(static_cast<int32_t>(item) * rowHeight - origin));
+            drawCount++;
+        }
+    }
+
+    // 表示範囲の最初と最後の項目（項目がなければNO_ITEM）
+    uint32_t firstVisible() const {
+        return itemCount > 0 ? static_cast<uint32_t>(scrollY / rowHeight) : NO_ITEM;
+    }
+    uint32_t lastVisible() const {
+        if (itemCount == 0) {
+            return NO_ITEM;
+        }
+        uint32_t last = static_cast<uint32_t>((scrollY + height - 1) / rowHeight);
+        return last < itemCount ? last : itemCount - 1;
+    }
+
+    // 項目の画面上のy座標
+    int16_t itemY(uint32_t item) const {
+        return static_cast<int16_t>(top + static_cast<int32_t>(item) * rowHeight - scrollY);
+    }
+
+    // 画面のy座標にある項目（なければNO_ITEM）
+    uint32_t itemAt(int16_t y) const {
+        if (y < top || y >= top + height) {
+            return NO_ITEM;
+        }
+        uint32_t item = static_cast<uint32_t>((scrollY + y - top) / rowHeight);
+        return item < itemCount ? item : NO_ITEM;
+    }
+
+    bool contains(int16_t y) const { return y >= top && y < top + height; }
+
+    // 最後の行の下端（画面座標）。ビューポートより短いリストの余白を消すのに使う
+    int32_t contentBottom() const { return top + contentHeight() - scrollY; }
+
+    int32_t getScrollY() const { return scrollY; }
+    int32_t getMaxScroll() const {
+        int32_t overflow = contentHeight() - height;
+        return overflow > 0 ? overflow : 0;
+    }
+    uint32_t getItemCount() const { return itemCount; }
+    int16_t getTop() const { return top; }
+    uint16_t getHeight() const { return height; }
+    uint16_t getRowHeight() const { return rowHeight; }
+
+    // 統計
+    uint32_t getBindCount() const { return bindCount; }
+    uint32_t getDrawCount() const { return drawCount; }
+};
+
+template <typename Row, size_t Slots>
+const uint32_t VirtualList<Row, Slots>::NO_ITEM;
+
+#endif // VIRTUAL_LIST_H
@@ -0,0 +1,37 @@
+#ifndef WIDGET_LIST_H
+#define WIDGET_LIST_H
+
+#include <cstddef>
+
+// 固定長のウィジェット参照リスト（所有はしない）
+// ウィジェット本体はObjectPoolなどが保持し、画面はポインタだけを並べる
+template <typename T, size_t N>
+class WidgetList {
+private:
+    T* items[N];
+    size_t count;
+
+public:
+    WidgetList() : count(0) {}
+
+    // 追加（容量超過またはnullptrの場合はfalse）
+    bool push_back(T* item) {
+        if (!item || count >= N) {
+            return false;
+        }
+        items[count++] = item;
+        return true;
+    }
+
+    void clear() { count = 0; }
+
+    T* operator[](size_t index) const { return items[index]; }
+    T* back() const { return count > 0 ? items[count - 1] : nullptr; }
+    T* const* begin() const { return items; }
+    T* const* end() const { return items + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr size_t capacity() { return N; }
+};
+
+#endif // WIDGET_LIST_H
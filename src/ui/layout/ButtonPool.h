@@ -0,0 +1,26 @@
+#ifndef BUTTON_POOL_H
+#define BUTTON_POOL_H
+
+#include <cstddef>
+#include "LayoutTable.h"
+#include "../components/ModernButton.h"
+#include "../../shared/ObjectPool.h"
+
+// 画面ごとのボタンプール（容量はレイアウト表の要素数から決める）
+template <size_t N>
+using ButtonPool = ObjectPool<ModernButton, N>;
+
+// プールからボタンを取得して定義を適用（容量不足時はnullptr）
+// 前回の訪問で同じスロットに同じラベルがあれば、計測済みの寸法をそのまま使う
+template <size_t N>
+ModernButton* acquireButton(ButtonPool<N>& pool, LGFX* display, const ButtonDef& def) {
+    ModernButton* button = pool.acquire(display, def.x, def.y, def.w, def.h, def.label);
+    if (!button) {
+        return nullptr;
+    }
+    button->reset(def.x, def.y, def.w, def.h, def.label);
+    applyButtonDef(*button, def);
+    return button;
+}
+
+#endif // BUTTON_POOL_H
@@ -0,0 +1,52 @@
+#ifndef BUTTON_SET_H
+#define BUTTON_SET_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include "LayoutTable.h"
+#include "../components/ModernButton.h"
+
+// レイアウト表からボタンを生成して保持する固定長コンテナ
+// ボタン本体はメンバ内の領域に配置newするため、ヒープ確保を行わない
+template <size_t N>
+class ButtonSet {
+private:
+    typedef typename std::aligned_storage<sizeof(ModernButton), alignof(ModernButton)>::type Slot;
+    static_assert(sizeof(Slot) == sizeof(ModernButton), "slot must be tightly packed");
+
+    Slot storage[N];
+    size_t count;
+
+public:
+    ButtonSet() : count(0) {}
+    ~ButtonSet() { clear(); }
+
+    ButtonSet(const ButtonSet&) = delete;
+    ButtonSet& operator=(const ButtonSet&) = delete;
+
+    // 表の全エントリからボタンを構築
+    void build(LGFX* display, const ButtonDef (&defs)[N]) {
+        clear();
+        for (size_t i = 0; i < N; ++i) {
+            const ButtonDef& def = defs[i];
+            ModernButton* button = new (&storage[i]) ModernButton(display, def.x, def.y, def.w, def.h, def.label);
+            applyButtonDef(*button, def);
+            count = i + 1;
+        }
+    }
+
+    void clear() {
+        while (count > 0) {
+            --count;
+            (*this)[count].~ModernButton();
+        }
+    }
+
+    ModernButton& operator[](size_t index) { return *reinterpret_cast<ModernButton*>(&storage[index]); }
+    ModernButton* begin() { return reinterpret_cast<ModernButton*>(&storage[0]); }
+    ModernButton* end() { return begin() + count; }
+    size_t size() const { return count; }
+};
+
+#endif // BUTTON_SET_H
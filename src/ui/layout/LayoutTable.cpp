@@ -0,0 +1,42 @@
+#include "LayoutTable.h"
+#include "../components/ModernButton.h"
+#include "../../shared/EventBus.h"
+#include <Arduino.h>
+
+ButtonStyle toButtonStyle(const ButtonStyleDef& def) {
+    ButtonStyle style;
+    style.normalColor = def.normalColor;
+    style.pressedColor = def.pressedColor;
+    style.cornerRadius = def.cornerRadius;
+    style.shadowOffset = def.shadowOffset;
+    style.borderWidth = def.borderWidth;
+    style.borderColor = def.borderColor;
+    return style;
+}
+
+void applyButtonDef(ModernButton& button, const ButtonDef& def) {
+    if (def.style) {
+        button.setStyle(toButtonStyle(*def.style));
+    }
+    // 定義はフラッシュ上の定数なのでポインタだけをキャプチャする
+    const ButtonDef* source = &def;
+    button.setOnClick([source]() {
+        Serial.printf("%s button pressed\n", source->label);
+        dispatchUiAction(source->action);
+    });
+}
+
+void dispatchUiAction(const UiActionDef& action) {
+    switch (action.type) {
+        case UI_ACTION_NAVIGATE: {
+            Event e = makeScreenChangeEvent(action.target, action.transition);
+            if (g_eventBus) {
+                g_eventBus->publish(e);
+            }
+            break;
+        }
+        case UI_ACTION_NONE:
+        default:
+            break;
+    }
+}
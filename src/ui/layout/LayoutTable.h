@@ -0,0 +1,129 @@
+#ifndef LAYOUT_TABLE_H
+#define LAYOUT_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../../screens/BaseScreen.h"
+
+class ModernButton;
+struct ButtonStyle;
+
+// 画面サイズ（横向き固定: setRotation(1)）
+constexpr int16_t UI_SCREEN_WIDTH = 320;
+constexpr int16_t UI_SCREEN_HEIGHT = 240;
+
+// コンパイル時にRGB565へ変換（LGFX::color565と同じ計算）
+constexpr uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+    return static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+constexpr int16_t layoutMax(int16_t a, int16_t b) {
+    return a > b ? a : b;
+}
+
+// グリッド配置の計算（列・行ごとの左上座標）
+constexpr int16_t gridGapX(uint16_t cellW, int16_t cols, int16_t minGap) {
+    return layoutMax(minGap, static_cast<int16_t>((UI_SCREEN_WIDTH - cols * cellW) / (cols + 1)));
+}
+
+constexpr int16_t gridCellX(int16_t col, uint16_t cellW, int16_t cols, int16_t minGap) {
+    return static_cast<int16_t>(gridGapX(cellW, cols, minGap) + col * (cellW + gridGapX(cellW, cols, minGap)));
+}
+
+constexpr int16_t gridStartY(uint16_t cellH, int16_t rows, int16_t rowGap, int16_t minY) {
+    return layoutMax(minY, static_cast<int16_t>((UI_SCREEN_HEIGHT - (rows * cellH + (rows - 1) * rowGap)) / 2));
+}
+
+constexpr int16_t gridCellY(int16_t row, uint16_t cellH, int16_t rows, int16_t rowGap, int16_t minY) {
+    return static_cast<int16_t>(gridStartY(cellH, rows, rowGap, minY) + row * (cellH + rowGap));
+}
+
+// ボタンのスタイル定義（フラッシュに配置される定数）
+struct ButtonStyleDef {
+    uint16_t normalColor;
+    uint16_t pressedColor;
+    uint8_t cornerRadius;
+    uint8_t shadowOffset;
+    uint8_t borderWidth;
+    uint16_t borderColor;
+};
+
+// ボタン押下時のアクション
+enum UiActionType {
+    UI_ACTION_NONE = 0,
+    UI_ACTION_NAVIGATE       // 画面遷移イベントを送信
+};
+
+struct UiActionDef {
+    UiActionType type;
+    ScreenID target;
+    TransitionType transition;
+};
+
+// ボタン1個分のレイアウト定義
+struct ButtonDef {
+    int16_t x;
+    int16_t y;
+    uint16_t w;
+    uint16_t h;
+    const char* label;
+    const ButtonStyleDef* style;
+    UiActionDef action;
+};
+
+// 共通スタイル
+constexpr ButtonStyleDef STYLE_BACK = {
+    rgb565(96, 125, 139), rgb565(69, 90, 100), 5, 2, 0, 0xFFFF      // Blue Grey
+};
+
+constexpr ButtonStyleDef STYLE_CLOSE = {
+    rgb565(244, 67, 54), rgb565(211, 47, 47), 0, 3, 2, rgb565(183, 28, 28)  // Material Red
+};
+
+// 右上の「戻る」ボタン
+constexpr ButtonDef BACK_TO_MENU_BUTTON = {
+    UI_SCREEN_WIDTH - 70, 10, 60, 30, "戻る", &STYLE_BACK,
+    {UI_ACTION_NAVIGATE, SCREEN_BACK, TRANSITION_SLIDE_RIGHT}
+};
+
+// 戻るボタンだけを持つ画面のレイアウト
+constexpr ButtonDef BACK_ONLY_LAYOUT[] = {
+    BACK_TO_MENU_BUTTON
+};
+
+// レイアウト表の要素数（プールなどの容量をコンパイル時に決める）
+template <size_t N>
+constexpr size_t layoutCount(const ButtonDef (&)[N]) {
+    return N;
+}
+
+// 表のボタンが遷移する画面を列挙（戻る・重複を除く）。書き込んだ数を返す
+template <size_t N>
+size_t collectNavigationTargets(const ButtonDef (&defs)[N], ScreenID* out, size_t maxCount) {
+    size_t count = 0;
+    for (size_t i = 0; i < N && count < maxCount; ++i) {
+        const UiActionDef& action = defs[i].action;
+        if (action.type != UI_ACTION_NAVIGATE || action.target == SCREEN_BACK) {
+            continue;
+        }
+        bool seen = false;
+        for (size_t j = 0; j < count; ++j) {
+            seen = seen || out[j] == action.target;
+        }
+        if (!seen) {
+            out[count++] = action.target;
+        }
+    }
+    return count;
+}
+
+// スタイル定義をButtonStyleに展開
+ButtonStyle toButtonStyle(const ButtonStyleDef& def);
+
+// ボタンにスタイルとアクションを適用
+void applyButtonDef(ModernButton& button, const ButtonDef& def);
+
+// アクションを実行
+void dispatchUiAction(const UiActionDef& action);
+
+#endif // LAYOUT_TABLE_H
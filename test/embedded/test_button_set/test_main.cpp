@@ -0,0 +1,120 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <cstdlib>
+#include <new>
+// ボタンの構築はLovyanGFX・シリアル・イベントバスに依存するので実機で確かめる
+#include "../../../src/ui/components/ModernButton.cpp"
+#include "../../../src/ui/layout/LayoutTable.cpp"
+#include "../../../src/audio/SfxMixer.cpp"
+#include "../../../src/shared/EventBus.cpp"
+#include "../../../src/shared/EventLanes.cpp"
+#include "../../../src/shared/MotionChannel.cpp"
+#include "../../../src/ui/layout/ButtonSet.h"
+#include "../../../src/ui/layout/ButtonPool.h"
+#include "../../../src/ui/components/WidgetList.h"
+
+// ヒープ確保回数をカウントする（このテストのプログラム全体のoperator newを置き換える）
+static volatile size_t g_allocCount = 0;
+
+void* operator new(size_t size) {
+    g_allocCount++;
+    void* p = std::malloc(size);
+    if (!p) {
+        abort();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+constexpr ButtonStyleDef STYLE_TEST = {
+    rgb565(33, 150, 243), rgb565(25, 118, 210), 8, 3, 0, 0xFFFF
+};
+
+// メニュー画面と同じ数・同じ種類の定義（遷移先を持つボタン6個と戻る）
+constexpr ButtonDef TEST_LAYOUT[] = {
+    {10, 60, 140, 44, "入力設定", &STYLE_TEST, {UI_ACTION_NAVIGATE, SCREEN_INPUT_SETTINGS, TRANSITION_SLIDE_LEFT}},
+    {170, 60, 140, 44, "出力設定", &STYLE_TEST, {UI_ACTION_NAVIGATE, SCREEN_OUTPUT_SETTINGS, TRANSITION_SLIDE_LEFT}},
+    {10, 114, 140, 44, "待機設定", &STYLE_TEST, {UI_ACTION_NAVIGATE, SCREEN_STANDBY_SETTINGS, TRANSITION_SLIDE_LEFT}},
+    {170, 114, 140, 44, "時刻設定", &STYLE_TEST, {UI_ACTION_NAVIGATE, SCREEN_TIME_SETTINGS, TRANSITION_SLIDE_LEFT}},
+    {10, 168, 140, 44, "ログ", &STYLE_TEST, {UI_ACTION_NAVIGATE, SCREEN_LOG, TRANSITION_SLIDE_LEFT}},
+    {170, 168, 140, 44, "情報", nullptr, {UI_ACTION_NAVIGATE, SCREEN_INFO, TRANSITION_SLIDE_LEFT}},
+    BACK_TO_MENU_BUTTON
+};
+constexpr size_t TEST_COUNT = layoutCount(TEST_LAYOUT);
+
+// 表示は使わない（構築と定義の適用は描画しない）
+LGFX* const NO_DISPLAY = nullptr;
+
+ButtonSet<TEST_COUNT> g_buttonSet;
+ButtonPool<TEST_COUNT> g_buttonPool;
+} // namespace
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// レイアウト表からの構築（配置new + applyButtonDefでのスタイルとコールバックの設定）は確保しない
+void test_button_set_build_does_not_allocate(void) {
+    size_t before = g_allocCount;
+    for (int visit = 0; visit < 100; visit++) {
+        g_buttonSet.build(NO_DISPLAY, TEST_LAYOUT);
+    }
+    size_t allocations = g_allocCount - before;
+
+    TEST_ASSERT_EQUAL(0, allocations);
+    TEST_ASSERT_EQUAL(TEST_COUNT, g_buttonSet.size());
+    TEST_ASSERT_EQUAL_STRING("入力設定", g_buttonSet[0].getText().c_str());
+    TEST_ASSERT_TRUE(g_buttonSet[TEST_COUNT - 1].contains(BACK_TO_MENU_BUTTON.x + 1, BACK_TO_MENU_BUTTON.y + 1));
+    g_buttonSet.clear();
+}
+
+// プールからの取得（訪問ごとのreset + applyButtonDef）も確保しない
+void test_pooled_buttons_do_not_allocate(void) {
+    WidgetList<ModernButton, TEST_COUNT> buttons;
+    size_t before = g_allocCount;
+    for (int visit = 0; visit < 100; visit++) {
+        buttons.clear();
+        g_buttonPool.releaseAll();
+        for (const ButtonDef& def : TEST_LAYOUT) {
+            TEST_ASSERT_TRUE(buttons.push_back(acquireButton(g_buttonPool, NO_DISPLAY, def)));
+        }
+    }
+    size_t allocations = g_allocCount - before;
+
+    TEST_ASSERT_EQUAL(0, allocations);
+    TEST_ASSERT_EQUAL(TEST_COUNT, buttons.size());
+    TEST_ASSERT_EQUAL_STRING("情報", buttons[5]->getText().c_str());
+    buttons.clear();
+    g_buttonPool.releaseAll();
+}
+
+// 置き換えたoperator newが数えていること（上の0件が見落としでないことの確認）
+void test_counter_sees_heap_allocations(void) {
+    size_t before = g_allocCount;
+    int* value = new int(1);
+    delete value;
+    TEST_ASSERT_EQUAL(1, g_allocCount - before);
+}
+
+void setup() {
+    delay(2000);  // シリアルモニタの接続待ち
+    UNITY_BEGIN();
+    RUN_TEST(test_counter_sees_heap_allocations);
+    RUN_TEST(test_button_set_build_does_not_allocate);
+    RUN_TEST(test_pooled_buttons_do_not_allocate);
+    UNITY_END();
+}
+
+void loop() {
+    // テスト後は何もしない
+}
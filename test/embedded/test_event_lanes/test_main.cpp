@@ -0,0 +1,152 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../../../src/shared/EventLanes.cpp"
+#include "../../../src/shared/MotionChannel.cpp"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static void drain(EventLanes& lanes) {
+    Event event;
+    while (lanes.receive(event)) {
+    }
+}
+
+// TOUCH_MOVEが溢れても画面遷移イベントは失われず、最初に取り出される
+void test_control_survives_motion_burst(void) {
+    EventLanes lanes;
+    for (int i = 0; i < 200; i++) {
+        lanes.send(makeTouchEvent(EVENT_TOUCH_MOVE, i, 0, 0, 0, micros()));
+    }
+    TEST_ASSERT_TRUE(lanes.send(makeScreenChangeEvent(1, 0)));
+
+    Event event;
+    TEST_ASSERT_TRUE(lanes.receive(event));
+    TEST_ASSERT_EQUAL(EVENT_SCREEN_CHANGE, event.getType());
+    TEST_ASSERT_EQUAL(0, lanes.getDropCount(EVENT_LANE_CONTROL));
+
+    // 連続した移動は最新の座標1件にまとめられ、何も捨てられない
+    TEST_ASSERT_EQUAL(1, lanes.getCount(EVENT_LANE_MOTION));
+    TEST_ASSERT_EQUAL(199, lanes.getCoalescedCount());
+    TEST_ASSERT_EQUAL(0, lanes.getDropCount(EVENT_LANE_MOTION));
+    TEST_ASSERT_TRUE(lanes.receive(event));
+    TEST_ASSERT_EQUAL(199, event.touch().x);
+    TEST_ASSERT_TRUE((event.flags & EVENT_FLAG_COALESCED) != 0);
+    TEST_ASSERT_FALSE(lanes.receive(event));
+}
+
+// ジェスチャーと移動はレーンをまたいでも送信順に取り出される
+// （DOWNやUPを挟んだ移動同士はまとめない）
+void test_gesture_and_motion_keep_send_order(void) {
+    EventLanes lanes;
+    lanes.send(makeTouchEvent(EVENT_TOUCH_DOWN, 10, 10, 0, 0, 1));
+    lanes.send(makeTouchEvent(EVENT_TOUCH_MOVE, 20, 10, 0, 0, 2));
+    lanes.send(makeTouchEvent(EVENT_TOUCH_MOVE, 30, 10, 0, 0, 3));
+    lanes.send(makeTouchEvent(EVENT_TOUCH_UP, 30, 10, 0, 0, 4));
+    lanes.send(makeTouchEvent(EVENT_TOUCH_DOWN, 100, 10, 0, 0, 5));
+    lanes.send(makeTouchEvent(EVENT_TOUCH_MOVE, 110, 10, 0, 0, 6));
+
+    const EventType expected[] = {EVENT_TOUCH_DOWN, EVENT_TOUCH_MOVE, EVENT_TOUCH_UP,
+                                  EVENT_TOUCH_DOWN, EVENT_TOUCH_MOVE};
+    const int16_t expectedX[] = {10, 30, 30, 100, 110};
+    Event event;
+    for (size_t i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(lanes.receive(event));
+        TEST_ASSERT_EQUAL(expected[i], event.getType());
+        TEST_ASSERT_EQUAL(expectedX[i], event.touch().x);
+    }
+    TEST_ASSERT_FALSE(lanes.receive(event));
+}
+
+// まとめられた座標も履歴に残り、速度計算に使われる
+void test_velocity_uses_coalesced_samples(void) {
+    EventLanes lanes;
+    lanes.send(makeTouchEvent(EVENT_TOUCH_DOWN, 0, 0, 0, 0, 0));
+    for (int i = 1; i <= 10; i++) {
+        // 10msごとに20px右へ（= 2000px/秒）
+        lanes.send(makeTouchEvent(EVENT_TOUCH_MOVE, i * 20, 0, 0, 0, i * 10000u));
+    }
+    float vx = 0, vy = 0;
+    TEST_ASSERT_TRUE(lanes.estimateMotionVelocity(50000, vx, vy));
+    TEST_ASSERT_INT_WITHIN(1, 2000, static_cast<int>(vx));
+    TEST_ASSERT_INT_WITHIN(1, 0, static_cast<int>(vy));
+    drain(lanes);
+
+    // 新しいタッチで履歴は破棄される
+    lanes.send(makeTouchEvent(EVENT_TOUCH_DOWN, 0, 0, 0, 0, 200000));
+    TEST_ASSERT_FALSE(lanes.estimateMotionVelocity(50000, vx, vy));
+    drain(lanes);
+}
+
+// 制御レーンは満杯時に新しいものを捨て、破棄数を数える
+void test_control_lane_drops_newest_when_full(void) {
+    EventLanes lanes;
+    const size_t capacity = EventLanes::getConfig(EVENT_LANE_CONTROL).capacity;
+    for (size_t i = 0; i < capacity + 3; i++) {
+        lanes.send(makeScreenChangeEvent(static_cast<int>(i), 0));
+    }
+    TEST_ASSERT_EQUAL(3, lanes.getDropCount(EVENT_LANE_CONTROL));
+
+    Event event;
+    TEST_ASSERT_TRUE(lanes.receive(event));
+    TEST_ASSERT_EQUAL(0, event.screenChange().targetScreen);
+    drain(lanes);
+}
+
+// ジェスチャーレーンが溢れても、受け付けた押下の解放は必ず届く
+// 入らない押下はそのタッチの移動・解放ごと捨て、押したままの画面を残さない
+void test_gesture_lane_keeps_touch_pairs(void) {
+    EventLanes lanes;
+    const size_t capacity = EventLanes::getConfig(EVENT_LANE_GESTURE).capacity;
+    TEST_ASSERT_TRUE(lanes.send(makeTouchEvent(EVENT_TOUCH_DOWN, 1, 1, 0, 0, 1)));
+    // スワイプで埋めても解放の1枠は残る
+    size_t swipes = 0;
+    while (lanes.send(makeGestureEvent(GestureEvent::GESTURE_LEFT, 0, 0, 100, 0, 100))) {
+        swipes++;
+    }
+    TEST_ASSERT_EQUAL(capacity - 2, swipes);
+    TEST_ASSERT_TRUE(lanes.send(makeTouchEvent(EVENT_TOUCH_UP, 1, 1, 0, 0, 2)));
+    TEST_ASSERT_EQUAL(capacity, lanes.getCount(EVENT_LANE_GESTURE));
+
+    // 満杯の間の押下は移動・解放と一緒に捨てる
+    uint32_t dropsBefore = lanes.getDropCount(EVENT_LANE_GESTURE);
+    TEST_ASSERT_FALSE(lanes.send(makeTouchEvent(EVENT_TOUCH_DOWN, 2, 2, 0, 0, 3)));
+    TEST_ASSERT_FALSE(lanes.send(makeTouchEvent(EVENT_TOUCH_MOVE, 20, 2, 0, 0, 4)));
+    TEST_ASSERT_FALSE(lanes.send(makeTouchEvent(EVENT_TOUCH_UP, 20, 2, 0, 0, 5)));
+    TEST_ASSERT_EQUAL(dropsBefore + 2, lanes.getDropCount(EVENT_LANE_GESTURE));
+    TEST_ASSERT_EQUAL(0, lanes.getCount(EVENT_LANE_MOTION));
+
+    // 押下と解放は数が揃って届く
+    Event event;
+    int presses = 0;
+    int releases = 0;
+    while (lanes.receive(event)) {
+        presses += event.is(EVENT_TOUCH_DOWN) ? 1 : 0;
+        releases += event.is(EVENT_TOUCH_UP) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL(1, presses);
+    TEST_ASSERT_EQUAL(1, releases);
+
+    // 空いたら次のタッチは通常どおり
+    TEST_ASSERT_TRUE(lanes.send(makeTouchEvent(EVENT_TOUCH_DOWN, 3, 3, 0, 0, 6)));
+    TEST_ASSERT_TRUE(lanes.send(makeTouchEvent(EVENT_TOUCH_UP, 3, 3, 0, 0, 7)));
+    drain(lanes);
+}
+
+void setup() {
+    delay(2000);  // シリアルモニタの接続待ち
+    UNITY_BEGIN();
+    RUN_TEST(test_control_survives_motion_burst);
+    RUN_TEST(test_gesture_and_motion_keep_send_order);
+    RUN_TEST(test_control_lane_drops_newest_when_full);
+    RUN_TEST(test_gesture_lane_keeps_touch_pairs);
+    RUN_TEST(test_velocity_uses_coalesced_samples);
+    UNITY_END();
+}
+
+void loop() {
+    // テスト後は何もしない
+}
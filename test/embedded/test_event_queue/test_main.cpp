@@ -0,0 +1,120 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../../../src/shared/EventQueue.h"
+
+// 旧フォーマット相当（int32_t中心のTouchEvent + 各メンバに重複したtype）
+struct LegacyTouchEvent {
+    EventType type;
+    int32_t x;
+    int32_t y;
+    int32_t raw_x;
+    int32_t raw_y;
+    uint32_t timestamp;
+    uint8_t pressure;
+};
+
+struct LegacyEvent {
+    EventType type;
+    union {
+        LegacyTouchEvent touch;
+        int32_t gesture[7];
+    } data;
+};
+
+static const size_t QUEUE_DEPTH = 64;
+static const int ROUNDS = 500;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 1スロット16バイトに収まっている
+void test_event_layout_is_compact(void) {
+    TEST_ASSERT_EQUAL(16, sizeof(Event));
+    TEST_ASSERT_EQUAL(32, sizeof(LegacyEvent));
+}
+
+// エンコードした値がキューを通って元に戻る
+void test_round_trip_through_queue(void) {
+    EventQueue queue(4);
+    TEST_ASSERT_TRUE(queue.send(makeTouchEvent(EVENT_TOUCH_MOVE, 319, 239, 3800, -5, 123456789u)));
+    TEST_ASSERT_TRUE(queue.send(makeGestureEvent(GestureEvent::GESTURE_LEFT, 300, 100, 20, 110, 180)));
+    TEST_ASSERT_TRUE(queue.send(makeScreenChangeEvent(3, 4)));
+
+    Event event;
+    TEST_ASSERT_TRUE(queue.receive(event));
+    TEST_ASSERT_EQUAL(EVENT_TOUCH_MOVE, event.getType());
+    TEST_ASSERT_EQUAL(319, event.touch().x);
+    TEST_ASSERT_EQUAL(239, event.touch().y);
+    TEST_ASSERT_EQUAL(3800, event.touch().rawX);
+    TEST_ASSERT_EQUAL(-5, event.touch().rawY);
+    TEST_ASSERT_EQUAL(123456789u, event.touch().timestampUs);
+
+    TEST_ASSERT_TRUE(queue.receive(event));
+    TEST_ASSERT_EQUAL(EVENT_GESTURE_SWIPE, event.getType());
+    TEST_ASSERT_EQUAL(GestureEvent::GESTURE_LEFT, event.gestureDirection());
+    TEST_ASSERT_EQUAL(180, event.gesture().durationMs);
+
+    TEST_ASSERT_TRUE(queue.receive(event));
+    TEST_ASSERT_EQUAL(3, event.screenChange().targetScreen);
+    TEST_ASSERT_EQUAL(4, event.screenChange().transition);
+}
+
+// キューを満杯にして全部取り出す、を繰り返した時の処理時間を比較
+void test_queue_throughput(void) {
+    QueueHandle_t legacyQueue = xQueueCreate(QUEUE_DEPTH, sizeof(LegacyEvent));
+    TEST_ASSERT_NOT_NULL(legacyQueue);
+    LegacyEvent legacy;
+    memset(&legacy, 0, sizeof(legacy));
+    legacy.type = EVENT_TOUCH_MOVE;
+
+    uint32_t start = micros();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (size_t i = 0; i < QUEUE_DEPTH; ++i) {
+            legacy.data.touch.x = static_cast<int32_t>(i);
+            xQueueSend(legacyQueue, &legacy, 0);
+        }
+        for (size_t i = 0; i < QUEUE_DEPTH; ++i) {
+            xQueueReceive(legacyQueue, &legacy, 0);
+        }
+    }
+    uint32_t legacyUs = micros() - start;
+    vQueueDelete(legacyQueue);
+
+    EventQueue queue(QUEUE_DEPTH);
+    Event event = makeTouchEvent(EVENT_TOUCH_MOVE, 0, 0, 0, 0, 0);
+    start = micros();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (size_t i = 0; i < QUEUE_DEPTH; ++i) {
+            event.data.touch.x = static_cast<int16_t>(i);
+            queue.send(event);
+        }
+        for (size_t i = 0; i < QUEUE_DEPTH; ++i) {
+            queue.receive(event);
+        }
+    }
+    uint32_t compactUs = micros() - start;
+
+    uint32_t events = ROUNDS * QUEUE_DEPTH;
+    char message[160];
+    snprintf(message, sizeof(message),
+             "legacy: %u events in %u us (%u bytes/slot), compact: %u events in %u us (%u bytes/slot)",
+             events, legacyUs, (unsigned)sizeof(LegacyEvent), events, compactUs, (unsigned)sizeof(Event));
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(compactUs > 0 && legacyUs > 0);
+}
+
+void setup() {
+    delay(2000);  // シリアルモニタの接続待ち
+    UNITY_BEGIN();
+    RUN_TEST(test_event_layout_is_compact);
+    RUN_TEST(test_round_trip_through_queue);
+    RUN_TEST(test_queue_throughput);
+    UNITY_END();
+}
+
+void loop() {
+    // テスト後は何もしない
+}
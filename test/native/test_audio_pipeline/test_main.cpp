@@ -0,0 +1,383 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../../../src/audio/AudioPipeline.cpp"
+#include "../../../src/audio/WavDecoder.cpp"
+#include "../../../src/audio/Mp3Decoder.cpp"
+
+static uint32_t hostMicros() {
+    using namespace std::chrono;
+    return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+static uint32_t fnv1a(const void* data, size_t length, uint32_t hash = 2166136261u) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void putLe16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+static void putLe32(std::vector<uint8_t>& out, uint32_t value) {
+    putLe16(out, static_cast<uint16_t>(value));
+    putLe16(out, static_cast<uint16_t>(value >> 16));
+}
+
+static void putTag(std::vector<uint8_t>& out, const char* tag) {
+    out.insert(out.end(), tag, tag + 4);
+}
+
+// WAVの試験データ（決まった波形、LISTチャンクとfmtの拡張部分も含める）
+struct WavFixture {
+    std::vector<uint8_t> file;
+    size_t dataOffset;
+    size_t dataLength;
+
+    WavFixture(uint32_t rate, uint16_t channels, uint16_t bits, uint32_t frames) {
+        uint16_t blockAlign = static_cast<uint16_t>(channels * bits / 8);
+        dataLength = frames * blockAlign;
+        putTag(file, "RIFF");
+        putLe32(file, 0);
+        putTag(file, "WAVE");
+        putTag(file, "fmt ");
+        putLe32(file, 18);
+        putLe16(file, 1);
+        putLe16(file, channels);
+        putLe32(file, rate);
+        putLe32(file, rate * blockAlign);
+        putLe16(file, blockAlign);
+        putLe16(file, bits);
+        putLe16(file, 0);                   // cbSize
+        putTag(file, "LIST");
+        putLe32(file, 5);
+        file.insert(file.end(), {'I', 'N', 'F', 'O', 'x', 0});  // 奇数長＋詰め物
+        putTag(file, "data");
+        putLe32(file, static_cast<uint32_t>(dataLength));
+        dataOffset = file.size();
+        uint32_t state = 12345;
+        for (size_t i = 0; i < dataLength; i++) {
+            state = state * 1103515245u + 12345u;
+            file.push_back(static_cast<uint8_t>(state >> 16));
+        }
+    }
+};
+
+// MPEG1 Layer IIIモノラル44.1kHz 128kbpsのフレームを組み立てる
+// スペクトルはcount1領域（表B）の±1だけで、フレームとグラニュールごとに位置と符号を変える。
+// main_data_beginは0なので各フレームで完結する。silentならスペクトルを持たない（復号すると無音）
+struct Mp3Fixture {
+    static const size_t FRAME_BYTES = 417;
+    static const size_t SIDE_INFO_BYTES = 17;
+    std::vector<uint8_t> file;
+    size_t frames;
+
+    explicit Mp3Fixture(size_t frameCount, bool silent = false) : frames(frameCount) {
+        for (size_t frame = 0; frame < frameCount; frame++) {
+            std::vector<uint8_t> bits;
+            uint32_t granuleBits[2];
+            std::vector<uint8_t> mainData;
+            for (int granule = 0; granule < 2; granule++) {
+                size_t before = mainData.size();
+                if (silent) {
+                    granuleBits[granule] = 0;
+                    continue;
+                }
+                size_t zeroQuads = (frame * 2 + granule) % 8;
+                for (size_t i = 0; i < zeroQuads; i++) {
+                    putBits(mainData, 0xF, 4);              // 0000
+                }
+                putBits(mainData, 0x0, 4);                  // 1111
+                putBits(mainData, (frame + granule) & 0xF, 4);  // 符号
+                granuleBits[granule] = static_cast<uint32_t>(mainData.size() - before);
+            }
+
+            // サイド情報（17バイト）
+            putBits(bits, 0, 9);        // main_data_begin
+            putBits(bits, 0, 5);        // private_bits
+            putBits(bits, 0, 4);        // scfsi
+            for (int granule = 0; granule < 2; granule++) {
+                putBits(bits, granuleBits[granule], 12);    // part2_3_length
+                putBits(bits, 0, 9);    // big_values
+                putBits(bits, 200, 8);  // global_gain
+                putBits(bits, 0, 4);    // scalefac_compress（スケールファクターなし）
+                putBits(bits, 0, 1);    // window_switching_flag
+                putBits(bits, 0, 15);   // table_select
+                putBits(bits, 0, 7);    // region0_count, region1_count
+                putBits(bits, 0, 2);    // preflag, scalefac_scale
+                putBits(bits, 1, 1);    // count1table_select（表B）
+            }
+            bits.insert(bits.end(), mainData.begin(), mainData.end());
+
+            const uint8_t header[4] = {0xFF, 0xFB, 0x90, 0xC4};
+            file.insert(file.end(), header, header + 4);
+            std::vector<uint8_t> bytes(FRAME_BYTES - 4, 0);
+            for (size_t i = 0; i < bits.size(); i++) {
+                if (bits[i]) {
+                    bytes[i / 8] |= static_cast<uint8_t>(0x80 >> (i % 8));
+                }
+            }
+            file.insert(file.end(), bytes.begin(), bytes.end());
+        }
+    }
+
+    // 1要素1bitで上位から積む
+    static void putBits(std::vector<uint8_t>& out, uint32_t value, int count) {
+        for (int i = count - 1; i >= 0; i--) {
+            out.push_back(static_cast<uint8_t>((value >> i) & 1));
+        }
+    }
+};
+
+// SD・DMAの代わりにホストのループで両リングを回す
+struct PipelineRun {
+    std::vector<int16_t> pcm;
+    uint32_t inputUnderruns;
+    uint32_t outputUnderruns;
+    bool failed;
+};
+
+// decoderを渡せばそれを使い回す（省略時は形式に合わせて新しく作る）
+static PipelineRun runPipeline(const std::vector<uint8_t>& file, size_t chunk, size_t renderCount,
+                               AudioDecoder* decoder = nullptr) {
+    SpscRing<uint8_t> input(4096);
+    SpscRing<int16_t> output(8192);
+    AudioPipeline pipeline(input, output, hostMicros);
+    WavDecoder wav;
+    Mp3Decoder mp3;
+    bool isWav = file.size() >= 4 && memcmp(file.data(), "RIFF", 4) == 0;
+    if (!decoder) {
+        decoder = isWav ? static_cast<AudioDecoder*>(&wav) : &mp3;
+    }
+    pipeline.start(decoder);
+
+    PipelineRun run;
+    std::vector<int16_t> block(renderCount);
+    size_t offset = 0;
+    for (int guard = 0; guard < 1000000 && !pipeline.isFinished(); guard++) {
+        if (offset < file.size()) {
+            size_t length = file.size() - offset < chunk ? file.size() - offset : chunk;
+            offset += input.write(file.data() + offset, length);
+            if (offset == file.size()) {
+                input.close();
+            }
+        }
+        while (pipeline.decodeStep() == AudioPipeline::STEP_PROGRESS) {
+        }
+        size_t copied = pipeline.render(block.data(), block.size());
+        run.pcm.insert(run.pcm.end(), block.begin(), block.begin() + copied);
+    }
+    run.inputUnderruns = pipeline.getInputUnderruns();
+    run.outputUnderruns = pipeline.getOutputUnderruns();
+    run.failed = pipeline.hasFailed();
+    return run;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 16bitステレオはファイルのPCMがそのまま出てくる（チェックサムで照合）
+void test_wav_stereo_roundtrip_checksum(void) {
+    WavFixture fixture(44100, 2, 16, 20000);
+    PipelineRun run = runPipeline(fixture.file, 1024, 512);
+    TEST_ASSERT_FALSE(run.failed);
+    TEST_ASSERT_EQUAL(fixture.dataLength / 2, run.pcm.size());
+    TEST_ASSERT_EQUAL_HEX32(fnv1a(&fixture.file[fixture.dataOffset], fixture.dataLength),
+                            fnv1a(run.pcm.data(), run.pcm.size() * sizeof(int16_t)));
+}
+
+// 8bitモノラルは符号付き16bitに広げて左右に複製する
+void test_wav_mono_8bit_is_expanded(void) {
+    WavFixture fixture(22050, 1, 8, 5000);
+    PipelineRun run = runPipeline(fixture.file, 333, 256);
+    TEST_ASSERT_FALSE(run.failed);
+    std::vector<int16_t> expected;
+    for (size_t i = 0; i < fixture.dataLength; i++) {
+        int16_t value = static_cast<int16_t>((fixture.file[fixture.dataOffset + i] - 128) * 256);
+        expected.push_back(value);
+        expected.push_back(value);
+    }
+    TEST_ASSERT_EQUAL(expected.size(), run.pcm.size());
+    TEST_ASSERT_EQUAL_HEX32(fnv1a(expected.data(), expected.size() * 2),
+                            fnv1a(run.pcm.data(), run.pcm.size() * 2));
+}
+
+// 先読みが細いと入力・出力の途切れとして数える（データは欠けない）
+void test_underruns_are_counted(void) {
+    WavFixture fixture(44100, 2, 16, 8000);
+    PipelineRun starved = runPipeline(fixture.file, 64, 2048);
+    TEST_ASSERT_TRUE(starved.inputUnderruns > 0);
+    TEST_ASSERT_TRUE(starved.outputUnderruns > 0);
+    TEST_ASSERT_EQUAL(fixture.dataLength / 2, starved.pcm.size());
+
+    PipelineRun smooth = runPipeline(fixture.file, 4096, 256);
+    TEST_ASSERT_EQUAL(0, smooth.outputUnderruns);
+}
+
+// 壊れたヘッダーは打ち切って失敗にする
+void test_invalid_wav_fails(void) {
+    WavFixture fixture(44100, 2, 16, 100);
+    fixture.file[20] = 3;   // IEEE float
+    PipelineRun run = runPipeline(fixture.file, 1024, 256);
+    TEST_ASSERT_TRUE(run.failed);
+    TEST_ASSERT_EQUAL(0, run.pcm.size());
+}
+
+// Layer IIIのフレームヘッダーとID3v2タグの大きさ
+void test_mp3_frame_header(void) {
+    const uint8_t mpeg1[4] = {0xFF, 0xFB, 0x90, 0x64};     // 128kbps 44.1kHz ジョイントステレオ
+    Mp3FrameHeader header;
+    TEST_ASSERT_TRUE(Mp3Decoder::parseFrameHeader(mpeg1, header));
+    TEST_ASSERT_EQUAL(10, header.version);
+    TEST_ASSERT_EQUAL(128, header.bitrateKbps);
+    TEST_ASSERT_EQUAL(44100, header.sampleRate);
+    TEST_ASSERT_EQUAL(2, header.channels);
+    TEST_ASSERT_EQUAL(417, header.frameLength);
+    TEST_ASSERT_EQUAL(1152, header.samplesPerFrame);
+
+    const uint8_t mpeg2Mono[4] = {0xFF, 0xF3, 0x82, 0xC4};  // 64kbps 22.05kHz モノラル＋詰め物
+    TEST_ASSERT_TRUE(Mp3Decoder::parseFrameHeader(mpeg2Mono, header));
+    TEST_ASSERT_EQUAL(20, header.version);
+    TEST_ASSERT_EQUAL(22050, header.sampleRate);
+    TEST_ASSERT_EQUAL(1, header.channels);
+    TEST_ASSERT_EQUAL(209, header.frameLength);
+    TEST_ASSERT_EQUAL(576, header.samplesPerFrame);
+
+    const uint8_t layer2[4] = {0xFF, 0xFD, 0x90, 0x64};
+    TEST_ASSERT_FALSE(Mp3Decoder::parseFrameHeader(layer2, header));
+
+    const uint8_t tag[10] = {'I', 'D', '3', 4, 0, 0, 0, 0, 0x02, 0x01};
+    TEST_ASSERT_EQUAL(267, Mp3Decoder::id3v2TagSize(tag, sizeof(tag)));
+    const uint8_t notTag[10] = {'I', 'D', '4', 4, 0, 0, 0, 0, 0x02, 0x01};
+    TEST_ASSERT_EQUAL(0, Mp3Decoder::id3v2TagSize(notTag, sizeof(notTag)));
+}
+
+// タグとごみを読み飛ばして最初のフレームで同期する（復号はHelixがあるときだけ）
+void test_mp3_skips_tag_and_resyncs(void) {
+    std::vector<uint8_t> stream = {'I', 'D', '3', 3, 0, 0, 0, 0, 0, 20};
+    stream.resize(30, 0);
+    stream.insert(stream.end(), {0x12, 0x34, 0xFF, 0x00, 0x56});
+    const uint8_t header[4] = {0xFF, 0xFB, 0x90, 0x64};
+    stream.insert(stream.end(), header, header + 4);
+    stream.resize(stream.size() + 413, 0);
+
+    Mp3Decoder decoder;
+    int16_t pcm[AUDIO_MAX_FRAME_SAMPLES];
+    size_t offset = 0;
+    DecodeStatus status = DECODE_SKIPPED;
+    for (int guard = 0; guard < 100 && status == DECODE_SKIPPED; guard++) {
+        size_t consumed = 0;
+        size_t samples = 0;
+        status = decoder.decode(&stream[offset], stream.size() - offset, true, consumed, pcm, samples);
+        offset += consumed;
+        if (offset == 30 + 5) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL(35, offset);
+    TEST_ASSERT_EQUAL(5, decoder.getResyncBytes());
+    if (!Mp3Decoder::hasDecoder()) {
+        size_t consumed = 0;
+        size_t samples = 0;
+        TEST_ASSERT_EQUAL(DECODE_ERROR, decoder.decode(&stream[offset], stream.size() - offset, true,
+                                                       consumed, pcm, samples));
+        TEST_ASSERT_EQUAL(0, consumed);
+    }
+}
+
+// MP3を復号してチェックサムで照合する。使い回したデコーダーは前のストリームの状態
+// （ビットリザーバーやIMDCTの重ね合わせ）を引きずらず、新しいデコーダーと同じ結果になる
+void test_mp3_decode_checksum(void) {
+    if (!Mp3Decoder::hasDecoder()) {
+        TEST_IGNORE_MESSAGE("Helix MP3 decoder is not linked");
+    }
+    Mp3Fixture fixture(12);
+    Mp3Decoder reused;
+    PipelineRun first = runPipeline(fixture.file, 1024, 512, &reused);
+    TEST_ASSERT_FALSE(first.failed);
+    TEST_ASSERT_EQUAL(fixture.frames, reused.getFrameCount());
+    TEST_ASSERT_EQUAL(fixture.frames * 1152 * 2, first.pcm.size());
+    bool audible = false;
+    for (int16_t sample : first.pcm) {
+        audible = audible || sample != 0;
+    }
+    TEST_ASSERT_TRUE(audible);
+
+    PipelineRun again = runPipeline(fixture.file, 333, 256, &reused);
+    PipelineRun fresh = runPipeline(fixture.file, 777, 1024);
+    uint32_t checksum = fnv1a(first.pcm.data(), first.pcm.size() * 2);
+    TEST_ASSERT_EQUAL(first.pcm.size(), again.pcm.size());
+    TEST_ASSERT_EQUAL_HEX32(checksum, fnv1a(again.pcm.data(), again.pcm.size() * 2));
+    TEST_ASSERT_EQUAL(first.pcm.size(), fresh.pcm.size());
+    TEST_ASSERT_EQUAL_HEX32(checksum, fnv1a(fresh.pcm.data(), fresh.pcm.size() * 2));
+    printf("MP3 fixture: %u frames, checksum %08x\n", (unsigned)fixture.frames, (unsigned)checksum);
+}
+
+// 音のあるストリームの後に同じデコーダーで無音のストリームを復号すると、厳密に無音になる
+// （IMDCTの重ね合わせや合成フィルターの履歴が残っていれば先頭のグラニュールに漏れ出す）
+void test_mp3_reused_decoder_starts_from_silence(void) {
+    if (!Mp3Decoder::hasDecoder()) {
+        TEST_IGNORE_MESSAGE("Helix MP3 decoder is not linked");
+    }
+    Mp3Fixture audible(12);
+    Mp3Fixture silent(12, true);
+    Mp3Decoder reused;
+    PipelineRun first = runPipeline(audible.file, 1024, 512, &reused);
+    TEST_ASSERT_FALSE(first.failed);
+    PipelineRun run = runPipeline(silent.file, 1024, 512, &reused);
+    TEST_ASSERT_FALSE(run.failed);
+    TEST_ASSERT_EQUAL(12 * 1152 * 2, run.pcm.size());
+    // 12フレーム × 1152サンプル × 左右 × 2バイトの0のFNV-1a
+    TEST_ASSERT_EQUAL_HEX32(0x35C07DC5, fnv1a(run.pcm.data(), run.pcm.size() * 2));
+}
+
+// 復号のスループット（10秒分の44.1kHzステレオ）
+static void benchmark() {
+    WavFixture fixture(44100, 2, 16, 441000);
+    auto start = std::chrono::steady_clock::now();
+    PipelineRun run = runPipeline(fixture.file, 1024, 512);
+    auto end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count();
+    printf("BENCH audio pipeline: %u samples in %.0f us (%.1f MB/s, %.0fx realtime), checksum %08x\n",
+           (unsigned)run.pcm.size(), us, fixture.dataLength / us,
+           10.0e6 / us, (unsigned)fnv1a(run.pcm.data(), run.pcm.size() * 2));
+
+    // MP3（10秒分の44.1kHzモノラル128kbps）
+    if (!Mp3Decoder::hasDecoder()) {
+        printf("BENCH mp3 decode: skipped (Helix MP3 decoder is not linked)\n");
+        return;
+    }
+    Mp3Fixture mp3(44100 * 10 / 1152);
+    start = std::chrono::steady_clock::now();
+    PipelineRun decoded = runPipeline(mp3.file, 1024, 512);
+    end = std::chrono::steady_clock::now();
+    us = std::chrono::duration<double, std::micro>(end - start).count();
+    double seconds = mp3.frames * 1152 / 44100.0;
+    printf("BENCH mp3 decode: %u frames in %.0f us (%.1f us/frame, %.0fx realtime), checksum %08x\n",
+           (unsigned)mp3.frames, us, us / mp3.frames, seconds * 1.0e6 / us,
+           (unsigned)fnv1a(decoded.pcm.data(), decoded.pcm.size() * 2));
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_wav_stereo_roundtrip_checksum);
+    RUN_TEST(test_wav_mono_8bit_is_expanded);
+    RUN_TEST(test_underruns_are_counted);
+    RUN_TEST(test_invalid_wav_fails);
+    RUN_TEST(test_mp3_frame_header);
+    RUN_TEST(test_mp3_skips_tag_and_resyncs);
+    RUN_TEST(test_mp3_decode_checksum);
+    RUN_TEST(test_mp3_reused_decoder_starts_from_silence);
+    benchmark();
+    return UNITY_END();
+}
@@ -0,0 +1,162 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include "../../../src/shared/Delegate.h"
+
+// ヒープ確保回数をカウントする
+static size_t g_allocCount = 0;
+
+void* operator new(size_t size) {
+    g_allocCount++;
+    void* p = std::malloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+typedef Delegate<void()> Callback;
+typedef Delegate<void(), 3 * sizeof(void*)> WideCallback;
+
+// Delegate自体もmemcpyで移動できること
+static_assert(std::is_trivially_copyable<Callback>::value, "Delegate must be trivially relocatable");
+
+static int g_counter = 0;
+static void freeFunction() { g_counter++; }
+
+// 最適化で呼び出しが消えないよう、呼び出しは非インライン関数を経由する
+__attribute__((noinline)) static void callDelegate(const Callback& cb) { cb(); }
+__attribute__((noinline)) static void callWideDelegate(const WideCallback& cb) { cb(); }
+__attribute__((noinline)) static void callFunction(const std::function<void()>& cb) { cb(); }
+
+void setUp(void) {
+    g_counter = 0;
+}
+
+void tearDown(void) {
+}
+
+void test_invokes_lambda_and_function_pointer(void) {
+    int value = 0;
+    int* ptr = &value;
+    Callback lambda = [ptr]() { (*ptr) += 2; };
+    Callback function = &freeFunction;
+    Callback empty;
+
+    lambda();
+    function();
+    TEST_ASSERT_EQUAL(2, value);
+    TEST_ASSERT_EQUAL(1, g_counter);
+    TEST_ASSERT_FALSE(static_cast<bool>(empty));
+}
+
+void test_return_value_and_arguments(void) {
+    int base = 10;
+    Delegate<int(int, int)> add = [base](int a, int b) { return base + a + b; };
+    TEST_ASSERT_EQUAL(15, add(2, 3));
+}
+
+// コピー・代入で確保しないこと（容量いっぱいのキャプチャでも）
+// 実際のボタン構築（ButtonSet・applyButtonDef）は実機のtest_button_setで確かめる
+void test_copy_does_not_allocate(void) {
+    int value = 0;
+    int* ptr = &value;
+    size_t before = g_allocCount;
+    Callback original = [ptr]() { (*ptr)++; };
+    Callback copies[8];
+    for (Callback& copy : copies) {
+        copy = original;
+    }
+    int base = 100;
+    Delegate<int(int)> full = [ptr, base](int add) { return *ptr + base + add; };     // ポインタ2個分
+    Delegate<int(int)> fullCopy = full;
+    for (const Callback& copy : copies) {
+        copy();
+    }
+    TEST_ASSERT_EQUAL(0, g_allocCount - before);
+    TEST_ASSERT_EQUAL(8, value);
+    TEST_ASSERT_EQUAL(110, fullCopy(2));
+}
+
+// std::functionとの比較ベンチマーク（構築＋呼び出し）
+// 同じキャプチャで比べる。ポインタ2個分ならlibstdc++のstd::functionも内部に収める（SBO 16バイト）ので、
+// 差は呼び出しの仕組みだけ。3個にするとstd::functionは構築のたびに確保するので別に示す
+template <typename Make, typename Call>
+static long long timeLoop(int iterations, Make make, Call call) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        call(make());
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void test_benchmark_against_std_function(void) {
+    const int iterations = 2000000;
+    int* counter = &g_counter;
+    int* other = &g_counter;
+    int extra = 1;
+
+    // キャプチャ2個（どちらも確保なし）
+    size_t before = g_allocCount;
+    long long delegateNs = timeLoop(iterations,
+        [=]() { return Callback([counter, extra]() { *counter += extra; }); },
+        [](const Callback& cb) { callDelegate(cb); });
+    size_t delegateAllocs = g_allocCount - before;
+    before = g_allocCount;
+    long long functionNs = timeLoop(iterations,
+        [=]() { return std::function<void()>([counter, extra]() { *counter += extra; }); },
+        [](const std::function<void()>& cb) { callFunction(cb); });
+    size_t functionAllocs = g_allocCount - before;
+
+    // キャプチャ3個（std::functionはSBOを超えて確保する）
+    before = g_allocCount;
+    long long wideDelegateNs = timeLoop(iterations,
+        [=]() { return WideCallback([counter, other, extra]() { *counter += extra; (void)other; }); },
+        [](const WideCallback& cb) { callWideDelegate(cb); });
+    size_t wideDelegateAllocs = g_allocCount - before;
+    before = g_allocCount;
+    long long wideFunctionNs = timeLoop(iterations,
+        [=]() { return std::function<void()>([counter, other, extra]() { *counter += extra; (void)other; }); },
+        [](const std::function<void()>& cb) { callFunction(cb); });
+    size_t wideFunctionAllocs = g_allocCount - before;
+
+    char message[160];
+    snprintf(message, sizeof(message),
+             "construct+call, 2 captures: Delegate %.2f ns (%u allocations), std::function %.2f ns (%u allocations)",
+             static_cast<double>(delegateNs) / iterations, (unsigned)delegateAllocs,
+             static_cast<double>(functionNs) / iterations, (unsigned)functionAllocs);
+    TEST_MESSAGE(message);
+    snprintf(message, sizeof(message),
+             "construct+call, 3 captures: Delegate %.2f ns (%u allocations), std::function %.2f ns (%u allocations)",
+             static_cast<double>(wideDelegateNs) / iterations, (unsigned)wideDelegateAllocs,
+             static_cast<double>(wideFunctionNs) / iterations, (unsigned)wideFunctionAllocs);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL(4 * iterations, g_counter);
+    TEST_ASSERT_EQUAL(0, delegateAllocs);
+    TEST_ASSERT_EQUAL(0, wideDelegateAllocs);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+
+    RUN_TEST(test_invokes_lambda_and_function_pointer);
+    RUN_TEST(test_return_value_and_arguments);
+    RUN_TEST(test_copy_does_not_allocate);
+    RUN_TEST(test_benchmark_against_std_function);
+
+    return UNITY_END();
+}
@@ -0,0 +1,268 @@
+#include <unity.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "../../../src/audio/DspChain.cpp"
+
+static const uint32_t RATE = 44100;
+// 実機の出力タスクと同じブロック
+static const size_t BLOCK_FRAMES = 64;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 正弦波（左右同じ）をブロックごとに通し、過渡を捨てた後半のRMSの比（dB）を返す
+static double measureGainDb(DspChain& dsp, double frequency, double amplitude) {
+    const size_t total = RATE / 2;
+    const size_t settle = RATE / 4;
+    std::vector<int16_t> block(BLOCK_FRAMES * 2);
+    double sumIn = 0;
+    double sumOut = 0;
+    for (size_t start = 0; start < total; start += BLOCK_FRAMES) {
+        for (size_t i = 0; i < BLOCK_FRAMES; i++) {
+            double x = amplitude * std::sin(2.0 * M_PI * frequency * (start + i) / RATE);
+            int16_t sample = static_cast<int16_t>(std::lround(x));
+            block[i * 2] = sample;
+            block[i * 2 + 1] = sample;
+            if (start + i >= settle) {
+                sumIn += static_cast<double>(sample) * sample;
+            }
+        }
+        dsp.process(block.data(), BLOCK_FRAMES);
+        for (size_t i = 0; i < BLOCK_FRAMES; i++) {
+            if (start + i >= settle) {
+                sumOut += static_cast<double>(block[i * 2]) * block[i * 2];
+            }
+        }
+    }
+    return 10.0 * std::log10(sumOut / sumIn);
+}
+
+static DspSettings flatSettings() {
+    DspSettings settings = DspChain::defaultSettings();
+    settings.limiter = false;
+    return settings;
+}
+
+// 全帯域0dB・音量0dBなら入力がそのまま出る
+void test_flat_settings_pass_through(void) {
+    DspChain dsp;
+    dsp.requestSettings(flatSettings());
+    TEST_ASSERT_TRUE(dsp.update(RATE));
+    int16_t block[BLOCK_FRAMES * 2];
+    for (size_t i = 0; i < BLOCK_FRAMES * 2; i++) {
+        block[i] = static_cast<int16_t>((i * 7919) % 65536 - 32768);
+    }
+    int16_t expected[BLOCK_FRAMES * 2];
+    memcpy(expected, block, sizeof(block));
+    dsp.process(block, BLOCK_FRAMES);
+    TEST_ASSERT_EQUAL_MEMORY(expected, block, sizeof(block));
+}
+
+// 低音を+12dBにすると50Hzは約+12dB、10kHzはほぼそのまま
+void test_low_shelf_frequency_response(void) {
+    DspChain dsp;
+    DspSettings settings = flatSettings();
+    settings.eqDb[0] = 12;
+    dsp.requestSettings(settings);
+    dsp.update(RATE);
+    TEST_ASSERT_FLOAT_WITHIN(0.8, 12.0, measureGainDb(dsp, 50, 4000));
+    TEST_ASSERT_FLOAT_WITHIN(0.3, 0.0, measureGainDb(dsp, 10000, 4000));
+}
+
+// 中音を-12dBにすると1kHzが中心で下がり、両側は戻る
+void test_peaking_frequency_response(void) {
+    DspChain dsp;
+    DspSettings settings = flatSettings();
+    settings.eqDb[1] = -12;
+    dsp.requestSettings(settings);
+    dsp.update(RATE);
+    TEST_ASSERT_FLOAT_WITHIN(0.3, -12.0, measureGainDb(dsp, 1000, 8000));
+    TEST_ASSERT_FLOAT_WITHIN(1.0, 0.0, measureGainDb(dsp, 60, 8000));
+    TEST_ASSERT_FLOAT_WITHIN(1.0, 0.0, measureGainDb(dsp, 15000, 8000));
+}
+
+// 高音を+12dBにしても係数が縮めて持たれ、15kHzで約+12dBになる
+void test_high_shelf_frequency_response(void) {
+    DspChain::Biquad biquad = DspChain::design(DspChain::BAND_HIGH_SHELF, RATE, 6000, 0.707, 12);
+    TEST_ASSERT_GREATER_THAN(0, biquad.postShift);
+    DspChain dsp;
+    DspSettings settings = flatSettings();
+    settings.eqDb[2] = 12;
+    dsp.requestSettings(settings);
+    dsp.update(RATE);
+    TEST_ASSERT_FLOAT_WITHIN(1.0, 12.0, measureGainDb(dsp, 15000, 2000));
+    TEST_ASSERT_FLOAT_WITHIN(0.3, 0.0, measureGainDb(dsp, 100, 2000));
+}
+
+// 音量は指定したdBだけ下がる
+void test_volume(void) {
+    DspChain dsp;
+    DspSettings settings = flatSettings();
+    settings.volumeDb = -6;
+    dsp.requestSettings(settings);
+    dsp.update(RATE);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, -6.0, measureGainDb(dsp, 440, 16000));
+}
+
+// EQで持ち上げて振り切れる信号も、リミッターがしきい値以下に収める
+void test_limiter_keeps_peak_below_threshold(void) {
+    DspChain dsp;
+    DspSettings settings = flatSettings();
+    settings.eqDb[0] = 12;
+    settings.limiter = true;
+    dsp.requestSettings(settings);
+    dsp.update(RATE);
+    const int16_t threshold = static_cast<int16_t>(32768 * std::pow(10.0, DSP_LIMITER_THRESHOLD_DB / 20.0)) + 1;
+    int16_t block[BLOCK_FRAMES * 2];
+    int16_t peak = 0;
+    for (size_t start = 0; start < RATE; start += BLOCK_FRAMES) {
+        for (size_t i = 0; i < BLOCK_FRAMES; i++) {
+            int16_t sample = static_cast<int16_t>(std::lround(20000 * std::sin(2.0 * M_PI * 80 * (start + i) / RATE)));
+            block[i * 2] = sample;
+            block[i * 2 + 1] = sample;
+        }
+        dsp.process(block, BLOCK_FRAMES);
+        for (size_t i = 0; i < BLOCK_FRAMES * 2; i++) {
+            int16_t magnitude = block[i] < 0 ? -block[i] : block[i];
+            peak = magnitude > peak ? magnitude : peak;
+        }
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(threshold, peak);
+    TEST_ASSERT_GREATER_THAN(0, dsp.getLimitedBlocks());
+    TEST_ASSERT_LESS_THAN(0, dsp.getLimiterGainDeciDb());
+}
+
+// 利得を下げるときも、しきい値を超えるまでのフレームは元の利得から滑らかに下げる
+// （ブロックの先頭で段差を作らない）
+void test_limiter_attack_ramps_within_block(void) {
+    DspChain dsp;
+    DspSettings settings = flatSettings();
+    settings.limiter = true;
+    dsp.requestSettings(settings);
+    dsp.update(RATE);
+    const int16_t threshold = static_cast<int16_t>(32768 * std::pow(10.0, DSP_LIMITER_THRESHOLD_DB / 20.0)) + 1;
+    int16_t block[BLOCK_FRAMES * 2];
+    const size_t loudFrom = BLOCK_FRAMES / 2;
+    for (size_t i = 0; i < BLOCK_FRAMES; i++) {
+        int16_t sample = i < loudFrom ? 8000 : 32767;
+        block[i * 2] = sample;
+        block[i * 2 + 1] = sample;
+    }
+    dsp.process(block, BLOCK_FRAMES);
+    TEST_ASSERT_INT_WITHIN(1, 8000, block[0]);
+    for (size_t i = 1; i < BLOCK_FRAMES; i++) {
+        if (i < loudFrom) {
+            TEST_ASSERT_LESS_OR_EQUAL(block[(i - 1) * 2], block[i * 2]);
+        }
+        TEST_ASSERT_LESS_OR_EQUAL(threshold, block[i * 2]);
+    }
+    TEST_ASSERT_TRUE(block[(loudFrom - 1) * 2] < 8000);
+    TEST_ASSERT_LESS_THAN(0, dsp.getLimiterGainDeciDb());
+}
+
+// 設定は1語に詰めて受け渡す（範囲の端も往復で変わらない）
+void test_settings_pack_into_one_word(void) {
+    DspChain dsp;
+    DspSettings settings;
+    settings.volumeDb = DSP_VOLUME_MIN_DB;
+    settings.eqDb[0] = -DSP_EQ_RANGE_DB;
+    settings.eqDb[1] = DSP_EQ_RANGE_DB;
+    settings.eqDb[2] = -1;
+    settings.limiter = false;
+    dsp.requestSettings(settings);
+    TEST_ASSERT_TRUE(dsp.getRequestedSettings() == settings);
+    settings.limiter = true;
+    settings.eqDb[2] = 1;
+    dsp.requestSettings(settings);
+    TEST_ASSERT_TRUE(dsp.getRequestedSettings() == settings);
+}
+
+// 係数は設定かレートが変わったときだけ作り直し、出力側は新しい面を1回だけ受け取る
+void test_recompute_only_on_change(void) {
+    DspChain dsp;
+    int16_t block[BLOCK_FRAMES * 2] = {};
+    TEST_ASSERT_TRUE(dsp.update(RATE));
+    TEST_ASSERT_FALSE(dsp.update(RATE));
+    dsp.process(block, BLOCK_FRAMES);
+    dsp.process(block, BLOCK_FRAMES);
+    TEST_ASSERT_EQUAL_UINT32(1, dsp.getSwapCount());
+
+    DspSettings settings = dsp.getRequestedSettings();
+    settings.eqDb[2] = 4;
+    dsp.requestSettings(settings);
+    TEST_ASSERT_TRUE(dsp.update(RATE));
+    TEST_ASSERT_TRUE(dsp.update(48000));
+    TEST_ASSERT_FALSE(dsp.update(48000));
+    TEST_ASSERT_EQUAL_UINT32(3, dsp.getRecomputeCount());
+    // 2回作り直しても出力側が受け取るのは最新の1面
+    dsp.process(block, BLOCK_FRAMES);
+    dsp.process(block, BLOCK_FRAMES);
+    TEST_ASSERT_EQUAL_UINT32(2, dsp.getSwapCount());
+    TEST_ASSERT_EQUAL(4, dsp.getRequestedSettings().eqDb[2]);
+}
+
+static uint64_t cycleCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static void benchmark() {
+    // 3帯域すべて有効・リミッターありの最悪の設定
+    DspChain dsp;
+    DspSettings settings = DspChain::defaultSettings();
+    settings.volumeDb = -4;
+    settings.eqDb[0] = 6;
+    settings.eqDb[1] = -4;
+    settings.eqDb[2] = 8;
+    dsp.requestSettings(settings);
+    dsp.update(RATE);
+    std::vector<int16_t> block(BLOCK_FRAMES * 2);
+    for (size_t i = 0; i < BLOCK_FRAMES; i++) {
+        int16_t sample = static_cast<int16_t>(std::lround(24000 * std::sin(2.0 * M_PI * 440 * i / RATE)));
+        block[i * 2] = sample;
+        block[i * 2 + 1] = sample;
+    }
+    const int blocks = 50000;
+    uint64_t startCycles = cycleCounter();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < blocks; i++) {
+        dsp.process(block.data(), BLOCK_FRAMES);
+    }
+    auto end = std::chrono::steady_clock::now();
+    uint64_t cycles = cycleCounter() - startCycles;
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    double samples = static_cast<double>(blocks) * BLOCK_FRAMES * 2;
+    printf("BENCH dsp chain: %.1f ns per sample", ns / samples);
+    if (cycles > 0) {
+        printf(", %.1f cycles per sample (TSC)", cycles / samples);
+    }
+    printf(", %.2f%% of real time at 44.1kHz stereo\n", ns / blocks / (BLOCK_FRAMES * 1e9 / RATE) * 100.0);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_flat_settings_pass_through);
+    RUN_TEST(test_low_shelf_frequency_response);
+    RUN_TEST(test_peaking_frequency_response);
+    RUN_TEST(test_high_shelf_frequency_response);
+    RUN_TEST(test_volume);
+    RUN_TEST(test_limiter_keeps_peak_below_threshold);
+    RUN_TEST(test_limiter_attack_ramps_within_block);
+    RUN_TEST(test_settings_pack_into_one_word);
+    RUN_TEST(test_recompute_only_on_change);
+    benchmark();
+    return UNITY_END();
+}
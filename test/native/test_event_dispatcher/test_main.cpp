@@ -0,0 +1,113 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include "../../../src/shared/EventDispatcher.h"
+
+// 受信回数を数える擬似購読者
+struct Counter {
+    int calls;
+    int lastX;
+    const Event* lastEvent;
+    Counter() : calls(0), lastX(0), lastEvent(nullptr) {}
+    void onEvent(const Event& event) {
+        calls++;
+        lastX = event.touch().x;
+        lastEvent = &event;
+    }
+};
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 種別はコンパイル時にトピックへ対応付けられる
+void test_topic_mapping(void) {
+    TEST_ASSERT_EQUAL(TOPIC_TOUCH, topicOf(EVENT_TOUCH_DOWN));
+    TEST_ASSERT_EQUAL(TOPIC_TOUCH, topicOf(EVENT_TOUCH_UP));
+    TEST_ASSERT_EQUAL(TOPIC_GESTURE, topicOf(EVENT_GESTURE_SWIPE));
+    TEST_ASSERT_EQUAL(TOPIC_NAVIGATION, topicOf(EVENT_SCREEN_CHANGE));
+    TEST_ASSERT_EQUAL(TOPIC_SYSTEM, topicOf(EVENT_SHOW_RESET_MESSAGE));
+}
+
+// トピックの購読者だけが呼ばれ、イベントはコピーされずに渡される
+void test_dispatch_reaches_only_interested_subscribers(void) {
+    EventDispatcher dispatcher;
+    Counter touch, navigation;
+    dispatcher.subscribe(TOPIC_TOUCH, &touch, [&touch](const Event& e) { touch.onEvent(e); });
+    dispatcher.subscribe(TOPIC_NAVIGATION, &navigation, [&navigation](const Event& e) { navigation.onEvent(e); });
+
+    Event move = makeTouchEvent(EVENT_TOUCH_MOVE, 42, 7, 0, 0, 0);
+    TEST_ASSERT_TRUE(dispatcher.dispatch(move));
+    TEST_ASSERT_EQUAL(1, touch.calls);
+    TEST_ASSERT_EQUAL(42, touch.lastX);
+    TEST_ASSERT_EQUAL_PTR(&move, touch.lastEvent);
+    TEST_ASSERT_EQUAL(0, navigation.calls);
+
+    TEST_ASSERT_FALSE(dispatcher.dispatch(makeGestureEvent(GestureEvent::GESTURE_UP, 0, 0, 0, 0, 0)));
+    TEST_ASSERT_EQUAL(1, dispatcher.getUnhandledCount());
+}
+
+// 登録順に呼ばれ、解除は所有者単位で順序を保つ
+void test_unsubscribe_by_owner_keeps_order(void) {
+    EventDispatcher dispatcher;
+    int order[3] = {0, 0, 0};
+    int next = 0;
+    int a = 0, b = 0, c = 0;
+    int* pOrder = order;
+    int* pNext = &next;
+    dispatcher.subscribe(TOPIC_GESTURE, &a, [pOrder, pNext](const Event&) { pOrder[(*pNext)++] = 1; });
+    dispatcher.subscribe(TOPIC_GESTURE, &b, [pOrder, pNext](const Event&) { pOrder[(*pNext)++] = 2; });
+    dispatcher.subscribe(TOPIC_GESTURE, &c, [pOrder, pNext](const Event&) { pOrder[(*pNext)++] = 3; });
+
+    dispatcher.unsubscribe(&b);
+    TEST_ASSERT_EQUAL(2, dispatcher.getSubscriberCount(TOPIC_GESTURE));
+    dispatcher.dispatch(makeGestureEvent(GestureEvent::GESTURE_LEFT, 0, 0, 0, 0, 0));
+    TEST_ASSERT_EQUAL(2, next);
+    TEST_ASSERT_EQUAL(1, order[0]);
+    TEST_ASSERT_EQUAL(3, order[1]);
+}
+
+// 購読表は固定長で、満杯ならfalse
+void test_subscriber_table_is_bounded(void) {
+    EventDispatcher dispatcher;
+    int owner = 0;
+    for (int i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++) {
+        TEST_ASSERT_TRUE(dispatcher.subscribe(TOPIC_SYSTEM, &owner, [](const Event&) {}));
+    }
+    TEST_ASSERT_FALSE(dispatcher.subscribe(TOPIC_SYSTEM, &owner, [](const Event&) {}));
+}
+
+// 配信コストは購読者数に比例し、関係のない種別の数には依存しない
+void test_dispatch_cost(void) {
+    EventDispatcher dispatcher;
+    Counter counter;
+    dispatcher.subscribe(TOPIC_TOUCH, &counter, [&counter](const Event& e) { counter.onEvent(e); });
+    for (int i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS - 1; i++) {
+        dispatcher.subscribe(TOPIC_SYSTEM, &counter, [](const Event&) {});
+    }
+
+    const int iterations = 1000000;
+    Event move = makeTouchEvent(EVENT_TOUCH_MOVE, 1, 1, 0, 0, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        dispatcher.dispatch(move);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT_EQUAL(iterations, counter.calls);
+    printf("dispatch to 1 of %d subscribers: %.1f ns/event\n",
+           EVENT_BUS_MAX_SUBSCRIBERS, static_cast<double>(elapsed) / iterations);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_topic_mapping);
+    RUN_TEST(test_dispatch_reaches_only_interested_subscribers);
+    RUN_TEST(test_unsubscribe_by_owner_keeps_order);
+    RUN_TEST(test_subscriber_table_is_bounded);
+    RUN_TEST(test_dispatch_cost);
+    return UNITY_END();
+}
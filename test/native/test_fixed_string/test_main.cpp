@@ -0,0 +1,132 @@
+#include <unity.h>
+#include "../../../src/shared/FixedString.h"
+
+// UTF-8の例（2・3・4バイトの文字）
+static const char TWO[] = "x\xC3\xA9";              // "xé"
+static const char THREE[] = "a\xE3\x81\x82";        // "aあ"
+static const char FOUR[] = "b\xF0\x9F\x98\x80";     // "b😀"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 文字の途中で切れたら、その文字ごと落とす
+void test_truncation_inside_multibyte_sequences(void) {
+    TEST_ASSERT_EQUAL(3, utf8TruncatedLength(TWO, 3));
+    TEST_ASSERT_EQUAL(1, utf8TruncatedLength(TWO, 2));
+
+    TEST_ASSERT_EQUAL(4, utf8TruncatedLength(THREE, 4));
+    TEST_ASSERT_EQUAL(1, utf8TruncatedLength(THREE, 3));
+    TEST_ASSERT_EQUAL(1, utf8TruncatedLength(THREE, 2));
+
+    TEST_ASSERT_EQUAL(5, utf8TruncatedLength(FOUR, 5));
+    TEST_ASSERT_EQUAL(1, utf8TruncatedLength(FOUR, 4));
+    TEST_ASSERT_EQUAL(1, utf8TruncatedLength(FOUR, 3));
+    TEST_ASSERT_EQUAL(1, utf8TruncatedLength(FOUR, 2));
+
+    // ASCIIだけなら切った位置のまま
+    TEST_ASSERT_EQUAL(2, utf8TruncatedLength("abc", 2));
+    TEST_ASSERT_EQUAL(0, utf8TruncatedLength("", 0));
+}
+
+// 先頭バイトのない継続バイトは落とす
+void test_stray_continuation_bytes_are_dropped(void) {
+    TEST_ASSERT_EQUAL(1, utf8TruncatedLength("a\x80", 2));
+    TEST_ASSERT_EQUAL(0, utf8TruncatedLength("\x80\x80", 2));
+
+    FixedString<16> text("ok\x80");
+    TEST_ASSERT_EQUAL(2, text.size());
+    TEST_ASSERT_EQUAL_STRING("ok", text.c_str());
+    TEST_ASSERT_FALSE(text.hasMultibyte());
+}
+
+// 容量を超える代入・追加は文字境界で切り詰める
+void test_assign_and_append_truncate_on_character_boundary(void) {
+    FixedString<8> text("\xE3\x81\x82\xE3\x81\x84\xE3\x81\x86");     // "あいう"（9バイト）
+    TEST_ASSERT_EQUAL(6, text.size());
+    TEST_ASSERT_EQUAL_STRING("\xE3\x81\x82\xE3\x81\x84", text.c_str());
+    TEST_ASSERT_TRUE(text.hasMultibyte());
+
+    FixedString<8> mixed("abcde");
+    mixed.append("\xE3\x81\x82");      // 3バイト目が入らない
+    TEST_ASSERT_EQUAL_STRING("abcde", mixed.c_str());
+    TEST_ASSERT_FALSE(mixed.hasMultibyte());
+}
+
+// 整形が溢れたら切り詰め、戻り値は整形に要る長さ（vsnprintfと同じ）
+void test_format_overflow(void) {
+    FixedString<8> text;
+    TEST_ASSERT_EQUAL(10, text.format("%s", "abcdefghij"));
+    TEST_ASSERT_EQUAL(7, text.size());
+    TEST_ASSERT_EQUAL_STRING("abcdefg", text.c_str());
+
+    // 溢れた位置がマルチバイト文字の途中なら、その文字ごと落とす
+    text.format("abcde%s", "\xE3\x81\x82");
+    TEST_ASSERT_EQUAL_STRING("abcde", text.c_str());
+    TEST_ASSERT_FALSE(text.hasMultibyte());
+
+    // 切り詰めた内容でハッシュを取り直している
+    FixedString<32> expected("abcde");
+    TEST_ASSERT_EQUAL_HEX32(expected.hash(), text.hash());
+}
+
+void test_append_format_overflow(void) {
+    FixedString<8> text("abc");
+    TEST_ASSERT_EQUAL(6, text.appendFormat("%d", 123456));
+    TEST_ASSERT_EQUAL_STRING("abc1234", text.c_str());
+    TEST_ASSERT_EQUAL(7, text.size());
+
+    // 満杯なら何も足さない
+    text.appendFormat("%s", "z");
+    TEST_ASSERT_EQUAL_STRING("abc1234", text.c_str());
+
+    FixedString<8> japanese("ab");
+    japanese.appendFormat("%s%s", "\xE3\x81\x82", "\xE3\x81\x84");      // 2文字目は入らない
+    TEST_ASSERT_EQUAL_STRING("ab\xE3\x81\x82", japanese.c_str());
+    TEST_ASSERT_TRUE(japanese.hasMultibyte());
+}
+
+// 容量の違う文字列どうしも内容で比べる
+void test_equality_across_capacities(void) {
+    FixedString<8> small("abc");
+    FixedString<64> large("abc");
+    TEST_ASSERT_TRUE(small == large);
+    TEST_ASSERT_TRUE(large == small);
+    TEST_ASSERT_FALSE(small != large);
+
+    large = "abd";
+    TEST_ASSERT_TRUE(small != large);
+    large = "abcd";
+    TEST_ASSERT_TRUE(small != large);
+
+    // 切り詰められた結果が同じなら等しい
+    FixedString<4> truncated("abcdef");
+    FixedString<16> prefix("abc");
+    TEST_ASSERT_TRUE(truncated == prefix);
+
+    // 大文字にしたらハッシュも変わる
+    small.toUpperAscii();
+    FixedString<16> upper("ABC");
+    TEST_ASSERT_TRUE(small == upper);
+    TEST_ASSERT_FALSE(small == prefix);
+
+    FixedString<8> empty;
+    FixedString<32> cleared("x");
+    cleared.clear();
+    TEST_ASSERT_TRUE(empty == cleared);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_truncation_inside_multibyte_sequences);
+    RUN_TEST(test_stray_continuation_bytes_are_dropped);
+    RUN_TEST(test_assign_and_append_truncate_on_character_boundary);
+    RUN_TEST(test_format_overflow);
+    RUN_TEST(test_append_format_overflow);
+    RUN_TEST(test_equality_across_capacities);
+    return UNITY_END();
+}
@@ -0,0 +1,185 @@
+#include <unity.h>
+#include <cstdio>
+#include "../../../src/core/FrameScheduler.h"
+
+// テスト用の時計（処理のコストはこの値を進めて表す）
+static uint32_t g_nowUs = 0;
+
+static uint32_t fakeClock() {
+    return g_nowUs;
+}
+
+// 1フレームを模擬: 描画にrenderUsかかり、残りで後回しの処理を進める
+static uint32_t runFrame(FrameScheduler& scheduler, uint32_t renderUs) {
+    uint32_t start = g_nowUs;
+    scheduler.beginFrame();
+    g_nowUs += renderUs;
+    scheduler.runDeferred();
+    scheduler.endFrame();
+    uint32_t used = g_nowUs - start;
+    g_nowUs = start + (used > FRAME_PERIOD_US ? used : FRAME_PERIOD_US);
+    return used;
+}
+
+// 1ステップごとにcostUsかかり、steps回で完了する処理
+struct CostlyJob {
+    uint32_t costUs;
+    int steps;
+    int* log;
+    int id;
+    int* order;
+    bool operator()() {
+        g_nowUs += costUs;
+        if (order) {
+            *order = *order * 10 + id;
+        }
+        return --steps <= 0;
+    }
+};
+
+static JobStep stepOf(CostlyJob& job) {
+    CostlyJob* target = &job;
+    return JobStep([target]() { return (*target)(); });
+}
+
+void setUp(void) {
+    g_nowUs = 1000;
+}
+
+void tearDown(void) {
+}
+
+// 描画の後、予算の残りだけ処理を進める
+void test_jobs_fill_remaining_budget(void) {
+    FrameScheduler scheduler(&fakeClock, 12000);
+    CostlyJob job = {1000, 100, nullptr, 1, nullptr};
+    TEST_ASSERT_TRUE(scheduler.post(&job, "slices", JOB_PRIORITY_NORMAL, 0, stepOf(job)));
+
+    uint32_t used = runFrame(scheduler, 5000);
+    TEST_ASSERT_TRUE(used <= 12000);
+    TEST_ASSERT_EQUAL(7, scheduler.getStepCount());
+    TEST_ASSERT_EQUAL(5000, scheduler.getLastRenderUs());
+    TEST_ASSERT_EQUAL(7000, scheduler.getLastJobUs());
+    TEST_ASSERT_EQUAL(100, scheduler.getLastUtilization());
+    TEST_ASSERT_EQUAL(0, scheduler.getOverBudgetFrames());
+}
+
+// 優先度の高いものから、同じ優先度なら期限の近いものから実行する
+void test_priority_then_deadline_order(void) {
+    FrameScheduler scheduler(&fakeClock, 12000);
+    int order = 0;
+    CostlyJob low = {100, 1, nullptr, 1, &order};
+    CostlyJob normalLate = {100, 1, nullptr, 2, &order};
+    CostlyJob normalSoon = {100, 1, nullptr, 3, &order};
+    CostlyJob high = {100, 1, nullptr, 4, &order};
+    scheduler.post(&low, "low", JOB_PRIORITY_LOW, 0, stepOf(low));
+    scheduler.post(&normalLate, "late", JOB_PRIORITY_NORMAL, 500, stepOf(normalLate));
+    scheduler.post(&normalSoon, "soon", JOB_PRIORITY_NORMAL, 50, stepOf(normalSoon));
+    scheduler.post(&high, "high", JOB_PRIORITY_HIGH, 0, stepOf(high));
+
+    runFrame(scheduler, 1000);
+    TEST_ASSERT_EQUAL(4321, order);
+    TEST_ASSERT_EQUAL(4, scheduler.getCompletedJobs());
+    TEST_ASSERT_EQUAL(0, scheduler.getPendingCount());
+}
+
+// 長いステップは次のフレームに回り、期限を過ぎたら予算外でも1ステップ進める
+void test_overdue_job_runs_and_counts_miss(void) {
+    FrameScheduler scheduler(&fakeClock, 12000);
+    CostlyJob slow = {20000, 3, nullptr, 1, nullptr};
+    scheduler.post(&slow, "slow", JOB_PRIORITY_NORMAL, 30, stepOf(slow));
+
+    runFrame(scheduler, 1000);      // 見積もりがないので1回目は実行される
+    TEST_ASSERT_EQUAL(1, scheduler.getStepCount());
+    TEST_ASSERT_EQUAL(1, scheduler.getOverBudgetFrames());
+
+    runFrame(scheduler, 1000);      // 20msは残り11msに収まらないので見送り
+    TEST_ASSERT_EQUAL(1, scheduler.getStepCount());
+
+    for (int i = 0; i < 4; i++) {
+        runFrame(scheduler, 1000);
+    }
+    TEST_ASSERT_EQUAL(0, scheduler.getPendingCount());
+    TEST_ASSERT_EQUAL(1, scheduler.getMissedDeadlines());
+}
+
+// 期限なしの長いステップも見積もりの減衰でいずれ実行される
+void test_long_step_without_deadline_is_not_starved(void) {
+    FrameScheduler scheduler(&fakeClock, 12000);
+    CostlyJob slow = {30000, 2, nullptr, 1, nullptr};
+    scheduler.post(&slow, "slow", JOB_PRIORITY_LOW, 0, stepOf(slow));
+    int frames = 0;
+    while (scheduler.getPendingCount() > 0 && frames < 50) {
+        runFrame(scheduler, 1000);
+        frames++;
+    }
+    TEST_ASSERT_EQUAL(0, scheduler.getPendingCount());
+    TEST_ASSERT_EQUAL(0, scheduler.getMissedDeadlines());
+}
+
+// 取り消しと表の上限
+void test_cancel_and_capacity(void) {
+    FrameScheduler scheduler(&fakeClock, 12000);
+    CostlyJob jobs[FRAME_SCHEDULER_MAX_JOBS + 1];
+    for (size_t i = 0; i <= FRAME_SCHEDULER_MAX_JOBS; i++) {
+        jobs[i] = CostlyJob{100, 1, nullptr, 0, nullptr};
+    }
+    for (size_t i = 0; i < FRAME_SCHEDULER_MAX_JOBS; i++) {
+        TEST_ASSERT_TRUE(scheduler.post(&jobs[0], "fill", JOB_PRIORITY_LOW, 0, stepOf(jobs[i])));
+    }
+    TEST_ASSERT_FALSE(scheduler.post(&jobs[0], "full", JOB_PRIORITY_LOW, 0, stepOf(jobs[FRAME_SCHEDULER_MAX_JOBS])));
+    TEST_ASSERT_EQUAL(1, scheduler.getRejectedJobs());
+
+    TEST_ASSERT_TRUE(scheduler.hasPending(&jobs[0]));
+    scheduler.cancel(&jobs[0]);
+    TEST_ASSERT_FALSE(scheduler.hasPending(&jobs[0]));
+    runFrame(scheduler, 1000);
+    TEST_ASSERT_EQUAL(0, scheduler.getStepCount());
+}
+
+// SDスキャン相当（マウント40ms + 64エントリ×8件ずつ）を分割した場合と同期実行の比較
+void test_sd_scan_frame_times(void) {
+    const uint32_t mountUs = 40000;
+    const uint32_t entryUs = 600;
+    const int entries = 64;
+
+    // 同期実行: 画面に入ったフレームですべて行う
+    uint32_t syncFrameUs = 4000 + mountUs + entries * entryUs;
+
+    FrameScheduler scheduler(&fakeClock, 12000);
+    CostlyJob mount = {mountUs, 1, nullptr, 1, nullptr};
+    CostlyJob list = {entryUs * 8, entries / 8, nullptr, 2, nullptr};
+    scheduler.post(&mount, "sd.mount", JOB_PRIORITY_NORMAL, 1000, stepOf(mount));
+    scheduler.post(&list, "sd.list", JOB_PRIORITY_LOW, 1000, stepOf(list));
+
+    uint32_t firstFrameUs = runFrame(scheduler, 4000);
+    uint32_t worstAfterMountUs = 0;
+    int frames = 1;
+    while (scheduler.getPendingCount() > 0 && frames < 100) {
+        uint32_t used = runFrame(scheduler, 4000);
+        if (used > worstAfterMountUs) {
+            worstAfterMountUs = used;
+        }
+        frames++;
+    }
+    TEST_ASSERT_EQUAL(0, scheduler.getPendingCount());
+    TEST_ASSERT_TRUE(worstAfterMountUs <= 12000);
+    TEST_ASSERT_EQUAL(0, scheduler.getMissedDeadlines());
+    printf("sd scan: sync %lu us in one frame; sliced %d frames, mount frame %lu us, "
+           "other frames <= %lu us, avg utilization %u%%\n",
+           (unsigned long)syncFrameUs, frames, (unsigned long)firstFrameUs,
+           (unsigned long)worstAfterMountUs, (unsigned)scheduler.getAverageUtilization());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_jobs_fill_remaining_budget);
+    RUN_TEST(test_priority_then_deadline_order);
+    RUN_TEST(test_overdue_job_runs_and_counts_miss);
+    RUN_TEST(test_long_step_without_deadline_is_not_starved);
+    RUN_TEST(test_cancel_and_capacity);
+    RUN_TEST(test_sd_scan_frame_times);
+    return UNITY_END();
+}
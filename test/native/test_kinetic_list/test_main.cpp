@@ -0,0 +1,287 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include "../../../src/ui/components/KineticScroller.cpp"
+#include "../../../src/ui/components/RingScroll.h"
+#include "../../../src/ui/components/VirtualList.h"
+
+// ファイル一覧と同じ大きさ（高さ160pxに32pxの行）
+static const uint16_t HEIGHT = 160;
+static const uint16_t ROW = 32;
+static const size_t SLOTS = VirtualList<uint32_t, 1>::slotsFor(HEIGHT, ROW);
+
+typedef VirtualList<uint32_t, SLOTS> List;
+
+// 描かれた行とそのyを記録する
+struct Drawn {
+    uint32_t binds = 0;
+    uint32_t draws = 0;
+    uint32_t items[16];
+    int16_t ys[16];
+};
+
+static void attach(List& list, Drawn& drawn) {
+    Drawn* d = &drawn;
+    list.setBinder([d](uint32_t item, uint32_t& row) {
+        d->binds++;
+        row = item;
+        return true;
+    });
+    list.setRenderer([d](uint32_t item, const uint32_t&, bool, int16_t y) {
+        if (d->draws < 16) {
+            d->items[d->draws] = item;
+            d->ys[d->draws] = y;
+        }
+        d->draws++;
+    });
+}
+
+// 16ms刻みで止まるまで進め、フレーム数を返す
+static uint32_t runFling(KineticScroller& scroller) {
+    uint32_t frames = 0;
+    while (scroller.isFlinging() && frames < 10000) {
+        scroller.step(16);
+        frames++;
+    }
+    return frames;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// フリックは減速して止まり、進む距離はおよそ速度×時定数
+void test_fling_decays_to_rest(void) {
+    KineticScroller scroller;
+    scroller.setRange(1000000);
+    scroller.setPosition(1000);
+    TEST_ASSERT_TRUE(scroller.fling(2000.0f));
+    TEST_ASSERT_TRUE(scroller.isFlinging());
+    scroller.step(16);
+    float first = scroller.getVelocity();
+    TEST_ASSERT_TRUE(first < 2000.0f && first > 1800.0f);
+    uint32_t frames = runFling(scroller);
+    TEST_ASSERT_TRUE(frames > 10 && frames < 200);
+    TEST_ASSERT_FALSE(scroller.isFlinging());
+    // 2000px/秒 × 0.325秒 = 650px（止める速度以下の分だけ手前で止まる）
+    int32_t distance = scroller.getPosition() - 1000;
+    TEST_ASSERT_TRUE(distance > 630 && distance <= 650);
+    TEST_ASSERT_EQUAL(1, scroller.getFlingCount());
+}
+
+// 遅すぎる離し方はフリックにせず、速すぎる速度は上限で切る
+void test_fling_velocity_limits(void) {
+    KineticScroller scroller;
+    scroller.setRange(1000000);
+    TEST_ASSERT_FALSE(scroller.fling(KINETIC_MIN_FLING_VELOCITY - 1.0f));
+    TEST_ASSERT_FALSE(scroller.isFlinging());
+    TEST_ASSERT_TRUE(scroller.fling(-50000.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, -KINETIC_MAX_VELOCITY, scroller.getVelocity());
+    // フレームが詰まっても一度に進むのは上限の時間分だけ
+    scroller.setPosition(500000);
+    scroller.fling(KINETIC_MAX_VELOCITY);
+    scroller.step(1000);
+    float limit = KINETIC_MAX_VELOCITY * KINETIC_MAX_STEP_MS / 1000.0f;
+    TEST_ASSERT_TRUE(scroller.getPosition() - 500000 <= static_cast<int32_t>(limit));
+}
+
+// 端に当たったら止まり、指が触れたらその場で止まる
+void test_fling_stops_at_edges_and_on_grab(void) {
+    KineticScroller scroller;
+    scroller.setRange(300);
+    scroller.setPosition(200);
+    scroller.fling(3000.0f);
+    runFling(scroller);
+    TEST_ASSERT_EQUAL(300, scroller.getPosition());
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 0.0, scroller.getVelocity());
+
+    scroller.fling(-3000.0f);
+    runFling(scroller);
+    TEST_ASSERT_EQUAL(0, scroller.getPosition());
+
+    scroller.setPosition(100);
+    scroller.fling(1000.0f);
+    scroller.step(16);
+    int32_t held = scroller.getPosition();
+    scroller.grab();
+    TEST_ASSERT_FALSE(scroller.isFlinging());
+    TEST_ASSERT_FALSE(scroller.step(16));
+    TEST_ASSERT_EQUAL(held, scroller.getPosition());
+    // ドラッグは範囲内に収まる
+    TEST_ASSERT_TRUE(scroller.dragBy(-1000));
+    TEST_ASSERT_EQUAL(0, scroller.getPosition());
+    TEST_ASSERT_FALSE(scroller.dragBy(-5));
+}
+
+// スクロールしたら新しく見えた帯だけが描き直し待ちになる
+void test_ring_marks_only_exposed_band(void) {
+    RingScroll ring(HEIGHT);
+    RingScroll::Band band;
+    TEST_ASSERT_FALSE(ring.isValid());
+    ring.scrollTo(0);
+    TEST_ASSERT_TRUE(ring.takeDirty(band));
+    TEST_ASSERT_EQUAL(0, band.top);
+    TEST_ASSERT_EQUAL(HEIGHT, band.bottom);
+    TEST_ASSERT_FALSE(ring.takeDirty(band));
+
+    ring.scrollTo(12);
+    TEST_ASSERT_TRUE(ring.takeDirty(band));
+    TEST_ASSERT_EQUAL(HEIGHT, band.top);
+    TEST_ASSERT_EQUAL(HEIGHT + 12, band.bottom);
+    TEST_ASSERT_EQUAL(12, ring.startRow());
+
+    ring.scrollTo(5);
+    TEST_ASSERT_TRUE(ring.takeDirty(band));
+    TEST_ASSERT_EQUAL(5, band.top);
+    TEST_ASSERT_EQUAL(12, band.bottom);
+
+    // 高さ以上跳んだら全体
+    ring.scrollTo(5 + HEIGHT);
+    TEST_ASSERT_TRUE(ring.takeDirty(band));
+    TEST_ASSERT_EQUAL(5 + HEIGHT, band.top);
+    TEST_ASSERT_EQUAL(5 + 2 * HEIGHT, band.bottom);
+}
+
+// 描き直し待ちは表示範囲に切り詰め、帯は折り返しで2つに分ける
+void test_ring_clips_and_splits_at_wrap(void) {
+    RingScroll ring(HEIGHT);
+    RingScroll::Band band;
+    ring.scrollTo(0);
+    ring.takeDirty(band);
+    ring.invalidate(HEIGHT + 10, HEIGHT + 50);
+    TEST_ASSERT_FALSE(ring.takeDirty(band));
+    ring.invalidate(-20, 10);
+    TEST_ASSERT_TRUE(ring.takeDirty(band));
+    TEST_ASSERT_EQUAL(0, band.top);
+    TEST_ASSERT_EQUAL(10, band.bottom);
+
+    // 待ちのまま動いたら、見えなくなった分は捨てる
+    ring.invalidate(0, 40);
+    ring.scrollTo(30);
+    TEST_ASSERT_TRUE(ring.takeDirty(band));
+    TEST_ASSERT_EQUAL(30, band.top);
+    TEST_ASSERT_EQUAL(HEIGHT + 30, band.bottom);
+
+    ring.scrollTo(150);
+    band.top = 150;
+    band.bottom = 310;
+    RingScroll::Segment segments[2];
+    TEST_ASSERT_EQUAL(2, ring.split(band, segments));
+    TEST_ASSERT_EQUAL(150, segments[0].top);
+    TEST_ASSERT_EQUAL(HEIGHT, segments[0].bottom);
+    TEST_ASSERT_EQUAL(0, segments[0].offset);
+    TEST_ASSERT_EQUAL(HEIGHT, segments[1].top);
+    TEST_ASSERT_EQUAL(310, segments[1].bottom);
+    TEST_ASSERT_EQUAL(HEIGHT, segments[1].offset);
+    TEST_ASSERT_EQUAL(150, ring.ringRow(150));
+    TEST_ASSERT_EQUAL(0, ring.ringRow(HEIGHT));
+}
+
+// drawBandは帯にかかる行だけを「内容のy - origin」で描く
+void test_draw_band_draws_only_band_rows(void) {
+    List list(0, HEIGHT, ROW);
+    Drawn drawn;
+    attach(list, drawn);
+    list.setItemCount(1000);
+    list.scrollTo(40);
+    list.layout();
+    // 内容の200〜210は項目6だけ
+    list.drawBand(200, 210, 160);
+    TEST_ASSERT_EQUAL(1, drawn.draws);
+    TEST_ASSERT_EQUAL(6, drawn.items[0]);
+    TEST_ASSERT_EQUAL(6 * ROW - 160, drawn.ys[0]);
+    // 表示範囲の外の行は描かない
+    drawn.draws = 0;
+    list.drawBand(0, 1000, 0);
+    TEST_ASSERT_EQUAL(list.lastVisible() - list.firstVisible() + 1, drawn.draws);
+    TEST_ASSERT_EQUAL(list.firstVisible(), drawn.items[0]);
+}
+
+// リストとリングをフリックで動かし、1フレームの作り直し・描画の行数と描く帯の高さを数える
+struct FlingStats {
+    uint32_t frames;
+    uint32_t maxBinds;
+    uint32_t maxDraws;
+    int32_t maxLines;
+    double nsPerFrame;
+};
+
+static FlingStats simulateFling(uint32_t itemCount) {
+    List list(0, HEIGHT, ROW);
+    Drawn drawn;
+    attach(list, drawn);
+    list.setItemCount(itemCount);
+    KineticScroller scroller;
+    scroller.setRange(list.getMaxScroll());
+    RingScroll ring(HEIGHT);
+    FlingStats stats = {0, 0, 0, 0, 0.0};
+    scroller.fling(KINETIC_MAX_VELOCITY);
+    auto start = std::chrono::steady_clock::now();
+    do {
+        uint32_t binds = drawn.binds;
+        uint32_t draws = drawn.draws;
+        scroller.step(16);
+        list.scrollTo(scroller.getPosition());
+        list.layout();
+        ring.scrollTo(list.getScrollY());
+        RingScroll::Band band;
+        int32_t lines = 0;
+        if (ring.takeDirty(band)) {
+            RingScroll::Segment segments[2];
+            size_t count = ring.split(band, segments);
+            for (size_t i = 0; i < count; i++) {
+                list.drawBand(segments[i].top, segments[i].bottom, segments[i].offset);
+            }
+            lines = band.height();
+        }
+        stats.frames++;
+        // 最初のフレームは全体を描くので除く
+        if (stats.frames > 1) {
+            stats.maxBinds = drawn.binds - binds > stats.maxBinds ? drawn.binds - binds : stats.maxBinds;
+            stats.maxDraws = drawn.draws - draws > stats.maxDraws ? drawn.draws - draws : stats.maxDraws;
+            stats.maxLines = lines > stats.maxLines ? lines : stats.maxLines;
+        }
+    } while (scroller.isFlinging());
+    auto end = std::chrono::steady_clock::now();
+    stats.nsPerFrame = std::chrono::duration<double, std::nano>(end - start).count() / stats.frames;
+    return stats;
+}
+
+// 1フレームの仕事は項目数に依らない
+void test_frame_work_is_independent_of_item_count(void) {
+    FlingStats small = simulateFling(100);
+    FlingStats large = simulateFling(100000);
+    TEST_ASSERT_EQUAL(small.maxBinds, large.maxBinds);
+    TEST_ASSERT_EQUAL(small.maxDraws, large.maxDraws);
+    TEST_ASSERT_EQUAL(small.maxLines, large.maxLines);
+    // 16msで動く最大の距離より多くは描かない
+    TEST_ASSERT_TRUE(large.maxLines <= KINETIC_MAX_VELOCITY * 16 / 1000 + 1);
+}
+
+static void benchmark() {
+    const uint32_t counts[] = {100, 100000};
+    for (uint32_t count : counts) {
+        FlingStats stats = simulateFling(count);
+        printf("BENCH kinetic list: fling over %u items, %u frames, max %u binds/frame, max %u rows drawn/frame, "
+               "max %d band lines/frame (of %u), %.0f ns/frame\n",
+               (unsigned)count, (unsigned)stats.frames, (unsigned)stats.maxBinds, (unsigned)stats.maxDraws,
+               (int)stats.maxLines, (unsigned)HEIGHT, stats.nsPerFrame);
+    }
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_fling_decays_to_rest);
+    RUN_TEST(test_fling_velocity_limits);
+    RUN_TEST(test_fling_stops_at_edges_and_on_grab);
+    RUN_TEST(test_ring_marks_only_exposed_band);
+    RUN_TEST(test_ring_clips_and_splits_at_wrap);
+    RUN_TEST(test_draw_band_draws_only_band_rows);
+    RUN_TEST(test_frame_work_is_independent_of_item_count);
+    benchmark();
+    return UNITY_END();
+}
@@ -0,0 +1,291 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "../../../src/shared/LogFormat.cpp"
+#include "../../../src/storage/LogWriter.cpp"
+
+static uint32_t fakeNowMs = 0;
+static uint32_t fakeClock() { return fakeNowMs; }
+
+void setUp(void) {
+    fakeNowMs = 0;
+}
+
+void tearDown(void) {
+}
+
+// 書いた記録をそのまま整形した本文
+template <typename... Args>
+static const char* formatted(const char* format, Args... args) {
+    static LogBuffer buffer(&fakeClock);
+    static char out[LOG_LINE_BYTES];
+    uint32_t sequence = buffer.getHead();
+    buffer.write(LOG_SEVERITY_INFO, format, args...);
+    LogRecord record;
+    if (!buffer.read(sequence, record)) {
+        return "(unreadable)";
+    }
+    formatLogMessage(record, out, sizeof(out));
+    return out;
+}
+
+// printfと同じ結果になる（整数は幅に合わせて取り込み、書式どおりに戻す）
+void test_format_matches_printf(void) {
+    TEST_ASSERT_EQUAL_STRING("Screen 3 constructed", formatted("Screen %d constructed", 3));
+    TEST_ASSERT_EQUAL_STRING("-5 4294967295 ff", formatted("%d %u %x", -5, 0xFFFFFFFFu, 255));
+    TEST_ASSERT_EQUAL_STRING("[  42] [7   ] [0009]", formatted("[%4d] [%-4d] [%04d]", 42, 7, 9));
+    TEST_ASSERT_EQUAL_STRING("-9000000000 18446744073709551615",
+                             formatted("%lld %llu", -9000000000LL, 0xFFFFFFFFFFFFFFFFULL));
+    TEST_ASSERT_EQUAL_STRING("123456 bytes", formatted("%lu bytes", 123456UL));
+    TEST_ASSERT_EQUAL_STRING("3.14 100%", formatted("%.2f %d%%", 3.14159, 100));
+    TEST_ASSERT_EQUAL_STRING("c=x", formatted("c=%c", 'x'));
+    // 末尾の改行は落とす
+    TEST_ASSERT_EQUAL_STRING("done", formatted("done\n"));
+}
+
+// 文字列はコピーする（呼び出し側の文字列が変わっても記録は変わらない）
+void test_strings_are_copied(void) {
+    LogBuffer buffer(&fakeClock);
+    char name[16];
+    strcpy(name, "MainMenu");
+    buffer.write(LOG_SEVERITY_INFO, "enter %s from %s", name, "Settings");
+    strcpy(name, "changed");
+    LogRecord record;
+    TEST_ASSERT_TRUE(buffer.read(0, record));
+    char out[LOG_LINE_BYTES];
+    formatLogMessage(record, out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("enter MainMenu from Settings", out);
+
+    // 領域を超えた分は切り詰める（後の引数は空になる）
+    char longText[64];
+    memset(longText, 'a', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = '\0';
+    buffer.write(LOG_SEVERITY_INFO, "%s|%s|%d", static_cast<const char*>(longText), "tail", 1);
+    TEST_ASSERT_TRUE(buffer.read(1, record));
+    size_t length = formatLogMessage(record, out, sizeof(out));
+    TEST_ASSERT_EQUAL(LOG_TEXT_BYTES - 1 + 3, length);
+    TEST_ASSERT_EQUAL_STRING("||1", out + LOG_TEXT_BYTES - 1);
+}
+
+// 引数の足りない変換・解釈できない変換はそのまま出し、出力は容量で切る
+void test_malformed_format_and_truncation(void) {
+    TEST_ASSERT_EQUAL_STRING("a=1 b=%d", formatted("a=%d b=%d", 1));
+    TEST_ASSERT_EQUAL_STRING("50%!", formatted("50%!"));
+
+    LogBuffer buffer(&fakeClock);
+    buffer.write(LOG_SEVERITY_WARN, "value %d is long", 123456);
+    LogRecord record;
+    TEST_ASSERT_TRUE(buffer.read(0, record));
+    char out[10];
+    TEST_ASSERT_EQUAL(9, formatLogMessage(record, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("value 123", out);
+
+    fakeNowMs = 12345;
+    buffer.write(LOG_SEVERITY_ERROR, "failed");
+    TEST_ASSERT_TRUE(buffer.read(1, record));
+    char line[LOG_LINE_BYTES];
+    formatLogLine(record, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("    12.345 E failed", line);
+}
+
+// 満杯なら古いものから上書きし、上書きされた記録は読めない
+void test_overwrite_oldest(void) {
+    LogBuffer buffer(&fakeClock);
+    LogRecord record;
+    TEST_ASSERT_FALSE(buffer.read(0, record));
+    for (uint32_t i = 0; i < LogBuffer::CAPACITY + 10; i++) {
+        buffer.write(i % 2 ? LOG_SEVERITY_WARN : LOG_SEVERITY_INFO, "n=%u", i);
+    }
+    TEST_ASSERT_EQUAL(LogBuffer::CAPACITY + 10, buffer.getHead());
+    TEST_ASSERT_EQUAL(10, buffer.getOldest());
+    TEST_ASSERT_FALSE(buffer.read(9, record));
+    TEST_ASSERT_TRUE(buffer.read(10, record));
+    TEST_ASSERT_EQUAL(10, record.args[0].u);
+    TEST_ASSERT_TRUE(buffer.read(LogBuffer::CAPACITY + 9, record));
+    TEST_ASSERT_FALSE(buffer.read(LogBuffer::CAPACITY + 10, record));
+    TEST_ASSERT_EQUAL((LogBuffer::CAPACITY + 10) / 2, buffer.getCount(LOG_SEVERITY_WARN));
+}
+
+// 既定ではデバッグの記録はリングに入らない（古い警告やエラーを押し出さない）
+void test_debug_records_are_filtered(void) {
+    LogBuffer buffer(&fakeClock);
+    TEST_ASSERT_EQUAL(LOG_SEVERITY_INFO, buffer.getMinSeverity());
+    buffer.write(LOG_SEVERITY_WARN, "kept");
+    for (uint32_t i = 0; i < LogBuffer::CAPACITY; i++) {
+        buffer.write(LOG_SEVERITY_DEBUG, "status %u", i);
+    }
+    TEST_ASSERT_EQUAL(1, buffer.getHead());
+    TEST_ASSERT_EQUAL(0, buffer.getCount(LOG_SEVERITY_DEBUG));
+    LogRecord record;
+    TEST_ASSERT_TRUE(buffer.read(0, record));
+    TEST_ASSERT_EQUAL(LOG_SEVERITY_WARN, record.severity);
+
+    buffer.setMinSeverity(LOG_SEVERITY_DEBUG);
+    buffer.write(LOG_SEVERITY_DEBUG, "status %u", 1u);
+    TEST_ASSERT_EQUAL(2, buffer.getHead());
+    TEST_ASSERT_EQUAL(1, buffer.getCount(LOG_SEVERITY_DEBUG));
+}
+
+// 複数のスレッドから同時に書いても、読めた記録はどれも1つの書き込みのまま
+void test_concurrent_writers(void) {
+    static LogBuffer buffer(&fakeClock);
+    const uint32_t THREADS = 4;
+    const uint32_t PER_THREAD = 20000;
+    buffer.setMinSeverity(LOG_SEVERITY_DEBUG);
+    std::thread writers[THREADS];
+    for (uint32_t t = 0; t < THREADS; t++) {
+        writers[t] = std::thread([t]() {
+            for (uint32_t i = 0; i < PER_THREAD; i++) {
+                buffer.write(LOG_SEVERITY_DEBUG, "%u %u %u", t, i, t * 100000 + i);
+            }
+        });
+    }
+    // 書いている間も読む（読めたものは崩れていない）
+    uint32_t checked = 0;
+    uint32_t broken = 0;
+    while (buffer.getHead() != THREADS * PER_THREAD) {
+        uint32_t head = buffer.getHead();
+        for (uint32_t sequence = buffer.getOldest(); sequence != head; sequence++) {
+            LogRecord record;
+            if (buffer.read(sequence, record)) {
+                checked++;
+                if (record.argCount != 3 || record.args[2].u != record.args[0].u * 100000 + record.args[1].u) {
+                    broken++;
+                }
+            }
+        }
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    TEST_ASSERT_EQUAL(0, broken);
+    TEST_ASSERT_EQUAL(THREADS * PER_THREAD, buffer.getHead());
+    TEST_ASSERT_EQUAL(THREADS * PER_THREAD, buffer.getCount(LOG_SEVERITY_DEBUG));
+    // 書き終わったあとは残っている分がすべて読める
+    for (uint32_t sequence = buffer.getOldest(); sequence != buffer.getHead(); sequence++) {
+        LogRecord record;
+        TEST_ASSERT_TRUE(buffer.read(sequence, record));
+    }
+    printf("concurrent: %u records checked while writing\n", (unsigned)checked);
+}
+
+// 書き出しはセクタの倍数だけ。半端な末尾は時間が過ぎたら埋めて書く
+void test_writer_emits_whole_sectors(void) {
+    LogBuffer buffer(&fakeClock);
+    LogWriter writer(buffer);
+    uint32_t echoed = 0;
+    uint32_t* counter = &echoed;
+    writer.setEcho([counter](const char*, size_t length) { *counter += static_cast<uint32_t>(length); });
+
+    for (int i = 0; i < 20; i++) {
+        buffer.write(LOG_SEVERITY_INFO, "line %d of the test log", i);
+    }
+    TEST_ASSERT_EQUAL(20, writer.collect(0));
+    size_t pending = writer.getPendingBytes();
+    TEST_ASSERT_EQUAL(pending, echoed);
+    TEST_ASSERT_TRUE(pending > LOG_SECTOR_BYTES && pending < 2 * LOG_SECTOR_BYTES);
+    TEST_ASSERT_EQUAL(LOG_SECTOR_BYTES, writer.ready(0, false));
+    writer.consume(LOG_SECTOR_BYTES, true);
+    TEST_ASSERT_EQUAL(pending - LOG_SECTOR_BYTES, writer.getPendingBytes());
+
+    // 溜めた時間が過ぎるまでは半端なセクタを出さない
+    TEST_ASSERT_EQUAL(0, writer.ready(LOG_WRITER_MAX_HOLD_MS - 1, false));
+    size_t padded = writer.ready(LOG_WRITER_MAX_HOLD_MS + 1, false);
+    TEST_ASSERT_EQUAL(LOG_SECTOR_BYTES, padded);
+    TEST_ASSERT_EQUAL('\n', writer.data()[padded - 1]);
+    TEST_ASSERT_EQUAL(' ', writer.data()[padded - 2]);
+    TEST_ASSERT_EQUAL(2 * LOG_SECTOR_BYTES - pending, writer.getPaddedBytes());
+    writer.consume(padded, false);
+    TEST_ASSERT_EQUAL(0, writer.getPendingBytes());
+    TEST_ASSERT_EQUAL(LOG_SECTOR_BYTES, writer.getWrittenBytes());
+    TEST_ASSERT_EQUAL(LOG_SECTOR_BYTES, writer.getDroppedBytes());
+
+    // 行は整形済みで1行ずつ
+    buffer.write(LOG_SEVERITY_WARN, "short");
+    writer.collect(10);
+    TEST_ASSERT_EQUAL(LOG_SECTOR_BYTES, writer.ready(10, true));
+    TEST_ASSERT_EQUAL(0, memcmp("     0.000 W short\n", writer.data(), 19));
+}
+
+// 追い越されたら失った数を1行残して続ける。ブロックが満杯なら次回に回す
+void test_writer_reports_lost_records(void) {
+    LogBuffer buffer(&fakeClock);
+    LogWriter writer(buffer);
+    for (uint32_t i = 0; i < LogBuffer::CAPACITY + 5; i++) {
+        buffer.write(LOG_SEVERITY_INFO, "%u", i);
+    }
+    writer.collect(0);
+    TEST_ASSERT_EQUAL(5, writer.getLostRecords());
+    TEST_ASSERT_EQUAL(0, memcmp("-- 5 log records lost --\n     0.000 I 5\n", writer.data(), 40));
+    while (writer.getCursor() != buffer.getHead()) {
+        writer.consume(writer.ready(0, true), true);
+        writer.collect(0);
+    }
+    TEST_ASSERT_EQUAL(5, writer.getLostRecords());
+    TEST_ASSERT_EQUAL(LogBuffer::CAPACITY + 1, writer.getLineCount());
+
+    // 入りきらない分は残し、書き出したあとで続きを詰める
+    char text[LOG_TEXT_BYTES];
+    memset(text, 'x', sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    LogWriter full(buffer);
+    for (uint32_t i = 0; i < LogBuffer::CAPACITY; i++) {
+        buffer.write(LOG_SEVERITY_INFO, "%s %s", static_cast<const char*>(text), static_cast<const char*>(text));
+    }
+    full.collect(0);
+    TEST_ASSERT_TRUE(full.getCursor() < buffer.getHead());
+    TEST_ASSERT_TRUE(full.getPendingBytes() <= LOG_WRITER_BLOCK_BYTES);
+    full.consume(full.ready(0, false), true);
+    uint32_t before = full.getCursor();
+    full.collect(0);
+    TEST_ASSERT_TRUE(full.getCursor() > before);
+}
+
+static void benchmark() {
+    static LogBuffer buffer(&fakeClock);
+    const int ITERATIONS = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        buffer.write(LOG_SEVERITY_INFO, "Screen %d constructed (%u bytes)", i, 1234u);
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        buffer.write(LOG_SEVERITY_INFO, "enter %s", "FileBrowser");
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    char line[LOG_LINE_BYTES];
+    LogRecord record;
+    size_t total = 0;
+    auto formatStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS / 10; i++) {
+        uint32_t sequence = buffer.getOldest() + static_cast<uint32_t>(i) % LogBuffer::CAPACITY;
+        if (buffer.read(sequence, record)) {
+            total += formatLogLine(record, line, sizeof(line));
+        }
+    }
+    auto formatEnd = std::chrono::steady_clock::now();
+    printf("BENCH log buffer: write with 2 ints %.0f ns, with 1 string %.0f ns, read+format line %.0f ns (%u bytes)\n",
+           std::chrono::duration<double, std::nano>(mid - start).count() / ITERATIONS,
+           std::chrono::duration<double, std::nano>(end - mid).count() / ITERATIONS,
+           std::chrono::duration<double, std::nano>(formatEnd - formatStart).count() / (ITERATIONS / 10),
+           (unsigned)total);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_format_matches_printf);
+    RUN_TEST(test_strings_are_copied);
+    RUN_TEST(test_malformed_format_and_truncation);
+    RUN_TEST(test_overwrite_oldest);
+    RUN_TEST(test_debug_records_are_filtered);
+    RUN_TEST(test_concurrent_writers);
+    RUN_TEST(test_writer_emits_whole_sectors);
+    RUN_TEST(test_writer_reports_lost_records);
+    benchmark();
+    return UNITY_END();
+}
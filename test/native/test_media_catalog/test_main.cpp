@@ -0,0 +1,253 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include "../../../src/storage/MediaCatalog.cpp"
+#include "../../../src/storage/MediaTags.cpp"
+
+// ホスト上の一時ディレクトリをSDカードの /sound に見立てる
+struct Fixture {
+    std::string root;
+    std::string dir;
+    std::string index;
+
+    Fixture() {
+        char pattern[] = "/tmp/media_catalog_XXXXXX";
+        root = mkdtemp(pattern);
+        dir = root + "/sound";
+        index = root + "/sound.idx";
+        mkdir(dir.c_str(), 0755);
+    }
+    ~Fixture() {
+        std::string command = "rm -rf " + root;
+        if (system(command.c_str()) != 0) {
+            printf("cleanup failed: %s\n", root.c_str());
+        }
+    }
+
+    void write(const char* name, size_t size) const {
+        std::string path = dir + "/" + name;
+        FILE* file = fopen(path.c_str(), "wb");
+        for (size_t i = 0; i < size; i++) {
+            fputc(static_cast<int>(i & 0xFF), file);
+        }
+        fclose(file);
+    }
+    void erase(const char* name) const {
+        remove((dir + "/" + name).c_str());
+    }
+};
+
+static void populate(const Fixture& fixture) {
+    fixture.write("b_track.mp3", 300);
+    fixture.write("A_Track.MP3", 100);
+    fixture.write("c_track.mp3", 200);
+    fixture.write("notes.txt", 10);
+    mkdir((fixture.dir + "/folder.mp3").c_str(), 0755);   // ディレクトリは数えない
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 初回は全件を調べ、名前順（大文字小文字を区別しない）に並べる
+void test_build_sorted_catalog(void) {
+    Fixture fixture;
+    populate(fixture);
+    MediaCatalog catalog;
+    TEST_ASSERT_EQUAL(MediaCatalog::UPDATE_CHANGED, catalog.update(fixture.dir.c_str(), ".mp3"));
+    TEST_ASSERT_EQUAL(3, catalog.size());
+    TEST_ASSERT_EQUAL(3, catalog.getAddedCount());
+    TEST_ASSERT_EQUAL_STRING("A_Track.MP3", catalog.nameAt(0));
+    TEST_ASSERT_EQUAL_STRING("b_track.mp3", catalog.nameAt(1));
+    TEST_ASSERT_EQUAL_STRING("c_track.mp3", catalog.nameAt(2));
+    TEST_ASSERT_EQUAL(100, catalog.recordAt(0).size);
+    TEST_ASSERT_EQUAL(1, catalog.find("b_track.mp3"));
+    TEST_ASSERT_EQUAL(-1, catalog.find("missing.mp3"));
+    TEST_ASSERT_EQUAL(5, catalog.getStamp().entryCount);
+}
+
+// 保存した目録は先頭32バイトだけで有効性と件数がわかる
+void test_header_validates_against_directory(void) {
+    Fixture fixture;
+    populate(fixture);
+    MediaCatalog catalog;
+    catalog.update(fixture.dir.c_str(), ".mp3");
+    TEST_ASSERT_TRUE(catalog.save(fixture.index.c_str()));
+
+    MediaCatalogStamp stamp;
+    MediaCatalogHeader header;
+    TEST_ASSERT_TRUE(MediaCatalog::readStamp(fixture.dir.c_str(), stamp));
+    TEST_ASSERT_TRUE(MediaCatalog::readHeader(fixture.index.c_str(), header));
+    TEST_ASSERT_TRUE(MediaCatalog::isCurrent(header, stamp, ".MP3"));
+    TEST_ASSERT_FALSE(MediaCatalog::isCurrent(header, stamp, ".wav"));
+    TEST_ASSERT_EQUAL(3, header.entryCount);
+
+    // 追加・改名で識別値が変わる
+    fixture.write("d_track.mp3", 50);
+    TEST_ASSERT_TRUE(MediaCatalog::readStamp(fixture.dir.c_str(), stamp));
+    TEST_ASSERT_FALSE(MediaCatalog::isCurrent(header, stamp, ".mp3"));
+    fixture.erase("d_track.mp3");
+    rename((fixture.dir + "/notes.txt").c_str(), (fixture.dir + "/memo.txt").c_str());
+    TEST_ASSERT_TRUE(MediaCatalog::readStamp(fixture.dir.c_str(), stamp));
+    TEST_ASSERT_FALSE(MediaCatalog::isCurrent(header, stamp, ".mp3"));
+}
+
+// 差分更新は変わっていないファイルの再生時間を引き継ぐ
+void test_incremental_update_keeps_unchanged_entries(void) {
+    Fixture fixture;
+    populate(fixture);
+    MediaCatalog catalog;
+    catalog.update(fixture.dir.c_str(), ".mp3");
+    TEST_ASSERT_TRUE(catalog.setDuration("A_Track.MP3", 61000));
+    TEST_ASSERT_TRUE(catalog.setDuration("b_track.mp3", 62000));
+    TEST_ASSERT_TRUE(catalog.save(fixture.index.c_str()));
+
+    fixture.erase("c_track.mp3");
+    fixture.write("b_track.mp3", 333);
+    fixture.write("e_track.mp3", 400);
+
+    MediaCatalog reloaded;
+    TEST_ASSERT_TRUE(reloaded.load(fixture.index.c_str()));
+    TEST_ASSERT_EQUAL(3, reloaded.size());
+    TEST_ASSERT_EQUAL(MediaCatalog::UPDATE_CHANGED, reloaded.update(fixture.dir.c_str(), ".mp3"));
+    TEST_ASSERT_EQUAL(1, reloaded.getReusedCount());
+    TEST_ASSERT_EQUAL(1, reloaded.getModifiedCount());
+    TEST_ASSERT_EQUAL(1, reloaded.getAddedCount());
+    TEST_ASSERT_EQUAL(1, reloaded.getRemovedCount());
+    TEST_ASSERT_EQUAL(3, reloaded.size());
+    TEST_ASSERT_EQUAL(61000, reloaded.recordAt(reloaded.find("A_Track.MP3")).durationMs);
+    TEST_ASSERT_EQUAL(0, reloaded.recordAt(reloaded.find("b_track.mp3")).durationMs);
+    TEST_ASSERT_EQUAL(333, reloaded.recordAt(reloaded.find("b_track.mp3")).size);
+    TEST_ASSERT_EQUAL(-1, reloaded.find("c_track.mp3"));
+
+    // 何も変えなければ変化なし
+    TEST_ASSERT_EQUAL(MediaCatalog::UPDATE_UNCHANGED, reloaded.update(fixture.dir.c_str(), ".mp3"));
+}
+
+// 壊れた目録は読み込まない
+void test_corrupt_catalog_is_rejected(void) {
+    Fixture fixture;
+    populate(fixture);
+    MediaCatalog catalog;
+    catalog.update(fixture.dir.c_str(), ".mp3");
+    TEST_ASSERT_TRUE(catalog.save(fixture.index.c_str()));
+
+    FILE* file = fopen(fixture.index.c_str(), "r+b");
+    fseek(file, static_cast<long>(catalog.getSerializedSize()) - 3, SEEK_SET);
+    fputc('#', file);
+    fclose(file);
+
+    MediaCatalog reloaded;
+    TEST_ASSERT_FALSE(reloaded.load(fixture.index.c_str()));
+    TEST_ASSERT_EQUAL(0, reloaded.size());
+}
+
+// ページ読み出しは目録ファイルから名前順の範囲だけを拾う
+void test_read_page_from_index(void) {
+    Fixture fixture;
+    char name[32];
+    for (int i = 0; i < 40; i++) {
+        snprintf(name, sizeof(name), "track_%02d.mp3", 39 - i);
+        fixture.write(name, 10 + i);
+    }
+    MediaCatalog catalog;
+    catalog.update(fixture.dir.c_str(), ".mp3");
+    TEST_ASSERT_TRUE(catalog.setDuration("track_17.mp3", 95000));
+    TEST_ASSERT_TRUE(catalog.save(fixture.index.c_str()));
+
+    MediaCatalogEntry page[16];
+    uint32_t written = 0;
+    uint32_t total = 0;
+    TEST_ASSERT_TRUE(MediaCatalog::readPage(fixture.index.c_str(), 16, page, 16, written, total));
+    TEST_ASSERT_EQUAL(16, written);
+    TEST_ASSERT_EQUAL(40, total);
+    TEST_ASSERT_EQUAL_STRING("track_16.mp3", page[0].name.c_str());
+    TEST_ASSERT_EQUAL_STRING("track_17.mp3", page[1].name.c_str());
+    TEST_ASSERT_EQUAL(95000, page[1].durationMs);
+    TEST_ASSERT_EQUAL(10 + 39 - 17, page[1].size);
+
+    // 末尾のページは残りの件数だけ、範囲外は0件
+    TEST_ASSERT_TRUE(MediaCatalog::readPage(fixture.index.c_str(), 32, page, 16, written, total));
+    TEST_ASSERT_EQUAL(8, written);
+    TEST_ASSERT_EQUAL_STRING("track_39.mp3", page[7].name.c_str());
+    TEST_ASSERT_TRUE(MediaCatalog::readPage(fixture.index.c_str(), 40, page, 16, written, total));
+    TEST_ASSERT_EQUAL(0, written);
+
+    TEST_ASSERT_FALSE(MediaCatalog::readPage((fixture.root + "/missing.idx").c_str(), 0, page, 16, written, total));
+    TEST_ASSERT_EQUAL(0, total);
+}
+
+// 途中経過のコールバックで中止できる
+void test_progress_can_abort(void) {
+    Fixture fixture;
+    populate(fixture);
+    uint32_t calls = 0;
+    uint32_t* counter = &calls;
+    MediaCatalog catalog;
+    MediaCatalog::UpdateResult result = catalog.update(fixture.dir.c_str(), ".mp3",
+        [counter](uint32_t matched, uint32_t) {
+            (*counter)++;
+            return matched < 2;
+        });
+    TEST_ASSERT_EQUAL(MediaCatalog::UPDATE_ABORTED, result);
+    TEST_ASSERT_EQUAL(2, calls);
+    TEST_ASSERT_EQUAL(0, catalog.size());
+}
+
+// 300曲のディレクトリで、全件の走査と先頭の照合を比べる
+static void benchmark() {
+    Fixture fixture;
+    char name[32];
+    for (int i = 0; i < 300; i++) {
+        snprintf(name, sizeof(name), "track_%03d.mp3", i);
+        fixture.write(name, 64);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    MediaCatalog catalog;
+    catalog.update(fixture.dir.c_str(), ".mp3");
+    catalog.save(fixture.index.c_str());
+    auto built = std::chrono::steady_clock::now();
+
+    MediaCatalogStamp stamp;
+    MediaCatalogHeader header;
+    bool current = MediaCatalog::readStamp(fixture.dir.c_str(), stamp) &&
+                   MediaCatalog::readHeader(fixture.index.c_str(), header) &&
+                   MediaCatalog::isCurrent(header, stamp, ".mp3");
+    auto checked = std::chrono::steady_clock::now();
+
+    printf("catalog of %u files: %u bytes; full walk+stat %lld us, header check %lld us (%s, %u bytes read)\n",
+           (unsigned)catalog.size(), (unsigned)catalog.getSerializedSize(),
+           (long long)std::chrono::duration_cast<std::chrono::microseconds>(built - start).count(),
+           (long long)std::chrono::duration_cast<std::chrono::microseconds>(checked - built).count(),
+           current ? "current" : "stale", (unsigned)sizeof(MediaCatalogHeader));
+
+    // 一覧の1ページ（16件）を目録ファイルから直接読む
+    MediaCatalogEntry page[16];
+    uint32_t written = 0;
+    uint32_t total = 0;
+    auto pageStart = std::chrono::steady_clock::now();
+    MediaCatalog::readPage(fixture.index.c_str(), 150, page, 16, written, total);
+    auto pageEnd = std::chrono::steady_clock::now();
+    printf("page of %u entries from %u: %lld us\n", (unsigned)written, (unsigned)total,
+           (long long)std::chrono::duration_cast<std::chrono::microseconds>(pageEnd - pageStart).count());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_build_sorted_catalog);
+    RUN_TEST(test_header_validates_against_directory);
+    RUN_TEST(test_read_page_from_index);
+    RUN_TEST(test_incremental_update_keeps_unchanged_entries);
+    RUN_TEST(test_corrupt_catalog_is_rejected);
+    RUN_TEST(test_progress_can_abort);
+    benchmark();
+    return UNITY_END();
+}
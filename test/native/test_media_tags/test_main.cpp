@@ -0,0 +1,393 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "../../../src/storage/MediaCatalog.cpp"
+#include "../../../src/storage/MediaTags.cpp"
+
+typedef std::vector<uint8_t> Bytes;
+
+// MPEG1 Layer III、128kbps、44.1kHz、ステレオ（1フレーム417バイト、1152サンプル）
+static const uint8_t FRAME_HEADER[4] = {0xFF, 0xFB, 0x90, 0x00};
+static const uint32_t FRAME_BYTES = 417;
+
+static void append(Bytes& out, const void* data, size_t length) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), p, p + length);
+}
+
+static void appendBe32(Bytes& out, uint32_t value) {
+    uint8_t bytes[4] = {uint8_t(value >> 24), uint8_t(value >> 16), uint8_t(value >> 8), uint8_t(value)};
+    append(out, bytes, 4);
+}
+
+static void appendSyncsafe(Bytes& out, uint32_t value) {
+    uint8_t bytes[4] = {uint8_t((value >> 21) & 0x7F), uint8_t((value >> 14) & 0x7F), uint8_t((value >> 7) & 0x7F),
+                        uint8_t(value & 0x7F)};
+    append(out, bytes, 4);
+}
+
+// ID3v2のフレーム（v2.2は3文字のIDと3バイトの大きさ、v2.4は7bit×4）
+static void appendFrame(Bytes& out, uint8_t version, const char* id, const Bytes& body) {
+    if (version == 2) {
+        append(out, id, 3);
+        uint8_t size[3] = {uint8_t(body.size() >> 16), uint8_t(body.size() >> 8), uint8_t(body.size())};
+        append(out, size, 3);
+    } else {
+        append(out, id, 4);
+        if (version == 4) {
+            appendSyncsafe(out, static_cast<uint32_t>(body.size()));
+        } else {
+            appendBe32(out, static_cast<uint32_t>(body.size()));
+        }
+        out.push_back(0);
+        out.push_back(0);
+    }
+    append(out, body.data(), body.size());
+}
+
+static Bytes text(uint8_t encoding, const char* value) {
+    Bytes body(1, encoding);
+    append(body, value, strlen(value));
+    return body;
+}
+
+// UTF-16（BOM付きリトルエンディアン）
+static Bytes utf16(const std::vector<uint16_t>& units) {
+    Bytes body = {1, 0xFF, 0xFE};
+    for (uint16_t unit : units) {
+        body.push_back(uint8_t(unit));
+        body.push_back(uint8_t(unit >> 8));
+    }
+    return body;
+}
+
+static Bytes tag(uint8_t version, const Bytes& frames, uint8_t flags = 0, size_t padding = 32) {
+    Bytes out = {'I', 'D', '3', version, 0, flags};
+    appendSyncsafe(out, static_cast<uint32_t>(frames.size() + padding));
+    append(out, frames.data(), frames.size());
+    out.resize(out.size() + padding, 0);
+    return out;
+}
+
+static void appendFrames(Bytes& out, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        size_t start = out.size();
+        append(out, FRAME_HEADER, 4);
+        out.resize(start + FRAME_BYTES, 0x55);
+    }
+}
+
+// 先頭のフレームにXingまたはVBRIのフレーム数を入れる
+static void appendVbrHeader(Bytes& out, const char* kind, uint32_t frames) {
+    size_t start = out.size();
+    append(out, FRAME_HEADER, 4);
+    if (strcmp(kind, "VBRI") == 0) {
+        out.resize(start + 4 + 32, 0);
+        append(out, "VBRI", 4);
+        uint8_t fields[6] = {0, 1, 0, 0, 0, 75};
+        append(out, fields, sizeof(fields));
+        appendBe32(out, frames * FRAME_BYTES);
+        appendBe32(out, frames);
+    } else {
+        out.resize(start + 4 + 32, 0);
+        append(out, kind, 4);
+        appendBe32(out, 0x01);
+        appendBe32(out, frames);
+    }
+    out.resize(start + FRAME_BYTES, 0);
+}
+
+static Bytes id3v1(const char* title, const char* artist) {
+    Bytes out(128, 0);
+    memcpy(out.data(), "TAG", 3);
+    memcpy(out.data() + 3, title, strlen(title));
+    memcpy(out.data() + 33, artist, strlen(artist));
+    return out;
+}
+
+// ホスト上の一時ディレクトリをSDカードの /sound に見立てる
+struct Fixture {
+    std::string root;
+    std::string dir;
+    std::string index;
+
+    Fixture() {
+        char pattern[] = "/tmp/media_tags_XXXXXX";
+        root = mkdtemp(pattern);
+        dir = root + "/sound";
+        index = root + "/sound.idx";
+        mkdir(dir.c_str(), 0755);
+    }
+    ~Fixture() {
+        std::string command = "rm -rf " + root;
+        if (system(command.c_str()) != 0) {
+            printf("cleanup failed: %s\n", root.c_str());
+        }
+    }
+
+    // headとtailの間をpaddingバイトの穴にする（大きなファイルを実際には書かない）
+    std::string write(const char* name, const Bytes& head, const Bytes& tail = Bytes(), size_t gap = 0) const {
+        std::string path = dir + "/" + name;
+        FILE* file = fopen(path.c_str(), "wb");
+        fwrite(head.data(), 1, head.size(), file);
+        if (gap > 0) {
+            fseek(file, static_cast<long>(gap), SEEK_CUR);
+        }
+        if (!tail.empty()) {
+            fwrite(tail.data(), 1, tail.size(), file);
+        } else if (gap > 0) {
+            fseek(file, -1, SEEK_CUR);
+            fputc(0, file);
+        }
+        fclose(file);
+        return path;
+    }
+};
+
+static uint32_t readFile(const std::string& path, MediaTags& tags) {
+    struct stat info;
+    stat(path.c_str(), &info);
+    static uint8_t window[MEDIA_TAG_HEAD_WINDOW];
+    return MediaTagReader::read(path.c_str(), static_cast<uint32_t>(info.st_size), tags, window, sizeof(window));
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// v2.3: UTF-16の題名（サロゲートを含む）とISO-8859-1のアーティスト、固定ビットレートの再生時間
+void test_id3v23_utf16_and_cbr_duration(void) {
+    Fixture fixture;
+    Bytes frames;
+    appendFrame(frames, 3, "TIT2", utf16({0x6D77, 0x306E, 0x6B4C, 0xD83C, 0xDFB5}));   // 海の歌🎵
+    appendFrame(frames, 3, "TPE1", text(0, "Caf\xE9 Trio"));
+    Bytes file = tag(3, frames);
+    size_t audioStart = file.size();
+    appendFrames(file, 100);
+
+    MediaTags tags;
+    readFile(fixture.write("a.mp3", file), tags);
+    TEST_ASSERT_EQUAL(3, tags.id3v2Version);
+    TEST_ASSERT_EQUAL_STRING("\xE6\xB5\xB7\xE3\x81\xAE\xE6\xAD\x8C\xF0\x9F\x8E\xB5", tags.title.c_str());
+    TEST_ASSERT_EQUAL_STRING("Caf\xC3\xA9 Trio", tags.artist.c_str());
+    TEST_ASSERT_EQUAL(audioStart, tags.audioOffset);
+    TEST_ASSERT_FALSE(tags.fromFrameCount);
+    // 100フレーム = 2612ms。平均ビットレートからの見積もりは1%以内
+    TEST_ASSERT_INT_WITHIN(26, 2612, tags.durationMs);
+}
+
+// v2.4: 拡張ヘッダーを読み飛ばし、UTF-8の値を読む。TLENよりXingのフレーム数を優先する
+void test_id3v24_with_xing_frame_count(void) {
+    Fixture fixture;
+    Bytes frames;
+    appendSyncsafe(frames, 6);                  // 拡張ヘッダー（自身を含む6バイト）
+    frames.push_back(1);
+    frames.push_back(0);
+    appendFrame(frames, 4, "TLEN", text(0, "1000"));
+    appendFrame(frames, 4, "TIT2", text(3, "\xE5\xA4\x9C\xE6\x83\xB3\xE6\x9B\xB2"));    // 夜想曲
+    appendFrame(frames, 4, "TPE1", text(3, "Quartet"));
+    Bytes file = tag(4, frames, 0x40);
+    appendVbrHeader(file, "Xing", 1000);
+    appendFrames(file, 20);
+
+    MediaTags tags;
+    readFile(fixture.write("b.mp3", file), tags);
+    TEST_ASSERT_EQUAL(4, tags.id3v2Version);
+    TEST_ASSERT_EQUAL_STRING("\xE5\xA4\x9C\xE6\x83\xB3\xE6\x9B\xB2", tags.title.c_str());
+    TEST_ASSERT_EQUAL_STRING("Quartet", tags.artist.c_str());
+    TEST_ASSERT_TRUE(tags.fromFrameCount);
+    TEST_ASSERT_EQUAL(1000u * 1152 * 1000 / 44100, tags.durationMs);
+}
+
+// v2.2の3文字フレームとTLE（フレームの先頭が見つからなくても長さはTLENから）
+void test_id3v22_frames(void) {
+    Fixture fixture;
+    Bytes frames;
+    appendFrame(frames, 2, "TT2", text(0, "Old Tag"));
+    appendFrame(frames, 2, "TP1", text(0, "Someone  "));
+    appendFrame(frames, 2, "TLE", text(0, "4321"));
+    Bytes file = tag(2, frames);
+    file.resize(file.size() + 600, 0);
+
+    MediaTags tags;
+    readFile(fixture.write("c.mp3", file), tags);
+    TEST_ASSERT_EQUAL(2, tags.id3v2Version);
+    TEST_ASSERT_EQUAL_STRING("Old Tag", tags.title.c_str());
+    TEST_ASSERT_EQUAL_STRING("Someone", tags.artist.c_str());
+    TEST_ASSERT_EQUAL(4321, tags.durationMs);
+}
+
+// ID3v1だけのファイルとVBRIヘッダー。v1の128バイトは音声の大きさから除く
+void test_id3v1_and_vbri(void) {
+    Fixture fixture;
+    Bytes file;
+    appendVbrHeader(file, "VBRI", 500);
+    appendFrames(file, 10);
+    Bytes v1 = id3v1("Short Title", "Band");
+    append(file, v1.data(), v1.size());
+
+    MediaTags tags;
+    readFile(fixture.write("d.mp3", file), tags);
+    TEST_ASSERT_EQUAL(0, tags.id3v2Version);
+    TEST_ASSERT_TRUE(tags.hasId3v1);
+    TEST_ASSERT_EQUAL_STRING("Short Title", tags.title.c_str());
+    TEST_ASSERT_EQUAL_STRING("Band", tags.artist.c_str());
+    TEST_ASSERT_EQUAL(0, tags.audioOffset);
+    TEST_ASSERT_EQUAL(500u * 1152 * 1000 / 44100, tags.durationMs);
+}
+
+// 窓より大きな画像フレームの先は読まず、ID3v1で補う。大きなファイルでも読むのは窓の分だけ
+void test_large_file_reads_bounded_windows(void) {
+    Fixture fixture;
+    Bytes picture(64 * 1024, 0x77);
+    picture[0] = 0;
+    Bytes frames;
+    appendFrame(frames, 3, "APIC", picture);
+    appendFrame(frames, 3, "TIT2", text(0, "Hidden Title"));
+    Bytes head = tag(3, frames);
+    size_t audioStart = head.size();
+    appendFrames(head, 8);
+    Bytes tail;
+    appendFrames(tail, 4);
+    Bytes v1 = id3v1("Fallback", "");
+    append(tail, v1.data(), v1.size());
+    const size_t gap = 8u * 1024 * 1024;
+
+    MediaTags tags;
+    uint32_t bytes = readFile(fixture.write("e.mp3", head, tail, gap), tags);
+    TEST_ASSERT_EQUAL_STRING("Fallback", tags.title.c_str());
+    TEST_ASSERT_TRUE(tags.artist.empty());
+    TEST_ASSERT_EQUAL(audioStart, tags.audioOffset);
+    TEST_ASSERT_LESS_OR_EQUAL(MEDIA_TAG_HEAD_WINDOW + MEDIA_TAG_FRAME_WINDOW + 128, bytes);
+    // 約8.1MBの128kbpsで約8.5分
+    uint32_t audioBytes = static_cast<uint32_t>(head.size() - audioStart + gap + tail.size() - 128);
+    TEST_ASSERT_EQUAL(static_cast<uint32_t>(static_cast<uint64_t>(audioBytes) * 8 / 128), tags.durationMs);
+}
+
+// タグのないファイルや偶然の0xFFはフレームとみなさない
+void test_garbage_is_not_a_frame(void) {
+    Bytes noise(1024);
+    for (size_t i = 0; i < noise.size(); i++) {
+        noise[i] = static_cast<uint8_t>(i * 37);
+    }
+    noise[100] = 0xFF;
+    noise[101] = 0xFB;
+    noise[102] = 0x90;
+    MediaTags tags;
+    uint32_t sync = 0;
+    TEST_ASSERT_EQUAL(0, MediaTagReader::parseId3v2(noise.data(), noise.size(), tags));
+    TEST_ASSERT_FALSE(MediaTagReader::parseMpegFrames(noise.data(), noise.size(), 1024, tags, sync));
+    TEST_ASSERT_FALSE(MediaTagReader::parseId3v1(noise.data(), noise.size(), tags));
+    TEST_ASSERT_EQUAL(0, tags.durationMs);
+}
+
+// 目録はタグを保存し、ページ読み出しで返す。変更されたファイルだけ読み直す
+void test_catalog_stores_tags(void) {
+    Fixture fixture;
+    Bytes frames;
+    appendFrame(frames, 3, "TIT2", text(0, "First Song"));
+    appendFrame(frames, 3, "TPE1", text(0, "Artist A"));
+    Bytes file = tag(3, frames);
+    appendFrames(file, 50);
+    fixture.write("one.mp3", file);
+    Bytes plain;
+    appendFrames(plain, 30);
+    fixture.write("two.mp3", plain);
+
+    MediaCatalog catalog;
+    TEST_ASSERT_EQUAL(MediaCatalog::UPDATE_CHANGED, catalog.update(fixture.dir.c_str(), ".mp3"));
+    TEST_ASSERT_EQUAL(2, catalog.getTaggedCount());
+    TEST_ASSERT_EQUAL_STRING("First Song", catalog.titleAt(0));
+    TEST_ASSERT_EQUAL_STRING("Artist A", catalog.artistAt(0));
+    TEST_ASSERT_EQUAL_STRING("", catalog.titleAt(1));
+    TEST_ASSERT_INT_WITHIN(20, 30 * 1152 * 1000 / 44100, catalog.recordAt(1).durationMs);
+    TEST_ASSERT_TRUE(catalog.save(fixture.index.c_str()));
+
+    MediaCatalogEntry page[2];
+    uint32_t written = 0;
+    uint32_t total = 0;
+    TEST_ASSERT_TRUE(MediaCatalog::readPage(fixture.index.c_str(), 0, page, 2, written, total));
+    TEST_ASSERT_EQUAL(2, written);
+    TEST_ASSERT_EQUAL_STRING("one.mp3", page[0].name.c_str());
+    TEST_ASSERT_EQUAL_STRING("First Song", page[0].title.c_str());
+    TEST_ASSERT_EQUAL_STRING("Artist A", page[0].artist.c_str());
+    TEST_ASSERT_TRUE(page[1].title.empty());
+
+    // 題名を変えたファイルだけ読み直し、古い文字列は詰め直しで消える
+    frames.clear();
+    appendFrame(frames, 3, "TIT2", text(0, "Renamed Song With Longer Title"));
+    file = tag(3, frames);
+    appendFrames(file, 60);
+    fixture.write("one.mp3", file);
+    MediaCatalog reloaded;
+    TEST_ASSERT_TRUE(reloaded.load(fixture.index.c_str()));
+    TEST_ASSERT_EQUAL(MediaCatalog::UPDATE_CHANGED, reloaded.update(fixture.dir.c_str(), ".mp3"));
+    TEST_ASSERT_EQUAL(1, reloaded.getTaggedCount());
+    TEST_ASSERT_EQUAL(1, reloaded.getModifiedCount());
+    TEST_ASSERT_EQUAL_STRING("Renamed Song With Longer Title", reloaded.titleAt(0));
+    TEST_ASSERT_EQUAL_STRING("", reloaded.artistAt(0));
+    TEST_ASSERT_EQUAL_STRING("two.mp3", reloaded.nameAt(1));
+    TEST_ASSERT_TRUE(reloaded.save(fixture.index.c_str()));
+    MediaCatalog again;
+    TEST_ASSERT_TRUE(again.load(fixture.index.c_str()));
+    TEST_ASSERT_EQUAL_STRING("Renamed Song With Longer Title", again.titleAt(0));
+}
+
+// 4MBの曲300件の目録を作り、1件あたりに読んだ量と速さを測る
+static void benchmark() {
+    Fixture fixture;
+    char name[32];
+    char title[32];
+    const size_t gap = 4u * 1024 * 1024;
+    for (int i = 0; i < 300; i++) {
+        Bytes frames;
+        snprintf(title, sizeof(title), "Song %03d", i);
+        appendFrame(frames, 3, "TIT2", text(0, title));
+        appendFrame(frames, 3, "TPE1", utf16({0x6B4C, 0x624B}));
+        Bytes head = tag(3, frames, 0, 1024);
+        appendVbrHeader(head, "Xing", 9000);
+        appendFrames(head, 8);
+        snprintf(name, sizeof(name), "track_%03d.mp3", i);
+        fixture.write(name, head, id3v1(title, "Band"), gap);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    MediaCatalog catalog;
+    catalog.update(fixture.dir.c_str(), ".mp3");
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double perFile = static_cast<double>(catalog.getTagBytesRead()) / catalog.getTaggedCount();
+    double fileBytes = static_cast<double>(catalog.recordAt(0).size);
+    printf("BENCH media tags: %u files indexed in %.1f ms (%.0f files/s), %.0f bytes read per %.0f KB file (%.2f%%)\n",
+           (unsigned)catalog.getTaggedCount(), seconds * 1000.0, catalog.getTaggedCount() / seconds, perFile,
+           fileBytes / 1024.0, perFile * 100.0 / fileBytes);
+
+    // タグを読まない差分更新（全件変わっていない）との比較
+    start = std::chrono::steady_clock::now();
+    catalog.update(fixture.dir.c_str(), ".mp3");
+    end = std::chrono::steady_clock::now();
+    printf("BENCH media tags: unchanged rescan %.1f ms (%u files re-read)\n",
+           std::chrono::duration<double, std::milli>(end - start).count(), (unsigned)catalog.getTaggedCount());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_id3v23_utf16_and_cbr_duration);
+    RUN_TEST(test_id3v24_with_xing_frame_count);
+    RUN_TEST(test_id3v22_frames);
+    RUN_TEST(test_id3v1_and_vbri);
+    RUN_TEST(test_large_file_reads_bounded_windows);
+    RUN_TEST(test_garbage_is_not_a_frame);
+    RUN_TEST(test_catalog_stores_tags);
+    benchmark();
+    return UNITY_END();
+}
@@ -0,0 +1,108 @@
+#include <unity.h>
+#include <cstdio>
+#include "../../../src/screens/NavigationPredictor.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 観測がなければ登録した辺をID順に返す
+void test_edges_seed_predictions(void) {
+    NavigationPredictor predictor;
+    predictor.addEdge(SCREEN_MENU, SCREEN_SETTINGS);
+    predictor.addEdge(SCREEN_MENU, SCREEN_STANDBY_SETTINGS);
+    predictor.addEdge(SCREEN_MENU, SCREEN_LOG);
+    predictor.addEdge(SCREEN_MENU, SCREEN_MENU);    // 自己遷移は無視
+
+    ScreenID out[2];
+    TEST_ASSERT_EQUAL(2, predictor.predict(SCREEN_MENU, out, 2));
+    TEST_ASSERT_EQUAL(SCREEN_SETTINGS, out[0]);
+    TEST_ASSERT_EQUAL(SCREEN_STANDBY_SETTINGS, out[1]);
+    TEST_ASSERT_EQUAL(0, predictor.predict(SCREEN_HOME, out, 2));
+}
+
+// よく使う遷移が上位に来る
+void test_observed_transitions_rank_first(void) {
+    NavigationPredictor predictor;
+    predictor.addEdge(SCREEN_MENU, SCREEN_STANDBY_SETTINGS);
+    predictor.addEdge(SCREEN_MENU, SCREEN_INPUT_SETTINGS);
+    predictor.addEdge(SCREEN_MENU, SCREEN_LOG);
+    for (int i = 0; i < 3; i++) {
+        predictor.record(SCREEN_MENU, SCREEN_LOG);
+    }
+    predictor.record(SCREEN_MENU, SCREEN_INPUT_SETTINGS);
+
+    ScreenID out[NAV_PREDICT_CANDIDATES];
+    size_t count = predictor.predict(SCREEN_MENU, out, NAV_PREDICT_CANDIDATES);
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL(SCREEN_LOG, out[0]);
+    TEST_ASSERT_EQUAL(SCREEN_INPUT_SETTINGS, out[1]);
+    TEST_ASSERT_EQUAL(4, predictor.getObservedCount());
+}
+
+// 飽和しそうになったら行を半分にし、順位は保つ
+void test_weights_decay_instead_of_overflowing(void) {
+    NavigationPredictor predictor;
+    for (int i = 0; i < 20000; i++) {
+        predictor.record(SCREEN_HOME, SCREEN_MENU);
+        if (i % 4 == 0) {
+            predictor.record(SCREEN_HOME, SCREEN_INFO);
+        }
+    }
+    TEST_ASSERT_TRUE(predictor.getWeight(SCREEN_HOME, SCREEN_MENU) < NavigationPredictor::WEIGHT_LIMIT);
+    TEST_ASSERT_TRUE(predictor.getWeight(SCREEN_HOME, SCREEN_MENU) > predictor.getWeight(SCREEN_HOME, SCREEN_INFO));
+
+    ScreenID out[1];
+    TEST_ASSERT_EQUAL(1, predictor.predict(SCREEN_HOME, out, 1));
+    TEST_ASSERT_EQUAL(SCREEN_MENU, out[0]);
+}
+
+// メニューの利用を模擬して、先読みが当たる割合を測る
+void test_scripted_session_hit_rate(void) {
+    NavigationPredictor predictor;
+    const ScreenID menuTargets[] = {
+        SCREEN_STANDBY_SETTINGS, SCREEN_INPUT_SETTINGS, SCREEN_OUTPUT_SETTINGS,
+        SCREEN_TIME_SETTINGS, SCREEN_LOG, SCREEN_SETTINGS
+    };
+    for (ScreenID target : menuTargets) {
+        predictor.addEdge(SCREEN_MENU, target);
+    }
+
+    // 入力設定が半分、ログが3割、残りはその他
+    const ScreenID session[] = {
+        SCREEN_INPUT_SETTINGS, SCREEN_LOG, SCREEN_INPUT_SETTINGS, SCREEN_SETTINGS,
+        SCREEN_INPUT_SETTINGS, SCREEN_LOG, SCREEN_INPUT_SETTINGS, SCREEN_TIME_SETTINGS,
+        SCREEN_INPUT_SETTINGS, SCREEN_LOG
+    };
+    int hits = 0;
+    const int rounds = 5;
+    for (int round = 0; round < rounds; round++) {
+        for (ScreenID next : session) {
+            ScreenID out[NAV_PREDICT_CANDIDATES];
+            size_t count = predictor.predict(SCREEN_MENU, out, NAV_PREDICT_CANDIDATES);
+            for (size_t i = 0; i < count; i++) {
+                if (out[i] == next) {
+                    hits++;
+                }
+            }
+            predictor.record(SCREEN_MENU, next);
+        }
+    }
+    int total = rounds * static_cast<int>(sizeof(session) / sizeof(session[0]));
+    TEST_ASSERT_TRUE(hits * 100 / total >= 70);
+    printf("prewarm hit rate: %d / %d (%d%%) with %d candidates\n",
+           hits, total, hits * 100 / total, NAV_PREDICT_CANDIDATES);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_edges_seed_predictions);
+    RUN_TEST(test_observed_transitions_rank_first);
+    RUN_TEST(test_weights_decay_instead_of_overflowing);
+    RUN_TEST(test_scripted_session_hit_rate);
+    return UNITY_END();
+}
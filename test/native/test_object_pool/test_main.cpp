@@ -0,0 +1,217 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "../../../src/shared/ObjectPool.h"
+#include "../../../src/shared/FixedString.h"
+#include "../../../src/ui/components/ModernButton.h"
+#include "../../../src/ui/components/WidgetList.h"
+#include "../../../src/ui/layout/LayoutTable.h"
+
+// ヒープ確保回数をカウントする
+static size_t g_allocCount = 0;
+
+void* operator new(size_t size) {
+    g_allocCount++;
+    void* p = std::malloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+// ModernButton相当の擬似ウィジェット（構築・計測・破棄の回数を記録）
+// ModernButton本体はLovyanGFXが要るのでホストでは作れない。ヒープに関わるメンバ
+// （テキストとクリック時のコールバック）は本物と同じ型を使う。
+static int g_constructed = 0;
+static int g_destroyed = 0;
+static int g_measured = 0;
+
+struct FakeButton {
+    int16_t x, y;
+    WidgetText text;
+    ButtonCallback onClick;
+    uint32_t metricsHash;
+    bool metricsValid;
+
+    FakeButton(int16_t px, int16_t py, const char* label)
+        : x(px), y(py), text(label), metricsHash(0), metricsValid(false) { g_constructed++; }
+    ~FakeButton() { g_destroyed++; }
+
+    void reset(int16_t px, int16_t py, const char* label) {
+        x = px;
+        y = py;
+        WidgetText next(label);
+        if (next != text) {
+            text = next;
+        }
+    }
+
+    void setOnClick(const ButtonCallback& callback) { onClick = callback; }
+
+    void draw() {
+        if (!metricsValid || metricsHash != text.hash()) {
+            g_measured++;
+            metricsHash = text.hash();
+            metricsValid = true;
+        }
+    }
+};
+
+// 従来のボタン（user-028以前の作り: std::stringのテキストとstd::functionのコールバック）
+struct LegacyButton {
+    int16_t x, y;
+    std::string text;
+    std::function<void()> onClick;
+
+    LegacyButton(int16_t px, int16_t py, const char* label) : x(px), y(py), text(label) {}
+};
+
+// LogScreenと同じ作りの画面（onEnterで表からボタンを取り、onExitでプールに返す）
+struct PooledScreen {
+    ObjectPool<FakeButton, layoutCount(BACK_ONLY_LAYOUT)> buttonPool;
+    WidgetList<FakeButton, layoutCount(BACK_ONLY_LAYOUT)> buttons;
+    int clicks = 0;
+
+    void onEnter() {
+        buttons.clear();
+        buttonPool.releaseAll();
+        for (const ButtonDef& def : BACK_ONLY_LAYOUT) {
+            FakeButton* button = buttonPool.acquire(def.x, def.y, def.label);
+            button->reset(def.x, def.y, def.label);
+            button->setOnClick([this]() { clicks++; });
+            buttons.push_back(button);
+        }
+        for (FakeButton* button : buttons) {
+            button->draw();
+        }
+    }
+
+    void onExit() {
+        buttons.clear();
+        buttonPool.releaseAll();
+    }
+};
+
+// 従来の画面（onEnterのたびにvectorとボタンを作り直す）
+struct LegacyScreen {
+    std::vector<std::unique_ptr<LegacyButton>> buttons;
+    int clicks = 0;
+
+    void onEnter() {
+        buttons.clear();
+        buttons.shrink_to_fit();
+        for (const ButtonDef& def : BACK_ONLY_LAYOUT) {
+            std::unique_ptr<LegacyButton> button(new LegacyButton(def.x, def.y, def.label));
+            button->onClick = [this]() { clicks++; };
+            buttons.push_back(std::move(button));
+        }
+    }
+};
+
+static const int SOAK_VISITS = 10000;
+
+void setUp(void) {
+    g_constructed = 0;
+    g_destroyed = 0;
+    g_measured = 0;
+}
+
+void tearDown(void) {
+}
+
+// 容量を超えるとnullptrを返し、返却したスロットは構築せずに再利用する
+void test_acquire_reuses_released_objects(void) {
+    ObjectPool<FakeButton, 2> pool;
+    FakeButton* a = pool.acquire(0, 0, "a");
+    FakeButton* b = pool.acquire(0, 0, "b");
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NULL(pool.acquire(0, 0, "c"));
+    TEST_ASSERT_EQUAL(1, pool.getExhaustedCount());
+
+    pool.release(b);
+    TEST_ASSERT_EQUAL(1, pool.size());
+    FakeButton* again = pool.acquire(0, 0, "ignored");
+    TEST_ASSERT_EQUAL_PTR(b, again);
+    TEST_ASSERT_EQUAL(2, g_constructed);
+    TEST_ASSERT_EQUAL(1, pool.getReuseCount());
+}
+
+// プールの破棄時に構築済みオブジェクトだけが破棄される
+void test_destructor_runs_for_constructed_slots(void) {
+    {
+        ObjectPool<FakeButton, 4> pool;
+        pool.acquire(0, 0, "a");
+        pool.acquire(0, 0, "b");
+        pool.releaseAll();
+        TEST_ASSERT_EQUAL(0, g_destroyed);
+    }
+    TEST_ASSERT_EQUAL(2, g_destroyed);
+}
+
+// プール外のポインタは返却対象にならない
+void test_release_ignores_foreign_pointer(void) {
+    ObjectPool<FakeButton, 1> pool;
+    FakeButton outside(0, 0, "x");
+    pool.acquire(0, 0, "a");
+    pool.release(&outside);
+    pool.release(nullptr);
+    TEST_ASSERT_EQUAL(1, pool.size());
+    TEST_ASSERT_FALSE(pool.owns(&outside));
+}
+
+// Menu→Log→Menuの往復: 2回目以降はボタンの構築・計測が起きず、
+// ボタンの置き場所（プール・リスト・テキスト・コールバック）はヒープを使わない。
+// 描画（LovyanGFX）と画面本体の生成はここでは測れないので、実機のHeapMonitorで確かめる
+void test_soak_screen_visits_are_flat(void) {
+    PooledScreen* screen = new PooledScreen();
+    size_t before = g_allocCount;
+    for (int visit = 0; visit < SOAK_VISITS; ++visit) {
+        screen->onEnter();
+        screen->buttons[0]->onClick();
+        screen->onExit();
+    }
+    size_t pooledAllocs = g_allocCount - before;
+    TEST_ASSERT_EQUAL(0, pooledAllocs);
+    TEST_ASSERT_EQUAL(SOAK_VISITS, screen->clicks);
+    TEST_ASSERT_EQUAL(1, g_constructed);
+    TEST_ASSERT_EQUAL(1, g_measured);
+    TEST_ASSERT_EQUAL(SOAK_VISITS - 1, screen->buttonPool.getReuseCount());
+    delete screen;
+
+    // 比較: 訪問のたびに作り直す従来の作り
+    LegacyScreen legacy;
+    before = g_allocCount;
+    for (int visit = 0; visit < SOAK_VISITS; ++visit) {
+        legacy.onEnter();
+    }
+    size_t legacyAllocs = g_allocCount - before;
+    TEST_ASSERT_TRUE(legacyAllocs >= static_cast<size_t>(SOAK_VISITS));
+    printf("visits=%d constructed=%d measured=%d heap allocations: pooled=%u rebuilt=%u\n",
+           SOAK_VISITS, g_constructed, g_measured, static_cast<unsigned>(pooledAllocs),
+           static_cast<unsigned>(legacyAllocs));
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_acquire_reuses_released_objects);
+    RUN_TEST(test_destructor_runs_for_constructed_slots);
+    RUN_TEST(test_release_ignores_foreign_pointer);
+    RUN_TEST(test_soak_screen_visits_are_flat);
+    return UNITY_END();
+}
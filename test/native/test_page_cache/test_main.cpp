@@ -0,0 +1,159 @@
+#include <unity.h>
+#include <algorithm>
+#include <vector>
+#include "../../../src/storage/PageCache.h"
+
+// ファイル一覧と同じ大きさ（8件のページを3枚、同時に読むのは2枚まで）
+static const uint32_t ENTRIES = 8;
+static const size_t PAGES = 3;
+static const size_t MAX_LOADING = 2;
+
+typedef PageCache<uint32_t, PAGES, ENTRIES> Cache;
+
+// SDサービスの代わりに、枠に項目番号を書き込んで読み込みを終える
+static void fill(Cache& cache, size_t index, uint32_t page) {
+    uint32_t* entries = cache.buffer(index);
+    for (uint32_t i = 0; i < ENTRIES; i++) {
+        entries[i] = page * ENTRIES + i;
+    }
+}
+
+static size_t request(Cache& cache, uint32_t page, uint16_t id) {
+    size_t index = cache.reserve(0, 1, MAX_LOADING);
+    if (index != Cache::NO_SLOT) {
+        cache.markLoading(index, page, id);
+    }
+    return index;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 読めたページの項目だけが見え、読み込み中は見えない
+void test_loaded_page_is_found(void) {
+    Cache cache;
+    size_t index = request(cache, 2, 10);
+    TEST_ASSERT_NOT_EQUAL(Cache::NO_SLOT, index);
+    TEST_ASSERT_TRUE(cache.contains(2));
+    TEST_ASSERT_TRUE(cache.hasLoading());
+    TEST_ASSERT_NULL(cache.find(16));
+    fill(cache, index, 2);
+    const Cache::Slot* slot = cache.complete(10, true, 5);
+    TEST_ASSERT_NOT_NULL(slot);
+    TEST_ASSERT_EQUAL(Cache::READY, slot->state);
+    TEST_ASSERT_FALSE(cache.hasLoading());
+    TEST_ASSERT_EQUAL(20, *cache.find(20));
+    // ページの件数より後ろの項目はない
+    TEST_ASSERT_NULL(cache.find(21));
+}
+
+// 読めなかった枠は空きに戻る
+void test_failed_page_is_freed(void) {
+    Cache cache;
+    request(cache, 0, 1);
+    const Cache::Slot* slot = cache.complete(1, false, 0);
+    TEST_ASSERT_NOT_NULL(slot);
+    TEST_ASSERT_EQUAL(Cache::EMPTY, slot->state);
+    TEST_ASSERT_FALSE(cache.contains(0));
+    TEST_ASSERT_FALSE(cache.hasLoading());
+}
+
+// 読み込み中に画面を離れて結果を受け取れなかった場合
+// 次に届いた結果（入り直したときの件数の確認など）で古い読み込みを空きに戻し、また頼めるようになる
+void test_exit_while_loading_recovers_on_next_result(void) {
+    Cache cache;
+    TEST_ASSERT_NOT_EQUAL(Cache::NO_SLOT, request(cache, 0, 20));
+    TEST_ASSERT_NOT_EQUAL(Cache::NO_SLOT, request(cache, 1, 21));
+    // 2枚とも結果が来ないまま: これ以上は頼めず、破棄もできない
+    TEST_ASSERT_EQUAL(Cache::NO_SLOT, request(cache, 2, 22));
+    TEST_ASSERT_TRUE(cache.hasLoading());
+    TEST_ASSERT_TRUE(cache.contains(0));
+
+    // 入り直して出した件数の確認（ID 23）の結果が届く
+    std::vector<uint32_t> retired;
+    size_t count = cache.retireOlder(23, [&retired](uint32_t page) { retired.push_back(page); });
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL(2, retired.size());
+    std::sort(retired.begin(), retired.end());
+    TEST_ASSERT_EQUAL(0, retired[0]);
+    TEST_ASSERT_EQUAL(1, retired[1]);
+    TEST_ASSERT_FALSE(cache.hasLoading());
+    TEST_ASSERT_FALSE(cache.contains(0));
+
+    // 同じページをまた頼める
+    size_t index = request(cache, 0, 24);
+    TEST_ASSERT_NOT_EQUAL(Cache::NO_SLOT, index);
+    TEST_ASSERT_NOT_EQUAL(Cache::NO_SLOT, request(cache, 1, 25));
+    // 空きに戻した要求の結果が遅れて届いても使わない
+    TEST_ASSERT_NULL(cache.complete(20, true, ENTRIES));
+    fill(cache, index, 0);
+    TEST_ASSERT_NOT_NULL(cache.complete(24, true, ENTRIES));
+    TEST_ASSERT_EQUAL(3, *cache.find(3));
+}
+
+// 新しい要求の読み込みはそのまま残す（IDが16bitで一周しても）
+void test_retire_keeps_newer_requests(void) {
+    Cache cache;
+    request(cache, 0, 0xFFFE);
+    request(cache, 1, 2);
+    std::vector<uint32_t> retired;
+    cache.retireOlder(1, [&retired](uint32_t page) { retired.push_back(page); });
+    TEST_ASSERT_EQUAL(1, retired.size());
+    TEST_ASSERT_EQUAL(0, retired[0]);
+    TEST_ASSERT_TRUE(cache.contains(1));
+    TEST_ASSERT_TRUE(cache.hasLoading());
+    TEST_ASSERT_TRUE(Cache::isOlderRequest(0xFFFF, 1));
+    TEST_ASSERT_FALSE(Cache::isOlderRequest(1, 0xFFFF));
+    TEST_ASSERT_FALSE(Cache::isOlderRequest(5, 5));
+}
+
+// 目録が変わったら読めたページを捨てるが、読み込み中の枠には触らない
+void test_reset_keeps_loading_pages(void) {
+    Cache cache;
+    size_t index = request(cache, 0, 1);
+    fill(cache, index, 0);
+    cache.complete(1, true, ENTRIES);
+    request(cache, 1, 2);
+    cache.reset();
+    TEST_ASSERT_FALSE(cache.contains(0));
+    TEST_ASSERT_TRUE(cache.contains(1));
+    TEST_ASSERT_TRUE(cache.hasLoading());
+}
+
+// 空きがなければ表示中でないページのうちいちばん長く使っていないものを読み直す
+void test_reserve_evicts_least_recently_used_hidden_page(void) {
+    Cache cache;
+    for (uint32_t page = 0; page < PAGES; page++) {
+        size_t index = request(cache, page, static_cast<uint16_t>(page + 1));
+        fill(cache, index, page);
+        cache.complete(static_cast<uint16_t>(page + 1), true, ENTRIES);
+    }
+    cache.find(2 * ENTRIES);
+    cache.find(0);
+    // ページ0・1が表示中なら、ページ2しか選べない
+    size_t index = cache.reserve(0, 1, MAX_LOADING);
+    TEST_ASSERT_NOT_EQUAL(Cache::NO_SLOT, index);
+    cache.markLoading(index, 5, 10);
+    TEST_ASSERT_FALSE(cache.contains(2));
+    // 表示中が3〜4なら、使ったのがいちばん古いページ1を選ぶ
+    index = cache.reserve(3, 4, MAX_LOADING);
+    cache.markLoading(index, 6, 11);
+    TEST_ASSERT_FALSE(cache.contains(1));
+    TEST_ASSERT_TRUE(cache.contains(0));
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_loaded_page_is_found);
+    RUN_TEST(test_failed_page_is_freed);
+    RUN_TEST(test_exit_while_loading_recovers_on_next_result);
+    RUN_TEST(test_retire_keeps_newer_requests);
+    RUN_TEST(test_reset_keeps_loading_pages);
+    RUN_TEST(test_reserve_evicts_least_recently_used_hidden_page);
+    return UNITY_END();
+}
@@ -0,0 +1,190 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../../../src/audio/SfxMixer.h"
+#include "../../../src/audio/SfxClips.cpp"
+
+// テスト用の時計（μs）
+static uint32_t g_nowUs = 0;
+
+static uint32_t fakeClock() {
+    return g_nowUs;
+}
+
+// 実機の出力段と同じ大きさ（44.1kHz、64フレーム×4バッファ）
+static const uint32_t OUTPUT_RATE = 44100;
+static const size_t BLOCK_FRAMES = 64;
+static const uint32_t BLOCK_US = BLOCK_FRAMES * 1000000 / OUTPUT_RATE;
+static const uint32_t QUEUED_US = 4 * BLOCK_FRAMES * 1000000 / OUTPUT_RATE;
+
+void setUp(void) {
+    g_nowUs = 1000;
+}
+
+void tearDown(void) {
+}
+
+// 16kHzの波形を32kHzに出すと各サンプルが2回ずつ並び、左右に同じ値が重なる
+void test_clip_is_resampled_and_scaled(void) {
+    SfxMixer mixer(fakeClock);
+    TEST_ASSERT_TRUE(mixer.trigger(SFX_CLICK, 128));
+    const SfxClip& clip = SFX_CLIPS[SFX_CLICK];
+    std::vector<int16_t> block(clip.length * 2 * 2 + 8, 0);
+    mixer.mix(block.data(), block.size() / 2, 32000, 0);
+    for (size_t i = 0; i < clip.length * 2; i++) {
+        int16_t expected = static_cast<int16_t>(clip.samples[i / 2] * 128);
+        TEST_ASSERT_EQUAL(expected, block[i * 2]);
+        TEST_ASSERT_EQUAL(expected, block[i * 2 + 1]);
+    }
+    // 鳴り終わった後ろは触らない
+    TEST_ASSERT_EQUAL(0, block[clip.length * 4]);
+}
+
+// 重ねた結果は16bitに飽和させる
+void test_mix_saturates(void) {
+    SfxMixer mixer(fakeClock);
+    mixer.trigger(SFX_ERROR);
+    // 矩形波の正負の両方が重なる長さ
+    std::vector<int16_t> block(BLOCK_FRAMES * 16 * 2);
+    for (size_t i = 0; i < block.size(); i++) {
+        block[i] = (i / 2) % 2 == 0 ? 32000 : -32000;
+    }
+    mixer.mix(block.data(), block.size() / 2, OUTPUT_RATE, 0);
+    bool clippedHigh = false;
+    bool clippedLow = false;
+    for (int16_t sample : block) {
+        clippedHigh = clippedHigh || sample == 32767;
+        clippedLow = clippedLow || sample == -32768;
+    }
+    TEST_ASSERT_TRUE(clippedHigh);
+    TEST_ASSERT_TRUE(clippedLow);
+}
+
+// 空きがなければいちばん古い音を止めて鳴らす
+void test_oldest_voice_is_stolen(void) {
+    SfxMixer mixer(fakeClock);
+    std::vector<int16_t> block(BLOCK_FRAMES * 2, 0);
+    for (int i = 0; i < AUDIO_SFX_VOICES + 1; i++) {
+        mixer.trigger(SFX_ERROR);
+    }
+    mixer.mix(block.data(), BLOCK_FRAMES, OUTPUT_RATE, 0);
+    TEST_ASSERT_EQUAL(AUDIO_SFX_VOICES + 1, mixer.getTriggeredCount());
+    TEST_ASSERT_EQUAL(1, mixer.getStolenCount());
+
+    // 要求のリングを超えた分は捨てる
+    for (int i = 0; i < AUDIO_SFX_COMMANDS + 2; i++) {
+        mixer.trigger(SFX_CLICK);
+    }
+    TEST_ASSERT_EQUAL(2, mixer.getDroppedCount());
+}
+
+// タッチ → 受け付け → 組み立て → 出力の各区間をタイムスタンプで記録する
+void test_latency_is_traced_per_stage(void) {
+    SfxMixer mixer(fakeClock);
+    std::vector<int16_t> block(BLOCK_FRAMES * 2, 0);
+    mixer.markInput(1000);
+    g_nowUs = 2500;
+    mixer.trigger(SFX_CLICK);
+    g_nowUs = 3400;
+    mixer.mix(block.data(), BLOCK_FRAMES, OUTPUT_RATE, QUEUED_US);
+    const LatencyTracer& tracer = mixer.getTracer();
+    TEST_ASSERT_EQUAL(1, tracer.getCount());
+    TEST_ASSERT_EQUAL(1500, tracer.getStageMaxUs(LatencyTracer::STAGE_DISPATCH));
+    TEST_ASSERT_EQUAL(900, tracer.getStageMaxUs(LatencyTracer::STAGE_MIX));
+    TEST_ASSERT_EQUAL(QUEUED_US, tracer.getStageMaxUs(LatencyTracer::STAGE_OUTPUT));
+    TEST_ASSERT_EQUAL(2400 + QUEUED_US, tracer.getLastTotalUs());
+
+    // 続くブロックでは同じ音を二重に数えない
+    g_nowUs += BLOCK_US;
+    mixer.mix(block.data(), BLOCK_FRAMES, OUTPUT_RATE, QUEUED_US);
+    TEST_ASSERT_EQUAL(1, tracer.getCount());
+
+    // 古いタッチは遅延に含めない（タッチと関係なく鳴らした音）
+    mixer.markInput(g_nowUs);
+    g_nowUs += AUDIO_SFX_INPUT_WINDOW_US + 1;
+    mixer.trigger(SFX_ERROR);
+    mixer.mix(block.data(), BLOCK_FRAMES, OUTPUT_RATE, QUEUED_US);
+    TEST_ASSERT_EQUAL(QUEUED_US, tracer.getLastTotalUs());
+}
+
+// 実機の周期を模擬: タッチ（10ms周期）→ 表示タスクの前倒し（描画中なら終わるまで）→ 出力ブロック
+static void simulateTouches(SfxMixer& mixer, uint32_t maxRenderUs, int touches) {
+    std::vector<int16_t> block(BLOCK_FRAMES * 2, 0);
+    uint32_t seed = 7;
+    uint32_t nextBlockUs = g_nowUs;
+    for (int i = 0; i < touches; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t touchUs = g_nowUs + 10000 + (seed >> 8) % 10000;
+        // 表示タスクが描画中ならその残りだけ待ち、そうでなければ通知ですぐ起きる
+        uint32_t busyUs = (seed >> 4) % (maxRenderUs + 1);
+        // 出力タスクはブロックごとにmix()を呼ぶ
+        while (nextBlockUs < touchUs) {
+            g_nowUs = nextBlockUs;
+            mixer.mix(block.data(), BLOCK_FRAMES, OUTPUT_RATE, QUEUED_US);
+            nextBlockUs += BLOCK_US;
+        }
+        g_nowUs = touchUs;
+        mixer.markInput(touchUs);
+        g_nowUs = touchUs + busyUs + 300;    // 配信と押下処理
+        mixer.trigger(SFX_CLICK);
+        while (nextBlockUs < g_nowUs) {
+            nextBlockUs += BLOCK_US;
+        }
+        g_nowUs = nextBlockUs;
+        mixer.mix(block.data(), BLOCK_FRAMES, OUTPUT_RATE, QUEUED_US);
+        nextBlockUs += BLOCK_US;
+    }
+}
+
+// 描画が2ms以内なら、タッチから音が出るまで10ms以内に収まる
+void test_touch_to_click_within_budget(void) {
+    SfxMixer mixer(fakeClock);
+    simulateTouches(mixer, 2000, 200);
+    const LatencyTracer& tracer = mixer.getTracer();
+    TEST_ASSERT_EQUAL(200, tracer.getCount());
+    TEST_ASSERT_EQUAL(0, tracer.getOverBudgetCount());
+    TEST_ASSERT_TRUE(tracer.getMaxTotalUs() < AUDIO_SFX_LATENCY_BUDGET_US);
+}
+
+static void benchmark() {
+    SfxMixer simulated(fakeClock);
+    simulateTouches(simulated, 2000, 1000);
+    const LatencyTracer& tracer = simulated.getTracer();
+    printf("BENCH touch-to-click (simulated): avg %u us, max %u us, stages max %u/%u/%u us\n",
+           (unsigned)tracer.getAverageTotalUs(), (unsigned)tracer.getMaxTotalUs(),
+           (unsigned)tracer.getStageMaxUs(LatencyTracer::STAGE_DISPATCH),
+           (unsigned)tracer.getStageMaxUs(LatencyTracer::STAGE_MIX),
+           (unsigned)tracer.getStageMaxUs(LatencyTracer::STAGE_OUTPUT));
+
+    // 4音同時に重ねるコスト
+    SfxMixer mixer(fakeClock);
+    std::vector<int16_t> block(BLOCK_FRAMES * 2, 0);
+    const int blocks = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < blocks; i++) {
+        if (i % 40 == 0) {
+            for (int v = 0; v < AUDIO_SFX_VOICES; v++) {
+                mixer.trigger(SFX_ERROR);
+            }
+        }
+        mixer.mix(block.data(), BLOCK_FRAMES, OUTPUT_RATE, QUEUED_US);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    printf("BENCH sfx mix: %.0f ns per %u-frame block (block period %u us)\n",
+           ns / blocks, (unsigned)BLOCK_FRAMES, (unsigned)BLOCK_US);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_clip_is_resampled_and_scaled);
+    RUN_TEST(test_mix_saturates);
+    RUN_TEST(test_oldest_voice_is_stolen);
+    RUN_TEST(test_latency_is_traced_per_stage);
+    RUN_TEST(test_touch_to_click_within_budget);
+    benchmark();
+    return UNITY_END();
+}
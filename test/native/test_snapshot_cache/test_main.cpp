@@ -0,0 +1,177 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../../../src/display/SnapshotCache.cpp"
+
+static const uint16_t WIDTH = 320;
+static const uint16_t HEIGHT = 240;
+static const uint16_t STRIP_ROWS = 8;
+
+// メニュー画面相当の合成フレーム（黒背景・角丸なしのボタン・文字の行）
+static std::vector<uint16_t> makeMenuFrame() {
+    std::vector<uint16_t> frame(WIDTH * HEIGHT, 0x0000);
+    for (int row = 0; row < 2; row++) {
+        for (int col = 0; col < 3; col++) {
+            int x0 = 16 + col * 100;
+            int y0 = 60 + row * 80;
+            uint16_t color = static_cast<uint16_t>(0x2104 * (row * 3 + col + 1));
+            for (int y = y0; y < y0 + 60; y++) {
+                for (int x = x0; x < x0 + 90; x++) {
+                    frame[y * WIDTH + x] = color;
+                }
+            }
+            // ボタン中央の文字（細かい模様）
+            for (int y = y0 + 22; y < y0 + 38; y++) {
+                for (int x = x0 + 20; x < x0 + 70; x++) {
+                    if (((x * 7 + y * 13) % 5) == 0) {
+                        frame[y * WIDTH + x] = 0xFFFF;
+                    }
+                }
+            }
+        }
+    }
+    return frame;
+}
+
+static void captureFrame(SnapshotCache& cache, uint8_t key, const std::vector<uint16_t>& frame) {
+    TEST_ASSERT_TRUE(cache.beginCapture(key, WIDTH, HEIGHT));
+    for (uint16_t y = 0; y < HEIGHT; y += STRIP_ROWS) {
+        cache.appendRows(&frame[y * WIDTH], STRIP_ROWS);
+    }
+}
+
+struct FrameSink {
+    std::vector<uint16_t>* out;
+    void operator()(uint16_t y, uint16_t rows, const uint16_t* pixels) {
+        for (size_t i = 0; i < static_cast<size_t>(rows) * WIDTH; i++) {
+            (*out)[y * WIDTH + i] = pixels[i];
+        }
+    }
+};
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 行の符号化と復号で元に戻る（ラン・リテラル・128画素超の境界を含む）
+void test_row_round_trip(void) {
+    uint16_t row[300];
+    for (int i = 0; i < 300; i++) {
+        row[i] = i < 200 ? 0x1234 : static_cast<uint16_t>(i * 31);
+    }
+    row[5] = 0xFFFF;
+    uint8_t encoded[rle565::maxEncodedRowSize(300)];
+    size_t size = rle565::encodeRow(row, 300, encoded, sizeof(encoded));
+    TEST_ASSERT_TRUE(size > 0);
+    TEST_ASSERT_TRUE(size < sizeof(encoded));
+
+    uint16_t decoded[300];
+    TEST_ASSERT_EQUAL(size, rle565::decodeRow(encoded, size, decoded, 300));
+    for (int i = 0; i < 300; i++) {
+        TEST_ASSERT_EQUAL(row[i], decoded[i]);
+    }
+
+    // 途中で切れたデータは失敗する
+    TEST_ASSERT_EQUAL(0, rle565::decodeRow(encoded, size - 1, decoded, 300));
+}
+
+// 画面全体を撮影して復元でき、命中率が数えられる
+void test_capture_and_restore_frame(void) {
+    std::vector<uint16_t> frame = makeMenuFrame();
+    SnapshotCache cache(40960);
+    captureFrame(cache, 1, frame);
+    TEST_ASSERT_FALSE(cache.isCapturing());
+    TEST_ASSERT_TRUE(cache.contains(1));
+    TEST_ASSERT_TRUE(cache.getUsedBytes() < WIDTH * HEIGHT * 2 / 4);
+
+    std::vector<uint16_t> restored(WIDTH * HEIGHT, 0xDEAD);
+    std::vector<uint16_t> strip(WIDTH * STRIP_ROWS);
+    FrameSink sink = {&restored};
+
+    auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT_TRUE(cache.restore(1, strip.data(), STRIP_ROWS, sink));
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT_TRUE(restored == frame);
+
+    TEST_ASSERT_FALSE(cache.restore(2, strip.data(), STRIP_ROWS, sink));
+    TEST_ASSERT_EQUAL(1, cache.getHitCount());
+    TEST_ASSERT_EQUAL(1, cache.getMissCount());
+    TEST_ASSERT_EQUAL(50, cache.getHitRatePercent());
+
+    printf("menu frame: %u -> %u bytes (%.1f%%), decode %lld us on host\n",
+           (unsigned)(WIDTH * HEIGHT * 2), (unsigned)cache.getUsedBytes(),
+           100.0 * cache.getUsedBytes() / (WIDTH * HEIGHT * 2), (long long)elapsedUs);
+}
+
+// 予算を超えると最も使われていないスナップショットから破棄する
+void test_budget_evicts_least_recently_used(void) {
+    std::vector<uint16_t> frame = makeMenuFrame();
+    SnapshotCache probe(40960);
+    captureFrame(probe, 0, frame);
+    size_t one = probe.getUsedBytes();
+
+    SnapshotCache cache(one * 2 + one / 2);
+    std::vector<uint16_t> strip(WIDTH * STRIP_ROWS);
+    std::vector<uint16_t> restored(WIDTH * HEIGHT);
+    FrameSink sink = {&restored};
+
+    captureFrame(cache, 1, frame);
+    captureFrame(cache, 2, frame);
+    TEST_ASSERT_TRUE(cache.restore(1, strip.data(), STRIP_ROWS, sink));   // 1を最近使ったことにする
+    captureFrame(cache, 3, frame);
+
+    TEST_ASSERT_TRUE(cache.contains(1));
+    TEST_ASSERT_FALSE(cache.contains(2));
+    TEST_ASSERT_TRUE(cache.contains(3));
+    TEST_ASSERT_TRUE(cache.getUsedBytes() <= cache.getBudget());
+}
+
+// 圧縮が効かない画面は予算を超えた時点で撮影を中止する
+void test_incompressible_frame_is_rejected(void) {
+    std::vector<uint16_t> noise(WIDTH * HEIGHT);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < noise.size(); i++) {
+        seed = seed * 1103515245u + 12345u;
+        noise[i] = static_cast<uint16_t>(seed >> 16);
+    }
+    SnapshotCache cache(8192);
+    captureFrame(cache, 4, noise);
+    TEST_ASSERT_FALSE(cache.isCapturing());
+    TEST_ASSERT_FALSE(cache.contains(4));
+    TEST_ASSERT_EQUAL(1, cache.getOverflowCount());
+}
+
+// 無効化と撮り直し
+void test_invalidate_and_recapture(void) {
+    std::vector<uint16_t> frame = makeMenuFrame();
+    SnapshotCache cache(40960);
+    captureFrame(cache, 1, frame);
+    cache.invalidate(1);
+    TEST_ASSERT_FALSE(cache.contains(1));
+
+    // 撮影途中の無効化は撮影を中止する
+    TEST_ASSERT_TRUE(cache.beginCapture(1, WIDTH, HEIGHT));
+    cache.appendRows(frame.data(), STRIP_ROWS);
+    cache.invalidate(1);
+    TEST_ASSERT_FALSE(cache.isCapturing());
+
+    captureFrame(cache, 1, frame);
+    TEST_ASSERT_TRUE(cache.contains(1));
+    TEST_ASSERT_EQUAL(2, cache.getCaptureCount());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_row_round_trip);
+    RUN_TEST(test_capture_and_restore_frame);
+    RUN_TEST(test_budget_evicts_least_recently_used);
+    RUN_TEST(test_incompressible_frame_is_rejected);
+    RUN_TEST(test_invalidate_and_recapture);
+    return UNITY_END();
+}
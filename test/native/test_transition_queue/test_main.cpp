@@ -0,0 +1,175 @@
+#include <unity.h>
+#include <cstdio>
+#include "../../../src/screens/TransitionQueue.h"
+
+static const uint32_t FRAME_MS = 16;   // 表示タスクの周期
+
+// フレームを進めながら切り替え回数と最後の行き先を記録
+struct FrameLog {
+    int swaps;
+    ScreenID lastTarget;
+    uint8_t minLevel;
+    FrameLog() : swaps(0), lastTarget(SCREEN_HOME), minLevel(255) {}
+
+    void apply(const TransitionQueue::Step& step) {
+        if (step.swap) {
+            swaps++;
+            lastTarget = step.request.target;
+        }
+        if (step.setLevel && step.level < minLevel) {
+            minLevel = step.level;
+        }
+    }
+};
+
+// 遷移要求（時刻付き）
+struct ScriptedTap {
+    uint32_t atMs;
+    ScreenID target;
+    TransitionType type;
+};
+
+// 台本どおりに要求を出し、最後の遷移が終わるまでの時間を返す
+static uint32_t runScript(TransitionQueue& queue, const ScriptedTap* taps, size_t count, FrameLog& log) {
+    size_t next = 0;
+    uint32_t now = 0;
+    while ((next < count || queue.isBusy()) && now < 10000) {
+        while (next < count && taps[next].atMs <= now) {
+            queue.request(taps[next].target, taps[next].type, taps[next].atMs);
+            next++;
+        }
+        log.apply(queue.advance(now));
+        now += FRAME_MS;
+    }
+    return now - FRAME_MS - taps[0].atMs;
+}
+
+// 要求を1件ずつ最後まで処理した場合（従来の直列処理）の所要時間
+static uint32_t serialDuration(const ScriptedTap* taps, size_t count) {
+    uint32_t finish = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t start = taps[i].atMs > finish ? taps[i].atMs : finish;
+        finish = start + (taps[i].type == TRANSITION_FADE ? TRANSITION_FADE_MS : FRAME_MS);
+    }
+    return finish - taps[0].atMs;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 同じフレーム内の連続要求は最後の行き先1回の切り替えにまとまる
+void test_chain_collapses_to_last_target(void) {
+    TransitionQueue queue;
+    queue.request(SCREEN_MENU, TRANSITION_NONE, 0);
+    queue.request(SCREEN_SETTINGS, TRANSITION_SLIDE_LEFT, 0);
+    queue.request(SCREEN_INFO, TRANSITION_SLIDE_LEFT, 0);
+
+    TransitionQueue::Step step = queue.advance(0);
+    TEST_ASSERT_TRUE(step.swap);
+    TEST_ASSERT_EQUAL(SCREEN_INFO, step.request.target);
+    TEST_ASSERT_EQUAL(2, queue.getCollapsedCount());
+    TEST_ASSERT_FALSE(queue.isBusy());
+}
+
+// フェードは暗転→切り替え→復帰の順に進み、明るさは元に戻る
+void test_fade_ramps_backlight_around_swap(void) {
+    TransitionQueue queue;
+    queue.request(SCREEN_SETTINGS, TRANSITION_FADE, 0);
+
+    TransitionQueue::Step first = queue.advance(0);
+    TEST_ASSERT_TRUE(first.started);
+    TEST_ASSERT_FALSE(first.swap);
+
+    uint8_t previous = 255;
+    uint32_t now = 0;
+    uint32_t swapAt = 0;
+    while (queue.isBusy()) {
+        now += FRAME_MS;
+        TransitionQueue::Step step = queue.advance(now);
+        TEST_ASSERT_TRUE(step.setLevel);
+        if (step.swap) {
+            TEST_ASSERT_EQUAL(0, step.level);
+            swapAt = now;
+        } else if (swapAt == 0) {
+            TEST_ASSERT_TRUE(step.level <= previous);
+        }
+        previous = step.level;
+    }
+    TEST_ASSERT_EQUAL(255, queue.getLevel());
+    TEST_ASSERT_INT_WITHIN(FRAME_MS, TRANSITION_FADE_MS / 2, swapAt);
+    TEST_ASSERT_INT_WITHIN(FRAME_MS, TRANSITION_FADE_MS, queue.getLastLatencyMs());
+}
+
+// 復帰中に新しい要求が来たら、途中の明るさから次の遷移に切り替える
+void test_new_target_cancels_fade_in(void) {
+    TransitionQueue queue;
+    FrameLog log;
+    queue.request(SCREEN_SETTINGS, TRANSITION_FADE, 0);
+    uint32_t now = 0;
+    while (log.swaps == 0) {
+        log.apply(queue.advance(now));
+        now += FRAME_MS;
+    }
+    log.apply(queue.advance(now));   // 復帰を1フレーム進める
+    uint8_t levelAtCancel = queue.getLevel();
+    TEST_ASSERT_TRUE(levelAtCancel > 0 && levelAtCancel < 255);
+
+    queue.request(SCREEN_INFO, TRANSITION_FADE, now);
+    TEST_ASSERT_EQUAL(1, queue.getCancelledCount());
+    TransitionQueue::Step step = queue.advance(now + FRAME_MS);
+    TEST_ASSERT_FALSE(step.started);
+    TEST_ASSERT_TRUE(step.level <= levelAtCancel);
+
+    while (queue.isBusy()) {
+        now += FRAME_MS;
+        log.apply(queue.advance(now));
+    }
+    TEST_ASSERT_EQUAL(2, log.swaps);
+    TEST_ASSERT_EQUAL(SCREEN_INFO, log.lastTarget);
+    TEST_ASSERT_EQUAL(255, queue.getLevel());
+}
+
+// 台本どおりの素早いタップ: Menu → Settings → Info
+void test_scripted_navigation_time(void) {
+    const ScriptedTap fadeTaps[] = {
+        {0,  SCREEN_SETTINGS, TRANSITION_FADE},
+        {40, SCREEN_INFO,     TRANSITION_FADE},
+    };
+    const ScriptedTap slideTaps[] = {
+        {0,  SCREEN_MENU,     TRANSITION_SLIDE_UP},
+        {5,  SCREEN_SETTINGS, TRANSITION_SLIDE_LEFT},
+        {10, SCREEN_INFO,     TRANSITION_SLIDE_LEFT},
+    };
+
+    TransitionQueue fadeQueue;
+    FrameLog fadeLog;
+    uint32_t fadeMs = runScript(fadeQueue, fadeTaps, 2, fadeLog);
+    TEST_ASSERT_EQUAL(SCREEN_INFO, fadeLog.lastTarget);
+    TEST_ASSERT_EQUAL(1, fadeLog.swaps);
+    TEST_ASSERT_TRUE(fadeMs < serialDuration(fadeTaps, 2));
+
+    TransitionQueue slideQueue;
+    FrameLog slideLog;
+    uint32_t slideMs = runScript(slideQueue, slideTaps, 3, slideLog);
+    TEST_ASSERT_EQUAL(SCREEN_INFO, slideLog.lastTarget);
+    TEST_ASSERT_TRUE(slideLog.swaps <= 2);
+
+    printf("fade  Settings->Info: %lu ms, %d swap(s) (serial: %lu ms, 2 swaps)\n",
+           (unsigned long)fadeMs, fadeLog.swaps, (unsigned long)serialDuration(fadeTaps, 2));
+    printf("slide Menu->Settings->Info: %lu ms, %d swap(s) (serial: %lu ms, 3 swaps)\n",
+           (unsigned long)slideMs, slideLog.swaps, (unsigned long)serialDuration(slideTaps, 3));
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_chain_collapses_to_last_target);
+    RUN_TEST(test_fade_ramps_backlight_around_swap);
+    RUN_TEST(test_new_target_cancels_fade_in);
+    RUN_TEST(test_scripted_navigation_time);
+    return UNITY_END();
+}
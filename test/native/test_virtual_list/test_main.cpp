@@ -0,0 +1,166 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include "../../../src/ui/components/VirtualList.h"
+
+// ファイル一覧と同じ大きさ（高さ160pxに32pxの行）
+static const int16_t TOP = 80;
+static const uint16_t HEIGHT = 160;
+static const uint16_t ROW = 32;
+static const size_t SLOTS = VirtualList<uint32_t, 1>::slotsFor(HEIGHT, ROW);
+
+typedef VirtualList<uint32_t, SLOTS> List;
+
+// bindは項目番号を行に入れ、readyLimit以上の項目は「まだ読めていない」とする
+struct Source {
+    uint32_t readyLimit = 0xFFFFFFFF;
+    uint32_t binds = 0;
+    uint32_t draws = 0;
+    uint32_t lastDrawn = List::NO_ITEM;
+    bool mismatch = false;
+};
+
+static void attach(List& list, Source& source) {
+    Source* s = &source;
+    list.setBinder([s](uint32_t item, uint32_t& row) {
+        s->binds++;
+        row = item;
+        return item < s->readyLimit;
+    });
+    list.setRenderer([s](uint32_t item, const uint32_t& row, bool, int16_t) {
+        s->draws++;
+        s->mismatch = s->mismatch || row != item;
+        s->lastDrawn = item;
+    });
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 何千件あっても、作るのは見えている行だけ
+void test_only_visible_rows_are_bound(void) {
+    TEST_ASSERT_EQUAL(6, SLOTS);
+    List list(TOP, HEIGHT, ROW);
+    Source source;
+    attach(list, source);
+    list.setItemCount(5000);
+    list.layout();
+    list.draw();
+    TEST_ASSERT_EQUAL(5, source.binds);
+    TEST_ASSERT_EQUAL(5, source.draws);
+    TEST_ASSERT_EQUAL(0, list.firstVisible());
+    TEST_ASSERT_EQUAL(4, list.lastVisible());
+    // 何も変わらなければ作り直さない
+    TEST_ASSERT_FALSE(list.layout());
+    TEST_ASSERT_EQUAL(5, source.binds);
+}
+
+// 1行ずらすと、新しく見えた行だけを作り、ほかのスロットはそのまま使う
+void test_scroll_recycles_slots(void) {
+    List list(TOP, HEIGHT, ROW);
+    Source source;
+    attach(list, source);
+    list.setItemCount(5000);
+    list.layout();
+    source.binds = 0;
+
+    TEST_ASSERT_TRUE(list.scrollBy(10));        // 0〜5が部分的に見える
+    list.layout();
+    TEST_ASSERT_EQUAL(1, source.binds);
+    TEST_ASSERT_TRUE(list.scrollBy(ROW - 10));  // 1〜5
+    TEST_ASSERT_FALSE(list.layout());
+    TEST_ASSERT_TRUE(list.scrollBy(ROW));       // 2〜6
+    list.layout();
+    TEST_ASSERT_EQUAL(2, source.binds);
+
+    source.draws = 0;
+    list.draw();
+    TEST_ASSERT_EQUAL(5, source.draws);
+    TEST_ASSERT_FALSE(source.mismatch);
+    TEST_ASSERT_EQUAL(TOP, list.itemY(2));
+    TEST_ASSERT_EQUAL(3, list.itemAt(TOP + ROW + 1));
+    TEST_ASSERT_EQUAL(List::NO_ITEM, list.itemAt(TOP - 1));
+}
+
+// まだ読めていない行は、invalidate()された範囲だけ作り直す
+void test_unready_rows_rebind_after_invalidate(void) {
+    List list(TOP, HEIGHT, ROW);
+    Source source;
+    source.readyLimit = 3;
+    attach(list, source);
+    list.setItemCount(100);
+    list.layout();
+    TEST_ASSERT_EQUAL(5, source.binds);
+
+    source.readyLimit = 100;
+    list.invalidate(3, 1);
+    list.layout();
+    TEST_ASSERT_EQUAL(7, source.binds);         // 3と、まだ読めていなかった4
+    TEST_ASSERT_FALSE(list.layout());
+    list.invalidate(0, 2);
+    list.layout();
+    TEST_ASSERT_EQUAL(9, source.binds);
+}
+
+// スクロールは範囲内に収まり、短いリストはスクロールしない
+void test_scroll_is_clamped(void) {
+    List list(TOP, HEIGHT, ROW);
+    Source source;
+    attach(list, source);
+    list.setItemCount(3);
+    TEST_ASSERT_EQUAL(0, list.getMaxScroll());
+    TEST_ASSERT_FALSE(list.scrollBy(50));
+    TEST_ASSERT_EQUAL(TOP + 3 * ROW, list.contentBottom());
+
+    list.setItemCount(1000);
+    TEST_ASSERT_TRUE(list.scrollTo(1 << 20));
+    TEST_ASSERT_EQUAL(1000 * ROW - HEIGHT, list.getScrollY());
+    TEST_ASSERT_EQUAL(999, list.lastVisible());
+    // 件数が減ったら位置も詰める
+    list.setItemCount(10);
+    TEST_ASSERT_EQUAL(10 * ROW - HEIGHT, list.getScrollY());
+    list.layout();
+    list.draw();
+    TEST_ASSERT_EQUAL(9, source.lastDrawn);
+}
+
+// 1万件を1pxずつ最後まで送り、1フレームあたりの作り直しと描画の行数を数える
+static void benchmark() {
+    List list(TOP, HEIGHT, ROW);
+    Source source;
+    attach(list, source);
+    list.setItemCount(10000);
+    uint32_t frames = 0;
+    uint32_t maxBinds = 0;
+    uint32_t maxDraws = 0;
+    auto start = std::chrono::steady_clock::now();
+    do {
+        uint32_t binds = source.binds;
+        uint32_t draws = source.draws;
+        list.layout();
+        list.draw();
+        maxBinds = source.binds - binds > maxBinds ? source.binds - binds : maxBinds;
+        maxDraws = source.draws - draws > maxDraws ? source.draws - draws : maxDraws;
+        frames++;
+    } while (list.scrollBy(1));
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    printf("BENCH virtual list: %u frames over 10000 items, %u binds total (max %u/frame), max %u rows drawn/frame, %u slots, %.0f ns/frame\n",
+           (unsigned)frames, (unsigned)source.binds, (unsigned)maxBinds, (unsigned)maxDraws, (unsigned)SLOTS,
+           ns / frames);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_only_visible_rows_are_bound);
+    RUN_TEST(test_scroll_recycles_slots);
+    RUN_TEST(test_unready_rows_rebind_after_invalidate);
+    RUN_TEST(test_scroll_is_clamped);
+    benchmark();
+    return UNITY_END();
+}